@@ -95,6 +95,8 @@
 #include "qjs_touch_list.h"
 #include "qjs_transition_event.h"
 #include "qjs_ui_event.h"
+#include "qjs_url.h"
+#include "qjs_url_search_params.h"
 #include "qjs_widget_element.h"
 #include "qjs_window.h"
 #include "qjs_window_or_worker_global_scope.h"
@@ -168,6 +170,8 @@ void InstallBindings(ExecutingContext* context) {
   QJSBoundingClientRect::Install(context);
   QJSScreen::Install(context);
   QJSBlob::Install(context);
+  QJSURL::Install(context);
+  QJSURLSearchParams::Install(context);
   QJSTouch::Install(context);
   QJSTouchList::Install(context);
   QJSDOMStringMap::Install(context);
@@ -11,6 +11,7 @@
 #include "bindings/qjs/qjs_engine_patch.h"
 #include "foundation/casting.h"
 #include "foundation/macros.h"
+#include "foundation/slab_allocator.h"
 #include "local_handle.h"
 
 namespace webf {
@@ -59,7 +60,12 @@ class MakeGarbageCollectedTrait {
  public:
   template <typename... Args>
   static T* Allocate(Args&&... args) {
-    T* object = ::new T(std::forward<Args>(args)...);
+    T* object;
+    if constexpr (IsSlabAllocated<T>::value) {
+      object = ::new (SlabAllocator::Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+    } else {
+      object = ::new T(std::forward<Args>(args)...);
+    }
     object->InitializeQuickJSObject();
     return object;
   }
@@ -6,6 +6,7 @@
 #include "qjs_engine_patch.h"
 #include <quickjs/cutils.h>
 #include <quickjs/list.h>
+#include <cassert>
 #include <cstring>
 
 #if WIN32
@@ -290,6 +291,8 @@ uint16_t* JS_ToUnicode(JSContext* ctx, JSValueConst value, uint32_t* length) {
   return buffer;
 }
 
+#define JS_STRING_LEN_MAX ((1 << 30) - 1)
+
 static JSString* js_alloc_string_rt(JSRuntime* rt, int max_len, int is_wide_char) {
   JSString* str;
   str = static_cast<JSString*>(js_malloc_rt(rt, sizeof(JSString) + (max_len << is_wide_char) + 1 - is_wide_char));
@@ -340,6 +343,24 @@ JSValue JS_NewRawUTF8String(JSContext* ctx, const uint8_t* buf, uint32_t len) {
   return JS_MKPTR(JS_TAG_STRING, str);
 }
 
+JSValue JS_NewUninitializedString8(JSContext* ctx, uint32_t length, uint8_t** characters) {
+  if (length > JS_STRING_LEN_MAX)
+    return JS_ThrowRangeError(ctx, "invalid string length");
+  JSString* str = js_alloc_string(JS_GetRuntime(ctx), ctx, length, 0);
+  if (!str)
+    return JS_EXCEPTION;
+  str->u.str8[length] = '\0';
+  *characters = str->u.str8;
+  return JS_MKPTR(JS_TAG_STRING, str);
+}
+
+void JS_TruncateString8(JSValue value, uint32_t length) {
+  JSString* str = JS_VALUE_GET_STRING(value);
+  assert(!str->is_wide_char && length <= str->len);
+  str->len = length;
+  str->u.str8[length] = '\0';
+}
+
 JSAtom JS_NewUnicodeAtom(JSContext* ctx, const uint16_t* code, uint32_t length) {
   JSValue value = JS_NewUnicodeString(ctx, code, length);
   JSAtom atom = JS_ValueToAtom(ctx, value);
@@ -117,6 +117,10 @@ static inline bool __JS_AtomIsConst(JSAtom v) {
 uint16_t* JS_ToUnicode(JSContext* ctx, JSValueConst value, uint32_t* length);
 JSValue JS_NewUnicodeString(JSContext* ctx, const uint16_t* code, uint32_t length);
 JSValue JS_NewRawUTF8String(JSContext* ctx, const uint8_t* code, uint32_t length);
+// Allocates an 8-bit string of |length| characters to be written through |characters| before the string is used,
+// which could be shortened by JS_TruncateString8 after the characters are written.
+JSValue JS_NewUninitializedString8(JSContext* ctx, uint32_t length, uint8_t** characters);
+void JS_TruncateString8(JSValue value, uint32_t length);
 JSAtom JS_NewUnicodeAtom(JSContext* ctx, const uint16_t* code, uint32_t length);
 JSClassID JSValueGetClassId(JSValue);
 bool JS_IsProxy(JSValue value);
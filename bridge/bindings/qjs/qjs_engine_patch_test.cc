@@ -100,3 +100,107 @@ TEST(JS_NewUnicodeString, fromChieseCode) {
   JS_FreeContext(ctx);
   JS_FreeRuntime(runtime);
 }
+
+static std::string EvalToString(JSContext* ctx, const std::string& code) {
+  JSValue result = JS_Eval(ctx, code.c_str(), code.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+  if (JS_IsException(result))
+    result = JS_GetException(ctx);
+  const char* str = JS_ToCString(ctx, result);
+  std::string string = str;
+  JS_FreeCString(ctx, str);
+  JS_FreeValue(ctx, result);
+  return string;
+}
+
+TEST(JS_RegExp, compiledFromTheSameSource) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  EXPECT_EQ(EvalToString(ctx,
+                         "var r = [];"
+                         "for (var i = 0; i < 3; i++) r.push('xabbAB ab'.replace(new RegExp('a(b+)', i == 2 ? 'gi' : 'g'), "
+                         "'[$1]'));"
+                         "r.join('|')"),
+            "x[bb]AB [b]|x[bb]AB [b]|x[bb][B] [b]");
+  EXPECT_EQ(EvalToString(ctx, "new RegExp('(', 'g')"), "SyntaxError: expecting ')'");
+  EXPECT_EQ(EvalToString(ctx, "new RegExp('(', 'g')"), "SyntaxError: expecting ')'");
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_RegExp, searchLongSubjects) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  EXPECT_EQ(EvalToString(ctx,
+                         "var s = '-'.repeat(100) + 'needle' + '-'.repeat(100) + 'needle';"
+                         "[s.search(/needle/), s.match(/ne+dle/g).length, s.split(/n(e)e/).length, /x/.test(s)].join()"),
+            "100,2,5,false");
+  EXPECT_EQ(EvalToString(ctx,
+                         "var w = '\\u0100'.repeat(40) + 'a1, b22,c333';"
+                         "[w.match(/\\d+/g).join(), w.split(/,\\s*/).length].join()"),
+            "1,22,333,3");
+  // A lone surrogate only matches inside a pair without the unicode flag.
+  EXPECT_EQ(EvalToString(ctx,
+                         "var e = 'x'.repeat(20) + '\\u{1F600}';"
+                         "[/\\u{1F600}/u.test(e), /\\uDE00/u.test(e), /\\uDE00/.test(e)].join()"),
+            "true,false,true");
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_InlineCache, globalVariables) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  EXPECT_EQ(EvalToString(ctx,
+                         "globalThis.doc = 1;"
+                         "function readDoc() { return doc; }"
+                         "function writeDoc(v) { doc = v; }"
+                         "var r = [readDoc(), readDoc()];"
+                         "writeDoc(2); writeDoc(3); r.push(readDoc());"
+                         "delete globalThis.doc; globalThis.doc = 4; r.push(readDoc());"
+                         "Object.defineProperty(globalThis, 'doc', {get() { return 'getter'; }}); r.push(readDoc());"
+                         "r.join()"),
+            "1,1,3,4,getter");
+  // A lexical declaration of a later script shadows the global object property.
+  EXPECT_EQ(EvalToString(ctx, "let doc = 'lexical'; readDoc()"), "lexical");
+  EXPECT_EQ(EvalToString(ctx,
+                         "function writeStrict() { 'use strict'; undeclared = 1; }"
+                         "var e = []; for (var i = 0; i < 2; i++) { try { writeStrict(); } catch (x) { e.push(x.name); } }"
+                         "e.join()"),
+            "ReferenceError,ReferenceError");
+
+  JSValue func = JS_Eval(ctx, "readDoc", 7, "<test>", JS_EVAL_TYPE_GLOBAL);
+  JSInlineCacheStats stats;
+  EXPECT_TRUE(JS_GetFunctionICStats(ctx, func, &stats));
+  EXPECT_EQ(stats.slot_count, 1u);
+  EXPECT_GT(stats.hits, 0u);
+  EXPECT_GT(stats.misses, 0u);
+  JS_FreeValue(ctx, func);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_InlineCache, prototypeChainMethods) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  EXPECT_EQ(EvalToString(ctx,
+                         "class A { m() { return 'A'; } } class B extends A {} class C extends B {}"
+                         "var c = new C();"
+                         "function call(o) { return o.m(); }"
+                         "var r = [call(c), call(c)];"
+                         "B.prototype.m = function() { return 'B'; }; r.push(call(c));"
+                         "delete B.prototype.m; r.push(call(c));"
+                         "Object.setPrototypeOf(C.prototype, { m() { return 'P'; } }); r.push(call(c));"
+                         "r.join()"),
+            "A,A,B,A,P");
+  // Array.prototype has an unhashed shape which is updated in place.
+  EXPECT_EQ(EvalToString(ctx,
+                         "var a = [1, 2];"
+                         "function find(x) { return x.indexOf(2); }"
+                         "var r = [find(a), find(a)];"
+                         "Array.prototype.indexOf = function() { return 'patched'; }; r.push(find(a));"
+                         "Object.defineProperty(Array.prototype, 'indexOf', { get() { return () => 'getter'; } });"
+                         "r.push(find(a)); r.join()"),
+            "1,1,patched,getter");
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
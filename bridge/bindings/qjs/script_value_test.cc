@@ -38,6 +38,27 @@ TEST(ScriptValue, CreateJsonObject) {
   });
 }
 
+TEST(ScriptValue, CreateJsonObjectWithRepeatedKeys) {
+  TestScriptValue([](JSContext* ctx) {
+    std::string code =
+        "[{\"id\":1,\"name\":\"a\\\"b\",\"size\":-0.5},{\"id\":2,\"name\":\"\\u00e9\",\"size\":1e+21},"
+        "{\"name\":\"c\",\"id\":3},{\"id\":4,\"id\":5}]";
+    ScriptValue value = ScriptValue::CreateJsonObject(ctx, code.c_str(), code.size());
+    EXPECT_EQ(value.IsObject(), true);
+    EXPECT_STREQ(value.ToJSONStringify(ctx, nullptr).ToString(ctx).ToStdString(ctx).c_str(),
+                 "[{\"id\":1,\"name\":\"a\\\"b\",\"size\":-0.5},{\"id\":2,\"name\":\"é\",\"size\":1e+21},"
+                 "{\"name\":\"c\",\"id\":3},{\"id\":5}]");
+  });
+}
+
+TEST(ScriptValue, CreateJsonObjectWithInvalidJson) {
+  TestScriptValue([](JSContext* ctx) {
+    std::string code = "{\"name\": 01}";
+    ScriptValue value = ScriptValue::CreateJsonObject(ctx, code.c_str(), code.size());
+    EXPECT_EQ(value.IsException(), true);
+  });
+}
+
 TEST(ScriptValue, Empty) {
   TestScriptValue([](JSContext* ctx) {
     ScriptValue empty = ScriptValue::Empty(ctx);
@@ -54,6 +75,15 @@ TEST(ScriptValue, ToString) {
   });
 }
 
+TEST(ScriptValue, ToJSONStringifyEscapesStrings) {
+  TestScriptValue([](JSContext* ctx) {
+    std::string code = "[\"a\\u0001\\ud800\\t\",{\"k\\n\":\"\\u00e9\\\"\",\"n\":[1.5,-0,1e21]}]";
+    ScriptValue json = ScriptValue::CreateJsonObject(ctx, code.c_str(), code.size());
+    EXPECT_STREQ(json.ToJSONStringify(ctx, nullptr).ToString(ctx).ToStdString(ctx).c_str(),
+                 "[\"a\\u0001\\ud800\\t\",{\"k\\n\":\"é\\\"\",\"n\":[1.5,0,1e+21]}]");
+  });
+}
+
 TEST(ScriptValue, CopyAssignment) {
   TestScriptValue([](JSContext* ctx) {
     std::string code = "{\"name\":1}";
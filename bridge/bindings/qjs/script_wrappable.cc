@@ -178,18 +178,18 @@ static int HandleJSPropertyDelete(JSContext* ctx, JSValueConst obj, JSAtom prop)
 
 static int HandleJSGetOwnPropertyNames(JSContext* ctx, JSPropertyEnum** ptab, uint32_t* plen, JSValueConst obj) {
   // All props and methods are finded in prototype object of scriptwrappable.
-  JSValue proto = JS_GetPrototype(ctx, obj);
-  bool result = JS_GetOwnPropertyNames(ctx, ptab, plen, proto, JS_GPN_ENUM_ONLY | JS_GPN_STRING_MASK);
-  JS_FreeValue(ctx, proto);
-  return result;
+  // Use the prototype of the class rather than the direct one, objects such as widget elements put a per-tag prototype
+  // in between whose properties are inherited, not own.
+  auto* object = static_cast<ScriptWrappable*>(JS_GetOpaque(obj, JSValueGetClassId(obj)));
+  JSValue proto = object->GetExecutingContext()->contextData()->prototypeForType(object->GetWrapperTypeInfo());
+  return JS_GetOwnPropertyNames(ctx, ptab, plen, proto, JS_GPN_ENUM_ONLY | JS_GPN_STRING_MASK);
 };
 
 static int HandleJSGetOwnProperty(JSContext* ctx, JSPropertyDescriptor* desc, JSValueConst obj, JSAtom prop) {
   // Call JSGetOwnPropertyNames will also call HandleJSGetOwnProperty for secondary verify.
-  JSValue proto = JS_GetPrototype(ctx, obj);
-  bool result = JS_GetOwnProperty(ctx, desc, proto, prop);
-  JS_FreeValue(ctx, proto);
-  return result;
+  auto* object = static_cast<ScriptWrappable*>(JS_GetOpaque(obj, JSValueGetClassId(obj)));
+  JSValue proto = object->GetExecutingContext()->contextData()->prototypeForType(object->GetWrapperTypeInfo());
+  return JS_GetOwnProperty(ctx, desc, proto, prop);
 }
 
 void ScriptWrappable::InitializeQuickJSObject() {
@@ -287,12 +287,16 @@ void ScriptWrappable::InitializeQuickJSObject() {
   /// within JavaScript code. When the reference count of `jsObject` decrease to 0, QuickJS will trigger `finalizer`
   /// callback and free `jsObject` memory. When QuickJS GC found `jsObject` at marking stage, `gc_mark` callback will be
   /// triggered.
-  jsObject_ = JS_NewObjectClass(ctx_, wrapper_type_info->classId);
+  /// The object is created with its prototype, so the objects of a class share one initial shape and the inline caches
+  /// of property lookups hit across them. Setting the prototype afterwards would give each object a shape of its own.
+  JSValue prototype = QuickJSObjectPrototype();
+  jsObject_ = JS_NewObjectProtoClass(ctx_, prototype, wrapper_type_info->classId);
+  JS_FreeValue(ctx_, prototype);
   JS_SetOpaque(jsObject_, this);
+}
 
-  // Let our instance into inherit prototype methods.
-  JSValue prototype = GetExecutingContext()->contextData()->prototypeForType(wrapper_type_info);
-  JS_SetPrototype(ctx_, jsObject_, prototype);
+JSValue ScriptWrappable::QuickJSObjectPrototype() {
+  return JS_DupValue(ctx_, GetExecutingContext()->contextData()->prototypeForType(GetWrapperTypeInfo()));
 }
 
 void ScriptWrappable::KeepAlive() {
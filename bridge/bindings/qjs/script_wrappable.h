@@ -67,6 +67,10 @@ class ScriptWrappable : public GarbageCollected<ScriptWrappable> {
   void KeepAlive();
   void ReleaseAlive();
 
+ protected:
+  // Returns a new reference to the prototype the JavaScript object is created with.
+  virtual JSValue QuickJSObjectPrototype();
+
  private:
   bool is_alive = false;
   JSValue jsObject_{JS_NULL};
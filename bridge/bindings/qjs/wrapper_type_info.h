@@ -18,6 +18,8 @@ class TouchList;
 enum {
   JS_CLASS_GC_TRACKER = JS_CLASS_INIT_COUNT + 1,
   JS_CLASS_BLOB,
+  JS_CLASS_URL,
+  JS_CLASS_URL_SEARCH_PARAMS,
   JS_CLASS_EVENT,
   JS_CLASS_ERROR_EVENT,
   JS_CLASS_MESSAGE_EVENT,
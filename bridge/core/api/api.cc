@@ -68,6 +68,28 @@ void evaluateQuickjsByteCodeInternal(void* page_,
                                                        persistent_handle, result_callback, is_success);
 }
 
+static void ReturnStartReplayRecordingToDart(Dart_PersistentHandle persistent_handle,
+                                             StartReplayRecordingCallback result_callback,
+                                             bool is_success) {
+  Dart_Handle handle = Dart_HandleFromPersistent_DL(persistent_handle);
+  result_callback(handle, is_success ? 1 : 0);
+  Dart_DeletePersistentHandle_DL(persistent_handle);
+}
+
+void startReplayRecordingInternal(void* page_,
+                                  char* path,
+                                  Dart_PersistentHandle persistent_handle,
+                                  StartReplayRecordingCallback result_callback) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+
+  bool is_success = page->executingContext()->StartReplayRecording(path);
+  free(path);
+
+  page->dartIsolateContext()->dispatcher()->PostToDart(page->isDedicated(), ReturnStartReplayRecordingToDart,
+                                                       persistent_handle, result_callback, is_success);
+}
+
 static void ReturnParseHTMLToDart(Dart_PersistentHandle persistent_handle, ParseHTMLCallback result_callback) {
   Dart_Handle handle = Dart_HandleFromPersistent_DL(persistent_handle);
   result_callback(handle);
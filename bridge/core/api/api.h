@@ -42,6 +42,11 @@ void invokeModuleEventInternal(void* page_,
                                Dart_Handle dart_handle,
                                InvokeModuleEventCallback result_callback);
 
+void startReplayRecordingInternal(void* page_,
+                                  char* path,
+                                  Dart_PersistentHandle persistent_handle,
+                                  StartReplayRecordingCallback result_callback);
+
 void dumpQuickJsByteCodeInternal(void* page_,
                                  int64_t profile_id,
                                  const char* code,
@@ -10,6 +10,7 @@
 #include "core/dom/events/event_target.h"
 #include "core/dom/mutation_observer_interest_group.h"
 #include "core/executing_context.h"
+#include "foundation/dart_readable.h"
 #include "foundation/native_string.h"
 #include "foundation/native_value_converter.h"
 #include "logging.h"
@@ -60,6 +61,9 @@ void NativeBindingObject::HandleCallFromDartSide(DartIsolateContext* dart_isolat
 
   dart_isolate_context->profiler()->StartTrackEvaluation(profile_id);
 
+  // Events and calls from dart side may be caused by layout changes, such as scrolling.
+  binding_object->binding_target_->GetExecutingContext()->layoutQueryCache()->Invalidate();
+
   AtomicString method = AtomicString(
       binding_object->binding_target_->ctx(),
       std::unique_ptr<AutoFreeNativeString>(reinterpret_cast<AutoFreeNativeString*>(native_method->u.ptr)));
@@ -119,7 +123,13 @@ NativeValue BindingObject::InvokeBindingMethod(const AtomicString& method,
   auto* context = GetExecutingContext();
   auto* profiler = context->dartIsolateContext()->profiler();
 
-  profiler->StartTrackSteps("BindingObject::InvokeBindingMethod");
+  profiler->StartTrackSteps(TraceLabel::kInvokeBindingMethod);
+  auto start = std::chrono::steady_clock::now();
+
+  // Methods implemented at dart side may change the layout, except the layout queries.
+  if (method != binding_call_methods::kgetBoundingClientRect && method != binding_call_methods::kgetClientRects) {
+    context->layoutQueryCache()->Invalidate();
+  }
 
   std::vector<NativeBindingObject*> invoke_elements_deps;
   // Collect all DOM elements in arguments.
@@ -135,7 +145,7 @@ NativeValue BindingObject::InvokeBindingMethod(const AtomicString& method,
   WEBF_LOG(INFO) << "[Dispatcher]: PostToDartSync method: InvokeBindingMethod; Call Begin";
 #endif
 
-  profiler->StartTrackLinkSteps("Call To Dart");
+  profiler->StartTrackLinkSteps(TraceLabel::kCallToDart);
 
   GetDispatcher()->PostToDartSync(
       GetExecutingContext()->isDedicated(), contextId(),
@@ -167,6 +177,8 @@ NativeValue BindingObject::InvokeBindingMethod(const AtomicString& method,
 
   profiler->FinishTrackLinkSteps();
   profiler->FinishTrackSteps();
+  context->metrics()->RecordBindingMethodCall(
+      method, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 
   return return_value;
 }
@@ -179,7 +191,18 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
   auto* context = GetExecutingContext();
   auto* profiler = context->dartIsolateContext()->profiler();
 
-  profiler->StartTrackSteps("BindingObject::InvokeBindingMethod");
+  profiler->StartTrackSteps(TraceLabel::kInvokeBindingMethod);
+  auto start = std::chrono::steady_clock::now();
+
+  switch (binding_method_call_operation) {
+    case BindingMethodCallOperations::kGetProperty:
+    case BindingMethodCallOperations::kGetAllPropertyNames:
+    case BindingMethodCallOperations::kGetLayoutProperties:
+      break;
+    default:
+      context->layoutQueryCache()->Invalidate();
+      break;
+  }
 
   std::vector<NativeBindingObject*> invoke_elements_deps;
   // Collect all DOM elements in arguments.
@@ -193,7 +216,7 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
   WEBF_LOG(INFO) << "[Dispatcher]: PostToDartSync method: InvokeBindingMethod; Call Begin";
 #endif
 
-  profiler->StartTrackLinkSteps("Call To Dart");
+  profiler->StartTrackLinkSteps(TraceLabel::kCallToDart);
 
   NativeValue native_method = NativeValueConverter<NativeTypeInt64>::ToNativeValue(binding_method_call_operation);
   GetDispatcher()->PostToDartSync(
@@ -225,6 +248,9 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
 
   profiler->FinishTrackLinkSteps();
   profiler->FinishTrackSteps();
+  context->metrics()->RecordBindingOperationCall(
+      binding_method_call_operation,
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 
   return return_value;
 }
@@ -239,7 +265,22 @@ NativeValue BindingObject::GetBindingProperty(const AtomicString& prop,
     return Native_NewNull();
   }
 
-  GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps("BindingObject::GetBindingProperty");
+  if (isUICommandReasonDependsOnLayout(reason)) {
+    LayoutQueryCache* layout_query_cache = GetExecutingContext()->layoutQueryCache();
+    NativeValue cached_result;
+    if (layout_query_cache->GetProperty(this, prop, &cached_result)) {
+      return cached_result;
+    }
+
+    if (auto* props = layout_query_cache->PropertyGroupOf(prop)) {
+      NativeValue result = Native_NewNull();
+      if (FetchLayoutProperties(*props, prop, reason, &result, exception_state) || exception_state.HasException()) {
+        return result;
+      }
+    }
+  }
+
+  GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kGetBindingProperty);
 
   const NativeValue argv[] = {Native_NewString(prop.ToNativeString(GetExecutingContext()->ctx()).release())};
   NativeValue result = InvokeBindingMethod(BindingMethodCallOperations::kGetProperty, 1, argv, reason, exception_state);
@@ -249,6 +290,42 @@ NativeValue BindingObject::GetBindingProperty(const AtomicString& prop,
   return result;
 }
 
+bool BindingObject::FetchLayoutProperties(const std::vector<AtomicString>& props,
+                                          const AtomicString& prop,
+                                          uint32_t reason,
+                                          NativeValue* result,
+                                          ExceptionState& exception_state) const {
+  GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kGetBindingProperty);
+
+  std::vector<NativeValue> argv;
+  argv.reserve(props.size());
+  for (auto& name : props) {
+    argv.emplace_back(Native_NewString(name.ToNativeString(ctx()).release()));
+  }
+  NativeValue values = InvokeBindingMethod(BindingMethodCallOperations::kGetLayoutProperties, argv.size(), argv.data(),
+                                           reason, exception_state);
+
+  GetExecutingContext()->dartIsolateContext()->profiler()->FinishTrackSteps();
+
+  if (exception_state.HasException() || values.tag != NativeTag::TAG_LIST) {
+    return false;
+  }
+
+  bool found = false;
+  auto* layout_query_cache = GetExecutingContext()->layoutQueryCache();
+  auto* list = static_cast<NativeValue*>(values.u.ptr);
+  for (uint32_t i = 0; i < values.uint32 && i < props.size(); i++) {
+    layout_query_cache->SetProperty(this, props[i], list[i]);
+    if (props[i] == prop) {
+      *result = list[i];
+      found = true;
+    }
+  }
+  dart_free(list);
+
+  return found;
+}
+
 NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
                                               NativeValue value,
                                               ExceptionState& exception_state) const {
@@ -262,17 +339,24 @@ NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
   if (auto element = const_cast<WidgetElement*>(DynamicTo<WidgetElement>(this))) {
     if (std::shared_ptr<MutationObserverInterestGroup> recipients =
             MutationObserverInterestGroup::CreateForAttributesMutation(*element, prop)) {
-      NativeValue old_native_value =
-          GetBindingProperty(prop, FlushUICommandReason::kDependentsOnElement, exception_state);
-      ScriptValue old_value = ScriptValue(ctx(), old_native_value);
-      recipients->EnqueueMutationRecord(
-          MutationRecord::CreateAttributes(element, prop, AtomicString::Null(), old_value.ToString(ctx())));
+      // Reading the old value is a sync call to dart, skip it when no observer asks for it.
+      AtomicString old_value = AtomicString::Null();
+      if (recipients->IsOldValueRequested()) {
+        NativeValue old_native_value =
+            GetBindingProperty(prop, FlushUICommandReason::kDependentsOnElement, exception_state);
+        old_value = ScriptValue(ctx(), old_native_value).ToString(ctx());
+      }
+      recipients->EnqueueMutationRecord(MutationRecord::CreateAttributes(element, prop, AtomicString::Null(), old_value));
     }
   }
 
-  const NativeValue argv[] = {Native_NewString(prop.ToNativeString(GetExecutingContext()->ctx()).release()), value};
-  return InvokeBindingMethod(BindingMethodCallOperations::kSetProperty, 2, argv,
-                             FlushUICommandReason::kDependentsOnElement, exception_state);
+  // The result of a setter is never used, the property is applied by dart side in the order of the UI commands and
+  // the next read from dart flushes it first.
+  auto* native_value = static_cast<NativeValue*>(malloc(sizeof(NativeValue)));
+  *native_value = value;
+  GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kSetProperty, prop.ToNativeString(ctx()),
+                                                       bindingObject(), native_value);
+  return Native_NewBool(true);
 }
 
 ScriptValue BindingObject::AnonymousFunctionCallback(JSContext* ctx,
@@ -68,6 +68,7 @@ enum BindingMethodCallOperations {
   kGetAllPropertyNames,
   kAnonymousFunctionCall,
   kAsyncAnonymousFunction,
+  kGetLayoutProperties,
 };
 
 enum CreateBindingObjectType { kCreateDOMMatrix = 0 };
@@ -150,6 +151,13 @@ class BindingObject : public ScriptWrappable {
   explicit BindingObject(JSContext* ctx, NativeBindingObject* native_binding_object);
 
  private:
+  // Fetch the layout properties of this object by one call and keep them in LayoutQueryCache.
+  bool FetchLayoutProperties(const std::vector<AtomicString>& props,
+                             const AtomicString& prop,
+                             uint32_t reason,
+                             NativeValue* result,
+                             ExceptionState& exception_state) const;
+
   NativeBindingObject* binding_object_ = nullptr;
   std::unordered_set<BindingObjectPromiseContext*> pending_promise_contexts_;
 };
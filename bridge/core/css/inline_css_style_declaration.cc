@@ -3,13 +3,16 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "inline_css_style_declaration.h"
+#include <algorithm>
 #include <vector>
+#include "core/css/parser/css_value_parser.h"
 #include "core/dom/element.h"
 #include "core/dom/mutation_observer_interest_group.h"
 #include "core/executing_context.h"
 #include "core/html/parser/html_parser.h"
 #include "css_property_list.h"
 #include "element_namespace_uris.h"
+#include "foundation/ascii_types.h"
 #include "html_names.h"
 
 namespace webf {
@@ -168,24 +171,54 @@ void InlineCssStyleDeclaration::SetCSSTextInternal(const AtomicString& value) {
   const std::string css_text = value.ToStdString(ctx());
   InternalClearProperty();
 
-  std::vector<std::string> styles;
-  std::string::size_type prev_pos = 0, pos = 0;
+  // Declarations are separated by the semicolons out of strings and parentheses, so values like url(data:...;base64)
+  // are kept whole. Each declaration is split at its first colon.
+  size_t declaration_begin = 0;
+  size_t colon = std::string::npos;
+  int parentheses = 0;
+  char quote = 0;
+  for (size_t i = 0; i <= css_text.size(); i++) {
+    char c = i < css_text.size() ? css_text[i] : ';';
+    if (quote != 0) {
+      if (c == '\\' && i + 1 < css_text.size())
+        i++;
+      else if (c == quote)
+        quote = 0;
+      if (i < css_text.size())
+        continue;
+    } else if (c == '"' || c == '\'') {
+      quote = c;
+      continue;
+    } else if (c == '(') {
+      parentheses++;
+      continue;
+    } else if (c == ')') {
+      parentheses = std::max(parentheses - 1, 0);
+      continue;
+    } else if (c == ':' && colon == std::string::npos) {
+      colon = i;
+      continue;
+    } else if (c != ';' || (parentheses > 0 && i < css_text.size())) {
+      continue;
+    }
 
-  while ((pos = css_text.find(';', pos)) != std::string::npos) {
-    styles.push_back(css_text.substr(prev_pos, pos - prev_pos));
-    prev_pos = ++pos;
-  }
-  styles.push_back(css_text.substr(prev_pos, pos - prev_pos));
-
-  for (auto& s : styles) {
-    std::string::size_type position = s.find(':');
-    if (position != std::basic_string<char>::npos) {
-      std::string css_key = s.substr(0, position);
-      css_key = trim(css_key);
-      std::string css_value = s.substr(position + 1, s.length());
-      css_value = trim(css_value);
-      InternalSetProperty(css_key, AtomicString(ctx(), css_value));
+    if (colon != std::string::npos) {
+      size_t key_begin = declaration_begin, key_end = colon;
+      size_t value_begin = colon + 1, value_end = std::min(i, css_text.size());
+      while (key_begin < key_end && IsASCIISpace(css_text[key_begin]))
+        key_begin++;
+      while (key_end > key_begin && IsASCIISpace(css_text[key_end - 1]))
+        key_end--;
+      while (value_begin < value_end && IsASCIISpace(css_text[value_begin]))
+        value_begin++;
+      while (value_end > value_begin && IsASCIISpace(css_text[value_end - 1]))
+        value_end--;
+      std::string css_key = css_text.substr(key_begin, key_end - key_begin);
+      InternalSetProperty(css_key, AtomicString(ctx(), css_text.data() + value_begin, value_end - value_begin));
     }
+    declaration_begin = i + 1;
+    colon = std::string::npos;
+    parentheses = 0;
   }
 }
 
@@ -193,20 +226,6 @@ void InlineCssStyleDeclaration::Trace(GCVisitor* visitor) const {
   visitor->TraceMember(owner_element_);
 }
 
-std::string InlineCssStyleDeclaration::ToString() const {
-  if (properties_.empty())
-    return "";
-
-  std::string s;
-
-  for (auto& attr : properties_) {
-    s += attr.first + ": " + attr.second.ToStdString(ctx()) + ";";
-  }
-
-  s += "\"";
-  return s;
-}
-
 void InlineCssStyleDeclaration::InlineStyleChanged() {
   assert(owner_element_->IsStyledElement());
 
@@ -215,7 +234,8 @@ void InlineCssStyleDeclaration::InlineStyleChanged() {
   if (std::shared_ptr<MutationObserverInterestGroup> recipients =
           MutationObserverInterestGroup::CreateForAttributesMutation(*owner_element_, html_names::kStyleAttr)) {
     AtomicString old_value = AtomicString::Null();
-    if (owner_element_->attributes()->hasAttribute(html_names::kStyleAttr, ASSERT_NO_EXCEPTION())) {
+    if (recipients->IsOldValueRequested() &&
+        owner_element_->attributes()->hasAttribute(html_names::kStyleAttr, ASSERT_NO_EXCEPTION())) {
       old_value = owner_element_->attributes()->getAttribute(html_names::kStyleAttr, ASSERT_NO_EXCEPTION());
     }
 
@@ -255,9 +275,12 @@ bool InlineCssStyleDeclaration::InternalSetProperty(std::string& name, const Ato
 
   properties_[name] = value;
 
+  // Common values are also sent parsed, so Dart side skips parsing them on the UI thread.
+  int64_t typed_value = value.IsEmpty() ? 0 : CSSValueParser::ParseStyleValue(value.ToStringView());
   std::unique_ptr<SharedNativeString> args_01 = stringToNativeString(name);
-  GetExecutingContext()->uiCommandBuffer()->AddCommand(
-      UICommand::kSetStyle, std::move(args_01), owner_element_->bindingObject(), value.ToNativeString(ctx()).release());
+  GetExecutingContext()->uiCommandBuffer()->AddCommandWithImmediate(UICommand::kSetStyle, typed_value,
+                                                                    std::move(args_01), owner_element_->bindingObject(),
+                                                                    value.ToNativeString(ctx()).release());
 
   return true;
 }
@@ -35,8 +35,6 @@ class InlineCssStyleDeclaration : public CSSStyleDeclaration {
   void setProperty(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state) override;
   AtomicString removeProperty(const AtomicString& key, ExceptionState& exception_state) override;
 
-  [[nodiscard]] std::string ToString() const;
-
   void InlineStyleChanged();
 
   bool NamedPropertyQuery(const AtomicString&, ExceptionState&) override;
@@ -51,6 +49,8 @@ class InlineCssStyleDeclaration : public CSSStyleDeclaration {
   void Trace(GCVisitor* visitor) const override;
 
  private:
+  friend class MarkupSerializer;
+
   AtomicString InternalGetPropertyValue(std::string& name);
   bool InternalSetProperty(std::string& name, const AtomicString& value);
   AtomicString InternalRemoveProperty(std::string& name);
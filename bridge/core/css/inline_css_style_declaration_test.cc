@@ -3,6 +3,9 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include "core/css/parser/css_value_parser.h"
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 
@@ -52,10 +55,11 @@ document.body.style.setProperty('--blue', 'lightblue'); console.assert(document.
 document.body.style.setProperty('--main-color', 'lightblue'); console.assert(document.body.style.getPropertyValue('--main-color') === 'lightblue');
 )";
   env->page()->evaluateScript(code, strlen(code), "vm://", 0);
-  UICommandItem* buffer = static_cast<UICommandItem*>(context->uiCommandBuffer()->data());
+  std::vector<UICommandItem*> buffer = TEST_getUICommandItems(context);
   size_t commandSize = context->uiCommandBuffer()->size();
+  EXPECT_EQ(buffer.size(), commandSize);
 
-  UICommandItem& last = buffer[commandSize - 2];
+  UICommandItem& last = *buffer[commandSize - 2];
 
   EXPECT_EQ(last.type, (int32_t)UICommand::kSetStyle);
   uint16_t* last_key = (uint16_t*)last.string_01;
@@ -102,4 +106,60 @@ TEST(InlineCSSStyleDeclaration, setNullValue) {
       "console.assert(document.body.style.height === '')";
   env->page()->evaluateScript(code, strlen(code), "vm://", 0);
   EXPECT_EQ(errorCalled, false);
-}
\ No newline at end of file
+}
+TEST(InlineCSSStyleDeclaration, sendTypedValues) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) { logCalled = true; };
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->executingContext();
+  const char* code = R"(
+document.body.style.left = '12.5px';
+document.body.style.transform = 'translate(10px)';
+document.body.style.cssText = 'color: #fff; background: url(data:image/png;base64,AA)';
+console.assert(document.body.style.background === 'url(data:image/png;base64,AA)');
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  std::vector<UICommandItem> styles;
+  for (UICommandItem* item : TEST_getUICommandItems(context)) {
+    if (item->type == (int32_t)UICommand::kSetStyle)
+      styles.emplace_back(*item);
+  }
+
+  ASSERT_EQ(styles.size(), 4);
+  // 125 / 10^1 px.
+  EXPECT_EQ(styles[0].immediate, int64_t{125} << 14 | 1 << 9 | (int64_t)CSSValueKind::kLength);
+  EXPECT_EQ(styles[1].immediate, 0);
+  EXPECT_EQ(styles[2].immediate, (int64_t)(uint64_t{0xffffffff} << 32) | (int64_t)CSSValueKind::kColor);
+  EXPECT_EQ(styles[3].immediate, 0);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(InlineCSSStyleDeclaration, inlineStyleIsNotAStyleDirtyRoot) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->executingContext();
+  TEST_takeStyleDirtyRoots(context);
+
+  // Dart side applies the inline styles as they arrive, the matched rules are unchanged.
+  const char* code = R"(
+document.body.style.color = 'red';
+document.body.style.removeProperty('color');
+document.body.style.cssText = 'width: 10px';
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_TRUE(TEST_takeStyleDirtyRoots(context).empty());
+
+  const char* attribute = "document.body.setAttribute('class', 'a');";
+  env->page()->evaluateScript(attribute, strlen(attribute), "vm://", 0);
+  std::vector<int64_t> roots = TEST_takeStyleDirtyRoots(context);
+  ASSERT_EQ(roots.size(), 1);
+  EXPECT_EQ(roots[0], reinterpret_cast<int64_t>(context->document()->body()->bindingObject()));
+  EXPECT_EQ(errorCalled, false);
+}
@@ -0,0 +1,635 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "css_parser.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace webf {
+
+namespace {
+
+constexpr size_t kHeaderSize = 3;
+
+bool IsBlockOpener(CSSTokenType type) {
+  return type == CSSTokenType::kLeftParen || type == CSSTokenType::kFunction || type == CSSTokenType::kLeftBracket ||
+         type == CSSTokenType::kLeftBrace;
+}
+
+CSSTokenType BlockCloser(CSSTokenType type) {
+  switch (type) {
+    case CSSTokenType::kLeftBracket:
+      return CSSTokenType::kRightBracket;
+    case CSSTokenType::kLeftBrace:
+      return CSSTokenType::kRightBrace;
+    default:
+      return CSSTokenType::kRightParen;
+  }
+}
+
+bool IsWordCharacter(char16_t c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+bool IsWhitespaceCharacter(char16_t c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+// The same as camelize() in style_property.dart, the style declarations are keyed by the camel cased names.
+std::u16string Camelize(const std::u16string& name) {
+  if (name.size() >= 2 && name[0] == '-' && name[1] == '-')
+    return name;
+  std::u16string result;
+  result.reserve(name.size());
+  for (size_t i = 0; i < name.size(); i++) {
+    if (name[i] == '-' && i + 1 < name.size() && IsWordCharacter(name[i + 1])) {
+      char16_t c = name[++i];
+      result += (c >= 'a' && c <= 'z') ? static_cast<char16_t>(c - 'a' + 'A') : c;
+    } else {
+      result += name[i];
+    }
+  }
+  return result;
+}
+
+bool IsLegacyPseudoElement(const std::u16string& name) {
+  return EqualIgnoringASCIICase(name, "after") || EqualIgnoringASCIICase(name, "before") ||
+         EqualIgnoringASCIICase(name, "first-letter") || EqualIgnoringASCIICase(name, "first-line");
+}
+
+// Splits the argument of a functional pseudo class into the terms processSelectorExpression() of the Dart parser
+// produces, '2n+1' is sent as ['2', 'n', '+', '1'] for the an+b parsing in query_selector.dart.
+std::vector<std::u16string> SplitSelectorExpression(const std::u16string& text) {
+  std::vector<std::u16string> terms;
+  size_t i = 0;
+  while (i < text.size()) {
+    char16_t c = text[i];
+    if (IsWhitespaceCharacter(c)) {
+      i++;
+    } else if (c == '"' || c == '\'') {
+      // A quoted string is the only term.
+      terms.clear();
+      size_t end = text.find(c, i + 1);
+      terms.push_back(text.substr(i, end == std::u16string::npos ? std::u16string::npos : end - i + 1));
+      break;
+    } else if ((c >= '0' && c <= '9') || c == '.') {
+      size_t start = i;
+      while (i < text.size() && ((text[i] >= '0' && text[i] <= '9') || text[i] == '.'))
+        i++;
+      terms.push_back(text.substr(start, i - start));
+    } else if (c == '+' || c == '-' || c == '%') {
+      terms.emplace_back(1, c);
+      i++;
+    } else if (IsWordCharacter(c) || c >= 0x80) {
+      size_t start = i;
+      while (i < text.size() && (IsWordCharacter(text[i]) || text[i] >= 0x80))
+        i++;
+      terms.push_back(text.substr(start, i - start));
+    } else {
+      break;
+    }
+  }
+  return terms;
+}
+
+}  // namespace
+
+uint32_t* CSSParser::ParseStyleSheet(const std::u16string& text) {
+  CSSParser parser(text);
+  if (!parser.Parse())
+    return nullptr;
+  return parser.TakeRuleSet();
+}
+
+CSSParser::CSSParser(const std::u16string& text) : text_(text) {
+  tokens_ = CSSTokenizer(text).TokenizeAll();
+  words_.reserve(kHeaderSize + tokens_.size());
+  words_.resize(kHeaderSize);
+}
+
+bool CSSParser::Parse() {
+  size_t index = 0;
+  while (tokens_[index].type != CSSTokenType::kEOF && !needs_dart_parser_) {
+    switch (tokens_[index].type) {
+      case CSSTokenType::kWhitespace:
+      case CSSTokenType::kCDO:
+      case CSSTokenType::kCDC:
+        index++;
+        break;
+      case CSSTokenType::kAtKeyword:
+        index = ConsumeAtRule(index);
+        break;
+      default:
+        index = ConsumeQualifiedRule(index);
+        break;
+    }
+  }
+  return !needs_dart_parser_;
+}
+
+uint32_t* CSSParser::TakeRuleSet() {
+  size_t string_table_offset = words_.size();
+  size_t characters = 0;
+  Write(strings_.size());
+  for (auto* string : strings_) {
+    Write(characters);
+    Write(string->size());
+    characters += string->size();
+  }
+  size_t characters_offset = words_.size();
+  words_.resize(characters_offset + (characters + 1) / 2);
+
+  words_[0] = static_cast<uint32_t>(words_.size());
+  words_[1] = static_cast<uint32_t>(string_table_offset);
+  words_[2] = rule_count_;
+
+  auto* rule_set = static_cast<uint32_t*>(malloc(words_.size() * sizeof(uint32_t)));
+  memcpy(rule_set, words_.data(), characters_offset * sizeof(uint32_t));
+  auto* dest = reinterpret_cast<char16_t*>(rule_set + characters_offset);
+  for (auto* string : strings_) {
+    memcpy(dest, string->data(), string->size() * sizeof(char16_t));
+    dest += string->size();
+  }
+  if (characters % 2 != 0)
+    *dest = 0;
+  return rule_set;
+}
+
+size_t CSSParser::ConsumeAtRule(size_t index) {
+  const std::u16string& name = tokens_[index].value;
+  size_t prelude_begin = index + 1;
+  size_t end = prelude_begin;
+  while (tokens_[end].type != CSSTokenType::kEOF && tokens_[end].type != CSSTokenType::kSemicolon &&
+         tokens_[end].type != CSSTokenType::kLeftBrace) {
+    if (IsBlockOpener(tokens_[end].type)) {
+      end = BlockEnd(end);
+      if (tokens_[end].type == CSSTokenType::kEOF)
+        return end;
+    }
+    end++;
+  }
+  if (tokens_[end].type != CSSTokenType::kLeftBrace)
+    return tokens_[end].type == CSSTokenType::kEOF ? end : end + 1;
+
+  size_t block_end = BlockEnd(end);
+  CSSKeyframesPrefix prefix = CSSKeyframesPrefix::kNone;
+  bool is_keyframes = true;
+  if (EqualIgnoringASCIICase(name, "keyframes")) {
+    prefix = CSSKeyframesPrefix::kNone;
+  } else if (EqualIgnoringASCIICase(name, "-webkit-keyframes")) {
+    prefix = CSSKeyframesPrefix::kWebkit;
+  } else if (EqualIgnoringASCIICase(name, "-moz-keyframes")) {
+    prefix = CSSKeyframesPrefix::kMoz;
+  } else if (EqualIgnoringASCIICase(name, "-o-keyframes")) {
+    prefix = CSSKeyframesPrefix::kO;
+  } else if (EqualIgnoringASCIICase(name, "-ms-keyframes")) {
+    prefix = CSSKeyframesPrefix::kMs;
+  } else {
+    is_keyframes = false;
+  }
+
+  if (is_keyframes) {
+    ConsumeKeyframes(prefix, prelude_begin, end, block_end);
+  } else if (EqualIgnoringASCIICase(name, "font-face")) {
+    Write(CSSRuleKind::kFontFace);
+    ConsumeDeclarations(end + 1, block_end);
+    rule_count_++;
+  }
+  return tokens_[block_end].type == CSSTokenType::kEOF ? block_end : block_end + 1;
+}
+
+void CSSParser::ConsumeKeyframes(CSSKeyframesPrefix prefix,
+                                 size_t prelude_begin,
+                                 size_t prelude_end,
+                                 size_t block_end) {
+  size_t name_index = SkipWhitespace(prelude_begin, prelude_end);
+  if (name_index == prelude_end ||
+      (tokens_[name_index].type != CSSTokenType::kIdent && tokens_[name_index].type != CSSTokenType::kString) ||
+      SkipWhitespace(name_index + 1, prelude_end) != prelude_end)
+    return;
+
+  size_t rule_start = words_.size();
+  Write(CSSRuleKind::kKeyframes);
+  Write(prefix);
+  Write(AddString(tokens_[name_index].value));
+  size_t block_count_index = words_.size();
+  Write(0);
+
+  // The block is a list of keyframe rules: '50%, to { declarations }'.
+  size_t index = prelude_end + 1;
+  while (index < block_end) {
+    index = SkipWhitespace(index, block_end);
+    if (index == block_end)
+      break;
+    size_t open = FindTopLevel(index, block_end, CSSTokenType::kLeftBrace);
+    if (open == block_end)
+      break;
+    size_t close = BlockEnd(open);
+
+    size_t selector_count_index = words_.size();
+    Write(0);
+    size_t selector_begin = index;
+    while (selector_begin < open) {
+      size_t selector_end = FindTopLevel(selector_begin, open, CSSTokenType::kComma);
+      std::u16string selector = SourceText(selector_begin, selector_end);
+      if (!selector.empty()) {
+        Write(AddString(selector));
+        words_[selector_count_index]++;
+      }
+      selector_begin = selector_end + 1;
+    }
+    ConsumeDeclarations(open + 1, close);
+    words_[block_count_index]++;
+    index = close + 1;
+  }
+
+  if (needs_dart_parser_) {
+    words_.resize(rule_start);
+    return;
+  }
+  rule_count_++;
+}
+
+size_t CSSParser::ConsumeQualifiedRule(size_t index) {
+  size_t open = FindTopLevel(index, tokens_.size() - 1, CSSTokenType::kLeftBrace);
+  // A rule without a block is dropped with the rest of the sheet.
+  if (open == tokens_.size() - 1)
+    return open;
+  size_t close = BlockEnd(open);
+
+  size_t rule_start = words_.size();
+  Write(CSSRuleKind::kStyle);
+  if (ConsumeSelectorList(index, open)) {
+    ConsumeDeclarations(open + 1, close);
+    rule_count_++;
+  } else {
+    // The rule with an invalid selector is dropped, see https://www.w3.org/TR/selectors-4/#invalid.
+    words_.resize(rule_start);
+  }
+  return tokens_[close].type == CSSTokenType::kEOF ? close : close + 1;
+}
+
+void CSSParser::ConsumeDeclarations(size_t begin, size_t end) {
+  size_t count_index = words_.size();
+  Write(0);
+  size_t index = begin;
+  while (index < end) {
+    CSSTokenType type = tokens_[index].type;
+    if (type == CSSTokenType::kWhitespace || type == CSSTokenType::kSemicolon) {
+      index++;
+      continue;
+    }
+
+    size_t item_end = index;
+    bool is_nested_rule = false;
+    while (item_end < end && tokens_[item_end].type != CSSTokenType::kSemicolon) {
+      if (tokens_[item_end].type == CSSTokenType::kLeftBrace) {
+        is_nested_rule = true;
+        item_end = BlockEnd(item_end) + 1;
+        break;
+      }
+      if (IsBlockOpener(tokens_[item_end].type))
+        item_end = BlockEnd(item_end);
+      item_end++;
+    }
+
+    if (is_nested_rule) {
+      // At-rules in a block are dropped, the nested style rules are left to the Dart parser.
+      if (type != CSSTokenType::kAtKeyword) {
+        needs_dart_parser_ = true;
+        return;
+      }
+    } else if (ConsumeDeclaration(index, item_end)) {
+      words_[count_index]++;
+    }
+    index = item_end;
+  }
+}
+
+bool CSSParser::ConsumeDeclaration(size_t begin, size_t end) {
+  if (tokens_[begin].type != CSSTokenType::kIdent)
+    return false;
+  size_t colon = SkipWhitespace(begin + 1, end);
+  if (colon == end || tokens_[colon].type != CSSTokenType::kColon)
+    return false;
+
+  size_t value_begin = SkipWhitespace(colon + 1, end);
+  size_t value_end = end;
+  bool important = false;
+  while (true) {
+    while (value_end > value_begin && tokens_[value_end - 1].type == CSSTokenType::kWhitespace)
+      value_end--;
+    if (value_end <= value_begin || tokens_[value_end - 1].type != CSSTokenType::kIdent ||
+        !EqualIgnoringASCIICase(tokens_[value_end - 1].value, "important"))
+      break;
+    size_t bang = value_end - 1;
+    while (bang > value_begin && tokens_[bang - 1].type == CSSTokenType::kWhitespace)
+      bang--;
+    if (bang == value_begin || !IsDelim(bang - 1, '!'))
+      break;
+    important = true;
+    value_end = bang - 1;
+  }
+  if (value_begin >= value_end)
+    return false;
+
+  Write(AddString(Camelize(tokens_[begin].value)));
+  Write(AddString(SourceText(value_begin, value_end)));
+  Write(important ? 1 : 0);
+  return true;
+}
+
+bool CSSParser::ConsumeSelectorList(size_t begin, size_t end) {
+  size_t count_index = words_.size();
+  Write(0);
+  size_t index = begin;
+  while (index <= end) {
+    size_t selector_end = FindTopLevel(index, end, CSSTokenType::kComma);
+    if (!ConsumeComplexSelector(index, selector_end))
+      return false;
+    words_[count_index]++;
+    index = selector_end + 1;
+  }
+  return true;
+}
+
+bool CSSParser::ConsumeComplexSelector(size_t begin, size_t end) {
+  size_t count_index = words_.size();
+  Write(0);
+  CSSCombinator combinator = CSSCombinator::kNone;
+  bool expects_compound = true;
+  size_t index = begin;
+  while (true) {
+    size_t next = SkipWhitespace(index, end);
+    if (next != index && words_[count_index] > 0 && combinator == CSSCombinator::kNone)
+      combinator = CSSCombinator::kDescendant;
+    index = next;
+    if (index == end)
+      break;
+
+    if (IsDelim(index, '>') || IsDelim(index, '+') || IsDelim(index, '~')) {
+      if (words_[count_index] == 0 || expects_compound)
+        return false;
+      char16_t delim = tokens_[index].delim;
+      combinator = delim == '>' ? CSSCombinator::kGreater : delim == '+' ? CSSCombinator::kPlus : CSSCombinator::kTilde;
+      expects_compound = true;
+      index++;
+      continue;
+    }
+    if (IsDelim(index, '&') || IsDelim(index, '|')) {
+      // Nesting and namespaces.
+      needs_dart_parser_ = true;
+      return false;
+    }
+
+    // A compound selector, the combinator is carried by its first simple selector.
+    bool first = true;
+    while (index < end && tokens_[index].type != CSSTokenType::kWhitespace && !IsDelim(index, '>') &&
+           !IsDelim(index, '+') && !IsDelim(index, '~')) {
+      Write(first ? combinator : CSSCombinator::kNone);
+      if (!ConsumeSimpleSelector(index, end, first))
+        return false;
+      words_[count_index]++;
+      first = false;
+    }
+    combinator = CSSCombinator::kNone;
+    expects_compound = false;
+  }
+  return words_[count_index] > 0 && !expects_compound;
+}
+
+bool CSSParser::ConsumeSimpleSelector(size_t& index, size_t end, bool allow_type) {
+  const CSSToken& token = tokens_[index];
+  switch (token.type) {
+    case CSSTokenType::kIdent:
+      if (!allow_type)
+        return false;
+      Write(CSSSimpleSelectorKind::kElement);
+      Write(AddString(token.value));
+      index++;
+      return true;
+    case CSSTokenType::kHash:
+      if (!token.hash_is_id)
+        return false;
+      Write(CSSSimpleSelectorKind::kId);
+      Write(AddString(token.value));
+      index++;
+      return true;
+    case CSSTokenType::kLeftBracket: {
+      size_t close = BlockEnd(index);
+      if (close >= end)
+        return false;
+      Write(CSSSimpleSelectorKind::kAttribute);
+      if (!ConsumeAttributeSelector(index + 1, close))
+        return false;
+      index = close + 1;
+      return true;
+    }
+    case CSSTokenType::kColon:
+      return ConsumePseudoSelector(index, end);
+    case CSSTokenType::kDelim:
+      if (token.delim == '*' && allow_type) {
+        Write(CSSSimpleSelectorKind::kUniversal);
+        index++;
+        return true;
+      }
+      if (token.delim == '.' && index + 1 < end && tokens_[index + 1].type == CSSTokenType::kIdent) {
+        Write(CSSSimpleSelectorKind::kClass);
+        Write(AddString(tokens_[index + 1].value));
+        index += 2;
+        return true;
+      }
+      if (token.delim == '&' || token.delim == '|')
+        needs_dart_parser_ = true;
+      return false;
+    default:
+      return false;
+  }
+}
+
+bool CSSParser::ConsumeAttributeSelector(size_t begin, size_t end) {
+  size_t index = SkipWhitespace(begin, end);
+  if (index == end || tokens_[index].type != CSSTokenType::kIdent)
+    return false;
+  uint32_t name = AddString(tokens_[index].value);
+  index = SkipWhitespace(index + 1, end);
+  if (index == end) {
+    Write(name);
+    Write(CSSAttributeMatch::kNone);
+    Write(CSSAttributeValueKind::kNone);
+    Write(0);
+    return true;
+  }
+
+  CSSAttributeMatch match;
+  if (IsDelim(index, '=')) {
+    match = CSSAttributeMatch::kEquals;
+    index++;
+  } else if (index + 1 < end && tokens_[index].type == CSSTokenType::kDelim && IsDelim(index + 1, '=')) {
+    switch (tokens_[index].delim) {
+      case '~':
+        match = CSSAttributeMatch::kIncludes;
+        break;
+      case '|':
+        match = CSSAttributeMatch::kDashMatch;
+        break;
+      case '^':
+        match = CSSAttributeMatch::kPrefixMatch;
+        break;
+      case '$':
+        match = CSSAttributeMatch::kSuffixMatch;
+        break;
+      case '*':
+        match = CSSAttributeMatch::kSubstring;
+        break;
+      default:
+        return false;
+    }
+    index += 2;
+  } else {
+    return false;
+  }
+
+  index = SkipWhitespace(index, end);
+  if (index == end)
+    return false;
+  CSSAttributeValueKind value_kind;
+  if (tokens_[index].type == CSSTokenType::kIdent) {
+    value_kind = CSSAttributeValueKind::kIdentifier;
+  } else if (tokens_[index].type == CSSTokenType::kString) {
+    value_kind = CSSAttributeValueKind::kString;
+  } else {
+    return false;
+  }
+  uint32_t value = AddString(tokens_[index].value);
+  // The case-sensitivity modifier is ignored, the Dart matcher always compares the case.
+  index = SkipWhitespace(index + 1, end);
+  if (index < end && tokens_[index].type == CSSTokenType::kIdent &&
+      (EqualIgnoringASCIICase(tokens_[index].value, "i") || EqualIgnoringASCIICase(tokens_[index].value, "s")))
+    index = SkipWhitespace(index + 1, end);
+  if (index != end)
+    return false;
+
+  Write(name);
+  Write(match);
+  Write(value_kind);
+  Write(value);
+  return true;
+}
+
+bool CSSParser::ConsumePseudoSelector(size_t& index, size_t end) {
+  index++;
+  bool is_element = index < end && tokens_[index].type == CSSTokenType::kColon;
+  if (is_element)
+    index++;
+  if (index == end)
+    return false;
+
+  const CSSToken& token = tokens_[index];
+  if (token.type == CSSTokenType::kIdent) {
+    if (is_element || IsLegacyPseudoElement(token.value)) {
+      Write(CSSSimpleSelectorKind::kPseudoElement);
+      Write(AddString(token.value));
+      Write(is_element ? 0 : 1);
+    } else {
+      Write(CSSSimpleSelectorKind::kPseudoClass);
+      Write(AddString(token.value));
+    }
+    index++;
+    return true;
+  }
+  if (token.type != CSSTokenType::kFunction)
+    return false;
+
+  size_t close = BlockEnd(index);
+  if (close >= end)
+    return false;
+  if (!is_element) {
+    if (EqualIgnoringASCIICase(token.value, "not")) {
+      size_t argument = SkipWhitespace(index + 1, close);
+      Write(CSSSimpleSelectorKind::kNegation);
+      if (argument == close || !ConsumeSimpleSelector(argument, close, true) ||
+          SkipWhitespace(argument, close) != close)
+        return false;
+      index = close + 1;
+      return true;
+    }
+    if (EqualIgnoringASCIICase(token.value, "host") || EqualIgnoringASCIICase(token.value, "host-context") ||
+        EqualIgnoringASCIICase(token.value, "global-context") ||
+        EqualIgnoringASCIICase(token.value, "-acx-global-context")) {
+      needs_dart_parser_ = true;
+      return false;
+    }
+  }
+
+  Write(is_element ? CSSSimpleSelectorKind::kPseudoElementFunction : CSSSimpleSelectorKind::kPseudoClassFunction);
+  Write(AddString(token.value));
+  std::vector<std::u16string> terms =
+      SplitSelectorExpression(text_.substr(token.end, tokens_[close].start - token.end));
+  Write(terms.size());
+  for (auto& term : terms) {
+    Write(AddString(term));
+  }
+  index = close + 1;
+  return true;
+}
+
+size_t CSSParser::BlockEnd(size_t open) const {
+  std::vector<CSSTokenType> closers;
+  for (size_t index = open;; index++) {
+    CSSTokenType type = tokens_[index].type;
+    if (type == CSSTokenType::kEOF)
+      return index;
+    if (IsBlockOpener(type)) {
+      closers.push_back(BlockCloser(type));
+    } else if (!closers.empty() && type == closers.back()) {
+      closers.pop_back();
+      if (closers.empty())
+        return index;
+    }
+  }
+}
+
+size_t CSSParser::FindTopLevel(size_t begin, size_t end, CSSTokenType type) const {
+  size_t index = begin;
+  while (index < end && tokens_[index].type != type) {
+    if (IsBlockOpener(tokens_[index].type)) {
+      index = BlockEnd(index);
+      if (index >= end)
+        return end;
+    }
+    index++;
+  }
+  return index;
+}
+
+size_t CSSParser::SkipWhitespace(size_t index, size_t end) const {
+  while (index < end && tokens_[index].type == CSSTokenType::kWhitespace)
+    index++;
+  return index;
+}
+
+bool CSSParser::IsDelim(size_t index, char16_t delim) const {
+  return tokens_[index].type == CSSTokenType::kDelim && tokens_[index].delim == delim;
+}
+
+std::u16string CSSParser::SourceText(size_t begin, size_t end) const {
+  begin = SkipWhitespace(begin, end);
+  while (end > begin && tokens_[end - 1].type == CSSTokenType::kWhitespace)
+    end--;
+  if (begin >= end)
+    return std::u16string();
+  return text_.substr(tokens_[begin].start, tokens_[end - 1].end - tokens_[begin].start);
+}
+
+uint32_t CSSParser::AddString(const std::u16string& string) {
+  auto it = string_ids_.find(string);
+  if (it != string_ids_.end())
+    return it->second;
+  uint32_t id = static_cast<uint32_t>(strings_.size());
+  auto result = string_ids_.emplace(string, id);
+  strings_.push_back(&result.first->first);
+  return id;
+}
+
+}  // namespace webf
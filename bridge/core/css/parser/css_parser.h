@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_CORE_CSS_PARSER_CSS_PARSER_H_
+#define BRIDGE_CORE_CSS_PARSER_CSS_PARSER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "css_tokenizer.h"
+
+namespace webf {
+
+// The rule set sent with UICommand::kSetStyleSheet is a malloc'd array of uint32 words, keep the layout in sync with
+// webf/lib/src/css/native_style_sheet.dart.
+//
+//   header:       [word count] [string table offset] [rule count]
+//   style rule:   [kStyle] [selector count] {[sequence count] {sequence}} declarations
+//   sequence:     [CSSCombinator] simple selector
+//   simple:       [CSSSimpleSelectorKind] and the payload of the kind, see CSSParser::ConsumeSimpleSelector
+//   keyframes:    [kKeyframes] [CSSKeyframesPrefix] [name] [block count] {[selector count] {selector} declarations}
+//   font face:    [kFontFace] declarations
+//   declarations: [count] {[property] [value] [important]}
+//   string table: [string count] {[start] [length]} and the UTF-16 characters, padded to a word
+//
+// Strings are referred by their index in the string table, a property name used by many rules is sent once.
+enum class CSSRuleKind : uint32_t { kStyle = 1, kKeyframes, kFontFace };
+enum class CSSCombinator : uint32_t { kNone, kDescendant, kPlus, kGreater, kTilde };
+enum class CSSSimpleSelectorKind : uint32_t {
+  // [name]
+  kElement,
+  kUniversal,
+  // [name]
+  kId,
+  kClass,
+  // [name] [CSSAttributeMatch] [CSSAttributeValueKind] [value]
+  kAttribute,
+  // [name]
+  kPseudoClass,
+  // [name] [is legacy]
+  kPseudoElement,
+  // [name] [term count] {[term]}
+  kPseudoClassFunction,
+  kPseudoElementFunction,
+  // The kind and the payload of the argument.
+  kNegation,
+};
+enum class CSSAttributeMatch : uint32_t { kNone, kEquals, kIncludes, kDashMatch, kPrefixMatch, kSuffixMatch, kSubstring };
+enum class CSSAttributeValueKind : uint32_t { kNone, kIdentifier, kString };
+enum class CSSKeyframesPrefix : uint32_t { kNone, kWebkit, kMoz, kO, kMs };
+
+// Parses a style sheet into the binary rule set on the JS thread, so the UI thread only builds the rule objects.
+//
+// The style rules, @keyframes and @font-face are kept and the other at-rules are dropped like the Dart parser does.
+// Nested rules and selectors taking selector arguments, which the Dart parser supports in its own way, make the whole
+// sheet fall back to the Dart parser.
+class CSSParser {
+ public:
+  // Returns the rule set, which is freed by the receiver, or nullptr when the sheet should be parsed by Dart.
+  static uint32_t* ParseStyleSheet(const std::u16string& text);
+
+ private:
+  explicit CSSParser(const std::u16string& text);
+
+  bool Parse();
+  uint32_t* TakeRuleSet();
+
+  size_t ConsumeAtRule(size_t index);
+  size_t ConsumeQualifiedRule(size_t index);
+  void ConsumeKeyframes(CSSKeyframesPrefix prefix, size_t prelude_begin, size_t prelude_end, size_t block_end);
+  void ConsumeDeclarations(size_t begin, size_t end);
+  bool ConsumeDeclaration(size_t begin, size_t end);
+
+  bool ConsumeSelectorList(size_t begin, size_t end);
+  bool ConsumeComplexSelector(size_t begin, size_t end);
+  bool ConsumeSimpleSelector(size_t& index, size_t end, bool allow_type);
+  bool ConsumeAttributeSelector(size_t begin, size_t end);
+  bool ConsumePseudoSelector(size_t& index, size_t end);
+
+  // Returns the index of the token closing the block opened at the index, or the index of kEOF.
+  size_t BlockEnd(size_t open) const;
+  // Returns the index of the first token of the type at the top level of [begin, end), or end.
+  size_t FindTopLevel(size_t begin, size_t end, CSSTokenType type) const;
+  size_t SkipWhitespace(size_t index, size_t end) const;
+  bool IsDelim(size_t index, char16_t delim) const;
+  std::u16string SourceText(size_t begin, size_t end) const;
+
+  uint32_t AddString(const std::u16string& string);
+  void Write(uint32_t word) { words_.push_back(word); }
+  template <typename T>
+  void Write(T value) {
+    words_.push_back(static_cast<uint32_t>(value));
+  }
+
+  const std::u16string& text_;
+  std::vector<CSSToken> tokens_;
+  std::vector<uint32_t> words_;
+  std::vector<const std::u16string*> strings_;
+  std::unordered_map<std::u16string, uint32_t> string_ids_;
+  uint32_t rule_count_{0};
+  bool needs_dart_parser_{false};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_PARSER_CSS_PARSER_H_
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "css_parser.h"
+#include <codecvt>
+#include <cstdlib>
+#include <locale>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+// Prints the rule set back as CSS, with the combinators and the simple selectors in brackets.
+class RuleSetPrinter {
+ public:
+  explicit RuleSetPrinter(const uint32_t* words) : words_(words) {}
+
+  std::string Print() {
+    size_t string_table = words_[1];
+    uint32_t string_count = words_[string_table];
+    auto* characters = reinterpret_cast<const char16_t*>(words_ + string_table + 1 + string_count * 2);
+    for (uint32_t i = 0; i < string_count; i++) {
+      const uint32_t* entry = words_ + string_table + 1 + i * 2;
+      strings_.push_back(std::u16string(characters + entry[0], entry[1]));
+    }
+
+    index_ = 3;
+    std::string result;
+    for (uint32_t rule = 0; rule < words_[2]; rule++) {
+      switch (static_cast<CSSRuleKind>(Read())) {
+        case CSSRuleKind::kStyle: {
+          uint32_t selectors = Read();
+          for (uint32_t i = 0; i < selectors; i++) {
+            if (i > 0)
+              result += ",";
+            uint32_t sequences = Read();
+            for (uint32_t j = 0; j < sequences; j++) {
+              result += "[" + std::to_string(Read()) + " ";
+              result += SimpleSelector() + "]";
+            }
+          }
+          result += Declarations();
+          break;
+        }
+        case CSSRuleKind::kKeyframes: {
+          result += "@" + std::to_string(Read()) + "keyframes ";
+          result += String(Read());
+          uint32_t blocks = Read();
+          for (uint32_t i = 0; i < blocks; i++) {
+            uint32_t selectors = Read();
+            result += " ";
+            for (uint32_t j = 0; j < selectors; j++) {
+              result += (j > 0 ? "," : "") + String(Read());
+            }
+            result += Declarations();
+          }
+          break;
+        }
+        case CSSRuleKind::kFontFace:
+          result += "@font-face" + Declarations();
+          break;
+      }
+      result += "\n";
+    }
+    return result;
+  }
+
+ private:
+  uint32_t Read() { return words_[index_++]; }
+
+  std::string String(uint32_t id) {
+    return std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>().to_bytes(strings_[id]);
+  }
+
+  std::string SimpleSelector() {
+    auto kind = static_cast<CSSSimpleSelectorKind>(Read());
+    switch (kind) {
+      case CSSSimpleSelectorKind::kElement:
+        return String(Read());
+      case CSSSimpleSelectorKind::kUniversal:
+        return "*";
+      case CSSSimpleSelectorKind::kId:
+        return "#" + String(Read());
+      case CSSSimpleSelectorKind::kClass:
+        return "." + String(Read());
+      case CSSSimpleSelectorKind::kAttribute: {
+        std::string name = String(Read());
+        uint32_t match = Read();
+        uint32_t value_kind = Read();
+        uint32_t value = Read();
+        if (value_kind == 0)
+          return "attr(" + name + ")";
+        return "attr(" + name + " " + std::to_string(match) + " " + std::to_string(value_kind) + " " + String(value) +
+               ")";
+      }
+      case CSSSimpleSelectorKind::kPseudoClass:
+        return ":" + String(Read());
+      case CSSSimpleSelectorKind::kPseudoElement: {
+        std::string name = String(Read());
+        return (Read() ? ":" : "::") + name;
+      }
+      case CSSSimpleSelectorKind::kPseudoClassFunction:
+      case CSSSimpleSelectorKind::kPseudoElementFunction: {
+        std::string result = (kind == CSSSimpleSelectorKind::kPseudoClassFunction ? ":" : "::") + String(Read()) + "(";
+        uint32_t terms = Read();
+        for (uint32_t i = 0; i < terms; i++) {
+          result += (i > 0 ? "|" : "") + String(Read());
+        }
+        return result + ")";
+      }
+      case CSSSimpleSelectorKind::kNegation:
+        return ":not(" + SimpleSelector() + ")";
+    }
+    return "?";
+  }
+
+  std::string Declarations() {
+    std::string result = "{";
+    uint32_t count = Read();
+    for (uint32_t i = 0; i < count; i++) {
+      result += String(Read()) + ":";
+      result += String(Read());
+      result += Read() ? "!;" : ";";
+    }
+    return result + "}";
+  }
+
+  const uint32_t* words_;
+  size_t index_{0};
+  std::vector<std::u16string> strings_;
+};
+
+std::string Parse(const std::u16string& text) {
+  uint32_t* rule_set = CSSParser::ParseStyleSheet(text);
+  if (rule_set == nullptr)
+    return "<dart>";
+  std::string result = RuleSetPrinter(rule_set).Print();
+  free(rule_set);
+  return result;
+}
+
+}  // namespace
+
+TEST(CSSParser, styleRules) {
+  EXPECT_EQ(Parse(u"div.a > #b, .c:hover span { color: red; background-color : rgba(0, 0, 0, .5) !important }"),
+            "[0 div][0 .a][3 #b],[0 .c][0 :hover][1 span]{color:red;backgroundColor:rgba(0, 0, 0, .5)!;}\n");
+  EXPECT_EQ(Parse(u"/* c */ <!-- a+b~c{--main-color: #fff; -webkit-box-flex: 1 /* x */;} -->"),
+            "[0 a][2 b][4 c]{--main-color:#fff;WebkitBoxFlex:1;}\n");
+  EXPECT_EQ(Parse(u"p{}"), "[0 p]{}\n");
+}
+
+TEST(CSSParser, selectors) {
+  EXPECT_EQ(Parse(u"*[title], a[href^='http' i], input[type=text] {a:b}"),
+            "[0 *][0 attr(title)],[0 a][0 attr(href 4 2 http)],[0 input][0 attr(type 1 1 text)]{a:b;}\n");
+  EXPECT_EQ(Parse(u"li:nth-child(2n + 1)::before, p:before, :not(.a) {a:b}"),
+            "[0 li][0 :nth-child(2|n|+|1)][0 ::before],[0 p][0 :before],[0 :not(.a)]{a:b;}\n");
+  EXPECT_EQ(Parse(u".a\\:b, #\\31 x {a:b}"), "[0 .a:b],[0 #1x]{a:b;}\n");
+}
+
+TEST(CSSParser, invalidRulesAreDropped) {
+  EXPECT_EQ(Parse(u"> a {a:b} a, {a:b} #1 {a:b} .a..b {a:b} b {c:d}"), "[0 b]{c:d;}\n");
+  // Declarations without a colon or a value are dropped, a broken one does not break the next one.
+  EXPECT_EQ(Parse(u"a { color; width: ; height: 1px; (x: y); top: 0 }"), "[0 a]{height:1px;top:0;}\n");
+  // The block is closed by the end of the sheet.
+  EXPECT_EQ(Parse(u"a { color: red"), "[0 a]{color:red;}\n");
+}
+
+TEST(CSSParser, atRules) {
+  EXPECT_EQ(Parse(u"@charset 'utf-8'; @import url(a.css); @media (max-width: 100px) { a { color: red } } b {c:d}"),
+            "[0 b]{c:d;}\n");
+  EXPECT_EQ(Parse(u"@-webkit-keyframes spin { from { opacity: 0 } 50%, 75% { opacity: .5 } to { opacity: 1 } }"),
+            "@1keyframes spin from{opacity:0;} 50%,75%{opacity:.5;} to{opacity:1;}\n");
+  EXPECT_EQ(Parse(u"@font-face { font-family: 'A'; src: url(a.ttf) }"), "@font-face{fontFamily:'A';src:url(a.ttf);}\n");
+}
+
+TEST(CSSParser, nestedRulesAreLeftToDart) {
+  EXPECT_EQ(Parse(u"div { color: red; span { color: blue } }"), "<dart>");
+  EXPECT_EQ(Parse(u"&.a {a:b}"), "<dart>");
+  EXPECT_EQ(Parse(u":host(.a) {a:b}"), "<dart>");
+  // At-rules in a block are dropped.
+  EXPECT_EQ(Parse(u"div { @media print { color: red } color: blue }"), "[0 div]{color:blue;}\n");
+}
+
+TEST(CSSParser, stringsAreShared) {
+  uint32_t* rule_set = CSSParser::ParseStyleSheet(u"a{color:red}b{color:red}");
+  ASSERT_NE(rule_set, nullptr);
+  // color, red, a and b.
+  EXPECT_EQ(rule_set[rule_set[1]], 4);
+  free(rule_set);
+}
@@ -0,0 +1,411 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "css_tokenizer.h"
+
+namespace webf {
+
+namespace {
+
+constexpr char16_t kReplacementCharacter = 0xFFFD;
+
+bool IsNewline(char16_t c) {
+  return c == '\n' || c == '\r' || c == '\f';
+}
+
+bool IsWhitespace(char16_t c) {
+  return c == ' ' || c == '\t' || IsNewline(c);
+}
+
+bool IsDigit(char16_t c) {
+  return c >= '0' && c <= '9';
+}
+
+bool IsHexDigit(char16_t c) {
+  return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+int HexValue(char16_t c) {
+  if (IsDigit(c))
+    return c - '0';
+  return (c | 0x20) - 'a' + 10;
+}
+
+bool IsNameStart(char16_t c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c >= 0x80;
+}
+
+bool IsNameCharacter(char16_t c) {
+  return IsNameStart(c) || IsDigit(c) || c == '-';
+}
+
+void AppendCodePoint(uint32_t code_point, std::u16string& out) {
+  if (code_point == 0 || (code_point >= 0xD800 && code_point <= 0xDFFF) || code_point > 0x10FFFF) {
+    out += kReplacementCharacter;
+  } else if (code_point >= 0x10000) {
+    code_point -= 0x10000;
+    out += static_cast<char16_t>(0xD800 + (code_point >> 10));
+    out += static_cast<char16_t>(0xDC00 + (code_point & 0x3FF));
+  } else {
+    out += static_cast<char16_t>(code_point);
+  }
+}
+
+}  // namespace
+
+bool EqualIgnoringASCIICase(const std::u16string& value, const char* ascii) {
+  size_t i = 0;
+  for (; ascii[i] != 0; i++) {
+    if (i >= value.size())
+      return false;
+    char16_t c = value[i];
+    if (c >= 'A' && c <= 'Z')
+      c |= 0x20;
+    if (c != ascii[i])
+      return false;
+  }
+  return i == value.size();
+}
+
+std::vector<CSSToken> CSSTokenizer::TokenizeAll() {
+  std::vector<CSSToken> tokens;
+  // Most tokens are longer than 4 characters once the whitespaces are counted.
+  tokens.reserve(text_.size() / 4 + 1);
+  while (true) {
+    tokens.push_back(NextToken());
+    if (tokens.back().type == CSSTokenType::kEOF)
+      break;
+  }
+  return tokens;
+}
+
+CSSToken CSSTokenizer::NextToken() {
+  ConsumeComments();
+
+  CSSToken token;
+  token.start = static_cast<uint32_t>(pos_);
+  if (AtEnd()) {
+    token.type = CSSTokenType::kEOF;
+    token.end = token.start;
+    return token;
+  }
+
+  char16_t c = text_[pos_];
+  if (IsWhitespace(c)) {
+    while (IsWhitespace(Peek()))
+      pos_++;
+    token.type = CSSTokenType::kWhitespace;
+  } else if (c == '"' || c == '\'') {
+    pos_++;
+    ConsumeStringToken(c, token);
+  } else if (c == '#') {
+    if (IsNameCharacter(Peek(1)) || IsValidEscape(1)) {
+      pos_++;
+      token.hash_is_id = StartsIdentifier();
+      token.type = CSSTokenType::kHash;
+      token.value = ConsumeName();
+    } else {
+      pos_++;
+      token.type = CSSTokenType::kDelim;
+      token.delim = c;
+    }
+  } else if (c == '(') {
+    pos_++;
+    token.type = CSSTokenType::kLeftParen;
+  } else if (c == ')') {
+    pos_++;
+    token.type = CSSTokenType::kRightParen;
+  } else if (c == '+' || c == '.') {
+    if (StartsNumber()) {
+      ConsumeNumericToken(token);
+    } else {
+      pos_++;
+      token.type = CSSTokenType::kDelim;
+      token.delim = c;
+    }
+  } else if (c == ',') {
+    pos_++;
+    token.type = CSSTokenType::kComma;
+  } else if (c == '-') {
+    if (StartsNumber()) {
+      ConsumeNumericToken(token);
+    } else if (Peek(1) == '-' && Peek(2) == '>') {
+      pos_ += 3;
+      token.type = CSSTokenType::kCDC;
+    } else if (StartsIdentifier()) {
+      ConsumeIdentLikeToken(token);
+    } else {
+      pos_++;
+      token.type = CSSTokenType::kDelim;
+      token.delim = c;
+    }
+  } else if (c == ':') {
+    pos_++;
+    token.type = CSSTokenType::kColon;
+  } else if (c == ';') {
+    pos_++;
+    token.type = CSSTokenType::kSemicolon;
+  } else if (c == '<') {
+    if (Peek(1) == '!' && Peek(2) == '-' && Peek(3) == '-') {
+      pos_ += 4;
+      token.type = CSSTokenType::kCDO;
+    } else {
+      pos_++;
+      token.type = CSSTokenType::kDelim;
+      token.delim = c;
+    }
+  } else if (c == '@') {
+    pos_++;
+    if (StartsIdentifier()) {
+      token.type = CSSTokenType::kAtKeyword;
+      token.value = ConsumeName();
+    } else {
+      token.type = CSSTokenType::kDelim;
+      token.delim = c;
+    }
+  } else if (c == '[') {
+    pos_++;
+    token.type = CSSTokenType::kLeftBracket;
+  } else if (c == '\\') {
+    if (IsValidEscape()) {
+      ConsumeIdentLikeToken(token);
+    } else {
+      pos_++;
+      token.type = CSSTokenType::kDelim;
+      token.delim = c;
+    }
+  } else if (c == ']') {
+    pos_++;
+    token.type = CSSTokenType::kRightBracket;
+  } else if (c == '{') {
+    pos_++;
+    token.type = CSSTokenType::kLeftBrace;
+  } else if (c == '}') {
+    pos_++;
+    token.type = CSSTokenType::kRightBrace;
+  } else if (IsDigit(c)) {
+    ConsumeNumericToken(token);
+  } else if (IsNameStart(c)) {
+    ConsumeIdentLikeToken(token);
+  } else {
+    pos_++;
+    token.type = CSSTokenType::kDelim;
+    token.delim = c;
+  }
+
+  token.end = static_cast<uint32_t>(pos_);
+  return token;
+}
+
+bool CSSTokenizer::IsValidEscape(size_t offset) const {
+  return Peek(offset) == '\\' && pos_ + offset + 1 < text_.size() && !IsNewline(Peek(offset + 1));
+}
+
+bool CSSTokenizer::StartsIdentifier(size_t offset) const {
+  char16_t c = Peek(offset);
+  if (c == '-') {
+    char16_t next = Peek(offset + 1);
+    return IsNameStart(next) || next == '-' || IsValidEscape(offset + 1);
+  }
+  if (IsNameStart(c))
+    return true;
+  return IsValidEscape(offset);
+}
+
+bool CSSTokenizer::StartsNumber() const {
+  char16_t c = Peek();
+  if (c == '+' || c == '-') {
+    return IsDigit(Peek(1)) || (Peek(1) == '.' && IsDigit(Peek(2)));
+  }
+  if (c == '.')
+    return IsDigit(Peek(1));
+  return IsDigit(c);
+}
+
+void CSSTokenizer::ConsumeComments() {
+  while (Peek() == '/' && Peek(1) == '*') {
+    size_t end = text_.find(u"*/", pos_ + 2);
+    pos_ = end == std::u16string::npos ? text_.size() : end + 2;
+  }
+}
+
+void CSSTokenizer::ConsumeEscape(std::u16string& out) {
+  // The backslash.
+  pos_++;
+  if (AtEnd()) {
+    out += kReplacementCharacter;
+    return;
+  }
+  if (IsHexDigit(Peek())) {
+    uint32_t code_point = 0;
+    for (int i = 0; i < 6 && IsHexDigit(Peek()); i++) {
+      code_point = code_point * 16 + HexValue(text_[pos_++]);
+    }
+    if (Peek() == '\r' && Peek(1) == '\n') {
+      pos_ += 2;
+    } else if (IsWhitespace(Peek())) {
+      pos_++;
+    }
+    AppendCodePoint(code_point, out);
+    return;
+  }
+  out += text_[pos_++];
+}
+
+std::u16string CSSTokenizer::ConsumeName() {
+  std::u16string name;
+  while (!AtEnd()) {
+    char16_t c = text_[pos_];
+    if (IsNameCharacter(c)) {
+      size_t start = pos_;
+      while (IsNameCharacter(Peek()))
+        pos_++;
+      name.append(text_, start, pos_ - start);
+    } else if (IsValidEscape()) {
+      ConsumeEscape(name);
+    } else {
+      break;
+    }
+  }
+  return name;
+}
+
+void CSSTokenizer::ConsumeNumericToken(CSSToken& token) {
+  if (Peek() == '+' || Peek() == '-')
+    pos_++;
+  while (IsDigit(Peek()))
+    pos_++;
+  if (Peek() == '.' && IsDigit(Peek(1))) {
+    pos_ += 2;
+    while (IsDigit(Peek()))
+      pos_++;
+  }
+  char16_t e = Peek();
+  if (e == 'e' || e == 'E') {
+    if (IsDigit(Peek(1))) {
+      pos_ += 2;
+      while (IsDigit(Peek()))
+        pos_++;
+    } else if ((Peek(1) == '+' || Peek(1) == '-') && IsDigit(Peek(2))) {
+      pos_ += 3;
+      while (IsDigit(Peek()))
+        pos_++;
+    }
+  }
+
+  if (StartsIdentifier()) {
+    token.type = CSSTokenType::kDimension;
+    token.value = ConsumeName();
+  } else if (Peek() == '%') {
+    pos_++;
+    token.type = CSSTokenType::kPercentage;
+  } else {
+    token.type = CSSTokenType::kNumber;
+  }
+}
+
+void CSSTokenizer::ConsumeIdentLikeToken(CSSToken& token) {
+  token.value = ConsumeName();
+  if (Peek() != '(') {
+    token.type = CSSTokenType::kIdent;
+    return;
+  }
+
+  pos_++;
+  if (EqualIgnoringASCIICase(token.value, "url")) {
+    size_t offset = 0;
+    while (IsWhitespace(Peek(offset)))
+      offset++;
+    // url("...") is a function with a string argument, unquoted urls are a single token.
+    if (Peek(offset) != '"' && Peek(offset) != '\'') {
+      pos_ += offset;
+      ConsumeUrlToken(token);
+      return;
+    }
+  }
+  token.type = CSSTokenType::kFunction;
+}
+
+void CSSTokenizer::ConsumeStringToken(char16_t ending, CSSToken& token) {
+  token.type = CSSTokenType::kString;
+  while (!AtEnd()) {
+    char16_t c = text_[pos_];
+    if (c == ending) {
+      pos_++;
+      return;
+    }
+    if (IsNewline(c)) {
+      // The newline is not consumed, it starts the next token.
+      token.type = CSSTokenType::kBadString;
+      return;
+    }
+    if (c == '\\') {
+      if (pos_ + 1 >= text_.size()) {
+        pos_++;
+      } else if (IsNewline(Peek(1))) {
+        pos_ += (Peek(1) == '\r' && Peek(2) == '\n') ? 3 : 2;
+      } else {
+        ConsumeEscape(token.value);
+      }
+      continue;
+    }
+    token.value += c;
+    pos_++;
+  }
+}
+
+void CSSTokenizer::ConsumeUrlToken(CSSToken& token) {
+  token.type = CSSTokenType::kUrl;
+  while (!AtEnd()) {
+    char16_t c = text_[pos_];
+    if (c == ')') {
+      pos_++;
+      return;
+    }
+    if (IsWhitespace(c)) {
+      while (IsWhitespace(Peek()))
+        pos_++;
+      if (AtEnd() || Peek() == ')') {
+        if (!AtEnd())
+          pos_++;
+        return;
+      }
+      token.type = CSSTokenType::kBadUrl;
+      ConsumeBadUrlRemnants();
+      return;
+    }
+    if (c == '"' || c == '\'' || c == '(' || c < 0x20 || c == 0x7F) {
+      token.type = CSSTokenType::kBadUrl;
+      ConsumeBadUrlRemnants();
+      return;
+    }
+    if (c == '\\') {
+      if (IsValidEscape()) {
+        ConsumeEscape(token.value);
+        continue;
+      }
+      token.type = CSSTokenType::kBadUrl;
+      ConsumeBadUrlRemnants();
+      return;
+    }
+    token.value += c;
+    pos_++;
+  }
+}
+
+void CSSTokenizer::ConsumeBadUrlRemnants() {
+  while (!AtEnd()) {
+    if (Peek() == ')') {
+      pos_++;
+      return;
+    }
+    if (IsValidEscape()) {
+      std::u16string ignored;
+      ConsumeEscape(ignored);
+      continue;
+    }
+    pos_++;
+  }
+}
+
+}  // namespace webf
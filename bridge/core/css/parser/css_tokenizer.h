@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_CORE_CSS_PARSER_CSS_TOKENIZER_H_
+#define BRIDGE_CORE_CSS_PARSER_CSS_TOKENIZER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace webf {
+
+enum class CSSTokenType : uint8_t {
+  kIdent,
+  kFunction,
+  kAtKeyword,
+  kHash,
+  kString,
+  kBadString,
+  kUrl,
+  kBadUrl,
+  kDelim,
+  kNumber,
+  kPercentage,
+  kDimension,
+  kWhitespace,
+  kCDO,
+  kCDC,
+  kColon,
+  kSemicolon,
+  kComma,
+  kLeftBracket,
+  kRightBracket,
+  kLeftParen,
+  kRightParen,
+  kLeftBrace,
+  kRightBrace,
+  kEOF,
+};
+
+struct CSSToken {
+  CSSTokenType type;
+  // The range of the token in the source text.
+  uint32_t start;
+  uint32_t end;
+  // The name of idents, functions, at-keywords and hashes, the unit of dimensions and the content of strings and urls,
+  // with the escapes resolved.
+  std::u16string value;
+  // The code point of delims.
+  char16_t delim{0};
+  // Whether a hash token would be a valid identifier, only such hashes are id selectors.
+  bool hash_is_id{false};
+};
+
+// Compares the value with a lower case ASCII string, CSS keywords are ASCII case-insensitive.
+bool EqualIgnoringASCIICase(const std::u16string& value, const char* ascii);
+
+// Splits the text into tokens, see https://www.w3.org/TR/css-syntax-3/#tokenization. Comments are dropped and the
+// last token is always kEOF.
+class CSSTokenizer {
+ public:
+  explicit CSSTokenizer(const std::u16string& text) : text_(text) {}
+
+  std::vector<CSSToken> TokenizeAll();
+
+ private:
+  CSSToken NextToken();
+  char16_t Peek(size_t offset = 0) const { return pos_ + offset < text_.size() ? text_[pos_ + offset] : 0; }
+  bool AtEnd() const { return pos_ >= text_.size(); }
+
+  bool StartsIdentifier(size_t offset = 0) const;
+  bool StartsNumber() const;
+  bool IsValidEscape(size_t offset = 0) const;
+
+  void ConsumeComments();
+  void ConsumeEscape(std::u16string& out);
+  std::u16string ConsumeName();
+  void ConsumeNumericToken(CSSToken& token);
+  void ConsumeIdentLikeToken(CSSToken& token);
+  void ConsumeStringToken(char16_t ending, CSSToken& token);
+  void ConsumeUrlToken(CSSToken& token);
+  void ConsumeBadUrlRemnants();
+
+  const std::u16string& text_;
+  size_t pos_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_PARSER_CSS_TOKENIZER_H_
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "css_value_parser.h"
+#include <cmath>
+#include <cstring>
+#include "foundation/ascii_types.h"
+
+namespace webf {
+
+namespace {
+
+constexpr int kUnitShift = 4;
+constexpr int kExponentShift = 9;
+constexpr int kMantissaShift = 14;
+constexpr int kColorShift = 32;
+constexpr int64_t kMaxMantissa = (int64_t{1} << 49) - 1;
+constexpr int kMaxExponent = 22;
+
+constexpr double kPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+struct Decimal {
+  int64_t mantissa{0};
+  int exponent{0};
+
+  double ToDouble() const { return static_cast<double>(mantissa) / kPowersOfTen[exponent]; }
+};
+
+struct LengthUnit {
+  const char* name;
+  CSSLengthUnit unit;
+};
+
+constexpr LengthUnit kLengthUnits[] = {
+    {"px", CSSLengthUnit::kPx},     {"em", CSSLengthUnit::kEm},     {"rem", CSSLengthUnit::kRem},
+    {"rpx", CSSLengthUnit::kRpx},   {"vw", CSSLengthUnit::kVw},     {"vh", CSSLengthUnit::kVh},
+    {"vmin", CSSLengthUnit::kVmin}, {"vmax", CSSLengthUnit::kVmax}, {"cm", CSSLengthUnit::kCm},
+    {"mm", CSSLengthUnit::kMm},     {"in", CSSLengthUnit::kIn},     {"pt", CSSLengthUnit::kPt},
+    {"pc", CSSLengthUnit::kPc},     {"q", CSSLengthUnit::kQ},
+};
+
+template <typename CharType>
+bool Equal(const CharType* begin, const CharType* end, const char* ascii) {
+  size_t length = strlen(ascii);
+  if (static_cast<size_t>(end - begin) != length)
+    return false;
+  for (size_t i = 0; i < length; i++) {
+    if (begin[i] != static_cast<CharType>(ascii[i]))
+      return false;
+  }
+  return true;
+}
+
+// [+-]?[0-9]*(.[0-9]+)?, which double.tryParse() in Dart converts the same way.
+template <typename CharType>
+bool ConsumeDecimal(const CharType*& position, const CharType* end, Decimal& result) {
+  const CharType* p = position;
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    p++;
+  }
+
+  int64_t mantissa = 0;
+  int exponent = 0;
+  bool has_digits = false;
+  while (p < end && IsASCIIDigit(*p)) {
+    int digit = *p++ - '0';
+    if (mantissa > (kMaxMantissa - digit) / 10)
+      return false;
+    mantissa = mantissa * 10 + digit;
+    has_digits = true;
+  }
+  if (p < end && *p == '.') {
+    p++;
+    if (p == end || !IsASCIIDigit(*p))
+      return false;
+    while (p < end && IsASCIIDigit(*p)) {
+      int digit = *p++ - '0';
+      if (mantissa > (kMaxMantissa - digit) / 10 || exponent == kMaxExponent)
+        return false;
+      mantissa = mantissa * 10 + digit;
+      exponent++;
+    }
+    has_digits = true;
+  }
+  if (!has_digits)
+    return false;
+
+  result.mantissa = negative ? -mantissa : mantissa;
+  result.exponent = exponent;
+  position = p;
+  return true;
+}
+
+int64_t EncodeDecimal(CSSValueKind kind, const Decimal& decimal, int64_t unit = 0) {
+  return static_cast<int64_t>(static_cast<uint64_t>(decimal.mantissa) << kMantissaShift) |
+         static_cast<int64_t>(decimal.exponent) << kExponentShift | unit << kUnitShift | static_cast<int64_t>(kind);
+}
+
+int64_t EncodeColor(uint32_t argb) {
+  return static_cast<int64_t>(static_cast<uint64_t>(argb) << kColorShift) |
+         static_cast<int64_t>(CSSValueKind::kColor);
+}
+
+template <typename CharType>
+int HexValue(CharType c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  return -1;
+}
+
+// #rgb, #rgba, #rrggbb and #rrggbbaa.
+template <typename CharType>
+int64_t ParseHexColor(const CharType* begin, const CharType* end) {
+  size_t length = end - begin;
+  if (length != 3 && length != 4 && length != 6 && length != 8)
+    return 0;
+  uint32_t digits[8];
+  for (size_t i = 0; i < length; i++) {
+    int value = HexValue(begin[i]);
+    if (value < 0)
+      return 0;
+    digits[i] = value;
+  }
+
+  uint32_t r, g, b, a = 0xff;
+  if (length <= 4) {
+    r = digits[0] * 0x11;
+    g = digits[1] * 0x11;
+    b = digits[2] * 0x11;
+    if (length == 4)
+      a = digits[3] * 0x11;
+  } else {
+    r = digits[0] << 4 | digits[1];
+    g = digits[2] << 4 | digits[3];
+    b = digits[4] << 4 | digits[5];
+    if (length == 8)
+      a = digits[6] << 4 | digits[7];
+  }
+  return EncodeColor(a << 24 | r << 16 | g << 8 | b);
+}
+
+template <typename CharType>
+bool IsColorSeparator(CharType c, bool allow_slash) {
+  return IsASCIISpace(c) || c == ',' || (allow_slash && c == '/');
+}
+
+// A component of rgb(), clamped to [0, max] like _parseColorPart() in color.dart.
+template <typename CharType>
+bool ConsumeColorComponent(const CharType*& position, const CharType* end, double max, double& result) {
+  Decimal decimal;
+  if (!ConsumeDecimal(position, end, decimal))
+    return false;
+  double value = decimal.ToDouble();
+  if (position < end && *position == '%') {
+    position++;
+    value = value / 100.0 * max;
+  }
+  // The component should be followed by a separator, which is the same as the component pattern of _colorRgbRegExp.
+  if (position < end && !IsColorSeparator(*position, false))
+    return false;
+  result = value < 0 ? 0 : (value > max ? max : value);
+  return true;
+}
+
+// rgb() and rgba() with the separators accepted by _colorRgbRegExp in color.dart, converted the same as
+// Color.fromRGBO().
+template <typename CharType>
+int64_t ParseRGBColor(const CharType* begin, const CharType* end) {
+  const CharType* p = begin;
+  double components[4] = {0, 0, 0, 1};
+  for (int i = 0; i < 3; i++) {
+    if (i > 0) {
+      const CharType* separator = p;
+      while (p < end && IsColorSeparator(*p, false))
+        p++;
+      if (p == separator)
+        return 0;
+    }
+    if (!ConsumeColorComponent(p, end, 255, components[i]))
+      return 0;
+  }
+
+  bool only_spaces = true;
+  const CharType* separator = p;
+  while (p < end && IsColorSeparator(*p, true)) {
+    only_spaces &= IsASCIISpace(*p);
+    p++;
+  }
+  if (p < end) {
+    if (p == separator || !ConsumeColorComponent(p, end, 1, components[3]))
+      return 0;
+    while (p < end && IsASCIISpace(*p))
+      p++;
+    if (p != end)
+      return 0;
+  } else if (!only_spaces) {
+    // Only whitespaces could follow the last component.
+    return 0;
+  }
+
+  uint32_t r = static_cast<uint32_t>(std::round(components[0]));
+  uint32_t g = static_cast<uint32_t>(std::round(components[1]));
+  uint32_t b = static_cast<uint32_t>(std::round(components[2]));
+  uint32_t a = static_cast<uint32_t>(static_cast<int64_t>(components[3] * 0xff) & 0xff);
+  return EncodeColor(a << 24 | r << 16 | g << 8 | b);
+}
+
+template <typename CharType>
+int64_t ParseValue(const CharType* begin, const CharType* end) {
+  if (begin == end || IsASCIISpace(*begin) || IsASCIISpace(*(end - 1)))
+    return 0;
+
+  const CharType* p = begin;
+  Decimal decimal;
+  if (ConsumeDecimal(p, end, decimal)) {
+    if (p == end)
+      return EncodeDecimal(CSSValueKind::kNumber, decimal);
+    if (*p == '%')
+      return p + 1 == end ? EncodeDecimal(CSSValueKind::kPercentage, decimal) : 0;
+    for (const LengthUnit& unit : kLengthUnits) {
+      if (Equal(p, end, unit.name))
+        return EncodeDecimal(CSSValueKind::kLength, decimal, static_cast<int64_t>(unit.unit));
+    }
+    return 0;
+  }
+
+  if (*begin == '#')
+    return ParseHexColor(begin + 1, end);
+  if (*(end - 1) == ')') {
+    if (end - begin > 4 && Equal(begin, begin + 4, "rgb("))
+      return ParseRGBColor(begin + 4, end - 1);
+    if (end - begin > 5 && Equal(begin, begin + 5, "rgba("))
+      return ParseRGBColor(begin + 5, end - 1);
+    return 0;
+  }
+  if (Equal(begin, end, "transparent"))
+    return EncodeColor(0);
+  if (Equal(begin, end, "auto"))
+    return static_cast<int64_t>(CSSValueKeyword::kAuto) << kUnitShift | static_cast<int64_t>(CSSValueKind::kKeyword);
+  if (Equal(begin, end, "none"))
+    return static_cast<int64_t>(CSSValueKeyword::kNone) << kUnitShift | static_cast<int64_t>(CSSValueKind::kKeyword);
+  return 0;
+}
+
+}  // namespace
+
+int64_t CSSValueParser::ParseStyleValue(const StringView& value) {
+  if (value.Is8Bit()) {
+    auto* characters = reinterpret_cast<const uint8_t*>(value.Characters8());
+    return ParseValue(characters, characters + value.length());
+  }
+  return ParseValue(value.Characters16(), value.Characters16() + value.length());
+}
+
+}  // namespace webf
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_CORE_CSS_PARSER_CSS_VALUE_PARSER_H_
+#define BRIDGE_CORE_CSS_PARSER_CSS_VALUE_PARSER_H_
+
+#include <cstdint>
+#include "foundation/string_view.h"
+
+namespace webf {
+
+// The typed value sent as the immediate operand of UICommand::kSetStyle along with the value text, keep the encoding
+// in sync with webf/lib/src/css/values/native_value.dart.
+//
+//   bits 0-3:    CSSValueKind
+//   number, percentage and length, the value is mantissa / 10^exponent:
+//   bits 4-8:    CSSLengthUnit of lengths
+//   bits 9-13:   exponent, 0 to 22
+//   bits 14-63:  signed mantissa
+//   color:
+//   bits 32-63:  ARGB
+//   keyword:
+//   bits 4-7:    CSSValueKeyword
+//
+// A decimal with a mantissa of less than 2^53 and a power of ten exactly representable as a double is converted to the
+// same double by the division as by parsing the text, so Dart side gets the same numbers without parsing them.
+enum class CSSValueKind : int64_t { kNone, kNumber, kPercentage, kLength, kColor, kKeyword };
+enum class CSSLengthUnit : int64_t { kPx, kEm, kRem, kRpx, kVw, kVh, kVmin, kVmax, kCm, kMm, kIn, kPt, kPc, kQ };
+enum class CSSValueKeyword : int64_t { kAuto, kNone };
+
+// Parses the common value grammars of style values on the JS thread: numbers, percentages, lengths, hex, rgb() and
+// rgba() colors and a few keywords. Other values, like functions and lists, are only sent as text.
+class CSSValueParser {
+ public:
+  // Returns the typed value, or 0 when the value is not in one of the grammars. Dart side uses the typed value only
+  // when the value text is unchanged by its normalization, so values which are not trimmed or lower case are skipped.
+  static int64_t ParseStyleValue(const StringView& value);
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_PARSER_CSS_VALUE_PARSER_H_
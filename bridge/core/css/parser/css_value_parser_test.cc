@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "css_value_parser.h"
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+int64_t Parse(const std::string& value) {
+  return CSSValueParser::ParseStyleValue(StringView(value));
+}
+
+int64_t Parse(const std::u16string& value) {
+  return CSSValueParser::ParseStyleValue(
+      StringView(const_cast<char16_t*>(value.data()), static_cast<unsigned>(value.length()), true));
+}
+
+CSSValueKind Kind(int64_t value) {
+  return static_cast<CSSValueKind>(value & 0xf);
+}
+
+CSSLengthUnit Unit(int64_t value) {
+  return static_cast<CSSLengthUnit>(value >> 4 & 0x1f);
+}
+
+double Number(int64_t value) {
+  static const double kPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  return static_cast<double>(value >> 14) / kPowersOfTen[value >> 9 & 0x1f];
+}
+
+uint32_t Color(int64_t value) {
+  return static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32);
+}
+
+}  // namespace
+
+TEST(CSSValueParser, numbers) {
+  EXPECT_EQ(Kind(Parse("1")), CSSValueKind::kNumber);
+  EXPECT_EQ(Number(Parse("1")), 1);
+  EXPECT_EQ(Number(Parse("-0.25")), -0.25);
+  EXPECT_EQ(Number(Parse("+.5")), 0.5);
+  // The same double as parsing the text.
+  EXPECT_EQ(Number(Parse("123.456789")), std::stod("123.456789"));
+  EXPECT_EQ(Number(Parse("0.1")), 0.1);
+  EXPECT_EQ(Parse("1."), 0);
+  EXPECT_EQ(Parse("1e3"), 0);
+  EXPECT_EQ(Parse("-"), 0);
+  EXPECT_EQ(Parse("12345678901234567"), 0);
+}
+
+TEST(CSSValueParser, lengths) {
+  int64_t value = Parse("12.5px");
+  EXPECT_EQ(Kind(value), CSSValueKind::kLength);
+  EXPECT_EQ(Unit(value), CSSLengthUnit::kPx);
+  EXPECT_EQ(Number(value), 12.5);
+  EXPECT_EQ(Unit(Parse("-3rem")), CSSLengthUnit::kRem);
+  EXPECT_EQ(Number(Parse("-3rem")), -3);
+  EXPECT_EQ(Unit(Parse("50vmin")), CSSLengthUnit::kVmin);
+  EXPECT_EQ(Unit(Parse("2q")), CSSLengthUnit::kQ);
+  EXPECT_EQ(Unit(Parse(u"1em")), CSSLengthUnit::kEm);
+
+  EXPECT_EQ(Kind(Parse("50%")), CSSValueKind::kPercentage);
+  EXPECT_EQ(Number(Parse("50%")), 50);
+
+  // Values which Dart side normalizes are only sent as text.
+  EXPECT_EQ(Parse("12PX"), 0);
+  EXPECT_EQ(Parse(" 12px"), 0);
+  EXPECT_EQ(Parse("12 px"), 0);
+  EXPECT_EQ(Parse("12pxx"), 0);
+  EXPECT_EQ(Parse("calc(1px + 2px)"), 0);
+}
+
+TEST(CSSValueParser, colors) {
+  EXPECT_EQ(Kind(Parse("#fff")), CSSValueKind::kColor);
+  EXPECT_EQ(Color(Parse("#fff")), 0xffffffff);
+  EXPECT_EQ(Color(Parse("#1234")), 0x44112233);
+  EXPECT_EQ(Color(Parse("#0a0b0c")), 0xff0a0b0c);
+  EXPECT_EQ(Color(Parse("#0a0b0c80")), 0x800a0b0c);
+  EXPECT_EQ(Parse("#0a0b0"), 0);
+  EXPECT_EQ(Parse("#FFF"), 0);
+
+  EXPECT_EQ(Color(Parse("rgb(255, 0, 10)")), 0xffff000a);
+  EXPECT_EQ(Color(Parse("rgba(0,0,0,.5)")), 0x7f000000);
+  EXPECT_EQ(Color(Parse("rgb(100% 300 -1 / 50%)")), 0x7fffff00);
+  EXPECT_EQ(Color(Parse("rgb(0.5, 1.5, 2.5)")), 0xff010203);
+  EXPECT_EQ(Color(Parse(u"rgba(1, 2, 3, 1)")), 0xff010203);
+  EXPECT_EQ(Parse("rgb(1, 2)"), 0);
+  EXPECT_EQ(Parse("rgb(1, 2, 3,)"), 0);
+  EXPECT_EQ(Parse("rgb(1, 2, 3/0.5)"), 0);
+  EXPECT_EQ(Parse("rgb( 1, 2, 3)"), 0);
+  EXPECT_EQ(Parse("rgb(var(--r), 2, 3)"), 0);
+
+  EXPECT_EQ(Kind(Parse("transparent")), CSSValueKind::kColor);
+  EXPECT_EQ(Color(Parse("transparent")), 0);
+}
+
+TEST(CSSValueParser, keywords) {
+  EXPECT_EQ(Kind(Parse("auto")), CSSValueKind::kKeyword);
+  EXPECT_EQ(static_cast<CSSValueKeyword>(Parse("none") >> 4 & 0xf), CSSValueKeyword::kNone);
+  EXPECT_EQ(Parse("block"), 0);
+  EXPECT_EQ(Parse(""), 0);
+}
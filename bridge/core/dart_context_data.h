@@ -5,6 +5,7 @@
 #ifndef WEBF_CORE_DART_CONTEXT_DATA_H_
 #define WEBF_CORE_DART_CONTEXT_DATA_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <unordered_map>
@@ -24,6 +25,9 @@ class DartContextData {
   const WidgetElementShape* GetWidgetElementShape(const std::string& key);
   bool HasWidgetElementShape(const std::string& key);
   void SetWidgetElementShape(const std::string& key, const std::shared_ptr<WidgetElementShape>& shape);
+  // Counts the custom elements defined at dart side, a tag without a shape is only asked again after it changes.
+  int64_t WidgetElementDefinitions() const { return widget_element_definitions_.load(std::memory_order_acquire); }
+  void DidDefineWidgetElement() { widget_element_definitions_.fetch_add(1, std::memory_order_acq_rel); }
 
  private:
   std::mutex context_data_mutex_;
@@ -32,6 +36,7 @@ class DartContextData {
   // prop getter and setter and functions for JS code. This map store the properties and methods of WidgetElement which
   // already created.
   std::unordered_map<std::string, std::shared_ptr<WidgetElementShape>> widget_element_shapes_;
+  std::atomic<int64_t> widget_element_definitions_{0};
 };
 
 }  // namespace webf
@@ -6,6 +6,7 @@
 #include <unordered_set>
 #include "defined_properties_initializer.h"
 #include "event_factory.h"
+#include "foundation/slab_allocator.h"
 #include "html_element_factory.h"
 #include "logging.h"
 #include "multiple_threading/looper.h"
@@ -60,6 +61,8 @@ const std::unique_ptr<DartContextData>& DartIsolateContext::EnsureData() const {
   return data_;
 }
 
+constexpr uint32_t kGCMinorCollectionsPerFull = 8;
+
 thread_local JSRuntime* runtime_{nullptr};
 thread_local uint32_t running_dart_isolates = 0;
 thread_local bool is_name_installed_ = false;
@@ -74,9 +77,16 @@ void InitializeBuiltInStrings(JSContext* ctx) {
 void DartIsolateContext::InitializeJSRuntime() {
   if (runtime_ != nullptr)
     return;
-  runtime_ = JS_NewRuntime();
+  // Small objects of the runtime and the DOM objects opted in are served from the slabs of this thread, all of them
+  // are released at once when the runtime finalized.
+  auto* slab_allocator = new SlabAllocator();
+  SlabAllocator::SetCurrent(slab_allocator);
+  runtime_ = JS_NewRuntime2(SlabAllocator::MallocFunctions(), slab_allocator);
   // Avoid stack overflow when running in multiple threads.
   JS_UpdateStackTop(runtime_);
+  // Most wrappers of a DOM-heavy page live as long as the page, only scan the newly allocated objects in most
+  // automatic collections to keep the pauses on the JS thread short.
+  JS_SetGCGenerational(runtime_, true, kGCMinorCollectionsPerFull);
   // Bump up the built-in classId. To make sure the created classId are larger than JS_CLASS_CUSTOM_CLASS_INIT_COUNT.
   for (int i = 0; i < JS_CLASS_CUSTOM_CLASS_INIT_COUNT - JS_CLASS_GC_TRACKER + 2; i++) {
     JSClassID id{0};
@@ -97,6 +107,8 @@ void DartIsolateContext::FinalizeJSRuntime() {
   JS_TurnOnGC(runtime_);
   JS_FreeRuntime(runtime_);
   runtime_ = nullptr;
+  delete SlabAllocator::Current();
+  SlabAllocator::SetCurrent(nullptr);
   is_name_installed_ = false;
 }
 
@@ -106,8 +118,11 @@ DartIsolateContext::DartIsolateContext(const uint64_t* dart_methods, int32_t dar
       profiler_(std::make_unique<WebFProfiler>(profile_enabled)),
       dart_method_ptr_(std::make_unique<DartMethodPointer>(this, dart_methods, dart_methods_length)) {
   is_valid_ = true;
+  TraceRecorder::SetThreadName("Dart UI Thread");
   running_dart_isolates++;
   InitializeJSRuntime();
+  // Created up front, dart thread reads the data while JS threads may be running.
+  EnsureData();
 }
 
 JSRuntime* DartIsolateContext::runtime() {
@@ -131,11 +146,13 @@ void DartIsolateContext::InitializeNewPageInJSThread(PageGroup* page_group,
                                                      DartIsolateContext* dart_isolate_context,
                                                      double page_context_id,
                                                      int32_t sync_buffer_size,
+                                                     NativeHeapPolicy heap_policy,
                                                      Dart_Handle dart_handle,
                                                      AllocateNewPageCallback result_callback) {
   dart_isolate_context->profiler()->StartTrackInitialize();
   DartIsolateContext::InitializeJSRuntime();
   auto* page = new WebFPage(dart_isolate_context, true, sync_buffer_size, page_context_id, nullptr);
+  page->executingContext()->idleGCScheduler()->ApplyHeapPolicy(heap_policy);
 
   dart_isolate_context->profiler()->FinishTrackInitialize();
 
@@ -163,6 +180,7 @@ void DartIsolateContext::DisposePageInJSThread(DartIsolateContext* dart_isolate_
 
 void* DartIsolateContext::AddNewPage(double thread_identity,
                                      int32_t sync_buffer_size,
+                                     NativeHeapPolicy heap_policy,
                                      Dart_Handle dart_handle,
                                      AllocateNewPageCallback result_callback) {
   bool is_in_flutter_ui_thread = thread_identity < 0;
@@ -183,12 +201,12 @@ void* DartIsolateContext::AddNewPage(double thread_identity,
   }
 
   dispatcher_->PostToJs(true, thread_group_id, InitializeNewPageInJSThread, page_group, this, thread_identity,
-                        sync_buffer_size, dart_handle, result_callback);
+                        sync_buffer_size, heap_policy, dart_handle, result_callback);
   return nullptr;
 }
 
 void* DartIsolateContext::AddNewPageSync(double thread_identity) {
-  profiler()->StartTrackSteps("WebFPage::Initialize");
+  profiler()->StartTrackSteps(TraceLabel::kWebFPageInitialize);
   auto page = std::make_unique<WebFPage>(this, false, 0, thread_identity, nullptr);
   profiler()->FinishTrackSteps();
 
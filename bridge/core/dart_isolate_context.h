@@ -62,6 +62,7 @@ class DartIsolateContext {
 
   void* AddNewPage(double thread_identity,
                    int32_t sync_buffer_size,
+                   NativeHeapPolicy heap_policy,
                    Dart_Handle dart_handle,
                    AllocateNewPageCallback result_callback);
   void* AddNewPageSync(double thread_identity);
@@ -78,6 +79,7 @@ class DartIsolateContext {
                                           DartIsolateContext* dart_isolate_context,
                                           double page_context_id,
                                           int32_t sync_buffer_size,
+                                          NativeHeapPolicy heap_policy,
                                           Dart_Handle dart_handle,
                                           AllocateNewPageCallback result_callback);
   static void DisposePageAndKilledJSThread(DartIsolateContext* dart_isolate_context,
@@ -24,6 +24,10 @@ void CharacterData::setData(const AtomicString& data, ExceptionState& exception_
 }
 
 void CharacterData::DidModifyData(const webf::AtomicString& old_data) {
+  if (ContainerNode* parent = parentNode()) {
+    parent->ChildrenChanged(ContainerNode::ChildrenChange::ForTextChange(*this, old_data));
+  }
+
   std::shared_ptr<MutationObserverInterestGroup> mutation_recipients =
       MutationObserverInterestGroup::CreateForCharacterDataMutation(*this);
   if (mutation_recipients != nullptr) {
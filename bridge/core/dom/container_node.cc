@@ -124,6 +124,13 @@ inline bool CheckReferenceChildParent(const Node& parent,
   return true;
 }
 
+// The mutation types observed for a node are inherited from its ancestors, so moving a node makes the ones cached for
+// its subtree stale. The rest of the document keeps its caches.
+static inline void InvalidateMutationObserverTypes(Node& node) {
+  if (node.GetDocument().HasMutationObservers())
+    node.InvalidateMutationObserverTypesInSubtree();
+}
+
 // This dispatches various events; DOM mutation events, blur events, IFRAME
 // unload events, etc.
 // Returns true if DOM mutation should be proceeded.
@@ -435,6 +442,7 @@ void ContainerNode::RemoveBetween(Node* previous_child, Node* next_child, Node&
   old_child.SetPreviousSibling(nullptr);
   old_child.SetNextSibling(nullptr);
   old_child.SetParentOrShadowHostNode(nullptr);
+  InvalidateMutationObserverTypes(old_child);
 
   GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRemoveNode, nullptr, old_child.bindingObject(),
                                                        nullptr);
@@ -486,16 +494,22 @@ void ContainerNode::InsertBeforeCommon(Node& next_child, Node& new_child) {
     SetFirstChild(&new_child);
   }
   new_child.SetParentOrShadowHostNode(this);
+  InvalidateMutationObserverTypes(new_child);
+  if (new_child.IsElementNode())
+    new_child.SetNeedsStyleRecalc();
   new_child.SetPreviousSibling(prev);
   new_child.SetNextSibling(&next_child);
 
-  std::unique_ptr<SharedNativeString> args_01 = stringToNativeString("beforebegin");
-  GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kInsertAdjacentNode, std::move(args_01),
-                                                       next_child.bindingObject(), new_child.bindingObject());
+  GetExecutingContext()->uiCommandBuffer()->AddCommandWithImmediate(
+      UICommand::kInsertAdjacentNode, static_cast<int64_t>(InsertAdjacentPosition::kBeforeBegin), nullptr,
+      next_child.bindingObject(), new_child.bindingObject());
 }
 
 void ContainerNode::AppendChildCommon(Node& child) {
   child.SetParentOrShadowHostNode(this);
+  InvalidateMutationObserverTypes(child);
+  if (child.IsElementNode())
+    child.SetNeedsStyleRecalc();
   if (last_child_) {
     child.SetPreviousSibling(last_child_);
     last_child_->SetNextSibling(&child);
@@ -504,9 +518,9 @@ void ContainerNode::AppendChildCommon(Node& child) {
   }
   SetLastChild(&child);
 
-  std::unique_ptr<SharedNativeString> args_01 = stringToNativeString("beforeend");
-  GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kInsertAdjacentNode, std::move(args_01),
-                                                       bindingObject(), child.bindingObject());
+  GetExecutingContext()->uiCommandBuffer()->AddCommandWithImmediate(
+      UICommand::kInsertAdjacentNode, static_cast<int64_t>(InsertAdjacentPosition::kBeforeEnd), nullptr,
+      bindingObject(), child.bindingObject());
 }
 
 void ContainerNode::NotifyNodeInsertedInternal(Node& root) {
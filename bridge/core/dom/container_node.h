@@ -103,6 +103,19 @@ class ContainerNode : public Node {
       return change;
     }
 
+    static ChildrenChange ForTextChange(Node& node, const AtomicString& old_text) {
+      ChildrenChange change = {
+          .type = ChildrenChangeType::kTextChanged,
+          .by_parser = ChildrenChangeSource::kAPI,
+          .affects_elements = ChildrenChangeAffectsElements::kNo,
+          .sibling_changed = &node,
+          .sibling_before_change = node.previousSibling(),
+          .sibling_after_change = node.nextSibling(),
+          .old_text = old_text,
+      };
+      return change;
+    }
+
     bool IsChildInsertion() const {
       return type == ChildrenChangeType::kElementInserted || type == ChildrenChangeType::kNonElementInserted;
     }
@@ -103,6 +103,13 @@ class Document : public ContainerNode, public TreeScope {
   bool HasMutationObserversOfType(MutationType type) const { return mutation_observer_types_ & type; }
   bool HasMutationObservers() const { return mutation_observer_types_; }
   void AddMutationObserverTypes(MutationType types) { mutation_observer_types_ |= types; }
+  // Bumped when a registration is added or removed, which invalidates the mutation types cached in NodeData. Moved
+  // nodes only drop the caches of their subtrees, see Node::InvalidateMutationObserverTypesInSubtree.
+  uint32_t MutationObserverVersion() const { return mutation_observer_version_; }
+  void InvalidateMutationObserverTypes() {
+    if (++mutation_observer_version_ == 0)
+      mutation_observer_version_ = 1;
+  }
 
   // nodeWillBeRemoved is only safe when removing one node at a time.
   void NodeWillBeRemoved(Node&);
@@ -130,7 +137,8 @@ class Document : public ContainerNode, public TreeScope {
  private:
   int node_count_{0};
   ScriptAnimationController script_animation_controller_;
-  MutationObserverOptions mutation_observer_types_;
+  MutationObserverOptions mutation_observer_types_{0};
+  uint32_t mutation_observer_version_{1};
 };
 
 template <>
@@ -19,6 +19,7 @@
 #include "element_namespace_uris.h"
 #include "foundation/native_value_converter.h"
 #include "html_element_type_helper.h"
+#include "markup_serializer.h"
 #include "mutation_observer_interest_group.h"
 #include "qjs_element.h"
 #include "text.h"
@@ -74,6 +75,12 @@ void Element::removeAttribute(const AtomicString& name, ExceptionState& exceptio
 }
 
 BoundingClientRect* Element::getBoundingClientRect(ExceptionState& exception_state) {
+  LayoutQueryCache* layout_query_cache = GetExecutingContext()->layoutQueryCache();
+  BoundingClientRectData cached_rect;
+  if (layout_query_cache->GetBoundingClientRect(this, &cached_rect)) {
+    return BoundingClientRect::Create(GetExecutingContext(), cached_rect);
+  }
+
   NativeValue result = InvokeBindingMethod(
       binding_call_methods::kgetBoundingClientRect, 0, nullptr,
       FlushUICommandReason::kDependentsOnElement | FlushUICommandReason::kDependentsOnLayout, exception_state);
@@ -84,7 +91,9 @@ BoundingClientRect* Element::getBoundingClientRect(ExceptionState& exception_sta
     return nullptr;
   }
 
-  return BoundingClientRect::Create(GetExecutingContext(), native_binding_object);
+  auto* rect = BoundingClientRect::Create(GetExecutingContext(), native_binding_object);
+  layout_query_cache->SetBoundingClientRect(this, rect->data());
+  return rect;
 }
 
 std::vector<BoundingClientRect*> Element::getClientRects(ExceptionState& exception_state) {
@@ -415,8 +424,8 @@ void ElementSnapshotReader::Start() {
             reader->HandleFailed(error);
             dart_free(error);
           } else {
+            // The blob takes the ownership of the bytes.
             reader->HandleSnapshot(bytes, length);
-            dart_free(bytes);
           }
           delete reader;
         },
@@ -431,7 +440,7 @@ void ElementSnapshotReader::HandleSnapshot(uint8_t* bytes, int32_t length) {
   MemberMutationScope mutation_scope{context_};
   Blob* blob = Blob::Create(context_);
   blob->SetMineType("image/png");
-  blob->AppendBytes(bytes, length);
+  blob->AppendBuffer(BlobBuffer::Adopt(bytes, length, dart_free));
   resolver_->Resolve<Blob*>(blob);
 }
 
@@ -561,53 +570,16 @@ void Element::SetInlineStyleFromString(const webf::AtomicString& new_style_strin
   EnsureCSSStyleDeclaration().SetCSSTextInternal(new_style_string);
 }
 
-std::string Element::outerHTML() {
-  std::string tagname = local_name_.ToStdString(ctx());
-  std::string s = "<" + tagname;
-
-  // Read attributes
-  if (attributes_ != nullptr) {
-    s += " " + attributes_->ToString();
-  }
-  if (cssom_wrapper_ != nullptr) {
-    s += " style=\"" + cssom_wrapper_->ToString();
-  }
-
-  s += ">";
-
-  std::string childHTML = innerHTML();
-  s += childHTML;
-  s += "</" + tagname + ">";
-
-  return s;
+AtomicString Element::outerHTML() {
+  MarkupSerializer serializer;
+  serializer.SerializeElement(*this);
+  return serializer.TakeResult(ctx());
 }
 
-std::string Element::innerHTML() {
-  std::string s;
-
-  // If Element is TemplateElement, the innerHTML content is the content of documentFragment.
-  Node* parent = To<Node>(this);
-
-  if (auto* template_element = DynamicTo<HTMLTemplateElement>(this)) {
-    parent = To<Node>(template_element->content());
-  }
-
-  if (parent->firstChild() == nullptr)
-    return s;
-
-  auto* child = parent->firstChild();
-  while (child != nullptr) {
-    if (auto* element = DynamicTo<Element>(child)) {
-      s += element->outerHTML();
-    } else if (auto* text = DynamicTo<Text>(child)) {
-      s += text->data().ToStdString(ctx());
-    } else if (auto* comment = DynamicTo<Comment>(child)) {
-      s += "<!--" + comment->data().ToStdString(ctx()) + "-->";
-    }
-    child = child->nextSibling();
-  }
-
-  return s;
+AtomicString Element::innerHTML() {
+  MarkupSerializer serializer;
+  serializer.SerializeChildren(*this);
+  return serializer.TakeResult(ctx());
 }
 
 void Element::setInnerHTML(const AtomicString& value, ExceptionState& exception_state) {
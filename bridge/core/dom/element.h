@@ -96,8 +96,8 @@ class Element : public ContainerNode {
   void StyleAttributeChanged(const AtomicString& new_style_string, AttributeModificationReason modification_reason);
   void SetInlineStyleFromString(const AtomicString&);
 
-  std::string outerHTML();
-  std::string innerHTML();
+  AtomicString outerHTML();
+  AtomicString innerHTML();
   void setInnerHTML(const AtomicString& value, ExceptionState& exception_state);
 
   bool HasTagName(const AtomicString&) const;
@@ -160,6 +160,8 @@ class Element : public ContainerNode {
   AtomicString local_name_ = AtomicString::Empty();
 
  private:
+  friend class MarkupSerializer;
+
   // Clone is private so that non-virtual CloneElementWithChildren and
   // CloneElementWithoutChildren are used inst
   Node* Clone(Document&, CloneChildrenFlag) const override;
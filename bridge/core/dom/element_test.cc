@@ -112,6 +112,58 @@ console.log(div.outerHTML, div.innerHTML, document.body.innerHTML);
   EXPECT_EQ(errorCalled, false);
 }
 
+TEST(Element, innerHTMLEscapesTextAndSkipsVoidEndTags) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(),
+                 "<p title=\"a&quot;b\">x &amp; y &lt;z&gt;<br><span>1<b>2</b></span></p><img src=\"z\"> "
+                 "55000");
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = R"(
+const div = document.createElement('div');
+div.innerHTML = '<p title="a&quot;b">x &amp; y &lt;z&gt;<br><span>1<b>2</b></span></p><img src="z">';
+
+const root = document.createElement('div');
+let parent = root;
+for (let i = 0; i < 5000; i++) {
+  const child = document.createElement('div');
+  parent.appendChild(child);
+  parent = child;
+}
+console.log(div.innerHTML, root.innerHTML.length);
+)";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(Element, innerHTMLKeepsTheLengthOfNonASCIIText) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "<b>\xC3\xA9\xF0\x9F\x98\x80</b><i>x</i> 18 true");
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = R"(
+const div = document.createElement('div');
+div.innerHTML = '<b>\u00e9\ud83d\ude00</b><i>x</i>';
+console.log(div.innerHTML, div.innerHTML.length, div.outerHTML === '<div>' + div.innerHTML + '</div>');
+)";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
 TEST(Element, style) {
   bool static errorCalled = false;
   bool static logCalled = false;
@@ -78,6 +78,7 @@ inline T* toNativeEvent(RawEvent* raw_event) {
 
 class Event : public ScriptWrappable {
   DEFINE_WRAPPERTYPEINFO();
+  WEBF_SLAB_ALLOCATED();
 
  public:
   using ImplType = Event*;
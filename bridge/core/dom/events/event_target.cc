@@ -62,13 +62,23 @@ EventTarget::~EventTarget() {
   if (TEST_getEnv(GetExecutingContext()->uniqueId())->on_event_target_disposed != nullptr) {
     TEST_getEnv(GetExecutingContext()->uniqueId())->on_event_target_disposed(this);
   }
+  TEST_getEnv(GetExecutingContext()->uniqueId())->event_targets.erase(event_target_id_);
 #endif
 }
 
-EventTarget::EventTarget(ExecutingContext* context) : BindingObject(context->ctx()) {}
+EventTarget::EventTarget(ExecutingContext* context)
+    : BindingObject(context->ctx()), event_target_id_(context->NextEventTargetId()) {
+#if UNIT_TEST
+  TEST_getEnv(context->uniqueId())->event_targets[event_target_id_] = this;
+#endif
+}
 
 EventTarget::EventTarget(ExecutingContext* context, NativeBindingObject* native_binding_object)
-    : BindingObject(context->ctx(), native_binding_object) {}
+    : BindingObject(context->ctx(), native_binding_object), event_target_id_(context->NextEventTargetId()) {
+#if UNIT_TEST
+  TEST_getEnv(context->uniqueId())->event_targets[event_target_id_] = this;
+#endif
+}
 
 Node* EventTarget::ToNode() {
   return nullptr;
@@ -280,8 +290,11 @@ bool EventTarget::AddEventListenerInternal(const AtomicString& event_type,
       listener_options->passive = options->passive();
     }
 
-    GetExecutingContext()->uiCommandBuffer()->AddCommand(
-        UICommand::kAddEvent, std::move(event_type.ToNativeString(ctx())), bindingObject(), listener_options);
+    SharedUICommand* ui_command_buffer = GetExecutingContext()->uiCommandBuffer();
+    std::unique_ptr<SharedNativeString> args_01;
+    int64_t event_type_id = ui_command_buffer->InternString(event_type, args_01);
+    ui_command_buffer->AddCommandWithImmediate(UICommand::kAddEvent, event_type_id, std::move(args_01),
+                                               bindingObject(), listener_options);
   }
 
   return added;
@@ -328,9 +341,11 @@ bool EventTarget::RemoveEventListenerInternal(const AtomicString& event_type,
   if (listener_count == 0) {
     bool has_capture = options->hasCapture() && options->capture();
 
-    GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRemoveEvent,
-                                                         std::move(event_type.ToNativeString(ctx())), bindingObject(),
-                                                         has_capture ? (void*)0x01 : nullptr);
+    SharedUICommand* ui_command_buffer = GetExecutingContext()->uiCommandBuffer();
+    std::unique_ptr<SharedNativeString> args_01;
+    int64_t event_type_id = ui_command_buffer->InternString(event_type, args_01);
+    ui_command_buffer->AddCommandWithImmediate(UICommand::kRemoveEvent, event_type_id, std::move(args_01),
+                                               bindingObject(), has_capture ? (void*)0x01 : nullptr);
   }
 
   return true;
@@ -361,7 +376,7 @@ NativeValue EventTarget::HandleCallFromDartSide(const AtomicString& method,
 }
 
 NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeValue* argv, Dart_Handle dart_object) {
-  GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps("EventTarget::HandleDispatchEventFromDart");
+  GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kHandleDispatchEventFromDart);
 
   assert(argc >= 2);
   NativeValue native_event_type = argv[0];
@@ -375,6 +390,10 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
   assert(event->target() != nullptr);
   assert(event->currentTarget() != nullptr);
 
+  if (auto* recorder = GetExecutingContext()->replayRecorder()) {
+    recorder->RecordDispatchEvent(this, event, isCapture);
+  }
+
   auto* window = DynamicTo<Window>(event->target());
   if (window != nullptr && (event->type() == event_type_names::kload || event->type() == event_type_names::kgcopen)) {
     window->OnLoadEventFired();
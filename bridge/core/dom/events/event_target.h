@@ -135,6 +135,9 @@ class EventTarget : public BindingObject {
   virtual bool IsNode() const { return false; }
   bool IsEventTarget() const override;
 
+  // Identifies the target in replay traces.
+  int64_t eventTargetId() const { return event_target_id_; }
+
   NativeValue HandleCallFromDartSide(const AtomicString& method,
                                      int32_t argc,
                                      const NativeValue* argv,
@@ -163,6 +166,8 @@ class EventTarget : public BindingObject {
   RegisteredEventListener* GetAttributeRegisteredEventListener(const AtomicString& event_type);
 
   bool FireEventListeners(Event&, EventTargetData*, EventListenerVector&, ExceptionState&);
+
+  int64_t event_target_id_;
 };
 
 template <>
@@ -276,4 +276,43 @@ proxy.dispatchEvent(new Event('click'));
 
   JS_RunGC(JS_GetRuntime(env->page()->executingContext()->ctx()));
   EXPECT_EQ(logCalled, true);
-}
\ No newline at end of file
+}
+TEST(EventTarget, eventTypesAreSentOnceAsImmediates) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->executingContext();
+  context->uiCommandBuffer()->data();
+  context->uiCommandBuffer()->clear();
+
+  const char* code = R"(
+const first = document.createElement('div');
+const second = document.createElement('div');
+first.addEventListener('foo', () => {});
+second.addEventListener('foo', () => {});
+first.addEventListener('bar', () => {});
+document.body.appendChild(first);
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+
+  std::vector<UICommandItem> add_events;
+  std::vector<UICommandItem> insertions;
+  for (UICommandItem* item : TEST_getUICommandItems(context)) {
+    if (item->type == (int32_t)UICommand::kAddEvent)
+      add_events.push_back(*item);
+    if (item->type == (int32_t)UICommand::kInsertAdjacentNode)
+      insertions.push_back(*item);
+  }
+  context->uiCommandBuffer()->clear();
+
+  ASSERT_EQ(add_events.size(), 3);
+  EXPECT_NE(add_events[0].string_01, 0);
+  EXPECT_EQ(add_events[1].string_01, 0);
+  EXPECT_EQ(add_events[1].immediate, add_events[0].immediate);
+  EXPECT_NE(add_events[2].string_01, 0);
+  EXPECT_NE(add_events[2].immediate, add_events[0].immediate);
+
+  ASSERT_EQ(insertions.size(), 1);
+  EXPECT_EQ(insertions[0].string_01, 0);
+  EXPECT_EQ(insertions[0].immediate, static_cast<int64_t>(InsertAdjacentPosition::kBeforeEnd));
+}
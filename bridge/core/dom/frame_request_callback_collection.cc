@@ -6,6 +6,7 @@
 
 #include <utility>
 #include "bindings/qjs/cppgc/gc_visitor.h"
+#include "core/executing_context.h"
 
 namespace webf {
 
@@ -15,7 +16,7 @@ std::shared_ptr<FrameCallback> FrameCallback::Create(ExecutingContext* context,
 }
 
 FrameCallback::FrameCallback(ExecutingContext* context, std::shared_ptr<QJSFunction> callback)
-    : context_(context), callback_(std::move(callback)) {}
+    : context_(context), callback_(std::move(callback)), scheduled_callback_id_(context->NextScheduledCallbackId()) {}
 
 void FrameCallback::Fire(double highResTimeStamp) {
   if (callback_ == nullptr)
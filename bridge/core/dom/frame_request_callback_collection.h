@@ -29,6 +29,8 @@ class FrameCallback {
 
   uint32_t frameId() { return frame_id_; }
   void SetFrameId(uint32_t id) { frame_id_ = id; }
+  // Frame ids are shared by all pages, replay traces refer the callback by the order it was scheduled in the context.
+  int64_t scheduledCallbackId() const { return scheduled_callback_id_; }
 
   void Trace(GCVisitor* visitor) const;
 
@@ -36,6 +38,7 @@ class FrameCallback {
   std::shared_ptr<QJSFunction> callback_;
   FrameStatus status_;
   uint32_t frame_id_;
+  int64_t scheduled_callback_id_;
   ExecutingContext* context_{nullptr};
 };
 
@@ -12,10 +12,19 @@ BoundingClientRect* BoundingClientRect::Create(ExecutingContext* context, Native
   return MakeGarbageCollected<BoundingClientRect>(context, native_binding_object);
 }
 
+BoundingClientRect* BoundingClientRect::Create(ExecutingContext* context, const BoundingClientRectData& data) {
+  return MakeGarbageCollected<BoundingClientRect>(context, data);
+}
+
 BoundingClientRect::BoundingClientRect(ExecutingContext* context, NativeBindingObject* native_binding_object)
     : BindingObject(context->ctx(), native_binding_object),
       extra_(static_cast<BoundingClientRectData*>(native_binding_object->extra)) {}
 
+BoundingClientRect::BoundingClientRect(ExecutingContext* context, const BoundingClientRectData& data)
+    : BindingObject(context->ctx()), data_(data) {
+  extra_ = &data_;
+}
+
 NativeValue BoundingClientRect::HandleCallFromDartSide(const AtomicString& method,
                                                        int32_t argc,
                                                        const NativeValue* argv,
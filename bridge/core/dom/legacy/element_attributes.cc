@@ -69,6 +69,8 @@ bool ElementAttributes::setAttribute(const AtomicString& name,
 
   GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kSetAttribute, std::move(args_01),
                                                        element_->bindingObject(), args_02.release());
+  // Selectors could match any attribute.
+  element_->SetNeedsStyleRecalc();
 
   return true;
 }
@@ -104,6 +106,7 @@ void ElementAttributes::removeAttribute(const AtomicString& name, ExceptionState
   std::unique_ptr<SharedNativeString> args_01 = name.ToNativeString(ctx());
   GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRemoveAttribute, std::move(args_01),
                                                        element_->bindingObject(), nullptr);
+  element_->SetNeedsStyleRecalc();
 }
 
 void ElementAttributes::CopyWith(ElementAttributes* attributes) {
@@ -112,17 +115,6 @@ void ElementAttributes::CopyWith(ElementAttributes* attributes) {
   }
 }
 
-std::string ElementAttributes::ToString() {
-  std::string s;
-
-  for (auto& attr : attributes_) {
-    s += attr.first.ToStdString(ctx()) + "=";
-    s += "\"" + attr.second.ToStdString(ctx()) + "\"";
-  }
-
-  return s;
-}
-
 bool ElementAttributes::IsEquivalent(const ElementAttributes& other) const {
   if (attributes_.size() != other.attributes_.size())
     return false;
@@ -32,7 +32,6 @@ class ElementAttributes : public ScriptWrappable {
   bool hasAttribute(const AtomicString& name, ExceptionState& exception_state);
   void removeAttribute(const AtomicString& name, ExceptionState& exception_state);
   void CopyWith(ElementAttributes* attributes);
-  std::string ToString();
 
   bool IsEquivalent(const ElementAttributes& other) const;
   std::tr1::unordered_map<AtomicString, AtomicString>::iterator begin();
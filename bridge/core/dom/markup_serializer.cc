@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "markup_serializer.h"
+#include <cstring>
+#include "comment.h"
+#include "core/dom/document_fragment.h"
+#include "core/html/html_template_element.h"
+#include "element.h"
+#include "html_names.h"
+#include "text.h"
+
+namespace webf {
+
+namespace {
+
+constexpr const char* kVoidElements[] = {"area",  "base",  "br",       "col",     "embed",  "hr",
+                                         "img",   "input", "link",     "meta",    "source", "track",
+                                         "wbr",   "param", "basefont", "bgsound", "frame",  "keygen"};
+// The text in these elements is not escaped.
+constexpr const char* kRawTextElements[] = {"style", "script", "xmp", "iframe", "noembed", "noframes", "plaintext"};
+
+template <size_t N>
+bool LocalNameIn(const Element& element, const char* const (&names)[N]) {
+  StringView local_name = element.localName().ToStringView();
+  if (!local_name.Is8Bit())
+    return false;
+  for (const char* name : names) {
+    if (strlen(name) == local_name.length() && memcmp(name, local_name.Characters8(), local_name.length()) == 0)
+      return true;
+  }
+  return false;
+}
+
+Node* ChildrenContainer(Element& element) {
+  if (auto* template_element = DynamicTo<HTMLTemplateElement>(element))
+    return template_element->content();
+  return &element;
+}
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+// Returns non zero when any byte of the word is the given byte.
+inline uint64_t MatchByte(uint64_t word, uint8_t byte) {
+  uint64_t x = word ^ (kOnes * byte);
+  return (x - kOnes) & ~x & kHighBits;
+}
+
+// Checks 8 characters at a time, the words of ASCII characters which need no escaping are copied as is.
+inline bool IsPlainWord(uint64_t word, MarkupSerializer::EscapeMode mode) {
+  if (word & kHighBits)
+    return false;
+  switch (mode) {
+    case MarkupSerializer::EscapeMode::kNone:
+      return true;
+    case MarkupSerializer::EscapeMode::kText:
+      return !(MatchByte(word, '&') | MatchByte(word, '<') | MatchByte(word, '>'));
+    case MarkupSerializer::EscapeMode::kAttribute:
+      return !(MatchByte(word, '&') | MatchByte(word, '"'));
+  }
+  return false;
+}
+
+inline bool IsPlainCharacter(uint32_t character, MarkupSerializer::EscapeMode mode) {
+  if (character >= 0x80)
+    return false;
+  switch (mode) {
+    case MarkupSerializer::EscapeMode::kNone:
+      return true;
+    case MarkupSerializer::EscapeMode::kText:
+      return character != '&' && character != '<' && character != '>';
+    case MarkupSerializer::EscapeMode::kAttribute:
+      return character != '&' && character != '"';
+  }
+  return false;
+}
+
+}  // namespace
+
+void MarkupSerializer::SerializeElement(Element& element) {
+  result_.reserve(result_.size() + EstimateSubtreeLength(element));
+  AppendStartTag(element);
+  if (LocalNameIn(element, kVoidElements))
+    return;
+  AppendChildren(element);
+  AppendEndTag(element);
+}
+
+void MarkupSerializer::SerializeChildren(Element& element) {
+  size_t length = 0;
+  for (Node* child = ChildrenContainer(element)->firstChild(); child != nullptr; child = child->nextSibling())
+    length += EstimateSubtreeLength(*child);
+  result_.reserve(result_.size() + length);
+  AppendChildren(element);
+}
+
+AtomicString MarkupSerializer::TakeResult(JSContext* ctx) {
+  JSValue value = JS_NewStringLen(ctx, result_.data(), result_.size());
+  AtomicString result(ctx, value);
+  JS_FreeValue(ctx, value);
+  result_.clear();
+  return result;
+}
+
+size_t MarkupSerializer::EstimateSubtreeLength(Node& node) {
+  size_t length = 0;
+  std::vector<Element*> open_elements;
+  Node* current = &node;
+  while (true) {
+    if (auto* element = DynamicTo<Element>(current)) {
+      // <name></name>
+      length += element->localName().length() * 2 + 5;
+      if (element->attributes_ != nullptr) {
+        for (auto it = element->attributes_->begin(); it != element->attributes_->end(); ++it)
+          length += it->first.length() + it->second.length() + 4;
+      }
+      if (element->cssom_wrapper_ != nullptr) {
+        for (auto& property : element->cssom_wrapper_->properties_)
+          length += property.first.size() + property.second.length() + 3;
+      }
+      Node* first_child = ChildrenContainer(*element)->firstChild();
+      if (first_child != nullptr) {
+        open_elements.push_back(element);
+        current = first_child;
+        continue;
+      }
+    } else if (auto* text = DynamicTo<Text>(current)) {
+      length += text->data().length();
+    } else if (auto* comment = DynamicTo<Comment>(current)) {
+      length += comment->data().length() + 7;
+    }
+
+    // The siblings of the node itself are not part of the subtree.
+    while (!open_elements.empty() && current->nextSibling() == nullptr) {
+      current = open_elements.back();
+      open_elements.pop_back();
+    }
+    if (open_elements.empty())
+      return length;
+    current = current->nextSibling();
+  }
+}
+
+void MarkupSerializer::AppendChildren(Element& element) {
+  size_t base = open_elements_.size();
+  Node* node = ChildrenContainer(element)->firstChild();
+  while (node != nullptr) {
+    if (auto* child_element = DynamicTo<Element>(node)) {
+      AppendStartTag(*child_element);
+      bool is_void = LocalNameIn(*child_element, kVoidElements);
+      Node* first_child = is_void ? nullptr : ChildrenContainer(*child_element)->firstChild();
+      if (first_child != nullptr) {
+        open_elements_.push_back(child_element);
+        node = first_child;
+        continue;
+      }
+      if (!is_void)
+        AppendEndTag(*child_element);
+    } else if (auto* text = DynamicTo<Text>(node)) {
+      Element& parent = open_elements_.size() > base ? *open_elements_.back() : element;
+      AppendString(text->data(), LocalNameIn(parent, kRawTextElements) ? EscapeMode::kNone : EscapeMode::kText);
+    } else if (auto* comment = DynamicTo<Comment>(node)) {
+      result_ += "<!--";
+      AppendString(comment->data(), EscapeMode::kNone);
+      result_ += "-->";
+    }
+
+    // Close the elements whose last child is done.
+    while (node->nextSibling() == nullptr && open_elements_.size() > base) {
+      Element* parent = open_elements_.back();
+      open_elements_.pop_back();
+      AppendEndTag(*parent);
+      node = parent;
+    }
+    node = node->nextSibling();
+  }
+}
+
+void MarkupSerializer::AppendStartTag(Element& element) {
+  result_ += '<';
+  AppendString(element.localName(), EscapeMode::kNone);
+
+  // The inline style is serialized from the style declaration, which is newer than the style attribute.
+  bool has_inline_style = element.cssom_wrapper_ != nullptr && !element.cssom_wrapper_->properties_.empty();
+  if (element.attributes_ != nullptr) {
+    for (auto it = element.attributes_->begin(); it != element.attributes_->end(); ++it) {
+      if (element.cssom_wrapper_ != nullptr && it->first == html_names::kStyleAttr)
+        continue;
+      AppendAttribute(it->first, it->second);
+    }
+  }
+  if (has_inline_style) {
+    result_ += " style=\"";
+    for (auto& property : element.cssom_wrapper_->properties_) {
+      result_ += property.first;
+      result_ += ": ";
+      AppendString(property.second, EscapeMode::kAttribute);
+      result_ += ';';
+    }
+    result_ += '"';
+  }
+
+  result_ += '>';
+}
+
+void MarkupSerializer::AppendEndTag(Element& element) {
+  result_ += "</";
+  AppendString(element.localName(), EscapeMode::kNone);
+  result_ += '>';
+}
+
+void MarkupSerializer::AppendAttribute(const AtomicString& name, const AtomicString& value) {
+  result_ += ' ';
+  AppendString(name, EscapeMode::kNone);
+  result_ += "=\"";
+  AppendString(value, EscapeMode::kAttribute);
+  result_ += '"';
+}
+
+void MarkupSerializer::AppendString(const AtomicString& string, EscapeMode mode) {
+  if (string.IsEmpty())
+    return;
+  StringView view = string.ToStringView();
+  if (view.Is8Bit()) {
+    AppendLatin1(view.Characters8(), view.length(), mode);
+  } else {
+    AppendUTF16(view.Characters16(), view.length(), mode);
+  }
+}
+
+void MarkupSerializer::AppendLatin1(const char* characters, size_t length, EscapeMode mode) {
+  size_t i = 0;
+  while (i < length) {
+    size_t start = i;
+    uint64_t word;
+    while (i + sizeof(word) <= length) {
+      memcpy(&word, characters + i, sizeof(word));
+      if (!IsPlainWord(word, mode))
+        break;
+      i += sizeof(word);
+    }
+    while (i < length && IsPlainCharacter(static_cast<uint8_t>(characters[i]), mode))
+      i++;
+    result_.append(characters + start, i - start);
+    if (i < length) {
+      AppendCharacter(static_cast<uint8_t>(characters[i]), mode);
+      i++;
+    }
+  }
+}
+
+void MarkupSerializer::AppendUTF16(const char16_t* characters, size_t length, EscapeMode mode) {
+  for (size_t i = 0; i < length; i++) {
+    uint32_t character = characters[i];
+    if (IsPlainCharacter(character, mode)) {
+      result_ += static_cast<char>(character);
+      continue;
+    }
+    if (character >= 0xD800 && character <= 0xDBFF && i + 1 < length && characters[i + 1] >= 0xDC00 &&
+        characters[i + 1] <= 0xDFFF) {
+      character = 0x10000 + ((character - 0xD800) << 10) + (characters[i + 1] - 0xDC00);
+      i++;
+    }
+    AppendCharacter(character, mode);
+  }
+}
+
+void MarkupSerializer::AppendCharacter(uint32_t character, EscapeMode mode) {
+  if (mode != EscapeMode::kNone) {
+    switch (character) {
+      case '&':
+        result_ += "&amp;";
+        return;
+      case 0xA0:
+        result_ += "&nbsp;";
+        return;
+      case '<':
+      case '>':
+        if (mode == EscapeMode::kText) {
+          result_ += character == '<' ? "&lt;" : "&gt;";
+          return;
+        }
+        break;
+      case '"':
+        if (mode == EscapeMode::kAttribute) {
+          result_ += "&quot;";
+          return;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Lone surrogates are encoded as is, the same as JS_ToCStringLen.
+  if (character < 0x80) {
+    result_ += static_cast<char>(character);
+  } else if (character < 0x800) {
+    result_ += static_cast<char>(0xC0 | (character >> 6));
+    result_ += static_cast<char>(0x80 | (character & 0x3F));
+  } else if (character < 0x10000) {
+    result_ += static_cast<char>(0xE0 | (character >> 12));
+    result_ += static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+    result_ += static_cast<char>(0x80 | (character & 0x3F));
+  } else {
+    result_ += static_cast<char>(0xF0 | (character >> 18));
+    result_ += static_cast<char>(0x80 | ((character >> 12) & 0x3F));
+    result_ += static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+    result_ += static_cast<char>(0x80 | (character & 0x3F));
+  }
+}
+
+}  // namespace webf
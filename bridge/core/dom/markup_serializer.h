@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_CORE_DOM_MARKUP_SERIALIZER_H_
+#define BRIDGE_CORE_DOM_MARKUP_SERIALIZER_H_
+
+#include <string>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class Element;
+class Node;
+
+// Serializes the nodes as HTML into a single UTF-8 buffer, see
+// https://html.spec.whatwg.org/multipage/parsing.html#serialising-html-fragments
+//
+// The tree is walked without recursion and the strings are read from the atoms directly, so the cost is linear in the
+// size of the output whatever the depth of the tree is. The buffer is reserved from the lengths of the names and the
+// data in the subtree up front, and turned into a string once at the end.
+class MarkupSerializer {
+ public:
+  enum class EscapeMode { kText, kAttribute, kNone };
+
+  // Appends the element with its start and end tags.
+  void SerializeElement(Element& element);
+  // Appends the children of the element, the content of a template element is used for templates.
+  void SerializeChildren(Element& element);
+
+  AtomicString TakeResult(JSContext* ctx);
+
+ private:
+  // Returns the length of the markup of the subtree without the escaping, which is what most trees serialize to.
+  size_t EstimateSubtreeLength(Node& node);
+  void AppendChildren(Element& element);
+  void AppendStartTag(Element& element);
+  void AppendEndTag(Element& element);
+  void AppendAttribute(const AtomicString& name, const AtomicString& value);
+  void AppendString(const AtomicString& string, EscapeMode mode);
+  void AppendLatin1(const char* characters, size_t length, EscapeMode mode);
+  void AppendUTF16(const char16_t* characters, size_t length, EscapeMode mode);
+  void AppendCharacter(uint32_t character, EscapeMode mode);
+
+  std::string result_;
+  std::vector<Element*> open_elements_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_MARKUP_SERIALIZER_H_
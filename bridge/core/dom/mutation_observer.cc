@@ -42,65 +42,52 @@
 
 namespace webf {
 
-class MutationObserverAgent;
-
 static unsigned g_observer_priority = 0;
-static thread_local std::unordered_map<ExecutingContext*, std::shared_ptr<MutationObserverAgent>> agent_map_;
-
-class MutationObserverAgent {
- public:
-  MutationObserverAgent() = delete;
-  explicit MutationObserverAgent(ExecutingContext* context) : context_(context){};
-
-  static std::shared_ptr<MutationObserverAgent> From(ExecutingContext* context) {
-    if (agent_map_.count(context) == 0) {
-      agent_map_[context] = std::make_shared<MutationObserverAgent>(context);
-    }
-    return agent_map_[context];
-  }
 
-  void ActivateObserver(MutationObserver* observer) {
-    if (!isContextValid(context_->contextId()))
-      return;
+void MutationObserverAgent::ActivateObserver(MutationObserver* observer) {
+  if (!isContextValid(context_->contextId()) || observer->is_active_)
+    return;
 
-    EnsureEnqueueMicrotask();
-    active_mutation_observers_.insert(observer);
-  }
+  EnsureEnqueueMicrotask();
+  if (!active_mutation_observers_.empty() && active_mutation_observers_.back()->priority_ > observer->priority_)
+    active_mutation_observers_sorted_ = false;
+  observer->is_active_ = true;
+  active_mutation_observers_.emplace_back(observer);
+}
 
- private:
-  void DeliverMutations() {
-    MemberMutationScope scopes{context_};
-    // These steps are defined in DOM Standard's "notify mutation observers".
-    // https://dom.spec.whatwg.org/#notify-mutation-observers
-    MutationObserverVector observers(active_mutation_observers_.begin(), active_mutation_observers_.end());
-    active_mutation_observers_.clear();
+void MutationObserverAgent::DeliverMutations() {
+  MemberMutationScope scopes{context_};
+  // These steps are defined in DOM Standard's "notify mutation observers".
+  // https://dom.spec.whatwg.org/#notify-mutation-observers
+  MutationObserverVector observers;
+  observers.swap(active_mutation_observers_);
+  if (!active_mutation_observers_sorted_) {
     std::sort(observers.begin(), observers.end(), MutationObserver::ObserverLessThan());
-    for (const auto& observer : observers)
-      observer->Deliver();
+    active_mutation_observers_sorted_ = true;
   }
+  // Observers activated by the callbacks are delivered in the next microtask.
+  for (const auto& observer : observers)
+    observer->is_active_ = false;
+  for (const auto& observer : observers)
+    observer->Deliver();
+}
 
-  void EnsureEnqueueMicrotask() {
-    if (active_mutation_observers_.empty() && context_->IsContextValid()) {
-      context_->EnqueueMicrotask(
-          [](void* p) {
-            auto* agent = static_cast<MutationObserverAgent*>(p);
-            agent->DeliverMutations();
-          },
-          this);
-    }
+void MutationObserverAgent::EnsureEnqueueMicrotask() {
+  if (active_mutation_observers_.empty() && context_->IsContextValid()) {
+    context_->EnqueueMicrotask(
+        [](void* p) {
+          auto* agent = static_cast<MutationObserverAgent*>(p);
+          agent->DeliverMutations();
+        },
+        this);
   }
-
-  MutationObserverSet active_mutation_observers_;
-  ExecutingContext* context_;
-};
+}
 
 static void ActivateObserver(MutationObserver* observer) {
   if (!observer->GetExecutingContext())
     return;
 
-  ExecutingContext* context = observer->GetExecutingContext();
-  auto agent = MutationObserverAgent::From(context);
-  agent->ActivateObserver(observer);
+  observer->GetExecutingContext()->mutationObserverAgent()->ActivateObserver(observer);
 }
 
 MutationObserver* MutationObserver::Create(ExecutingContext* context,
@@ -246,6 +233,11 @@ void MutationObserver::Deliver() {
 
   JS_FreeValue(ctx(), v);
   function_->Invoke(ctx(), ToValue(), 2, arguments);
+
+  // Hand the storage back for the records of the next delivery, unless the callback caused new ones.
+  records.clear();
+  if (records_.empty())
+    swap(records_, records);
 }
 
 void MutationObserver::SetHasTransientRegistration() {
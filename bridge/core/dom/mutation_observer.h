@@ -96,10 +96,33 @@ class MutationObserver final : public ScriptWrappable {
   void Trace(webf::GCVisitor* visitor) const override;
 
  private:
+  friend class MutationObserverAgent;
+
   MutationRecordVector records_;
   MutationObserverRegistrationSet registrations_;
   std::shared_ptr<QJSFunction> function_;
   unsigned priority_;
+  // Whether the observer is waiting in the MutationObserverAgent for the delivery.
+  bool is_active_{false};
+};
+
+// Notifies the observers of a context which have pending records in a microtask, owned by the ExecutingContext.
+// https://dom.spec.whatwg.org/#notify-mutation-observers
+class MutationObserverAgent {
+ public:
+  explicit MutationObserverAgent(ExecutingContext* context) : context_(context) {}
+
+  void ActivateObserver(MutationObserver* observer);
+
+ private:
+  void DeliverMutations();
+  void EnsureEnqueueMicrotask();
+
+  // Each observer appears once. Observers are mostly activated in the creation order, so the vector is only sorted
+  // when an older observer is activated after a newer one.
+  MutationObserverVector active_mutation_observers_;
+  bool active_mutation_observers_sorted_{true};
+  ExecutingContext* context_;
 };
 
 }  // namespace webf
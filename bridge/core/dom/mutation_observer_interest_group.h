@@ -43,10 +43,12 @@ namespace webf {
 
 class Node;
 
+// The observers interested in a mutation of a node. The Create functions return nullptr without walking the ancestors
+// when no registration covers the node, so writes outside of the observed subtrees stay cheap.
 class MutationObserverInterestGroup {
  public:
   static std::shared_ptr<MutationObserverInterestGroup> CreateForChildListMutation(Node& target) {
-    if (!target.GetDocument().HasMutationObserversOfType(kMutationTypeChildList))
+    if (!(target.MutationObserverTypesOfInterest() & kMutationTypeChildList))
       return nullptr;
 
     MutationRecordDeliveryOptions old_value_flag = 0;
@@ -54,7 +56,7 @@ class MutationObserverInterestGroup {
   }
 
   static std::shared_ptr<MutationObserverInterestGroup> CreateForCharacterDataMutation(Node& target) {
-    if (!target.GetDocument().HasMutationObserversOfType(kMutationTypeCharacterData))
+    if (!(target.MutationObserverTypesOfInterest() & kMutationTypeCharacterData))
       return nullptr;
 
     return CreateIfNeeded(target, kMutationTypeCharacterData, MutationObserver::kCharacterDataOldValue);
@@ -63,7 +65,7 @@ class MutationObserverInterestGroup {
   static std::shared_ptr<MutationObserverInterestGroup> CreateForAttributesMutation(
       Node& target,
       const AtomicString& attribute_name) {
-    if (!target.GetDocument().HasMutationObserversOfType(kMutationTypeAttributes))
+    if (!(target.MutationObserverTypesOfInterest() & kMutationTypeAttributes))
       return nullptr;
 
     return CreateIfNeeded(target, kMutationTypeAttributes, MutationObserver::kAttributeOldValue, &attribute_name);
@@ -30,6 +30,7 @@
  */
 
 #include "node.h"
+#include <algorithm>
 #include <unordered_map>
 #include "character_data.h"
 #include "child_list_mutation_scope.h"
@@ -116,18 +117,82 @@ static inline void CollectMatchingObserversForMutation(MutationObserverOptionsMa
       MutationRecordDeliveryOptions delivery_options = registration->DeliveryOptions();
       MutationObserver* ob = registration->Observer();
 
-      bool inserted = false;
-      auto position = observers.end();
-      std::tie(position, inserted) = observers.insert(std::make_pair(ob, delivery_options));
-      if (inserted) {
+      auto position = std::find_if(observers.begin(), observers.end(),
+                                   [ob](const auto& entry) { return entry.first == ob; });
+      if (position != observers.end()) {
         position->second |= delivery_options;
       } else {
-        position->second = delivery_options;
+        observers.emplace_back(ob, delivery_options);
       }
     }
   }
 }
 
+void Node::InvalidateMutationObserverTypesInSubtree() {
+  // The caches are filled from a node up to its nearest cached ancestor, so a node without a valid cache has no cached
+  // descendants and its subtree is skipped.
+  uint32_t version = GetDocument().MutationObserverVersion();
+  Node* node = this;
+  while (node) {
+    NodeData* data = node->Data();
+    if (data == nullptr || data->CachedMutationObserverTypes().version != version) {
+      node = NodeTraversal::NextSkippingChildren(*node, this);
+      continue;
+    }
+    data->CachedMutationObserverTypes().version = 0;
+    node = NodeTraversal::Next(*node, this);
+  }
+}
+
+MutationObserverOptions Node::MutationObserverTypesOfInterest() {
+  Document& document = GetDocument();
+  if (!document.HasMutationObservers())
+    return 0;
+
+  uint32_t version = document.MutationObserverVersion();
+  NodeData::MutationObserverTypes& types = EnsureNodeData().CachedMutationObserverTypes();
+  if (types.version == version)
+    return types.self;
+
+  // Collect the ancestors with stale caches up to the nearest valid one, then fill the caches from top to bottom.
+  std::vector<Node*> stale_nodes{this};
+  MutationObserverOptions inherited = 0;
+  for (Node* node = parentNode(); node; node = node->parentNode()) {
+    NodeData::MutationObserverTypes& cached = node->EnsureNodeData().CachedMutationObserverTypes();
+    if (cached.version == version) {
+      inherited = cached.subtree;
+      break;
+    }
+    stale_nodes.push_back(node);
+  }
+
+  for (auto it = stale_nodes.rbegin(); it != stale_nodes.rend(); ++it) {
+    Node* node = *it;
+    MutationObserverOptions self = 0;
+    MutationObserverOptions subtree = 0;
+    if (const MutationObserverRegistrationVector* registry = node->MutationObserverRegistry()) {
+      for (const auto& registration : *registry) {
+        self |= registration->MutationTypes();
+        if (registration->IsSubtree())
+          subtree |= registration->MutationTypes();
+      }
+    }
+    // Transient registrations are always created from subtree registrations.
+    if (const MutationObserverRegistrationSet* transient_registry = node->TransientMutationObserverRegistry()) {
+      for (const auto& registration : *transient_registry)
+        subtree |= registration->MutationTypes();
+    }
+
+    NodeData::MutationObserverTypes& cached = node->Data()->CachedMutationObserverTypes();
+    cached.version = version;
+    cached.self = self | subtree | inherited;
+    cached.subtree = subtree | inherited;
+    inherited = cached.subtree;
+  }
+
+  return types.self;
+}
+
 void Node::GetRegisteredMutationObserversOfType(MutationObserverOptionsMap& observers,
                                                 MutationType type,
                                                 const AtomicString* attribute_name) {
@@ -161,6 +226,7 @@ void Node::RegisterMutationObserver(MutationObserver& observer,
   }
 
   GetDocument().AddMutationObserverTypes(registration->MutationTypes());
+  GetDocument().InvalidateMutationObserverTypes();
 }
 
 void Node::UnregisterMutationObserver(MutationObserverRegistration* registration) {
@@ -171,10 +237,12 @@ void Node::UnregisterMutationObserver(MutationObserverRegistration* registration
 
   registration->Dispose();
   EnsureNodeData().EnsureMutationObserverData().RemoveRegistration(registration);
+  GetDocument().InvalidateMutationObserverTypes();
 }
 
 void Node::RegisterTransientMutationObserver(MutationObserverRegistration* registration) {
   EnsureNodeData().EnsureMutationObserverData().AddTransientRegistration(registration);
+  InvalidateMutationObserverTypesInSubtree();
 }
 
 void Node::UnregisterTransientMutationObserver(MutationObserverRegistration* registration) {
@@ -184,6 +252,7 @@ void Node::UnregisterTransientMutationObserver(MutationObserverRegistration* reg
     return;
 
   EnsureNodeData().EnsureMutationObserverData().RemoveTransientRegistration(registration);
+  InvalidateMutationObserverTypesInSubtree();
 }
 
 void Node::NotifyMutationObserversNodeWillDetach() {
@@ -204,6 +273,37 @@ void Node::NotifyMutationObserversNodeWillDetach() {
   }
 }
 
+void Node::SetNeedsStyleRecalc() {
+  SetFlag(kNeedsStyleRecalcFlag);
+  for (Node* ancestor = parentNode(); ancestor && !ancestor->ChildNeedsStyleRecalc(); ancestor = ancestor->parentNode())
+    ancestor->SetFlag(kChildNeedsStyleRecalcFlag);
+}
+
+void Node::TakeStyleDirtyRoots(std::vector<Node*>& roots) {
+  if (NeedsStyleRecalc()) {
+    roots.push_back(this);
+    ClearStyleDirtyBits();
+    return;
+  }
+  if (!ChildNeedsStyleRecalc())
+    return;
+
+  ClearFlag(kChildNeedsStyleRecalcFlag);
+  for (Node* child = firstChild(); child; child = child->nextSibling())
+    child->TakeStyleDirtyRoots(roots);
+}
+
+// The descendants are covered by the dirty root, only the bits need to be cleared.
+void Node::ClearStyleDirtyBits() {
+  bool child_needs_style_recalc = ChildNeedsStyleRecalc();
+  ClearFlag(kNeedsStyleRecalcFlag);
+  ClearFlag(kChildNeedsStyleRecalcFlag);
+  if (!child_needs_style_recalc)
+    return;
+  for (Node* child = firstChild(); child; child = child->nextSibling())
+    child->ClearStyleDirtyBits();
+}
+
 NodeData& Node::CreateNodeData() {
   node_data_ = std::make_unique<NodeData>();
   SetFlag(kHasDataFlag);
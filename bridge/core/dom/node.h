@@ -19,7 +19,8 @@
 
 namespace webf {
 
-using MutationObserverOptionsMap = std::unordered_map<MutationObserver*, MutationRecordDeliveryOptions>;
+// Observers of a mutation with their delivery options, there are only a few of them so a vector is cheaper than a map.
+using MutationObserverOptionsMap = std::vector<std::pair<MutationObserver*, MutationRecordDeliveryOptions>>;
 
 const int kDOMNodeTypeShift = 2;
 const int kElementNamespaceTypeShift = 4;
@@ -50,6 +51,7 @@ enum class CloneChildrenFlag { kSkip, kClone, kCloneWithShadows };
 // https://dom.spec.whatwg.org/#interface-node
 class Node : public EventTarget {
   DEFINE_WRAPPERTYPEINFO();
+  WEBF_SLAB_ALLOCATED();
   friend class TreeScope;
 
  public:
@@ -234,10 +236,27 @@ class Node : public EventTarget {
   void SetHasDuplicateAttributes() { SetFlag(kHasDuplicateAttributes); }
   [[nodiscard]] bool HasDuplicateAttribute() const { return GetFlag(kHasDuplicateAttributes); }
 
+  // Style dirty bits. A node needs style recalc when its attributes changed or when it was inserted, its ancestors are
+  // marked with ChildNeedsStyleRecalc. Inline style changes don't change the matched rules and are applied by dart side
+  // as they arrive. The topmost dirty nodes are sent to dart side with the UI commands, so the style recalc could be
+  // limited to the changed subtrees.
+  [[nodiscard]] bool NeedsStyleRecalc() const { return GetFlag(kNeedsStyleRecalcFlag); }
+  [[nodiscard]] bool ChildNeedsStyleRecalc() const { return GetFlag(kChildNeedsStyleRecalcFlag); }
+  void SetNeedsStyleRecalc();
+  // Appends the topmost dirty nodes of the subtree to |roots| and clears the dirty bits of the subtree.
+  void TakeStyleDirtyRoots(std::vector<Node*>& roots);
+
   [[nodiscard]] bool SelfOrAncestorHasDirAutoAttribute() const { return GetFlag(kSelfOrAncestorHasDirAutoAttribute); }
   void SetSelfOrAncestorHasDirAutoAttribute() { SetFlag(kSelfOrAncestorHasDirAutoAttribute); }
   void ClearSelfOrAncestorHasDirAutoAttribute() { ClearFlag(kSelfOrAncestorHasDirAutoAttribute); }
 
+  // The mutation types any observer could be interested in for this node, which is the union of the registrations of
+  // the node and the subtree registrations of its ancestors. It is cached in NodeData, so that a mutation nobody
+  // observes doesn't walk the ancestors.
+  MutationObserverOptions MutationObserverTypesOfInterest();
+  // Drops the mutation types cached for this node and its descendants, which are inherited from the ancestors and go
+  // stale when the node is moved.
+  void InvalidateMutationObserverTypesInSubtree();
   void GetRegisteredMutationObserversOfType(MutationObserverOptionsMap&,
                                             MutationType,
                                             const AtomicString* attribute_name);
@@ -276,6 +295,10 @@ class Node : public EventTarget {
     // Set by the parser when the children are done parsing.
     kIsFinishedParsingChildrenFlag = 1 << 10,
 
+    // Style dirty bits, see NeedsStyleRecalc().
+    kChildNeedsStyleRecalcFlag = 1 << 12,
+    kNeedsStyleRecalcFlag = 1 << kNodeStyleChangeShift,
+
     kCustomElementStateMask = 0x7 << kNodeCustomElementShift,
     kHasNameOrIsEditingTextFlag = 1 << 20,
     kHasEventTargetDataFlag = 1 << 21,
@@ -345,6 +368,8 @@ class Node : public EventTarget {
   ~Node();
 
  private:
+  void ClearStyleDirtyBits();
+
   uint32_t node_flags_;
   Member<Node> parent_or_shadow_host_node_;
   Member<Node> previous_;
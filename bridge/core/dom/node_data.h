@@ -63,11 +63,22 @@ class NodeData {
 
   EmptyNodeList* EnsureEmptyChildNodeList(Node& node);
 
+  // The mutation types observed for this node and the ones passed down to its descendants by subtree observations,
+  // see Node::MutationObserverTypesOfInterest. Valid while |version| matches Document::MutationObserverVersion(),
+  // a cached node always has cached ancestors.
+  struct MutationObserverTypes {
+    uint32_t version{0};
+    MutationObserverOptions self{0};
+    MutationObserverOptions subtree{0};
+  };
+  MutationObserverTypes& CachedMutationObserverTypes() { return mutation_observer_types_; }
+
   void Trace(GCVisitor* visitor) const;
 
  private:
   Member<NodeList> node_list_;
   std::shared_ptr<NodeMutationObserverData> mutation_observer_data_;
+  MutationObserverTypes mutation_observer_types_;
 };
 
 }  // namespace webf
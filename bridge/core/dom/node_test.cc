@@ -3,6 +3,9 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include "core/dom/document.h"
+#include "core/dom/node_data.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 
@@ -74,6 +77,91 @@ Promise.resolve().then(() => {
   EXPECT_EQ(logCalled, true);
 }
 
+TEST(Node, MutationObserverOnlyObservesRegisteredSubtrees) {
+  bool static errorCalled = false;
+  static std::string logs;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logs += message + ";";
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->executingContext();
+  const char* code = R"(
+const observed = document.createElement('div');
+const other = document.createElement('div');
+const child = document.createElement('span');
+document.body.appendChild(observed);
+document.body.appendChild(other);
+other.appendChild(child);
+
+const first = new MutationObserver((records) => console.log('first', records.map(r => r.attributeName).join(',')));
+const second = new MutationObserver((records) => console.log('second', records.length, records[0].oldValue));
+second.observe(observed, { attributes: true, subtree: true, attributeOldValue: true });
+first.observe(observed, { attributes: true, subtree: true });
+
+child.setAttribute('id', 'outside');
+observed.appendChild(child);
+child.setAttribute('id', 'inside');
+observed.setAttribute('class', 'a');
+Promise.resolve().then(() => {
+  other.appendChild(child);
+  child.setAttribute('id', 'outside again');
+  first.disconnect();
+  observed.setAttribute('class', 'b');
+});
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  TEST_runLoop(context);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logs, "first id,class;second 2 outside;second 1 a;");
+}
+
+TEST(Node, MutationObserverFollowsMovedSubtrees) {
+  bool static errorCalled = false;
+  static std::string logs;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logs += message + ";";
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->executingContext();
+  const char* code = R"(
+const observed = document.createElement('div');
+const other = document.createElement('div');
+const wrapper = document.createElement('div');
+const inner = document.createElement('span');
+document.body.appendChild(observed);
+document.body.appendChild(other);
+document.body.appendChild(wrapper);
+wrapper.appendChild(inner);
+
+const observer = new MutationObserver((records) => console.log(records.map(r => r.oldValue).join(',')));
+observer.observe(observed, { attributes: true, subtree: true, attributeOldValue: true });
+
+inner.setAttribute('id', '1');
+observed.appendChild(wrapper);
+inner.setAttribute('id', '2');
+other.appendChild(document.createElement('p'));
+inner.setAttribute('id', '3');
+document.body.appendChild(wrapper);
+inner.setAttribute('id', '4');
+observed.appendChild(wrapper);
+wrapper.setAttribute('class', 'w');
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  TEST_runLoop(context);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logs, "1,2,null;");
+
+  // Moving a node outside of the observed subtree keeps the cached types of the observed one.
+  Document* document = context->document();
+  Node* observed = document->body()->firstChild();
+  observed->MutationObserverTypesOfInterest();
+  const char* append = "other.appendChild(document.createElement('p'));";
+  env->page()->evaluateScript(append, strlen(append), "vm://", 0);
+  EXPECT_EQ(observed->Data()->CachedMutationObserverTypes().version, document->MutationObserverVersion());
+}
+
 TEST(Node, nodeName) {
   bool static errorCalled = false;
   bool static logCalled = false;
@@ -367,4 +455,46 @@ console.assert(el.isConnected == false);
 
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, false);
-}
\ No newline at end of file
+}
+
+TEST(Node, styleDirtyRootsAreTheTopmostChangedNodes) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->executingContext();
+  const char* code = R"(
+const outer = document.createElement('div');
+const inner = document.createElement('span');
+const other = document.createElement('p');
+outer.appendChild(inner);
+document.body.appendChild(outer);
+document.body.appendChild(other);
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  TEST_takeStyleDirtyRoots(context);
+
+  Node* other = context->document()->body()->lastChild();
+  Node* outer = other->previousSibling();
+
+  const char* update = R"(
+inner.setAttribute('class', 'b');
+other.setAttribute('class', 'a');
+outer.setAttribute('id', 'outer');
+document.createElement('div').setAttribute('class', 'c');
+)";
+  env->page()->evaluateScript(update, strlen(update), "vm://", 0);
+  // The roots lead the batch, ahead of the attribute commands whose style recalc they stand for.
+  std::vector<UICommandItem*> items = TEST_getUICommandItems(context);
+  ASSERT_FALSE(items.empty());
+  EXPECT_EQ(items.front()->type, (int32_t)UICommand::kStyleDirtyRoots);
+  EXPECT_EQ(items.back()->type, (int32_t)UICommand::kFinishRecordingCommand);
+  std::vector<int64_t> roots = TEST_takeStyleDirtyRoots(context);
+  ASSERT_EQ(roots.size(), 2);
+  EXPECT_EQ(roots[0], reinterpret_cast<int64_t>(outer->bindingObject()));
+  EXPECT_EQ(roots[1], reinterpret_cast<int64_t>(other->bindingObject()));
+
+  // The dirty bits are cleared once the roots are published.
+  EXPECT_FALSE(outer->NeedsStyleRecalc());
+  EXPECT_FALSE(outer->firstChild()->NeedsStyleRecalc());
+  EXPECT_FALSE(context->document()->ChildNeedsStyleRecalc());
+  EXPECT_EQ(errorCalled, false);
+}
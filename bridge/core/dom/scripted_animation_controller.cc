@@ -29,10 +29,14 @@ static void handleRAFTransientCallback(void* ptr, double contextId, double highR
   }
 
   context->dartIsolateContext()->profiler()->StartTrackAsyncEvaluation();
-  context->dartIsolateContext()->profiler()->StartTrackSteps("handleRAFTransientCallback");
+  context->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kHandleRAFTransientCallback);
 
   assert(frame_callback->status() == FrameCallback::FrameStatus::kPending);
 
+  if (auto* recorder = context->replayRecorder()) {
+    recorder->RecordAnimationFrame(frame_callback->scheduledCallbackId(), highResTimeStamp);
+  }
+
   frame_callback->SetStatus(FrameCallback::FrameStatus::kExecuting);
 
   // Trigger callbacks.
@@ -63,36 +63,36 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
   JS_SetContextOpaque(ctx, this);
   JS_SetHostPromiseRejectionTracker(script_state_.runtime(), promiseRejectTracker, nullptr);
 
-  dart_isolate_context->profiler()->StartTrackSteps("ExecutingContext::InstallBindings");
+  dart_isolate_context->profiler()->StartTrackSteps(TraceLabel::kInstallBindings);
 
   // Register all built-in native bindings.
   InstallBindings(this);
 
   dart_isolate_context->profiler()->FinishTrackSteps();
-  dart_isolate_context->profiler()->StartTrackSteps("ExecutingContext::InstallDocument");
+  dart_isolate_context->profiler()->StartTrackSteps(TraceLabel::kInstallDocument);
 
   // Install document.
   InstallDocument();
 
   dart_isolate_context->profiler()->FinishTrackSteps();
-  dart_isolate_context->profiler()->StartTrackSteps("ExecutingContext::InstallGlobal");
+  dart_isolate_context->profiler()->StartTrackSteps(TraceLabel::kInstallGlobal);
 
   // Binding global object and window.
   InstallGlobal();
 
   dart_isolate_context->profiler()->FinishTrackSteps();
-  dart_isolate_context->profiler()->StartTrackSteps("ExecutingContext::InstallPerformance");
+  dart_isolate_context->profiler()->StartTrackSteps(TraceLabel::kInstallPerformance);
 
   // Install performance
   InstallPerformance();
 
   dart_isolate_context->profiler()->FinishTrackSteps();
-  dart_isolate_context->profiler()->StartTrackSteps("ExecutingContext::initWebFPolyFill");
+  dart_isolate_context->profiler()->StartTrackSteps(TraceLabel::kInitWebFPolyFill);
 
   initWebFPolyFill(this);
 
   dart_isolate_context->profiler()->FinishTrackSteps();
-  dart_isolate_context->profiler()->StartTrackSteps("ExecutingContext::InitializePlugin");
+  dart_isolate_context->profiler()->StartTrackSteps(TraceLabel::kInitializePlugin);
 
   for (auto& p : plugin_byte_code) {
     EvaluateByteCode(p.second.bytes, p.second.length);
@@ -140,17 +140,17 @@ bool ExecutingContext::EvaluateJavaScript(const char* code,
   if (ScriptForbiddenScope::IsScriptForbidden()) {
     return false;
   }
-  dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::EvaluateJavaScript");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kEvaluateJavaScript);
 
   JSValue result;
   if (parsed_bytecodes == nullptr) {
-    dart_isolate_context_->profiler()->StartTrackSteps("JS_Eval");
+    dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSEval);
 
     result = JS_Eval(script_state_.ctx(), code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL);
 
     dart_isolate_context_->profiler()->FinishTrackSteps();
   } else {
-    dart_isolate_context_->profiler()->StartTrackSteps("JS_Eval");
+    dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSEval);
 
     JSValue byte_object =
         JS_Eval(script_state_.ctx(), code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
@@ -163,13 +163,13 @@ bool ExecutingContext::EvaluateJavaScript(const char* code,
       return false;
     }
 
-    dart_isolate_context_->profiler()->StartTrackSteps("JS_Eval");
+    dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSEval);
     size_t len;
     *parsed_bytecodes = JS_WriteObject(script_state_.ctx(), &len, byte_object, JS_WRITE_OBJ_BYTECODE);
     *bytecode_len = len;
 
     dart_isolate_context_->profiler()->FinishTrackSteps();
-    dart_isolate_context_->profiler()->StartTrackSteps("JS_EvalFunction");
+    dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSEvalFunction);
 
     result = JS_EvalFunction(script_state_.ctx(), byte_object);
 
@@ -203,11 +203,11 @@ bool ExecutingContext::EvaluateJavaScript(const char* code, size_t codeLength, c
 }
 
 bool ExecutingContext::EvaluateByteCode(uint8_t* bytes, size_t byteLength) {
-  dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::EvaluateByteCode");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kEvaluateByteCode);
 
   JSValue obj, val;
 
-  dart_isolate_context_->profiler()->StartTrackSteps("JS_EvalFunction");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSEvalFunction);
 
   obj = JS_ReadObject(script_state_.ctx(), bytes, byteLength, JS_READ_OBJ_BYTECODE);
 
@@ -218,7 +218,7 @@ bool ExecutingContext::EvaluateByteCode(uint8_t* bytes, size_t byteLength) {
     return false;
   }
 
-  dart_isolate_context_->profiler()->StartTrackSteps("JS_EvalFunction");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSEvalFunction);
 
   val = JS_EvalFunction(script_state_.ctx(), obj);
 
@@ -323,7 +323,7 @@ void ExecutingContext::ReportError(JSValueConst error) {
 }
 
 void ExecutingContext::DrainMicrotasks() {
-  dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::DrainMicrotasks");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kDrainMicrotasks);
 
   DrainPendingPromiseJobs();
 
@@ -368,14 +368,14 @@ void ExecutingContext::DrainPendingPromiseJobs() {
   // should executing pending promise jobs.
   JSContext* pctx;
 
-  dart_isolate_context_->profiler()->StartTrackSteps("JS_ExecutePendingJob");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSExecutePendingJob);
 
   int finished = JS_ExecutePendingJob(script_state_.runtime(), &pctx);
 
   dart_isolate_context_->profiler()->FinishTrackSteps();
 
   while (finished != 0) {
-    dart_isolate_context_->profiler()->StartTrackSteps("JS_ExecutePendingJob");
+    dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSExecutePendingJob);
     finished = JS_ExecutePendingJob(script_state_.runtime(), &pctx);
     dart_isolate_context_->profiler()->FinishTrackSteps();
     if (finished == -1) {
@@ -401,7 +401,7 @@ uint8_t* ExecutingContext::DumpByteCode(const char* code,
                                         uint32_t codeLength,
                                         const char* sourceURL,
                                         uint64_t* bytecodeLength) {
-  dart_isolate_context_->profiler()->StartTrackSteps("JS_Eval");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSEval);
 
   JSValue object =
       JS_Eval(script_state_.ctx(), code, codeLength, sourceURL, JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
@@ -412,7 +412,7 @@ uint8_t* ExecutingContext::DumpByteCode(const char* code,
   if (!success)
     return nullptr;
 
-  dart_isolate_context_->profiler()->StartTrackSteps("JS_WriteObject");
+  dart_isolate_context_->profiler()->StartTrackSteps(TraceLabel::kJSWriteObject);
 
   size_t len;
   uint8_t* bytes = JS_WriteObject(script_state_.ctx(), &len, object, JS_WRITE_OBJ_BYTECODE);
@@ -451,6 +451,42 @@ static void DispatchPromiseRejectionEvent(const AtomicString& event_type,
   }
 }
 
+MutationObserverAgent* ExecutingContext::mutationObserverAgent() {
+  if (mutation_observer_agent_ == nullptr)
+    mutation_observer_agent_ = std::make_unique<MutationObserverAgent>(this);
+  return mutation_observer_agent_.get();
+}
+
+int64_t* ExecutingContext::TakeStyleDirtyRoots() {
+  if (document_ == nullptr || !document_->ChildNeedsStyleRecalc())
+    return nullptr;
+
+  std::vector<Node*> roots;
+  document_->TakeStyleDirtyRoots(roots);
+  if (roots.empty())
+    return nullptr;
+
+  auto* payload = static_cast<int64_t*>(malloc(sizeof(int64_t) * (roots.size() + 1)));
+  payload[0] = static_cast<int64_t>(roots.size());
+  for (size_t i = 0; i < roots.size(); i++) {
+    payload[i + 1] = reinterpret_cast<int64_t>(roots[i]->bindingObject());
+  }
+  return payload;
+}
+
+bool ExecutingContext::StartReplayRecording(const std::string& path) {
+  auto recorder = std::make_unique<ReplayRecorder>(this);
+  if (!recorder->Open(path))
+    return false;
+  recorder->RecordStart(replay_ids_);
+  replay_recorder_ = std::move(recorder);
+  return true;
+}
+
+void ExecutingContext::StopReplayRecording() {
+  replay_recorder_ = nullptr;
+}
+
 void ExecutingContext::FlushUICommand(const BindingObject* self, uint32_t reason) {
   std::vector<NativeBindingObject*> deps;
   FlushUICommand(self, reason, deps);
@@ -460,8 +496,8 @@ void ExecutingContext::FlushUICommand(const webf::BindingObject* self,
                                       uint32_t reason,
                                       std::vector<NativeBindingObject*>& deps) {
   if (!uiCommandBuffer()->empty()) {
+    bool should_swap_ui_commands = false;
     if (is_dedicated_) {
-      bool should_swap_ui_commands = false;
       if (isUICommandReasonDependsOnElement(reason)) {
         bool element_mounted_on_dart = self->bindingObject()->invoke_bindings_methods_from_native != nullptr;
         bool is_deps_elements_mounted_on_dart = true;
@@ -481,12 +517,18 @@ void ExecutingContext::FlushUICommand(const webf::BindingObject* self,
         should_swap_ui_commands = true;
       }
 
+      if (reason != FlushUICommandReason::kStandard && ui_command_buffer_.HasPendingPropertySets()) {
+        should_swap_ui_commands = true;
+      }
+
       // Sync commands to dart when caller dependents on Element.
       if (should_swap_ui_commands) {
         ui_command_buffer_.SyncToActive();
       }
     }
 
+    metrics_.RecordFlushUICommand(reason, should_swap_ui_commands);
+
     dartMethodPtr()->flushUICommand(is_dedicated_, context_id_, self->bindingObject());
   }
 }
@@ -26,6 +26,10 @@
 #include "dart_isolate_context.h"
 #include "dart_methods.h"
 #include "executing_context_data.h"
+#include "idle_gc_scheduler.h"
+#include "layout_query_cache.h"
+#include "page_metrics.h"
+#include "replay_recorder.h"
 #include "frame/dom_timer_coordinator.h"
 #include "frame/module_context_coordinator.h"
 #include "frame/module_listener_container.h"
@@ -48,6 +52,7 @@ class MemberMutationScope;
 class ErrorEvent;
 class DartContext;
 class MutationObserver;
+class MutationObserverAgent;
 class BindingObject;
 struct NativeBindingObject;
 class ScriptWrappable;
@@ -132,6 +137,21 @@ class ExecutingContext {
   FORCE_INLINE DartIsolateContext* dartIsolateContext() const { return dart_isolate_context_; };
   FORCE_INLINE Performance* performance() const { return performance_; }
   FORCE_INLINE SharedUICommand* uiCommandBuffer() { return &ui_command_buffer_; };
+  FORCE_INLINE IdleGCScheduler* idleGCScheduler() { return &idle_gc_scheduler_; };
+  FORCE_INLINE PageMetrics* metrics() { return &metrics_; };
+  FORCE_INLINE LayoutQueryCache* layoutQueryCache() { return &layout_query_cache_; };
+  MutationObserverAgent* mutationObserverAgent();
+  // Returns the payload of UICommand::kStyleDirtyRoots and clears the style dirty bits of the document, nullptr when
+  // no style changed since the last call.
+  int64_t* TakeStyleDirtyRoots();
+  // Returns nullptr unless the inputs of the page are being recorded.
+  FORCE_INLINE ReplayRecorder* replayRecorder() const { return replay_recorder_.get(); }
+  bool StartReplayRecording(const std::string& path);
+  void StopReplayRecording();
+  FORCE_INLINE const ReplayIds& replayIds() const { return replay_ids_; }
+  FORCE_INLINE int64_t NextEventTargetId() { return replay_ids_.event_target++; }
+  FORCE_INLINE int64_t NextScheduledCallbackId() { return replay_ids_.scheduled_callback++; }
+  FORCE_INLINE int64_t NextModuleInvocationId() { return replay_ids_.module_invocation++; }
   FORCE_INLINE DartMethodPointer* dartMethodPtr() const {
     assert(dart_isolate_context_->valid());
     return dart_isolate_context_->dartMethodPtr();
@@ -181,6 +201,10 @@ class ExecutingContext {
   // Members first initialized and destructed at the last.
   // Keep uiCommandBuffer below dartMethod ptr to make sure we can flush all disposeEventTarget when UICommandBuffer
   // release.
+  // Keep metrics and layout query cache above uiCommandBuffer, the disposeEventTarget commands are still recorded when
+  // UICommandBuffer release.
+  PageMetrics metrics_{this};
+  LayoutQueryCache layout_query_cache_{this};
   SharedUICommand ui_command_buffer_{this};
   DartIsolateContext* dart_isolate_context_{nullptr};
   // Keep uiCommandBuffer above ScriptState to make sure we can collect all disposedEventTarget command when free
@@ -202,6 +226,7 @@ class ExecutingContext {
   Window* window_{nullptr};
   Performance* performance_{nullptr};
   DOMTimerCoordinator timers_;
+  IdleGCScheduler idle_gc_scheduler_{this};
   ModuleListenerContainer module_listener_container_;
   ModuleContextCoordinator module_contexts_;
   ExecutionContextData context_data_{this};
@@ -209,6 +234,9 @@ class ExecutingContext {
   RejectedPromises rejected_promises_;
   MemberMutationScope* active_mutation_scope{nullptr};
   std::unordered_set<ScriptWrappable*> active_wrappers_;
+  std::unique_ptr<MutationObserverAgent> mutation_observer_agent_;
+  std::unique_ptr<ReplayRecorder> replay_recorder_;
+  ReplayIds replay_ids_;
   bool is_dedicated_;
 };
 
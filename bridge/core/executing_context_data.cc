@@ -25,6 +25,33 @@ JSValue ExecutionContextData::prototypeForType(const WrapperTypeInfo* type) {
   return it != prototype_map_.end() ? it->second : JS_NULL;
 }
 
+JSValue ExecutionContextData::widgetElementPrototype(JSAtom tag_name) const {
+  auto it = widget_element_prototype_map_.find(tag_name);
+  return it != widget_element_prototype_map_.end() ? it->second : JS_NULL;
+}
+
+void ExecutionContextData::setWidgetElementPrototype(JSAtom tag_name, JSValue prototype) {
+  assert(widget_element_prototype_map_.count(tag_name) == 0);
+  widget_element_prototype_map_[JS_DupAtom(m_context->ctx(), tag_name)] = prototype;
+}
+
+JSValue ExecutionContextData::unshapedWidgetElementPrototype(JSAtom tag_name, int64_t definitions) const {
+  auto it = unshaped_widget_element_prototype_map_.find(tag_name);
+  if (it == unshaped_widget_element_prototype_map_.end() || it->second.second != definitions)
+    return JS_NULL;
+  return it->second.first;
+}
+
+void ExecutionContextData::setUnshapedWidgetElementPrototype(JSAtom tag_name, JSValue prototype, int64_t definitions) {
+  auto it = unshaped_widget_element_prototype_map_.find(tag_name);
+  if (it != unshaped_widget_element_prototype_map_.end()) {
+    JS_FreeValue(m_context->ctx(), it->second.first);
+    it->second = {prototype, definitions};
+    return;
+  }
+  unshaped_widget_element_prototype_map_[JS_DupAtom(m_context->ctx(), tag_name)] = {prototype, definitions};
+}
+
 JSValue ExecutionContextData::constructorForIdSlowCase(const WrapperTypeInfo* type) {
   JSContext* ctx = m_context->ctx();
 
@@ -84,6 +111,16 @@ void ExecutionContextData::Dispose() {
   for (auto& entry : constructor_map_) {
     JS_FreeValueRT(m_context->dartIsolateContext()->runtime(), entry.second);
   }
+
+  for (auto& entry : widget_element_prototype_map_) {
+    JS_FreeAtomRT(m_context->dartIsolateContext()->runtime(), entry.first);
+    JS_FreeValueRT(m_context->dartIsolateContext()->runtime(), entry.second);
+  }
+
+  for (auto& entry : unshaped_widget_element_prototype_map_) {
+    JS_FreeAtomRT(m_context->dartIsolateContext()->runtime(), entry.first);
+    JS_FreeValueRT(m_context->dartIsolateContext()->runtime(), entry.second.first);
+  }
 }
 
 }  // namespace webf
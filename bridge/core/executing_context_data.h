@@ -25,6 +25,13 @@ class ExecutionContextData final {
   JSValue constructorForType(const WrapperTypeInfo* type);
   // Returns the prototype object that is appropriately initialized.
   JSValue prototypeForType(const WrapperTypeInfo* type);
+  // Returns the prototype compiled from the dart side shape of the widget element tag, JS_NULL if not compiled yet.
+  JSValue widgetElementPrototype(JSAtom tag_name) const;
+  void setWidgetElementPrototype(JSAtom tag_name, JSValue prototype);
+  // Returns the prototype of a widget element tag which had no dart side shape, JS_NULL if it was compiled before the
+  // last custom element definition of dart side.
+  JSValue unshapedWidgetElementPrototype(JSAtom tag_name, int64_t definitions) const;
+  void setUnshapedWidgetElementPrototype(JSAtom tag_name, JSValue prototype, int64_t definitions);
 
   void Dispose();
 
@@ -32,6 +39,8 @@ class ExecutionContextData final {
   JSValue constructorForIdSlowCase(const WrapperTypeInfo* type);
   std::unordered_map<const WrapperTypeInfo*, JSValue> constructor_map_;
   std::unordered_map<const WrapperTypeInfo*, JSValue> prototype_map_;
+  std::unordered_map<JSAtom, JSValue> widget_element_prototype_map_;
+  std::unordered_map<JSAtom, std::pair<JSValue, int64_t>> unshaped_widget_element_prototype_map_;
 
   ExecutingContext* m_context;
 };
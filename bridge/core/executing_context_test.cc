@@ -355,3 +355,47 @@ TEST(jsValueToNativeString, utf8String) {
   }
   JS_FreeValue(env->page()->executingContext()->ctx(), str);
 }
+
+TEST(Context, idleGCWithHeapPolicy) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  JSRuntime* runtime = context->dartIsolateContext()->runtime();
+  context->TurnOnJavaScriptGC();
+
+  NativeHeapPolicy policy;
+  policy.initial_gc_threshold = 1;
+  policy.gc_growth_factor = 2;
+  // Large enough for the full collection to fit whatever the last one took.
+  policy.idle_gc_budget_us = 1000000;
+  context->idleGCScheduler()->ApplyHeapPolicy(policy);
+
+  const char* code = "let list = []; for (let i = 0; i < 1000; i++) { list.push({ i }); }";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  context->idleGCScheduler()->ScheduleIdleGC();
+  EXPECT_EQ(context->idleGCScheduler()->idleCollectionCount(), 1);
+  EXPECT_GE(JS_GetGCThreshold(runtime), JS_GetMallocSize(runtime));
+
+  // Heap is far below the new threshold, no more collection in the next idle gap.
+  context->idleGCScheduler()->ScheduleIdleGC();
+  EXPECT_EQ(context->idleGCScheduler()->idleCollectionCount(), 1);
+
+  JS_SetGCGrowthFactor(runtime, 1.5);
+}
+
+TEST(Context, idleGCSkippedOverBudget) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  JSRuntime* runtime = context->dartIsolateContext()->runtime();
+  context->TurnOnJavaScriptGC();
+  // Measure the duration of a full collection, which is far above the budget below.
+  JS_RunGC(runtime);
+
+  NativeHeapPolicy policy;
+  policy.initial_gc_threshold = 1;
+  policy.idle_gc_budget_us = 1;
+  context->idleGCScheduler()->ApplyHeapPolicy(policy);
+
+  context->idleGCScheduler()->ScheduleIdleGC();
+  EXPECT_EQ(context->idleGCScheduler()->idleCollectionCount(), 0);
+}
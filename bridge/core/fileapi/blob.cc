@@ -3,11 +3,13 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "blob.h"
-#include <modp_b64/modp_b64.h>
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include "bindings/qjs/script_promise_resolver.h"
 #include "built_in_string.h"
 #include "core/executing_context.h"
+#include "foundation/base64.h"
 
 namespace webf {
 
@@ -39,11 +41,23 @@ void BlobReaderClient::Start() {
 
 void BlobReaderClient::DidFinishLoading() {
   if (read_type_ == ReadType::kReadAsText) {
-    resolver_->Resolve<std::string>(blob_->StringResult());
+    JSValue result = blob_->StringResult();
+    resolver_->Resolve(result);
+    JS_FreeValue(context_->ctx(), result);
   } else if (read_type_ == ReadType::kReadAsArrayBuffer) {
-    resolver_->Resolve<ArrayBufferData>(blob_->ArrayBufferResult());
+    JSValue result = blob_->ArrayBufferResult();
+    resolver_->Resolve(result);
+    JS_FreeValue(context_->ctx(), result);
   } else if (read_type_ == ReadType::kReadAsBase64) {
-    resolver_->Resolve<std::string>(blob_->Base64Result());
+    JSValue result = blob_->Base64Result();
+    if (JS_IsException(result)) {
+      JSValue error = JS_GetException(context_->ctx());
+      resolver_->Reject(error);
+      JS_FreeValue(context_->ctx(), error);
+    } else {
+      resolver_->Resolve(result);
+      JS_FreeValue(context_->ctx(), result);
+    }
   }
   delete this;
 }
@@ -70,52 +84,112 @@ Blob* Blob::Create(ExecutingContext* context,
 }
 
 int32_t Blob::size() {
-  return _data.size();
+  return data_.size();
 }
 
 uint8_t* Blob::bytes() {
-  return _data.data();
+  return const_cast<uint8_t*>(data_.Flatten());
 }
 
 void Blob::Trace(GCVisitor* visitor) const {}
 
 Blob* Blob::slice(ExceptionState& exception_state) {
-  return slice(0, _data.size(), exception_state);
+  return slice(0, data_.size(), exception_state);
 }
 Blob* Blob::slice(int64_t start, ExceptionState& exception_state) {
-  return slice(start, _data.size(), exception_state);
+  return slice(start, data_.size(), exception_state);
 }
 Blob* Blob::slice(int64_t start, int64_t end, ExceptionState& exception_state) {
   return slice(start, end, AtomicString::Empty(), exception_state);
 }
+
+// Negative offsets count from the end of the blob, see https://w3c.github.io/FileAPI/#slice-blob
+static size_t ClampSliceOffset(int64_t offset, size_t size) {
+  if (offset < 0)
+    return static_cast<size_t>(std::max<int64_t>(static_cast<int64_t>(size) + offset, 0));
+  return static_cast<size_t>(std::min<int64_t>(offset, static_cast<int64_t>(size)));
+}
+
 Blob* Blob::slice(int64_t start, int64_t end, const AtomicString& content_type, ExceptionState& exception_state) {
+  size_t relative_start = ClampSliceOffset(start, data_.size());
+  size_t relative_end = std::max(ClampSliceOffset(end, data_.size()), relative_start);
+
+  // The new blob refers the same buffers, only the ranges are copied.
   auto* newBlob = MakeGarbageCollected<Blob>(ctx());
-  std::vector<uint8_t> newData;
-  newData.reserve(_data.size() - (end - start));
-  newData.insert(newData.begin(), _data.begin() + start, _data.end() - (_data.size() - end));
-  newBlob->_data = newData;
+  newBlob->data_ = data_.Slice(relative_start, relative_end);
   newBlob->mime_type_ = content_type != built_in_string::kempty_string ? content_type.ToStdString(ctx()) : mime_type_;
   return newBlob;
 }
 
-std::string Blob::StringResult() {
-  return std::string(bytes(), bytes() + size());
+JSValue Blob::StringResult() {
+  if (data_.size() == 0)
+    return JS_NewString(ctx(), "");
+  return JS_NewStringLen(ctx(), reinterpret_cast<const char*>(data_.Flatten()), data_.size());
+}
+
+// Encodes the segments into dest, the bytes which do not fill a 3 bytes group are carried to the next segment.
+static char* EncodeSegments(char* dest, const BlobData& data) {
+  uint8_t carry[3];
+  size_t carry_len = 0;
+  for (auto& segment : data.segments()) {
+    const uint8_t* src = segment.data();
+    size_t len = segment.length;
+    if (carry_len > 0) {
+      while (carry_len < 3 && len > 0) {
+        carry[carry_len++] = *src++;
+        len--;
+      }
+      if (carry_len < 3)
+        continue;
+      dest += Base64::Encode(dest, carry, 3);
+      carry_len = 0;
+    }
+    size_t aligned = len - len % 3;
+    dest += Base64::Encode(dest, src, aligned);
+    memcpy(carry, src + aligned, len - aligned);
+    carry_len = len - aligned;
+  }
+  if (carry_len > 0) {
+    dest += Base64::Encode(dest, carry, carry_len);
+  }
+  return dest;
 }
 
-std::string Blob::Base64Result() {
-  size_t encode_len = modp_b64_encode_data_len(size());
-  std::string buffer;
-  buffer.resize(encode_len);
+JSValue Blob::Base64Result() {
+  static const char kPrefix[] = "data:";
+  static const char kSuffix[] = ";base64,";
+  std::string header = kPrefix + mime_type_ + kSuffix;
+  size_t header_len = header.size();
+  size_t length = header_len + Base64::EncodedLength(data_.size());
+
+  // Types set by scripts are not required to be ASCII, those are converted from UTF-8 like other strings.
+  if (std::any_of(header.begin(), header.end(), [](char c) { return static_cast<uint8_t>(c) >= 0x80; })) {
+    header.resize(length);
+    char* end = EncodeSegments(header.data() + header_len, data_);
+    assert(end == header.data() + length);
+    return JS_NewStringLen(ctx(), header.data(), length);
+  }
 
-  const size_t output_size =
-      modp_b64_encode_data(reinterpret_cast<char*>(buffer.data()), reinterpret_cast<const char*>(bytes()), size());
-  assert(output_size == encode_len);
+  // Encodes into the characters of the result string directly, the encoded data could be megabytes for images.
+  uint8_t* characters;
+  JSValue result = JS_NewUninitializedString8(ctx(), length, &characters);
+  if (JS_IsException(result))
+    return result;
+  memcpy(characters, header.data(), header_len);
+  char* end = EncodeSegments(reinterpret_cast<char*>(characters) + header_len, data_);
+  assert(end == reinterpret_cast<char*>(characters) + length);
+  return result;
+}
 
-  return "data:" + mime_type_ + ";base64," + buffer;
+static void FreeArrayBufferData(JSRuntime* rt, void* opaque, void* ptr) {
+  free(ptr);
 }
 
-ArrayBufferData Blob::ArrayBufferResult() {
-  return ArrayBufferData{bytes(), size()};
+JSValue Blob::ArrayBufferResult() {
+  // ArrayBuffers are writable, so the bytes are copied once into the memory owned by the ArrayBuffer.
+  auto* buffer = static_cast<uint8_t*>(malloc(std::max<size_t>(data_.size(), 1)));
+  data_.CopyTo(buffer);
+  return JS_NewArrayBuffer(ctx(), buffer, data_.size(), FreeArrayBufferData, nullptr, false);
 }
 
 std::string Blob::type() {
@@ -145,21 +219,51 @@ ScriptPromise Blob::base64(ExceptionState& exception_state) {
 }
 
 void Blob::PopulateBlobData(const std::vector<std::shared_ptr<BlobPart>>& data) {
+  // Strings and array buffers are copied into a single buffer, blobs are referred without copying.
+  size_t copy_length = 0;
+  for (auto& item : data) {
+    switch (item->GetContentType()) {
+      case BlobPart::ContentType::kString:
+        copy_length += item->GetString().size();
+        break;
+      case BlobPart::ContentType::kArrayBuffer:
+      case BlobPart::ContentType::kArrayBufferView: {
+        uint32_t length;
+        item->GetBytes(&length);
+        copy_length += length;
+        break;
+      }
+      case BlobPart::ContentType::kBlob:
+        break;
+    }
+  }
+
+  std::shared_ptr<BlobBuffer> buffer = copy_length > 0 ? BlobBuffer::Allocate(copy_length) : nullptr;
+  size_t offset = 0;
+  auto append_copy = [&](const uint8_t* bytes, size_t length) {
+    if (length == 0)
+      return;
+    memcpy(buffer->data() + offset, bytes, length);
+    data_.Append(buffer, offset, length);
+    offset += length;
+  };
+
   for (auto& item : data) {
     switch (item->GetContentType()) {
       case BlobPart::ContentType::kString: {
-        AppendText(item->GetString());
+        const std::string& string = item->GetString();
+        append_copy(reinterpret_cast<const uint8_t*>(string.data()), string.size());
         break;
       }
       case BlobPart::ContentType::kArrayBuffer:
       case BlobPart::ContentType::kArrayBufferView: {
         uint32_t length;
-        uint8_t* buffer = item->GetBytes(&length);
-        AppendBytes(buffer, length);
+        uint8_t* bytes = item->GetBytes(&length);
+        append_copy(bytes, length);
         break;
       }
       case BlobPart::ContentType::kBlob: {
-        AppendBytes(item->GetBlob()->bytes(), item->GetBlob()->size());
+        data_.Append(item->GetBlob()->data_);
         break;
       }
     }
@@ -167,16 +271,16 @@ void Blob::PopulateBlobData(const std::vector<std::shared_ptr<BlobPart>>& data)
 }
 
 void Blob::AppendText(const std::string& string) {
-  std::vector<uint8_t> strArr(string.begin(), string.end());
-  _data.reserve(_data.size() + strArr.size());
-  _data.insert(_data.end(), strArr.begin(), strArr.end());
+  data_.AppendCopy(reinterpret_cast<const uint8_t*>(string.data()), string.size());
 }
 
 void Blob::AppendBytes(uint8_t* buffer, uint32_t length) {
-  _data.reserve(_data.size() + length);
-  for (size_t i = 0; i < length; i++) {
-    _data.emplace_back(buffer[i]);
-  }
+  data_.AppendCopy(buffer, length);
+}
+
+void Blob::AppendBuffer(std::shared_ptr<BlobBuffer> buffer) {
+  size_t length = buffer->size();
+  data_.Append(std::move(buffer), 0, length);
 }
 
 }  // namespace webf
@@ -7,10 +7,10 @@
 
 #include <string>
 #include <vector>
-#include "array_buffer_data.h"
 #include "bindings/qjs/macros.h"
 #include "bindings/qjs/script_promise.h"
 #include "bindings/qjs/script_wrappable.h"
+#include "blob_data.h"
 #include "blob_part.h"
 #include "blob_property_bag.h"
 
@@ -45,9 +45,12 @@ class Blob : public ScriptWrappable {
 
   void AppendText(const std::string& string);
   void AppendBytes(uint8_t* buffer, uint32_t length);
+  // Appends the buffer without copying it.
+  void AppendBuffer(std::shared_ptr<BlobBuffer> buffer);
 
   /// get an pointer of bytes data from JSBlob
   uint8_t* bytes();
+  const BlobData& data() const { return data_; }
   /// get bytes data's length
   int32_t size();
   std::string type();
@@ -62,9 +65,9 @@ class Blob : public ScriptWrappable {
   Blob* slice(int64_t start, int64_t end, ExceptionState& exception_state);
   Blob* slice(int64_t start, int64_t end, const AtomicString& content_type, ExceptionState& exception_state);
 
-  std::string StringResult();
-  std::string Base64Result();
-  ArrayBufferData ArrayBufferResult();
+  JSValue StringResult();
+  JSValue Base64Result();
+  JSValue ArrayBufferResult();
 
   void Trace(GCVisitor* visitor) const override;
 
@@ -73,7 +76,7 @@ class Blob : public ScriptWrappable {
 
  private:
   std::string mime_type_;
-  std::vector<uint8_t> _data;
+  BlobData data_;
 };
 
 }  // namespace webf
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "blob_data.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+namespace webf {
+
+std::shared_ptr<BlobBuffer> BlobBuffer::Allocate(size_t length) {
+  // malloc(0) could return nullptr, keep a valid pointer for the empty buffer.
+  auto* bytes = static_cast<uint8_t*>(malloc(std::max<size_t>(length, 1)));
+  return std::make_shared<BlobBuffer>(bytes, length, free);
+}
+
+std::shared_ptr<BlobBuffer> BlobBuffer::Adopt(uint8_t* bytes, size_t length, Deleter deleter) {
+  return std::make_shared<BlobBuffer>(bytes, length, deleter);
+}
+
+BlobBuffer::~BlobBuffer() {
+  if (deleter_ != nullptr)
+    deleter_(bytes_);
+}
+
+void BlobData::Append(std::shared_ptr<BlobBuffer> buffer, size_t offset, size_t length) {
+  if (length == 0)
+    return;
+  assert(offset + length <= buffer->size());
+
+  size_ += length;
+  if (!segments_.empty()) {
+    Segment& last = segments_.back();
+    if (last.buffer == buffer && last.offset + last.length == offset) {
+      last.length += length;
+      segment_ends_.back() = size_;
+      return;
+    }
+  }
+  segments_.push_back(Segment{std::move(buffer), offset, length});
+  segment_ends_.push_back(size_);
+}
+
+void BlobData::Append(const BlobData& data) {
+  for (auto& segment : data.segments_) {
+    Append(segment.buffer, segment.offset, segment.length);
+  }
+}
+
+void BlobData::AppendCopy(const uint8_t* bytes, size_t length) {
+  if (length == 0)
+    return;
+  auto buffer = BlobBuffer::Allocate(length);
+  memcpy(buffer->data(), bytes, length);
+  Append(std::move(buffer), 0, length);
+}
+
+BlobData BlobData::Slice(size_t start, size_t end) const {
+  assert(start <= end && end <= size_);
+  BlobData result;
+  if (start == end)
+    return result;
+
+  // The first segment ends after the start.
+  size_t index = std::upper_bound(segment_ends_.begin(), segment_ends_.end(), start) - segment_ends_.begin();
+  for (; index < segments_.size() && start < end; index++) {
+    const Segment& segment = segments_[index];
+    size_t segment_start = segment_ends_[index] - segment.length;
+    size_t offset_in_segment = start - segment_start;
+    size_t length = std::min(segment.length - offset_in_segment, end - start);
+    result.Append(segment.buffer, segment.offset + offset_in_segment, length);
+    start += length;
+  }
+  return result;
+}
+
+const uint8_t* BlobData::Flatten() {
+  if (segments_.empty())
+    return nullptr;
+  if (segments_.size() > 1) {
+    auto buffer = BlobBuffer::Allocate(size_);
+    CopyTo(buffer->data());
+    segments_.clear();
+    segment_ends_.clear();
+    size_t size = size_;
+    size_ = 0;
+    Append(std::move(buffer), 0, size);
+  }
+  return segments_[0].data();
+}
+
+void BlobData::CopyTo(uint8_t* dest) const {
+  for (auto& segment : segments_) {
+    memcpy(dest, segment.data(), segment.length);
+    dest += segment.length;
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_CORE_FILEAPI_BLOB_DATA_H_
+#define BRIDGE_CORE_FILEAPI_BLOB_DATA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace webf {
+
+// An immutable byte buffer. The bytes are never changed after the buffer is filled, so blobs, their slices and the
+// blobs built from them could refer the same buffer instead of copying it.
+class BlobBuffer {
+ public:
+  using Deleter = void (*)(void*);
+
+  // Allocates an uninitialized buffer, which should be filled before it is appended to a BlobData.
+  static std::shared_ptr<BlobBuffer> Allocate(size_t length);
+  // Takes the ownership of the bytes, the deleter is called when the last reference is dropped.
+  static std::shared_ptr<BlobBuffer> Adopt(uint8_t* bytes, size_t length, Deleter deleter);
+
+  BlobBuffer(uint8_t* bytes, size_t length, Deleter deleter) : bytes_(bytes), length_(length), deleter_(deleter) {}
+  BlobBuffer(const BlobBuffer&) = delete;
+  BlobBuffer& operator=(const BlobBuffer&) = delete;
+  ~BlobBuffer();
+
+  uint8_t* data() const { return bytes_; }
+  size_t size() const { return length_; }
+
+ private:
+  uint8_t* bytes_;
+  size_t length_;
+  Deleter deleter_;
+};
+
+// The bytes of a blob, kept as a list of ranges of the shared buffers.
+class BlobData {
+ public:
+  struct Segment {
+    std::shared_ptr<BlobBuffer> buffer;
+    size_t offset;
+    size_t length;
+
+    const uint8_t* data() const { return buffer->data() + offset; }
+  };
+
+  size_t size() const { return size_; }
+  const std::vector<Segment>& segments() const { return segments_; }
+
+  // Refers the range of the buffer, a range following the last segment in the same buffer extends it.
+  void Append(std::shared_ptr<BlobBuffer> buffer, size_t offset, size_t length);
+  void Append(const BlobData& data);
+  // Copies the bytes into a new buffer.
+  void AppendCopy(const uint8_t* bytes, size_t length);
+
+  // Refers the bytes in [start, end) without copying them, the offsets should be clamped to size().
+  BlobData Slice(size_t start, size_t end) const;
+
+  // Returns the bytes as a contiguous range. A blob with several segments is joined into a single buffer the first
+  // time, so later reads are free.
+  const uint8_t* Flatten();
+  void CopyTo(uint8_t* dest) const;
+
+ private:
+  std::vector<Segment> segments_;
+  // The end offset of each segment in the blob, for the binary search in Slice.
+  std::vector<size_t> segment_ends_;
+  size_t size_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_FILEAPI_BLOB_DATA_H_
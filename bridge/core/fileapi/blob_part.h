@@ -37,7 +37,7 @@ class BlobPart {
                     size_t byte_offset,
                     size_t byte_length,
                     size_t byte_per_element)
-      : content_type_(ContentType::kArrayBufferView), bytes_(buffer), byte_length_(length){};
+      : content_type_(ContentType::kArrayBufferView), bytes_(buffer + byte_offset), byte_length_(byte_length){};
   explicit BlobPart(JSContext* ctx, std::string value)
       : content_type_(ContentType::kString), member_string_(std::move(value)){};
   explicit BlobPart(JSContext* ctx, Blob* blob) : content_type_(ContentType::kBlob), blob_(blob){};
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "blob_data.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static std::string ToString(const BlobData& data) {
+  std::string result(data.size(), '\0');
+  data.CopyTo(reinterpret_cast<uint8_t*>(result.data()));
+  return result;
+}
+
+TEST(BlobData, sliceSharesTheBuffers) {
+  BlobData data;
+  data.AppendCopy(reinterpret_cast<const uint8_t*>("hello"), 5);
+  data.AppendCopy(reinterpret_cast<const uint8_t*>(" world"), 6);
+  EXPECT_EQ(data.segments().size(), 2);
+
+  BlobData slice = data.Slice(3, 8);
+  EXPECT_EQ(ToString(slice), "lo wo");
+  ASSERT_EQ(slice.segments().size(), 2);
+  EXPECT_EQ(slice.segments()[0].buffer, data.segments()[0].buffer);
+  EXPECT_EQ(slice.segments()[1].buffer, data.segments()[1].buffer);
+
+  EXPECT_EQ(ToString(slice.Slice(3, 5)), "wo");
+  EXPECT_EQ(slice.Slice(2, 2).size(), 0);
+}
+
+TEST(BlobData, adjacentRangesAreMerged) {
+  BlobData data;
+  data.AppendCopy(reinterpret_cast<const uint8_t*>("abcdef"), 6);
+
+  BlobData joined = data.Slice(0, 2);
+  joined.Append(data.Slice(2, 6));
+  EXPECT_EQ(joined.segments().size(), 1);
+  EXPECT_EQ(ToString(joined), "abcdef");
+}
+
+TEST(BlobData, flattenJoinsTheSegments) {
+  BlobData data;
+  data.AppendCopy(reinterpret_cast<const uint8_t*>("ab"), 2);
+  data.AppendCopy(reinterpret_cast<const uint8_t*>("cd"), 2);
+  const uint8_t* bytes = data.Flatten();
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(bytes), 4), "abcd");
+  EXPECT_EQ(data.segments().size(), 1);
+  EXPECT_EQ(data.Flatten(), bytes);
+}
+
+TEST(Blob, sliceAndRead) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    EXPECT_STREQ(message.c_str(), "lo wo cde 3 data:text/plain;base64,YWJjZGVm 100,0,101,0");
+    logCalled = true;
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) { errorCalled = true; });
+  auto context = env->page()->executingContext();
+  const char* code = R"(
+(async () => {
+  let blob = new Blob([new Blob(['hello']), ' world']);
+  let bytes = new Uint8Array([97, 98, 99, 100, 101, 102]);
+  let view = new Blob([bytes.subarray(2, 5)]);
+  let joined = new Blob([new Blob(['ab']), new Blob(['cd']), 'ef'], {type: 'text/plain'});
+  let int16 = await new Blob([new Int16Array([100, 101])]).arrayBuffer();
+  console.log(await blob.slice(3, 8).text(), await view.text(), blob.slice(-3).size, await joined.base64(),
+      Array.from(new Uint8Array(int16)).join(','));
+})();
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  TEST_runLoop(context);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
@@ -22,7 +22,11 @@ std::shared_ptr<DOMTimer> DOMTimer::create(ExecutingContext* context,
 }
 
 DOMTimer::DOMTimer(ExecutingContext* context, std::shared_ptr<QJSFunction> callback, TimerKind timer_kind)
-    : context_(context), callback_(std::move(callback)), status_(TimerStatus::kPending), kind_(timer_kind) {}
+    : context_(context),
+      callback_(std::move(callback)),
+      status_(TimerStatus::kPending),
+      kind_(timer_kind),
+      scheduled_callback_id_(context->NextScheduledCallbackId()) {}
 
 void DOMTimer::Fire() {
   if (status_ == TimerStatus::kTerminated)
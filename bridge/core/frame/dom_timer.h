@@ -31,6 +31,8 @@ class DOMTimer {
 
   [[nodiscard]] int32_t timerId() const { return timer_id_; };
   void setTimerId(int32_t timerId);
+  // Timer ids are shared by all pages, replay traces refer the timer by the order it was scheduled in the context.
+  [[nodiscard]] int64_t scheduledCallbackId() const { return scheduled_callback_id_; }
 
   void SetStatus(TimerStatus status) { status_ = status; }
   [[nodiscard]] TimerStatus status() const { return status_; }
@@ -41,6 +43,7 @@ class DOMTimer {
   TimerKind kind_;
   ExecutingContext* context_{nullptr};
   int32_t timer_id_{-1};
+  int64_t scheduled_callback_id_;
   TimerStatus status_;
   std::shared_ptr<QJSFunction> callback_;
 };
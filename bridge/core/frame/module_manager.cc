@@ -11,6 +11,9 @@
 
 namespace webf {
 
+ModuleContext::ModuleContext(ExecutingContext* context, const std::shared_ptr<ModuleCallback>& callback)
+    : context(context), callback(callback), invocation_id(context->NextModuleInvocationId()) {}
+
 NativeValue* handleInvokeModuleTransientCallback(void* ptr,
                                                  double contextId,
                                                  const char* errmsg,
@@ -34,12 +37,16 @@ NativeValue* handleInvokeModuleTransientCallback(void* ptr,
     return nullptr;
 
   context->dartIsolateContext()->profiler()->StartTrackAsyncEvaluation();
-  context->dartIsolateContext()->profiler()->StartTrackSteps("handleInvokeModuleTransientCallback");
+  context->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kHandleInvokeModuleTransientCallback);
 
   ExceptionState exception_state;
 
   NativeValue* return_value = nullptr;
   if (errmsg != nullptr) {
+    if (auto* recorder = context->replayRecorder()) {
+      recorder->RecordModuleCallback(moduleContext->invocation_id, errmsg, nullptr);
+    }
+
     ScriptValue error_object = ScriptValue::CreateErrorObject(ctx, errmsg);
     ScriptValue arguments[] = {error_object};
     ScriptValue result = moduleContext->callback->value()->Invoke(ctx, ScriptValue::Empty(ctx), 1, arguments);
@@ -51,6 +58,9 @@ NativeValue* handleInvokeModuleTransientCallback(void* ptr,
     memcpy(return_value, &native_result, sizeof(NativeValue));
   } else {
     ScriptValue arguments[] = {ScriptValue::Empty(ctx), ScriptValue(ctx, *extra_data)};
+    if (auto* recorder = context->replayRecorder()) {
+      recorder->RecordModuleCallback(moduleContext->invocation_id, nullptr, &arguments[1]);
+    }
     ScriptValue result = moduleContext->callback->value()->Invoke(ctx, ScriptValue::Empty(ctx), 2, arguments);
     if (result.IsException()) {
       context->HandleException(&result);
@@ -146,7 +156,7 @@ ScriptValue ModuleManager::__webf_invoke_module__(ExecutingContext* context,
   auto module_name_string = module_name.ToNativeString(context->ctx());
   auto method_name_string = method.ToNativeString(context->ctx());
 
-  context->dartIsolateContext()->profiler()->StartTrackLinkSteps("Call To Dart");
+  context->dartIsolateContext()->profiler()->StartTrackLinkSteps(TraceLabel::kCallToDart);
 
   if (callback != nullptr) {
     auto module_callback = ModuleCallback::Create(callback);
@@ -13,10 +13,11 @@
 namespace webf {
 
 struct ModuleContext {
-  ModuleContext(ExecutingContext* context, const std::shared_ptr<ModuleCallback>& callback)
-      : context(context), callback(callback) {}
+  ModuleContext(ExecutingContext* context, const std::shared_ptr<ModuleCallback>& callback);
   ExecutingContext* context;
   std::shared_ptr<ModuleCallback> callback;
+  // Identifies the invocation in replay traces.
+  int64_t invocation_id;
 };
 
 class ModuleManager {
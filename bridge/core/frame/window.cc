@@ -4,7 +4,6 @@
  */
 
 #include "window.h"
-#include <modp_b64/modp_b64.h>
 #include "binding_call_methods.h"
 #include "bindings/qjs/cppgc/garbage_collected.h"
 #include "core/css/computed_css_style_declaration.h"
@@ -13,6 +12,7 @@
 #include "core/events/message_event.h"
 #include "core/executing_context.h"
 #include "event_type_names.h"
+#include "foundation/base64.h"
 #include "foundation/native_value_converter.h"
 
 namespace webf {
@@ -32,31 +32,42 @@ bool IsAsciiWhitespace(CharType character) {
 AtomicString Window::btoa(const AtomicString& source, ExceptionState& exception_state) {
   if (source.IsEmpty())
     return AtomicString::Empty();
-  size_t encode_len = modp_b64_encode_data_len(source.length());
-  std::vector<char> buffer;
-  buffer.resize(encode_len);
 
-  const size_t output_size = modp_b64_encode_data(reinterpret_cast<char*>(buffer.data()),
-                                                  reinterpret_cast<const char*>(source.Character8()), source.length());
-  assert(output_size == encode_len);
+  // Encodes into the characters of the result string directly.
+  uint8_t* characters;
+  JSValue str = JS_NewUninitializedString8(ctx(), Base64::EncodedLength(source.length()), &characters);
+  if (JS_IsException(str)) {
+    JSValue error = JS_GetException(ctx());
+    exception_state.ThrowException(ctx(), error);
+    JS_FreeValue(ctx(), error);
+    return AtomicString::Empty();
+  }
+  Base64::Encode(reinterpret_cast<char*>(characters), source.Character8(), source.length());
 
-  return {ctx(), buffer.data(), buffer.size()};
+  AtomicString result = {ctx(), str};
+  JS_FreeValue(ctx(), str);
+  return result;
 }
 
-// Invokes modp_b64 without stripping whitespace.
-bool Base64DecodeRaw(const AtomicString& in, std::vector<uint8_t>& out, ModpDecodePolicy policy) {
-  size_t decode_len = modp_b64_decode_len(in.length());
-  out.resize(decode_len);
-
-  const size_t output_size = modp_b64_decode(reinterpret_cast<char*>(out.data()),
-                                             reinterpret_cast<const char*>(in.Character8()), in.length(), policy);
-  if (output_size == MODP_B64_ERROR)
-    return false;
-  out.resize(output_size);
-  return true;
+// Decodes into the characters of a new string without stripping whitespace, returns JS_NULL if the input is not
+// correctly encoded.
+static JSValue Base64DecodeRaw(JSContext* ctx, const AtomicString& in, ModpDecodePolicy policy) {
+  uint8_t* characters;
+  JSValue str = JS_NewUninitializedString8(ctx, Base64::DecodedCapacity(in.length()), &characters);
+  if (JS_IsException(str))
+    return str;
+
+  const size_t output_size =
+      Base64::Decode(characters, reinterpret_cast<const char*>(in.Character8()), in.length(), policy);
+  if (output_size == MODP_B64_ERROR) {
+    JS_FreeValue(ctx, str);
+    return JS_NULL;
+  }
+  JS_TruncateString8(str, output_size);
+  return str;
 }
 
-bool Base64Decode(JSContext* ctx, AtomicString in, std::vector<uint8_t>& out, ModpDecodePolicy policy) {
+static JSValue Base64Decode(JSContext* ctx, const AtomicString& in, ModpDecodePolicy policy) {
   switch (policy) {
     case ModpDecodePolicy::kForgiving: {
       // https://infra.spec.whatwg.org/#forgiving-base64-decode
@@ -68,14 +79,16 @@ bool Base64Decode(JSContext* ctx, AtomicString in, std::vector<uint8_t>& out, Mo
       // TODO(csharrison): Most callers use String inputs so ToString() should
       // be fast. Still, we should add a RemoveCharacters method to StringView
       // to avoid a double allocation for non-String-backed StringViews.
-      return Base64DecodeRaw(in, out, policy) ||
-             Base64DecodeRaw(in.RemoveCharacters(ctx, &IsAsciiWhitespace), out, policy);
+      JSValue result = Base64DecodeRaw(ctx, in, policy);
+      if (!JS_IsNull(result))
+        return result;
+      return Base64DecodeRaw(ctx, in.RemoveCharacters(ctx, &IsAsciiWhitespace), policy);
     }
     case ModpDecodePolicy::kNoPaddingValidation: {
-      return Base64DecodeRaw(in, out, policy);
+      return Base64DecodeRaw(ctx, in, policy);
     }
     case ModpDecodePolicy::kStrict:
-      return false;
+      return JS_NULL;
   }
 }
 
@@ -89,13 +102,19 @@ AtomicString Window::atob(const AtomicString& source, ExceptionState& exception_
     return AtomicString::Empty();
   }
 
-  std::vector<uint8_t> buffer;
-  if (!Base64Decode(ctx(), source, buffer, ModpDecodePolicy::kForgiving)) {
+  // The decoded bytes are the Latin1 characters of the result string.
+  JSValue str = Base64Decode(ctx(), source, ModpDecodePolicy::kForgiving);
+  if (JS_IsException(str)) {
+    JSValue error = JS_GetException(ctx());
+    exception_state.ThrowException(ctx(), error);
+    JS_FreeValue(ctx(), error);
+    return AtomicString::Empty();
+  }
+  if (JS_IsNull(str)) {
     exception_state.ThrowException(ctx(), ErrorType::TypeError, "The string to be decoded is not correctly encoded.");
     return AtomicString::Empty();
   }
 
-  JSValue str = JS_NewRawUTF8String(ctx(), buffer.data(), buffer.size());
   AtomicString result = {ctx(), str};
   JS_FreeValue(ctx(), str);
   return result;
@@ -21,8 +21,12 @@ static void handleTimerCallback(DOMTimer* timer, char* errmsg) {
   if (context->Timers()->getTimerById(timer->timerId()) == nullptr)
     return;
 
+  if (auto* recorder = context->replayRecorder()) {
+    recorder->RecordTimer(timer->scheduledCallbackId());
+  }
+
   context->dartIsolateContext()->profiler()->StartTrackAsyncEvaluation();
-  context->dartIsolateContext()->profiler()->StartTrackSteps("handleTimerCallback");
+  context->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kHandleTimerCallback);
 
   // Trigger timer callbacks.
   timer->Fire();
@@ -188,4 +192,22 @@ ScriptValue WindowOrWorkerGlobalScope::__memory_usage__(ExecutingContext* contex
   return ScriptValue::CreateJsonObject(context->ctx(), buff, strlen(buff));
 }
 
+ScriptValue WindowOrWorkerGlobalScope::__gc_stats__(ExecutingContext* context, ExceptionState& exception) {
+  JSRuntime* runtime = context->GetScriptState()->runtime();
+  JSGCStats gc_stats;
+  JS_GetGCStats(runtime, &gc_stats);
+
+  char buff[2048];
+  snprintf(buff, 2048,
+           R"({"full_collections": %llu, "minor_collections": %llu, "total_duration_us": %llu, )"
+           R"("total_bytes_freed": %llu, "last_is_minor": %s, "last_duration_us": %lld, )"
+           R"("last_objects_scanned": %lld, "last_bytes_freed": %lld})",
+           (unsigned long long)gc_stats.full_collections, (unsigned long long)gc_stats.minor_collections,
+           (unsigned long long)gc_stats.total_duration_us, (unsigned long long)gc_stats.total_bytes_freed,
+           gc_stats.last_is_minor ? "true" : "false", (long long)gc_stats.last_duration_us,
+           (long long)gc_stats.last_objects_scanned, (long long)gc_stats.last_bytes_freed);
+
+  return ScriptValue::CreateJsonObject(context->ctx(), buff, strlen(buff));
+}
+
 }  // namespace webf
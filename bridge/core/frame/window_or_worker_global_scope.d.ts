@@ -16,4 +16,6 @@ declare const __gc__: () => void;
 
 declare const __memory_usage__: () => any;
 
+declare const __gc_stats__: () => any;
+
 
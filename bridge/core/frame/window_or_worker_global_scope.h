@@ -29,6 +29,7 @@ class WindowOrWorkerGlobalScope {
   static void clearInterval(ExecutingContext* context, int32_t timerId, ExceptionState& exception);
   static void __gc__(ExecutingContext* context, ExceptionState& exception);
   static ScriptValue __memory_usage__(ExecutingContext* context, ExceptionState& exception_state);
+  static ScriptValue __gc_stats__(ExecutingContext* context, ExceptionState& exception_state);
 };
 
 }  // namespace webf
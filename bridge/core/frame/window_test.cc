@@ -4,6 +4,7 @@
  */
 
 #include "window.h"
+#include <quickjs/quickjs.h>
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 
@@ -165,4 +166,160 @@ TEST(Window, btoaToEmpty) {
   std::string code = std::string("atob(' ')");
   env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
   EXPECT_EQ(errorCalled, false);
-}
\ No newline at end of file
+}
+
+TEST(Window, btoaAndAtobRoundTrip) {
+  static bool errorCalled = false;
+  static bool logCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "4000 true true true");
+  };
+
+  std::string code = std::string(R"(
+    let s = '';
+    for (let i = 0; i < 3000; i++) s += String.fromCharCode((i * 7) % 256);
+    let encoded = btoa(s);
+    console.log(encoded.length, atob(encoded) === s, atob(encoded.replace(/(.{76})/g, '$1\n')) === s,
+      (() => { try { atob(encoded.slice(1)); } catch (e) { return e instanceof TypeError; } })());
+  )");
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(Window, gcStats) {
+  static bool errorCalled = false;
+  static bool logCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "true true");
+  };
+
+  std::string code = std::string(R"(
+    for (let i = 0; i < 100; i++) { let a = {}; a.self = a; }
+    let before = __gc_stats__();
+    __gc__();
+    let after = __gc_stats__();
+    console.log(after.full_collections === before.full_collections + 1, after.last_is_minor === false);
+  )");
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+namespace {
+
+int gc_test_finalized = 0;
+JSClassID gc_test_class_id = 0;
+
+// Objects of a class with a finalizer, so the tests see when the collector frees them.
+JSValue NewGCTestObject(JSContext* ctx) {
+  JSRuntime* runtime = JS_GetRuntime(ctx);
+  if (gc_test_class_id == 0)
+    JS_NewClassID(&gc_test_class_id);
+  if (!JS_IsRegisteredClass(runtime, gc_test_class_id)) {
+    JSClassDef def{};
+    def.class_name = "GCTestObject";
+    def.finalizer = [](JSRuntime* rt, JSValue val) { gc_test_finalized++; };
+    JS_NewClass(runtime, gc_test_class_id, &def);
+  }
+  return JS_NewObjectClass(ctx, gc_test_class_id);
+}
+
+}  // namespace
+
+TEST(Window, minorGCCollectsYoungCycles) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  JSRuntime* runtime = JS_GetRuntime(ctx);
+  JS_RunMinorGC(runtime);
+  gc_test_finalized = 0;
+
+  JSValue a = NewGCTestObject(ctx);
+  JSValue b = NewGCTestObject(ctx);
+  JS_SetPropertyStr(ctx, a, "peer", JS_DupValue(ctx, b));
+  JS_SetPropertyStr(ctx, b, "peer", a);
+  JS_FreeValue(ctx, b);
+  EXPECT_EQ(gc_test_finalized, 0);
+
+  // The finalizers of the young objects run when their cycle is freed.
+  JS_RunMinorGC(runtime);
+  EXPECT_EQ(gc_test_finalized, 2);
+  JSGCStats stats;
+  JS_GetGCStats(runtime, &stats);
+  EXPECT_TRUE(stats.last_is_minor);
+}
+
+TEST(Window, minorGCKeepsYoungObjectsReferencedByOldOnes) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  JSRuntime* runtime = JS_GetRuntime(ctx);
+  JSValue old = NewGCTestObject(ctx);
+  JS_RunMinorGC(runtime);
+  gc_test_finalized = 0;
+
+  // Only the references between young objects are discounted, the one from the old object keeps the cycle alive.
+  JSValue young = NewGCTestObject(ctx);
+  JS_SetPropertyStr(ctx, young, "self", JS_DupValue(ctx, young));
+  JS_SetPropertyStr(ctx, old, "child", young);
+  JS_RunMinorGC(runtime);
+  EXPECT_EQ(gc_test_finalized, 0);
+  JSValue child = JS_GetPropertyStr(ctx, old, "child");
+  EXPECT_TRUE(JS_IsLiveObject(runtime, child));
+  JS_FreeValue(ctx, child);
+
+  JS_FreeValue(ctx, old);
+  EXPECT_EQ(gc_test_finalized, 1);
+  JS_RunGC(runtime);
+  EXPECT_EQ(gc_test_finalized, 2);
+}
+
+TEST(Window, minorGCPromotesSurvivors) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  JSRuntime* runtime = JS_GetRuntime(ctx);
+  gc_test_finalized = 0;
+
+  JSValue a = NewGCTestObject(ctx);
+  JS_SetPropertyStr(ctx, a, "self", JS_DupValue(ctx, a));
+  JS_RunMinorGC(runtime);
+  // Nothing was allocated since, the survivors are not scanned again.
+  JS_RunMinorGC(runtime);
+  JSGCStats stats;
+  JS_GetGCStats(runtime, &stats);
+  EXPECT_EQ(stats.last_objects_scanned, 0);
+
+  // A promoted cycle is left to the full collections.
+  JS_FreeValue(ctx, a);
+  JS_RunMinorGC(runtime);
+  EXPECT_EQ(gc_test_finalized, 0);
+  JS_RunGC(runtime);
+  EXPECT_EQ(gc_test_finalized, 1);
+}
+
+TEST(Window, minorGCReleasesOldObjectsOfFreedCycles) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  JSRuntime* runtime = JS_GetRuntime(ctx);
+  JSValue old = NewGCTestObject(ctx);
+  JS_RunMinorGC(runtime);
+  gc_test_finalized = 0;
+
+  JSValue young = NewGCTestObject(ctx);
+  JS_SetPropertyStr(ctx, young, "self", JS_DupValue(ctx, young));
+  JS_SetPropertyStr(ctx, young, "old", old);
+  JS_FreeValue(ctx, young);
+
+  // The old object loses its last reference with the young cycle and is freed in the same pass.
+  JS_RunMinorGC(runtime);
+  EXPECT_EQ(gc_test_finalized, 2);
+}
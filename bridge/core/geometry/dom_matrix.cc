@@ -3,18 +3,191 @@
  */
 
 #include "dom_matrix.h"
+#include "core/executing_context.h"
 
 namespace webf {
 
+DOMMatrix* DOMMatrix::Create(ExecutingContext* context, ExceptionState& exception_state) {
+  return MakeGarbageCollected<DOMMatrix>(context, TransformationMatrix(), true);
+}
+
 DOMMatrix* DOMMatrix::Create(ExecutingContext* context,
                              const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                              ExceptionState& exception_state) {
-  return MakeGarbageCollected<DOMMatrix>(context, init, exception_state);
+  TransformationMatrix matrix;
+  bool is_2d;
+  if (!InitMatrix(context, init, &matrix, &is_2d, exception_state)) {
+    return nullptr;
+  }
+  return MakeGarbageCollected<DOMMatrix>(context, matrix, is_2d);
+}
+
+DOMMatrix* DOMMatrix::Create(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d) {
+  return MakeGarbageCollected<DOMMatrix>(context, matrix, is_2d);
+}
+
+DOMMatrix::DOMMatrix(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d)
+    : DOMMatrixReadonly(context, matrix, is_2d) {}
+
+DOMMatrix* DOMMatrix::translateSelf(ExceptionState& exception_state) {
+  return this;
+}
+
+DOMMatrix* DOMMatrix::translateSelf(double tx, ExceptionState& exception_state) {
+  return translateSelf(tx, 0, 0, exception_state);
+}
+
+DOMMatrix* DOMMatrix::translateSelf(double tx, double ty, ExceptionState& exception_state) {
+  return translateSelf(tx, ty, 0, exception_state);
+}
+
+DOMMatrix* DOMMatrix::translateSelf(double tx, double ty, double tz, ExceptionState& exception_state) {
+  MutableMatrix().Translate(tx, ty, tz);
+  if (tz != 0) {
+    is_2d_ = false;
+  }
+  return this;
+}
+
+DOMMatrix* DOMMatrix::scaleSelf(ExceptionState& exception_state) {
+  return this;
+}
+
+DOMMatrix* DOMMatrix::scaleSelf(double scale_x, ExceptionState& exception_state) {
+  return scaleSelf(scale_x, scale_x, 1, exception_state);
+}
+
+DOMMatrix* DOMMatrix::scaleSelf(double scale_x, double scale_y, ExceptionState& exception_state) {
+  return scaleSelf(scale_x, scale_y, 1, exception_state);
+}
+
+DOMMatrix* DOMMatrix::scaleSelf(double scale_x, double scale_y, double scale_z, ExceptionState& exception_state) {
+  MutableMatrix().Scale(scale_x, scale_y, scale_z);
+  if (scale_z != 1) {
+    is_2d_ = false;
+  }
+  return this;
+}
+
+DOMMatrix* DOMMatrix::rotateSelf(ExceptionState& exception_state) {
+  return this;
+}
+
+DOMMatrix* DOMMatrix::rotateSelf(double rot_x, ExceptionState& exception_state) {
+  // With a single angle, the rotation is around the z axis.
+  return rotateSelf(0, 0, rot_x, exception_state);
+}
+
+DOMMatrix* DOMMatrix::rotateSelf(double rot_x, double rot_y, ExceptionState& exception_state) {
+  return rotateSelf(rot_x, rot_y, 0, exception_state);
+}
+
+DOMMatrix* DOMMatrix::rotateSelf(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state) {
+  TransformationMatrix& matrix = MutableMatrix();
+  matrix.RotateAxisAngle(0, 0, 1, rot_z);
+  matrix.RotateAxisAngle(0, 1, 0, rot_y);
+  matrix.RotateAxisAngle(1, 0, 0, rot_x);
+  if (rot_x != 0 || rot_y != 0) {
+    is_2d_ = false;
+  }
+  return this;
+}
+
+DOMMatrix* DOMMatrix::rotateAxisAngleSelf(ExceptionState& exception_state) {
+  return this;
+}
+
+DOMMatrix* DOMMatrix::rotateAxisAngleSelf(double x, ExceptionState& exception_state) {
+  return rotateAxisAngleSelf(x, 0, 0, 0, exception_state);
+}
+
+DOMMatrix* DOMMatrix::rotateAxisAngleSelf(double x, double y, ExceptionState& exception_state) {
+  return rotateAxisAngleSelf(x, y, 0, 0, exception_state);
+}
+
+DOMMatrix* DOMMatrix::rotateAxisAngleSelf(double x, double y, double z, ExceptionState& exception_state) {
+  return rotateAxisAngleSelf(x, y, z, 0, exception_state);
+}
+
+DOMMatrix* DOMMatrix::rotateAxisAngleSelf(double x,
+                                          double y,
+                                          double z,
+                                          double angle,
+                                          ExceptionState& exception_state) {
+  MutableMatrix().RotateAxisAngle(x, y, z, angle);
+  if (x != 0 || y != 0) {
+    is_2d_ = false;
+  }
+  return this;
+}
+
+DOMMatrix* DOMMatrix::skewXSelf(ExceptionState& exception_state) {
+  return this;
+}
+
+DOMMatrix* DOMMatrix::skewXSelf(double sx, ExceptionState& exception_state) {
+  MutableMatrix().SkewX(sx);
+  return this;
+}
+
+DOMMatrix* DOMMatrix::skewYSelf(ExceptionState& exception_state) {
+  return this;
+}
+
+DOMMatrix* DOMMatrix::skewYSelf(double sy, ExceptionState& exception_state) {
+  MutableMatrix().SkewY(sy);
+  return this;
+}
+
+DOMMatrix* DOMMatrix::multiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state) {
+  if (other == nullptr) {
+    exception_state.ThrowException(ctx(), ErrorType::TypeError, "The matrix to multiply must be a DOMMatrix.");
+    return nullptr;
+  }
+  MutableMatrix().Multiply(other->matrix());
+  if (!other->is2D()) {
+    is_2d_ = false;
+  }
+  return this;
 }
 
-DOMMatrix::DOMMatrix(ExecutingContext* context,
-                     const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
-                     ExceptionState& exception_state)
-    : DOMMatrixReadonly(context, init, exception_state) {}
+DOMMatrix* DOMMatrix::preMultiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state) {
+  if (other == nullptr) {
+    exception_state.ThrowException(ctx(), ErrorType::TypeError, "The matrix to multiply must be a DOMMatrix.");
+    return nullptr;
+  }
+  MutableMatrix().PreMultiply(other->matrix());
+  if (!other->is2D()) {
+    is_2d_ = false;
+  }
+  return this;
+}
+
+DOMMatrix* DOMMatrix::invertSelf(ExceptionState& exception_state) {
+  if (!MutableMatrix().Invert()) {
+    is_2d_ = false;
+  }
+  return this;
+}
+
+DOMMatrix* DOMMatrix::setMatrixValue(const AtomicString& transform_list, ExceptionState& exception_state) {
+  std::string text = transform_list.ToStdString(ctx());
+  TransformationMatrix matrix;
+  bool is_2d;
+  if (!TransformationMatrix::Parse(text, &matrix, &is_2d)) {
+    exception_state.ThrowException(ctx(), ErrorType::SyntaxError, "Failed to parse '" + text + "'.");
+    return nullptr;
+  }
+  MutableMatrix() = matrix;
+  is_2d_ = is_2d;
+  return this;
+}
+
+void DOMMatrix::Set3DComponent(void (TransformationMatrix::*setter)(double), double value, double value_2d) {
+  (MutableMatrix().*setter)(value);
+  if (value != value_2d) {
+    is_2d_ = false;
+  }
+}
 
-}  // namespace webf
\ No newline at end of file
+}  // namespace webf
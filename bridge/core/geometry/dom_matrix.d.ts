@@ -1,3 +1,38 @@
 interface DOMMatrix extends DOMMatrixReadonly {
-  new(init: string | double[]): DOMMatrix;
-}
\ No newline at end of file
+  a: double;
+  b: double;
+  c: double;
+  d: double;
+  e: double;
+  f: double;
+
+  m11: double;
+  m12: double;
+  m13: double;
+  m14: double;
+  m21: double;
+  m22: double;
+  m23: double;
+  m24: double;
+  m31: double;
+  m32: double;
+  m33: double;
+  m34: double;
+  m41: double;
+  m42: double;
+  m43: double;
+  m44: double;
+
+  translateSelf(tx?: double, ty?: double, tz?: double): DOMMatrix;
+  scaleSelf(scaleX?: double, scaleY?: double, scaleZ?: double): DOMMatrix;
+  rotateSelf(rotX?: double, rotY?: double, rotZ?: double): DOMMatrix;
+  rotateAxisAngleSelf(x?: double, y?: double, z?: double, angle?: double): DOMMatrix;
+  skewXSelf(sx?: double): DOMMatrix;
+  skewYSelf(sy?: double): DOMMatrix;
+  multiplySelf(other: DOMMatrixReadonly): DOMMatrix;
+  preMultiplySelf(other: DOMMatrixReadonly): DOMMatrix;
+  invertSelf(): DOMMatrix;
+  setMatrixValue(transformList: string): DOMMatrix;
+
+  new(init?: string | double[]): DOMMatrix;
+}
@@ -13,16 +13,67 @@ class DOMMatrix : public DOMMatrixReadonly {
   DEFINE_WRAPPERTYPEINFO();
 
  public:
+  static DOMMatrix* Create(ExecutingContext* context, ExceptionState& exception_state);
   static DOMMatrix* Create(ExecutingContext* context,
                            const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                            ExceptionState& exception_state);
+  static DOMMatrix* Create(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d);
 
   DOMMatrix() = delete;
-  explicit DOMMatrix(ExecutingContext* context,
-                     const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
-                     ExceptionState& exception_state);
+  explicit DOMMatrix(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d);
+
+  void setA(double value, ExceptionState& exception_state) { MutableMatrix().setM11(value); }
+  void setB(double value, ExceptionState& exception_state) { MutableMatrix().setM12(value); }
+  void setC(double value, ExceptionState& exception_state) { MutableMatrix().setM21(value); }
+  void setD(double value, ExceptionState& exception_state) { MutableMatrix().setM22(value); }
+  void setE(double value, ExceptionState& exception_state) { MutableMatrix().setM41(value); }
+  void setF(double value, ExceptionState& exception_state) { MutableMatrix().setM42(value); }
+
+  void setM11(double value, ExceptionState& exception_state) { MutableMatrix().setM11(value); }
+  void setM12(double value, ExceptionState& exception_state) { MutableMatrix().setM12(value); }
+  void setM13(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM13, value, 0); }
+  void setM14(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM14, value, 0); }
+  void setM21(double value, ExceptionState& exception_state) { MutableMatrix().setM21(value); }
+  void setM22(double value, ExceptionState& exception_state) { MutableMatrix().setM22(value); }
+  void setM23(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM23, value, 0); }
+  void setM24(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM24, value, 0); }
+  void setM31(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM31, value, 0); }
+  void setM32(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM32, value, 0); }
+  void setM33(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM33, value, 1); }
+  void setM34(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM34, value, 0); }
+  void setM41(double value, ExceptionState& exception_state) { MutableMatrix().setM41(value); }
+  void setM42(double value, ExceptionState& exception_state) { MutableMatrix().setM42(value); }
+  void setM43(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM43, value, 0); }
+  void setM44(double value, ExceptionState& exception_state) { Set3DComponent(&TransformationMatrix::setM44, value, 1); }
+
+  DOMMatrix* translateSelf(ExceptionState& exception_state);
+  DOMMatrix* translateSelf(double tx, ExceptionState& exception_state);
+  DOMMatrix* translateSelf(double tx, double ty, ExceptionState& exception_state);
+  DOMMatrix* translateSelf(double tx, double ty, double tz, ExceptionState& exception_state);
+  DOMMatrix* scaleSelf(ExceptionState& exception_state);
+  DOMMatrix* scaleSelf(double scale_x, ExceptionState& exception_state);
+  DOMMatrix* scaleSelf(double scale_x, double scale_y, ExceptionState& exception_state);
+  DOMMatrix* scaleSelf(double scale_x, double scale_y, double scale_z, ExceptionState& exception_state);
+  DOMMatrix* rotateSelf(ExceptionState& exception_state);
+  DOMMatrix* rotateSelf(double rot_x, ExceptionState& exception_state);
+  DOMMatrix* rotateSelf(double rot_x, double rot_y, ExceptionState& exception_state);
+  DOMMatrix* rotateSelf(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state);
+  DOMMatrix* rotateAxisAngleSelf(ExceptionState& exception_state);
+  DOMMatrix* rotateAxisAngleSelf(double x, ExceptionState& exception_state);
+  DOMMatrix* rotateAxisAngleSelf(double x, double y, ExceptionState& exception_state);
+  DOMMatrix* rotateAxisAngleSelf(double x, double y, double z, ExceptionState& exception_state);
+  DOMMatrix* rotateAxisAngleSelf(double x, double y, double z, double angle, ExceptionState& exception_state);
+  DOMMatrix* skewXSelf(ExceptionState& exception_state);
+  DOMMatrix* skewXSelf(double sx, ExceptionState& exception_state);
+  DOMMatrix* skewYSelf(ExceptionState& exception_state);
+  DOMMatrix* skewYSelf(double sy, ExceptionState& exception_state);
+  DOMMatrix* multiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state);
+  DOMMatrix* preMultiplySelf(DOMMatrixReadonly* other, ExceptionState& exception_state);
+  DOMMatrix* invertSelf(ExceptionState& exception_state);
+  DOMMatrix* setMatrixValue(const AtomicString& transform_list, ExceptionState& exception_state);
 
  private:
+  void Set3DComponent(void (TransformationMatrix::*setter)(double), double value, double value_2d);
 };
 
 }  // namespace webf
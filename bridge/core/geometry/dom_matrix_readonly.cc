@@ -3,29 +3,207 @@
  */
 
 #include "dom_matrix_readonly.h"
+#include "binding_call_methods.h"
+#include "core/executing_context.h"
+#include "dom_matrix.h"
 #include "foundation/native_value_converter.h"
 
 namespace webf {
 
+DOMMatrixReadonly* DOMMatrixReadonly::Create(ExecutingContext* context, ExceptionState& exception_state) {
+  return MakeGarbageCollected<DOMMatrixReadonly>(context, TransformationMatrix(), true);
+}
+
 DOMMatrixReadonly* DOMMatrixReadonly::Create(ExecutingContext* context,
                                              const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                                              ExceptionState& exception_state) {
-  return MakeGarbageCollected<DOMMatrixReadonly>(context, init, exception_state);
+  TransformationMatrix matrix;
+  bool is_2d;
+  if (!InitMatrix(context, init, &matrix, &is_2d, exception_state)) {
+    return nullptr;
+  }
+  return MakeGarbageCollected<DOMMatrixReadonly>(context, matrix, is_2d);
 }
 
-DOMMatrixReadonly::DOMMatrixReadonly(ExecutingContext* context,
-                                     const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
-                                     ExceptionState& exception_state)
-    : BindingObject(context->ctx()) {
-  NativeValue arguments[1];
+DOMMatrixReadonly::DOMMatrixReadonly(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d)
+    : BindingObject(context->ctx()), is_2d_(is_2d), matrix_(matrix) {}
+
+bool DOMMatrixReadonly::InitMatrix(ExecutingContext* context,
+                                   const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
+                                   TransformationMatrix* matrix,
+                                   bool* is_2d,
+                                   ExceptionState& exception_state) {
+  *is_2d = true;
+  if (init == nullptr) {
+    return true;
+  }
+
   if (init->IsDomString()) {
-    arguments[0] = NativeValueConverter<NativeTypeString>::ToNativeValue(ctx(), init->GetAsDomString());
-  } else if (init->IsSequenceDouble()) {
-    arguments[0] = NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(init->GetAsSequenceDouble());
+    std::string transform_list = init->GetAsDomString().ToStdString(context->ctx());
+    if (!TransformationMatrix::Parse(transform_list, matrix, is_2d)) {
+      exception_state.ThrowException(context->ctx(), ErrorType::SyntaxError,
+                                     "Failed to parse '" + transform_list + "'.");
+      return false;
+    }
+    return true;
+  }
+
+  const std::vector<double>& sequence = init->GetAsSequenceDouble();
+  if (sequence.size() == 6) {
+    *matrix = TransformationMatrix(sequence[0], sequence[1], sequence[2], sequence[3], sequence[4], sequence[5]);
+  } else if (sequence.size() == TransformationMatrix::kSize) {
+    *matrix = TransformationMatrix(sequence.data());
+    *is_2d = false;
+  } else {
+    exception_state.ThrowException(
+        context->ctx(), ErrorType::TypeError,
+        "The sequence must contain 6 elements for a 2D matrix or 16 elements for a 3D matrix.");
+    return false;
+  }
+  return true;
+}
+
+DOMMatrix* DOMMatrixReadonly::Copy() const {
+  return DOMMatrix::Create(GetExecutingContext(), matrix_, is_2d_);
+}
+
+DOMMatrix* DOMMatrixReadonly::translate(ExceptionState& exception_state) const {
+  return Copy()->translateSelf(exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::translate(double tx, ExceptionState& exception_state) const {
+  return Copy()->translateSelf(tx, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::translate(double tx, double ty, ExceptionState& exception_state) const {
+  return Copy()->translateSelf(tx, ty, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::translate(double tx, double ty, double tz, ExceptionState& exception_state) const {
+  return Copy()->translateSelf(tx, ty, tz, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::scale(ExceptionState& exception_state) const {
+  return Copy()->scaleSelf(exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::scale(double scale_x, ExceptionState& exception_state) const {
+  return Copy()->scaleSelf(scale_x, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::scale(double scale_x, double scale_y, ExceptionState& exception_state) const {
+  return Copy()->scaleSelf(scale_x, scale_y, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::scale(double scale_x,
+                                    double scale_y,
+                                    double scale_z,
+                                    ExceptionState& exception_state) const {
+  return Copy()->scaleSelf(scale_x, scale_y, scale_z, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotate(ExceptionState& exception_state) const {
+  return Copy()->rotateSelf(exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotate(double rot_x, ExceptionState& exception_state) const {
+  return Copy()->rotateSelf(rot_x, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotate(double rot_x, double rot_y, ExceptionState& exception_state) const {
+  return Copy()->rotateSelf(rot_x, rot_y, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotate(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state) const {
+  return Copy()->rotateSelf(rot_x, rot_y, rot_z, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotateAxisAngle(ExceptionState& exception_state) const {
+  return Copy()->rotateAxisAngleSelf(exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotateAxisAngle(double x, ExceptionState& exception_state) const {
+  return Copy()->rotateAxisAngleSelf(x, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotateAxisAngle(double x, double y, ExceptionState& exception_state) const {
+  return Copy()->rotateAxisAngleSelf(x, y, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotateAxisAngle(double x, double y, double z, ExceptionState& exception_state) const {
+  return Copy()->rotateAxisAngleSelf(x, y, z, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::rotateAxisAngle(double x,
+                                              double y,
+                                              double z,
+                                              double angle,
+                                              ExceptionState& exception_state) const {
+  return Copy()->rotateAxisAngleSelf(x, y, z, angle, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::skewX(ExceptionState& exception_state) const {
+  return Copy()->skewXSelf(exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::skewX(double sx, ExceptionState& exception_state) const {
+  return Copy()->skewXSelf(sx, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::skewY(ExceptionState& exception_state) const {
+  return Copy()->skewYSelf(exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::skewY(double sy, ExceptionState& exception_state) const {
+  return Copy()->skewYSelf(sy, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::multiply(DOMMatrixReadonly* other, ExceptionState& exception_state) const {
+  return Copy()->multiplySelf(other, exception_state);
+}
+
+DOMMatrix* DOMMatrixReadonly::flipX(ExceptionState& exception_state) const {
+  DOMMatrix* result = Copy();
+  result->MutableMatrix().Multiply(TransformationMatrix(-1, 0, 0, 1, 0, 0));
+  return result;
+}
+
+DOMMatrix* DOMMatrixReadonly::flipY(ExceptionState& exception_state) const {
+  DOMMatrix* result = Copy();
+  result->MutableMatrix().Multiply(TransformationMatrix(1, 0, 0, -1, 0, 0));
+  return result;
+}
+
+DOMMatrix* DOMMatrixReadonly::inverse(ExceptionState& exception_state) const {
+  return Copy()->invertSelf(exception_state);
+}
+
+AtomicString DOMMatrixReadonly::toString(ExceptionState& exception_state) const {
+  if (!matrix_.IsFinite()) {
+    exception_state.ThrowException(ctx(), ErrorType::TypeError,
+                                   "Cannot be serialized with NaN or Infinity values.");
+    return AtomicString::Empty();
+  }
+  return AtomicString(ctx(), matrix_.ToString(is_2d_));
+}
+
+void DOMMatrixReadonly::SyncToDart(ExceptionState& exception_state) {
+  if (dart_synced_)
+    return;
+
+  std::vector<double> values(matrix_.data(), matrix_.data() + TransformationMatrix::kSize);
+  NativeValue arguments[] = {NativeValueConverter<NativeTypeArray<NativeTypeDouble>>::ToNativeValue(values)};
+  if (dart_created_) {
+    // Refresh the existing dart object, it may be referenced by the objects the matrix was passed to.
+    InvokeBindingMethod(binding_call_methods::kupdateMatrix, 1, arguments, FlushUICommandReason::kStandard,
+                        exception_state);
+  } else {
+    GetExecutingContext()->dartMethodPtr()->createBindingObject(
+        GetExecutingContext()->isDedicated(), GetExecutingContext()->contextId(), bindingObject(),
+        CreateBindingObjectType::kCreateDOMMatrix, arguments, 1);
+    dart_created_ = true;
   }
-  GetExecutingContext()->dartMethodPtr()->createBindingObject(GetExecutingContext()->isDedicated(),
-                                                              GetExecutingContext()->contextId(), bindingObject(),
-                                                              CreateBindingObjectType::kCreateDOMMatrix, arguments, 1);
+  dart_synced_ = !exception_state.HasException();
 }
 
 NativeValue DOMMatrixReadonly::HandleCallFromDartSide(const AtomicString& method,
@@ -35,4 +213,4 @@ NativeValue DOMMatrixReadonly::HandleCallFromDartSide(const AtomicString& method
   return Native_NewNull();
 }
 
-}  // namespace webf
\ No newline at end of file
+}  // namespace webf
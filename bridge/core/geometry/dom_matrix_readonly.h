@@ -8,27 +8,112 @@
 #include "bindings/qjs/script_wrappable.h"
 #include "core/binding_object.h"
 #include "qjs_union_dom_string_sequencedouble.h"
+#include "transformation_matrix.h"
 
 namespace webf {
 
+class DOMMatrix;
+
+// The matrix math runs at native side, a dart side DOMMatrix is only created when the matrix is handed over to dart,
+// e.g. as the transform of a canvas pattern.
 class DOMMatrixReadonly : public BindingObject {
   DEFINE_WRAPPERTYPEINFO();
 
  public:
   using ImplType = DOMMatrixReadonly*;
+  static DOMMatrixReadonly* Create(ExecutingContext* context, ExceptionState& exception_state);
   static DOMMatrixReadonly* Create(ExecutingContext* context,
                                    const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
                                    ExceptionState& exception_state);
 
   DOMMatrixReadonly() = delete;
-  explicit DOMMatrixReadonly(ExecutingContext* context,
-                             const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
-                             ExceptionState& exception_state);
+  explicit DOMMatrixReadonly(ExecutingContext* context, const TransformationMatrix& matrix, bool is_2d);
+
+  double a() const { return matrix_.m11(); }
+  double b() const { return matrix_.m12(); }
+  double c() const { return matrix_.m21(); }
+  double d() const { return matrix_.m22(); }
+  double e() const { return matrix_.m41(); }
+  double f() const { return matrix_.m42(); }
+
+  double m11() const { return matrix_.m11(); }
+  double m12() const { return matrix_.m12(); }
+  double m13() const { return matrix_.m13(); }
+  double m14() const { return matrix_.m14(); }
+  double m21() const { return matrix_.m21(); }
+  double m22() const { return matrix_.m22(); }
+  double m23() const { return matrix_.m23(); }
+  double m24() const { return matrix_.m24(); }
+  double m31() const { return matrix_.m31(); }
+  double m32() const { return matrix_.m32(); }
+  double m33() const { return matrix_.m33(); }
+  double m34() const { return matrix_.m34(); }
+  double m41() const { return matrix_.m41(); }
+  double m42() const { return matrix_.m42(); }
+  double m43() const { return matrix_.m43(); }
+  double m44() const { return matrix_.m44(); }
+
+  bool is2D() const { return is_2d_; }
+  bool isIdentity() const { return matrix_.IsIdentity(); }
+
+  DOMMatrix* translate(ExceptionState& exception_state) const;
+  DOMMatrix* translate(double tx, ExceptionState& exception_state) const;
+  DOMMatrix* translate(double tx, double ty, ExceptionState& exception_state) const;
+  DOMMatrix* translate(double tx, double ty, double tz, ExceptionState& exception_state) const;
+  DOMMatrix* scale(ExceptionState& exception_state) const;
+  DOMMatrix* scale(double scale_x, ExceptionState& exception_state) const;
+  DOMMatrix* scale(double scale_x, double scale_y, ExceptionState& exception_state) const;
+  DOMMatrix* scale(double scale_x, double scale_y, double scale_z, ExceptionState& exception_state) const;
+  DOMMatrix* rotate(ExceptionState& exception_state) const;
+  DOMMatrix* rotate(double rot_x, ExceptionState& exception_state) const;
+  DOMMatrix* rotate(double rot_x, double rot_y, ExceptionState& exception_state) const;
+  DOMMatrix* rotate(double rot_x, double rot_y, double rot_z, ExceptionState& exception_state) const;
+  DOMMatrix* rotateAxisAngle(ExceptionState& exception_state) const;
+  DOMMatrix* rotateAxisAngle(double x, ExceptionState& exception_state) const;
+  DOMMatrix* rotateAxisAngle(double x, double y, ExceptionState& exception_state) const;
+  DOMMatrix* rotateAxisAngle(double x, double y, double z, ExceptionState& exception_state) const;
+  DOMMatrix* rotateAxisAngle(double x, double y, double z, double angle, ExceptionState& exception_state) const;
+  DOMMatrix* skewX(ExceptionState& exception_state) const;
+  DOMMatrix* skewX(double sx, ExceptionState& exception_state) const;
+  DOMMatrix* skewY(ExceptionState& exception_state) const;
+  DOMMatrix* skewY(double sy, ExceptionState& exception_state) const;
+  DOMMatrix* multiply(DOMMatrixReadonly* other, ExceptionState& exception_state) const;
+  DOMMatrix* flipX(ExceptionState& exception_state) const;
+  DOMMatrix* flipY(ExceptionState& exception_state) const;
+  DOMMatrix* inverse(ExceptionState& exception_state) const;
+  AtomicString toString(ExceptionState& exception_state) const;
+
+  const TransformationMatrix& matrix() const { return matrix_; }
+
+  // Creates or refreshes the dart side DOMMatrix with the current values before the matrix is passed to dart.
+  void SyncToDart(ExceptionState& exception_state);
 
   NativeValue HandleCallFromDartSide(const AtomicString& method,
                                      int32_t argc,
                                      const NativeValue* argv,
                                      Dart_Handle dart_object) override;
+
+ protected:
+  static bool InitMatrix(ExecutingContext* context,
+                         const std::shared_ptr<QJSUnionDomStringSequenceDouble>& init,
+                         TransformationMatrix* matrix,
+                         bool* is_2d,
+                         ExceptionState& exception_state);
+
+  // Every mutation goes through here so that the dart side copy is refreshed on the next sync.
+  TransformationMatrix& MutableMatrix() {
+    dart_synced_ = false;
+    return matrix_;
+  }
+
+  bool is_2d_;
+
+ private:
+  DOMMatrix* Copy() const;
+
+  TransformationMatrix matrix_;
+  bool dart_synced_{false};
+  bool dart_created_{false};
 };
 
 }  // namespace webf
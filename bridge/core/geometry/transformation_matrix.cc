@@ -0,0 +1,558 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "transformation_matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace webf {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+double DegToRad(double deg) {
+  return deg * kPi / 180.0;
+}
+
+// out = lhs * rhs, |out| may alias one of the inputs.
+void MultiplyMatrices(const double* lhs, const double* rhs, double* out) {
+  alignas(32) double result[TransformationMatrix::kSize];
+  for (int col = 0; col < 4; col++) {
+    double* r = result + col * 4;
+    r[0] = r[1] = r[2] = r[3] = 0;
+    for (int k = 0; k < 4; k++) {
+      double s = rhs[col * 4 + k];
+      const double* l = lhs + k * 4;
+      for (int row = 0; row < 4; row++) {
+        r[row] += l[row] * s;
+      }
+    }
+  }
+  memcpy(out, result, sizeof(result));
+}
+
+// Formats a double the same way as Number.prototype.toString.
+void AppendNumber(std::string& out, double value) {
+  if (std::isnan(value)) {
+    out += "NaN";
+    return;
+  }
+  if (std::isinf(value)) {
+    out += value > 0 ? "Infinity" : "-Infinity";
+    return;
+  }
+  if (value == 0) {
+    out += '0';
+    return;
+  }
+
+  // Find the shortest digits which round trip.
+  char buffer[32];
+  for (int precision = 1; precision <= 17; precision++) {
+    snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, value);
+    if (strtod(buffer, nullptr) == value)
+      break;
+  }
+
+  const char* p = buffer;
+  if (*p == '-') {
+    out += '-';
+    p++;
+  }
+  std::string digits;
+  for (; *p != 'e'; p++) {
+    if (*p != '.')
+      digits += *p;
+  }
+  // value = 0.digits * 10^n
+  int n = atoi(p + 1) + 1;
+  int k = static_cast<int>(digits.size());
+
+  if (k <= n && n <= 21) {
+    out += digits;
+    out.append(n - k, '0');
+  } else if (0 < n && n <= 21) {
+    out.append(digits, 0, n);
+    out += '.';
+    out.append(digits, n, std::string::npos);
+  } else if (-6 < n && n <= 0) {
+    out += "0.";
+    out.append(-n, '0');
+    out += digits;
+  } else {
+    out += digits[0];
+    if (k > 1) {
+      out += '.';
+      out.append(digits, 1, std::string::npos);
+    }
+    out += 'e';
+    out += n - 1 > 0 ? '+' : '-';
+    out += std::to_string(std::abs(n - 1));
+  }
+}
+
+struct TransformArgument {
+  double value;
+  std::string unit;
+};
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+void SkipSpaces(const char*& p, const char* end) {
+  while (p < end && IsSpace(*p))
+    p++;
+}
+
+bool ToLength(const TransformArgument& argument, double* px) {
+  const std::string& unit = argument.unit;
+  double factor;
+  if (unit.empty()) {
+    // Only zero is allowed to omit the unit.
+    if (argument.value != 0)
+      return false;
+    factor = 1;
+  } else if (unit == "px") {
+    factor = 1;
+  } else if (unit == "in") {
+    factor = 96;
+  } else if (unit == "cm") {
+    factor = 96 / 2.54;
+  } else if (unit == "mm") {
+    factor = 96 / 25.4;
+  } else if (unit == "q") {
+    factor = 96 / 101.6;
+  } else if (unit == "pt") {
+    factor = 96.0 / 72;
+  } else if (unit == "pc") {
+    factor = 16;
+  } else {
+    // Relative lengths can not be resolved without a layout.
+    return false;
+  }
+  *px = argument.value * factor;
+  return true;
+}
+
+bool ToAngle(const TransformArgument& argument, double* deg) {
+  const std::string& unit = argument.unit;
+  if (unit.empty()) {
+    if (argument.value != 0)
+      return false;
+    *deg = 0;
+  } else if (unit == "deg") {
+    *deg = argument.value;
+  } else if (unit == "rad") {
+    *deg = argument.value * 180 / kPi;
+  } else if (unit == "grad") {
+    *deg = argument.value * 0.9;
+  } else if (unit == "turn") {
+    *deg = argument.value * 360;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ToNumber(const TransformArgument& argument, double* number) {
+  if (!argument.unit.empty())
+    return false;
+  *number = argument.value;
+  return true;
+}
+
+bool ParseArguments(const char*& p, const char* end, std::vector<TransformArgument>& arguments) {
+  while (true) {
+    SkipSpaces(p, end);
+    if (p >= end)
+      return false;
+
+    char* number_end;
+    std::string number(p, end - p < 64 ? end - p : 64);
+    TransformArgument argument;
+    argument.value = strtod(number.c_str(), &number_end);
+    size_t length = number_end - number.c_str();
+    if (length == 0 || !std::isfinite(argument.value))
+      return false;
+    p += length;
+    while (p < end && (isalpha(static_cast<unsigned char>(*p)) || *p == '%')) {
+      argument.unit += static_cast<char>(tolower(static_cast<unsigned char>(*p)));
+      p++;
+    }
+    arguments.emplace_back(std::move(argument));
+
+    SkipSpaces(p, end);
+    if (p >= end)
+      return false;
+    if (*p == ')') {
+      p++;
+      return true;
+    }
+    if (*p != ',')
+      return false;
+    p++;
+  }
+}
+
+bool ApplyTransformFunction(const std::string& name,
+                            const std::vector<TransformArgument>& args,
+                            TransformationMatrix* matrix,
+                            bool* is_2d) {
+  size_t argc = args.size();
+  if (name == "matrix" || name == "matrix3d") {
+    size_t count = name == "matrix" ? 6 : 16;
+    if (argc != count)
+      return false;
+    double values[16];
+    for (size_t i = 0; i < count; i++) {
+      if (!ToNumber(args[i], &values[i]))
+        return false;
+    }
+    if (count == 6) {
+      matrix->Multiply(TransformationMatrix(values[0], values[1], values[2], values[3], values[4], values[5]));
+    } else {
+      matrix->Multiply(TransformationMatrix(values));
+      *is_2d = false;
+    }
+    return true;
+  }
+
+  if (name == "translate" || name == "translatex" || name == "translatey" || name == "translatez" ||
+      name == "translate3d") {
+    double t[3] = {0, 0, 0};
+    if (name == "translate") {
+      if (argc < 1 || argc > 2 || !ToLength(args[0], &t[0]) || (argc == 2 && !ToLength(args[1], &t[1])))
+        return false;
+    } else if (name == "translate3d") {
+      if (argc != 3 || !ToLength(args[0], &t[0]) || !ToLength(args[1], &t[1]) || !ToLength(args[2], &t[2]))
+        return false;
+      *is_2d = false;
+    } else {
+      int axis = name.back() - 'x';
+      if (argc != 1 || !ToLength(args[0], &t[axis]))
+        return false;
+      if (axis == 2)
+        *is_2d = false;
+    }
+    matrix->Translate(t[0], t[1], t[2]);
+    return true;
+  }
+
+  if (name == "scale" || name == "scalex" || name == "scaley" || name == "scalez" || name == "scale3d") {
+    double s[3] = {1, 1, 1};
+    if (name == "scale") {
+      if (argc < 1 || argc > 2 || !ToNumber(args[0], &s[0]))
+        return false;
+      s[1] = s[0];
+      if (argc == 2 && !ToNumber(args[1], &s[1]))
+        return false;
+    } else if (name == "scale3d") {
+      if (argc != 3 || !ToNumber(args[0], &s[0]) || !ToNumber(args[1], &s[1]) || !ToNumber(args[2], &s[2]))
+        return false;
+      *is_2d = false;
+    } else {
+      int axis = name.back() - 'x';
+      if (argc != 1 || !ToNumber(args[0], &s[axis]))
+        return false;
+      if (axis == 2)
+        *is_2d = false;
+    }
+    matrix->Scale(s[0], s[1], s[2]);
+    return true;
+  }
+
+  if (name == "rotate" || name == "rotatex" || name == "rotatey" || name == "rotatez") {
+    double angle;
+    if (argc != 1 || !ToAngle(args[0], &angle))
+      return false;
+    if (name == "rotate") {
+      matrix->RotateAxisAngle(0, 0, 1, angle);
+      return true;
+    }
+    int axis = name.back() - 'x';
+    matrix->RotateAxisAngle(axis == 0, axis == 1, axis == 2, angle);
+    *is_2d = false;
+    return true;
+  }
+
+  if (name == "rotate3d") {
+    double v[3], angle;
+    if (argc != 4 || !ToNumber(args[0], &v[0]) || !ToNumber(args[1], &v[1]) || !ToNumber(args[2], &v[2]) ||
+        !ToAngle(args[3], &angle))
+      return false;
+    matrix->RotateAxisAngle(v[0], v[1], v[2], angle);
+    *is_2d = false;
+    return true;
+  }
+
+  if (name == "skew" || name == "skewx" || name == "skewy") {
+    double ax = 0, ay = 0;
+    if (name == "skew") {
+      if (argc < 1 || argc > 2 || !ToAngle(args[0], &ax) || (argc == 2 && !ToAngle(args[1], &ay)))
+        return false;
+    } else if (argc != 1 || !ToAngle(args[0], name == "skewx" ? &ax : &ay)) {
+      return false;
+    }
+    matrix->Multiply(TransformationMatrix(1, tan(DegToRad(ay)), tan(DegToRad(ax)), 1, 0, 0));
+    return true;
+  }
+
+  if (name == "perspective") {
+    double distance;
+    if (argc != 1 || !ToLength(args[0], &distance) || distance < 0)
+      return false;
+    TransformationMatrix perspective;
+    if (distance != 0) {
+      perspective.setM34(-1 / distance);
+    }
+    matrix->Multiply(perspective);
+    *is_2d = false;
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+TransformationMatrix::TransformationMatrix(double a, double b, double c, double d, double e, double f) {
+  MakeIdentity();
+  m_[0] = a;
+  m_[1] = b;
+  m_[4] = c;
+  m_[5] = d;
+  m_[12] = e;
+  m_[13] = f;
+}
+
+TransformationMatrix::TransformationMatrix(const double* values) {
+  memcpy(m_, values, sizeof(m_));
+}
+
+void TransformationMatrix::MakeIdentity() {
+  memset(m_, 0, sizeof(m_));
+  m_[0] = m_[5] = m_[10] = m_[15] = 1;
+}
+
+bool TransformationMatrix::IsIdentity() const {
+  for (int i = 0; i < kSize; i++) {
+    if (m_[i] != (i % 5 == 0 ? 1 : 0))
+      return false;
+  }
+  return true;
+}
+
+bool TransformationMatrix::Is2D() const {
+  return m_[2] == 0 && m_[3] == 0 && m_[6] == 0 && m_[7] == 0 && m_[8] == 0 && m_[9] == 0 && m_[10] == 1 &&
+         m_[11] == 0 && m_[14] == 0 && m_[15] == 1;
+}
+
+bool TransformationMatrix::IsFinite() const {
+  for (double v : m_) {
+    if (!std::isfinite(v))
+      return false;
+  }
+  return true;
+}
+
+void TransformationMatrix::Multiply(const TransformationMatrix& other) {
+  MultiplyMatrices(m_, other.m_, m_);
+}
+
+void TransformationMatrix::PreMultiply(const TransformationMatrix& other) {
+  MultiplyMatrices(other.m_, m_, m_);
+}
+
+bool TransformationMatrix::Invert() {
+  if (Is2D()) {
+    double det = m_[0] * m_[5] - m_[1] * m_[4];
+    if (det == 0 || !std::isfinite(det)) {
+      std::fill(std::begin(m_), std::end(m_), std::numeric_limits<double>::quiet_NaN());
+      return false;
+    }
+    double a = m_[5] / det;
+    double b = -m_[1] / det;
+    double c = -m_[4] / det;
+    double d = m_[0] / det;
+    double e = -(a * m_[12] + c * m_[13]);
+    double f = -(b * m_[12] + d * m_[13]);
+    *this = TransformationMatrix(a, b, c, d, e, f);
+    return true;
+  }
+
+  const double* m = m_;
+  double inv[kSize];
+  inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] +
+           m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+  inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] -
+           m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+  inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] +
+           m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+  inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] -
+            m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+  inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] -
+           m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+  inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] +
+           m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+  inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] -
+           m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+  inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] +
+            m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+  inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] +
+           m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+  inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] -
+           m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+  inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] +
+            m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+  inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] -
+            m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+  inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] -
+           m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+  inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] +
+           m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+  inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] -
+            m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+  inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] +
+            m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+  double det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+  if (det == 0 || !std::isfinite(det)) {
+    std::fill(std::begin(m_), std::end(m_), std::numeric_limits<double>::quiet_NaN());
+    return false;
+  }
+
+  double inv_det = 1.0 / det;
+  for (int i = 0; i < kSize; i++) {
+    m_[i] = inv[i] * inv_det;
+  }
+  return true;
+}
+
+void TransformationMatrix::Translate(double tx, double ty, double tz) {
+  for (int row = 0; row < 4; row++) {
+    m_[12 + row] += tx * m_[row] + ty * m_[4 + row] + tz * m_[8 + row];
+  }
+}
+
+void TransformationMatrix::Scale(double sx, double sy, double sz) {
+  for (int row = 0; row < 4; row++) {
+    m_[row] *= sx;
+    m_[4 + row] *= sy;
+    m_[8 + row] *= sz;
+  }
+}
+
+void TransformationMatrix::RotateAxisAngle(double x, double y, double z, double angle) {
+  double length = std::sqrt(x * x + y * y + z * z);
+  if (length == 0 || angle == 0)
+    return;
+  x /= length;
+  y /= length;
+  z /= length;
+
+  double rad = DegToRad(angle);
+  double sc = std::sin(rad / 2) * std::cos(rad / 2);
+  double sq = std::sin(rad / 2) * std::sin(rad / 2);
+
+  TransformationMatrix rotation;
+  rotation.m_[0] = 1 - 2 * (y * y + z * z) * sq;
+  rotation.m_[1] = 2 * (x * y * sq + z * sc);
+  rotation.m_[2] = 2 * (x * z * sq - y * sc);
+  rotation.m_[4] = 2 * (x * y * sq - z * sc);
+  rotation.m_[5] = 1 - 2 * (x * x + z * z) * sq;
+  rotation.m_[6] = 2 * (y * z * sq + x * sc);
+  rotation.m_[8] = 2 * (x * z * sq + y * sc);
+  rotation.m_[9] = 2 * (y * z * sq - x * sc);
+  rotation.m_[10] = 1 - 2 * (x * x + y * y) * sq;
+  Multiply(rotation);
+}
+
+void TransformationMatrix::SkewX(double angle) {
+  double t = tan(DegToRad(angle));
+  for (int row = 0; row < 4; row++) {
+    m_[4 + row] += t * m_[row];
+  }
+}
+
+void TransformationMatrix::SkewY(double angle) {
+  double t = tan(DegToRad(angle));
+  for (int row = 0; row < 4; row++) {
+    m_[row] += t * m_[4 + row];
+  }
+}
+
+std::string TransformationMatrix::ToString(bool as_2d) const {
+  std::string result;
+  if (as_2d) {
+    const int indexes[] = {0, 1, 4, 5, 12, 13};
+    result = "matrix(";
+    for (int i = 0; i < 6; i++) {
+      if (i > 0)
+        result += ", ";
+      AppendNumber(result, m_[indexes[i]]);
+    }
+  } else {
+    result = "matrix3d(";
+    for (int i = 0; i < kSize; i++) {
+      if (i > 0)
+        result += ", ";
+      AppendNumber(result, m_[i]);
+    }
+  }
+  result += ')';
+  return result;
+}
+
+bool TransformationMatrix::Parse(const std::string& text, TransformationMatrix* result, bool* is_2d) {
+  const char* p = text.c_str();
+  const char* end = p + text.size();
+  TransformationMatrix matrix;
+  *is_2d = true;
+
+  std::vector<TransformArgument> arguments;
+  bool has_function = false;
+  SkipSpaces(p, end);
+  while (p < end) {
+    std::string name;
+    while (p < end && (isalnum(static_cast<unsigned char>(*p)))) {
+      name += static_cast<char>(tolower(static_cast<unsigned char>(*p)));
+      p++;
+    }
+    SkipSpaces(p, end);
+    if (name == "none" && !has_function && p == end) {
+      *result = matrix;
+      return true;
+    }
+    if (name.empty() || p >= end || *p != '(')
+      return false;
+    p++;
+
+    arguments.clear();
+    if (!ParseArguments(p, end, arguments) || !ApplyTransformFunction(name, arguments, &matrix, is_2d))
+      return false;
+    has_function = true;
+    SkipSpaces(p, end);
+  }
+
+  // An empty or whitespace only list is the identity matrix.
+  *result = matrix;
+  return true;
+}
+
+bool TransformationMatrix::operator==(const TransformationMatrix& other) const {
+  for (int i = 0; i < kSize; i++) {
+    if (m_[i] != other.m_[i])
+      return false;
+  }
+  return true;
+}
+
+}  // namespace webf
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_GEOMETRY_TRANSFORMATION_MATRIX_H_
+#define WEBF_CORE_GEOMETRY_TRANSFORMATION_MATRIX_H_
+
+#include <string>
+
+namespace webf {
+
+// A 4x4 matrix of doubles stored in column-major order, the same layout used by DOMMatrix (m11, m12, m13, m14, m21,
+// ...) and the Matrix4 at dart side. Products are computed column by column as linear combinations of the columns of
+// the left hand matrix, which keeps the inner loops contiguous for the compiler to vectorize.
+class TransformationMatrix {
+ public:
+  static constexpr int kSize = 16;
+
+  TransformationMatrix() { MakeIdentity(); }
+  TransformationMatrix(double a, double b, double c, double d, double e, double f);
+  // |values| holds 16 doubles in column-major order.
+  explicit TransformationMatrix(const double* values);
+
+  double m11() const { return m_[0]; }
+  double m12() const { return m_[1]; }
+  double m13() const { return m_[2]; }
+  double m14() const { return m_[3]; }
+  double m21() const { return m_[4]; }
+  double m22() const { return m_[5]; }
+  double m23() const { return m_[6]; }
+  double m24() const { return m_[7]; }
+  double m31() const { return m_[8]; }
+  double m32() const { return m_[9]; }
+  double m33() const { return m_[10]; }
+  double m34() const { return m_[11]; }
+  double m41() const { return m_[12]; }
+  double m42() const { return m_[13]; }
+  double m43() const { return m_[14]; }
+  double m44() const { return m_[15]; }
+
+  void setM11(double v) { m_[0] = v; }
+  void setM12(double v) { m_[1] = v; }
+  void setM13(double v) { m_[2] = v; }
+  void setM14(double v) { m_[3] = v; }
+  void setM21(double v) { m_[4] = v; }
+  void setM22(double v) { m_[5] = v; }
+  void setM23(double v) { m_[6] = v; }
+  void setM24(double v) { m_[7] = v; }
+  void setM31(double v) { m_[8] = v; }
+  void setM32(double v) { m_[9] = v; }
+  void setM33(double v) { m_[10] = v; }
+  void setM34(double v) { m_[11] = v; }
+  void setM41(double v) { m_[12] = v; }
+  void setM42(double v) { m_[13] = v; }
+  void setM43(double v) { m_[14] = v; }
+  void setM44(double v) { m_[15] = v; }
+
+  const double* data() const { return m_; }
+
+  void MakeIdentity();
+  bool IsIdentity() const;
+  // True when the matrix only has 2D components, i.e. it could be written as matrix(a, b, c, d, e, f).
+  bool Is2D() const;
+  bool IsFinite() const;
+
+  // this = this * other.
+  void Multiply(const TransformationMatrix& other);
+  // this = other * this.
+  void PreMultiply(const TransformationMatrix& other);
+  // Inverts the matrix in place, returns false and fills the matrix with NaN when it is not invertible.
+  bool Invert();
+
+  // The following operations post-multiply the matrix, angles are in degrees.
+  void Translate(double tx, double ty, double tz);
+  void Scale(double sx, double sy, double sz);
+  void RotateAxisAngle(double x, double y, double z, double angle);
+  void SkewX(double angle);
+  void SkewY(double angle);
+
+  // Serializes as matrix() or matrix3d() with the shortest numbers which round trip.
+  std::string ToString(bool as_2d) const;
+
+  // Parses a CSS <transform-list> (or "none") with absolute lengths, the result is the product of all functions.
+  // An empty string gives the identity matrix.
+  // |is_2d| is cleared when any of the functions is a 3D one.
+  static bool Parse(const std::string& text, TransformationMatrix* result, bool* is_2d);
+
+  bool operator==(const TransformationMatrix& other) const;
+
+ private:
+  alignas(32) double m_[kSize];
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_GEOMETRY_TRANSFORMATION_MATRIX_H_
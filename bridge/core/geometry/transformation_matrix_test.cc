@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "transformation_matrix.h"
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(TransformationMatrix, multiplyAndInvert) {
+  TransformationMatrix matrix;
+  matrix.Translate(10, 20, 0);
+  matrix.Scale(2, 3, 1);
+  EXPECT_TRUE(matrix.Is2D());
+  EXPECT_EQ(matrix.ToString(true), "matrix(2, 0, 0, 3, 10, 20)");
+
+  TransformationMatrix inverse = matrix;
+  EXPECT_TRUE(inverse.Invert());
+  inverse.Multiply(matrix);
+  EXPECT_TRUE(inverse.IsIdentity());
+
+  TransformationMatrix perspective;
+  perspective.setM34(-0.01);
+  perspective.RotateAxisAngle(1, 1, 0, 30);
+  TransformationMatrix perspective_inverse = perspective;
+  EXPECT_TRUE(perspective_inverse.Invert());
+  perspective_inverse.PreMultiply(perspective);
+  for (int i = 0; i < TransformationMatrix::kSize; i++) {
+    EXPECT_NEAR(perspective_inverse.data()[i], i % 5 == 0 ? 1 : 0, 1e-12);
+  }
+
+  TransformationMatrix singular(0, 0, 0, 0, 0, 0);
+  EXPECT_FALSE(singular.Invert());
+  EXPECT_EQ(singular.ToString(true), "matrix(NaN, NaN, NaN, NaN, NaN, NaN)");
+}
+
+TEST(TransformationMatrix, parse) {
+  TransformationMatrix matrix;
+  bool is_2d;
+  EXPECT_TRUE(TransformationMatrix::Parse("translate(10px, 5px) scale(2)", &matrix, &is_2d));
+  EXPECT_TRUE(is_2d);
+  EXPECT_EQ(matrix.ToString(true), "matrix(2, 0, 0, 2, 10, 5)");
+
+  EXPECT_TRUE(TransformationMatrix::Parse("  none ", &matrix, &is_2d));
+  EXPECT_TRUE(matrix.IsIdentity());
+
+  EXPECT_TRUE(TransformationMatrix::Parse("matrix(1,2,3,4,5,6)", &matrix, &is_2d));
+  EXPECT_EQ(matrix, TransformationMatrix(1, 2, 3, 4, 5, 6));
+
+  EXPECT_TRUE(TransformationMatrix::Parse("translateZ(1in) rotate(0.5turn)", &matrix, &is_2d));
+  EXPECT_FALSE(is_2d);
+  EXPECT_EQ(matrix.m43(), 96);
+  EXPECT_NEAR(matrix.m11(), -1, 1e-12);
+
+  EXPECT_FALSE(TransformationMatrix::Parse("translate(1em)", &matrix, &is_2d));
+  EXPECT_FALSE(TransformationMatrix::Parse("translate(10)", &matrix, &is_2d));
+  EXPECT_FALSE(TransformationMatrix::Parse("scale(1", &matrix, &is_2d));
+}
+
+TEST(TransformationMatrix, parseEmptyAsIdentity) {
+  TransformationMatrix matrix(1, 2, 3, 4, 5, 6);
+  bool is_2d = false;
+  EXPECT_TRUE(TransformationMatrix::Parse("", &matrix, &is_2d));
+  EXPECT_TRUE(matrix.IsIdentity());
+  EXPECT_TRUE(is_2d);
+
+  matrix = TransformationMatrix(1, 2, 3, 4, 5, 6);
+  EXPECT_TRUE(TransformationMatrix::Parse(" \t\n ", &matrix, &is_2d));
+  EXPECT_TRUE(matrix.IsIdentity());
+
+  EXPECT_FALSE(TransformationMatrix::Parse(" , ", &matrix, &is_2d));
+}
+
+TEST(TransformationMatrix, serialize) {
+  TransformationMatrix matrix(0.1, -0.5, 1e21, 1e-7, 123456789, 0.000001);
+  EXPECT_EQ(matrix.ToString(true), "matrix(0.1, -0.5, 1e+21, 1e-7, 123456789, 0.000001)");
+  EXPECT_EQ(TransformationMatrix().ToString(false), "matrix3d(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1)");
+}
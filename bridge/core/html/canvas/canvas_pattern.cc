@@ -12,6 +12,9 @@ CanvasPattern::CanvasPattern(ExecutingContext* context, NativeBindingObject* nat
     : BindingObject(context->ctx(), native_binding_object) {}
 
 void CanvasPattern::setTransform(DOMMatrix* dom_matrix, ExceptionState& exception_state) {
+  dom_matrix->SyncToDart(exception_state);
+  if (exception_state.HasException())
+    return;
   NativeValue arguments[] = {NativeValueConverter<NativeTypePointer<DOMMatrix>>::ToNativeValue(dom_matrix)};
   InvokeBindingMethod(binding_call_methods::ksetTransform, 1, arguments, FlushUICommandReason::kDependentsOnElement,
                       exception_state);
@@ -5,8 +5,8 @@
 
 #include "widget_element.h"
 #include "binding_call_methods.h"
-#include "built_in_string.h"
 #include "core/dom/document.h"
+#include "core/executing_context.h"
 #include "foundation/native_value_converter.h"
 
 namespace webf {
@@ -27,44 +27,100 @@ bool WidgetElement::IsValidName(const AtomicString& name) {
   return false;
 }
 
-bool WidgetElement::NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) {
-  return GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(key.ToStdString(ctx()));
+bool WidgetElement::IsWidgetElement() const {
+  return true;
+}
+
+JSValue WidgetElement::QuickJSObjectPrototype() {
+  return ShapePrototype();
 }
 
-void WidgetElement::NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState& exception_state) {
-  NativeValue result = GetAllBindingPropertyNames(exception_state);
-  assert(result.tag == NativeTag::TAG_LIST);
-  std::vector<AtomicString> property_names =
-      NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), result);
-  names.reserve(property_names.size());
-  for (auto& property_name : property_names) {
-    names.emplace_back(property_name);
+void WidgetElement::CloneNonAttributePropertiesFrom(const Element& other, CloneChildrenFlag flag) {
+  // Expando properties are own properties of the element, the dart properties live in the prototype. The own property
+  // hooks of the wrapper also report the names of the class prototype, skip them so no accessor is read.
+  JSValue source = other.ToQuickJSUnsafe();
+  JSValue target = ToQuickJSUnsafe();
+  JSValue class_prototype = GetExecutingContext()->contextData()->prototypeForType(GetWrapperTypeInfo());
+  JSPropertyEnum* properties;
+  uint32_t length;
+  if (JS_GetOwnPropertyNames(ctx(), &properties, &length, source, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0)
+    return;
+  for (uint32_t i = 0; i < length; i++) {
+    if (JS_GetOwnProperty(ctx(), nullptr, class_prototype, properties[i].atom) == 0) {
+      JSValue value = JS_GetProperty(ctx(), source, properties[i].atom);
+      if (!JS_IsException(value)) {
+        JS_DefinePropertyValue(ctx(), target, properties[i].atom, value, JS_PROP_C_W_E);
+      }
+    }
+    JS_FreeAtom(ctx(), properties[i].atom);
   }
+  js_free(ctx(), properties);
 }
 
-ScriptValue WidgetElement::item(const AtomicString& key, ExceptionState& exception_state) {
-  if (unimplemented_properties_.count(key) > 0) {
-    return unimplemented_properties_[key];
+JSValue WidgetElement::PropertyGetterCallback(JSContext* ctx,
+                                              JSValueConst this_val,
+                                              int argc,
+                                              JSValueConst* argv,
+                                              int magic,
+                                              JSValue* func_data) {
+  auto* element = static_cast<WidgetElement*>(JS_GetOpaque(this_val, GetStaticWrapperTypeInfo()->classId));
+  if (element == nullptr) {
+    return JS_ThrowTypeError(ctx, "Illegal invocation");
   }
 
-  std::string shape_key = tagName().ToStdString(ctx());
-  std::string property_key = key.ToStdString(ctx());
-  bool have_shape = true;
+  ExceptionState exception_state;
+  NativeValue result = element->GetBindingProperty(AtomicString(ctx, static_cast<JSAtom>(magic)),
+                                                   FlushUICommandReason::kDependentsOnElement, exception_state);
+  if (UNLIKELY(exception_state.HasException())) {
+    return exception_state.ToQuickJS();
+  }
+  return JS_DupValue(ctx, ScriptValue(ctx, result).QJSValue());
+}
 
-  if (!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(shape_key)) {
-    GetExecutingContext()->FlushUICommand(this, FlushUICommandReason::kDependentsOnElement);
-    have_shape = false;
+JSValue WidgetElement::PropertySetterCallback(JSContext* ctx,
+                                              JSValueConst this_val,
+                                              int argc,
+                                              JSValueConst* argv,
+                                              int magic,
+                                              JSValue* func_data) {
+  auto* element = static_cast<WidgetElement*>(JS_GetOpaque(this_val, GetStaticWrapperTypeInfo()->classId));
+  if (element == nullptr) {
+    return JS_ThrowTypeError(ctx, "Illegal invocation");
+  }
+
+  ExceptionState exception_state;
+  NativeValue value = ScriptValue(ctx, argc > 0 ? argv[0] : JS_UNDEFINED).ToNative(ctx, exception_state);
+  if (UNLIKELY(exception_state.HasException())) {
+    return exception_state.ToQuickJS();
+  }
+  element->SetBindingProperty(AtomicString(ctx, static_cast<JSAtom>(magic)), value, exception_state);
+  if (UNLIKELY(exception_state.HasException())) {
+    return exception_state.ToQuickJS();
   }
+  return JS_UNDEFINED;
+}
 
-  if (key == built_in_string::kSymbol_toStringTag) {
-    return ScriptValue(ctx(), tagName().ToNativeString(ctx()).release());
+JSValue WidgetElement::ShapePrototype() {
+  ExecutionContextData* context_data = GetExecutingContext()->contextData();
+  JSValue prototype = context_data->widgetElementPrototype(tagName().Impl());
+  if (!JS_IsNull(prototype)) {
+    return JS_DupValue(ctx(), prototype);
   }
 
-  const WidgetElementShape* shape = nullptr;
+  // A tag without a dart widget is not asked again until dart side defines another custom element.
+  DartContextData* dart_data = GetExecutingContext()->dartIsolateContext()->EnsureData().get();
+  int64_t definitions = dart_data->WidgetElementDefinitions();
+  prototype = context_data->unshapedWidgetElementPrototype(tagName().Impl(), definitions);
+  if (!JS_IsNull(prototype)) {
+    return JS_DupValue(ctx(), prototype);
+  }
 
-  if (have_shape) {
-    shape = GetExecutingContext()->dartIsolateContext()->EnsureData()->GetWidgetElementShape(shape_key);
-  } else {
+  std::string shape_key = tagName().ToStdString(ctx());
+  const WidgetElementShape* shape = dart_data->GetWidgetElementShape(shape_key);
+
+  if (shape == nullptr) {
+    // The dart side element must exist before it can report the shape of its class.
+    GetExecutingContext()->FlushUICommand(this, FlushUICommandReason::kDependentsOnElement);
     NativeValue raw_shapes[3];
     bool is_success = GetExecutingContext()->dartMethodPtr()->getWidgetElementShape(
         GetExecutingContext()->isDedicated(), contextId(), bindingObject(),
@@ -74,88 +130,51 @@ ScriptValue WidgetElement::item(const AtomicString& key, ExceptionState& excepti
     }
   }
 
+  prototype = CompileShapePrototype(shape);
   if (shape != nullptr) {
-    if (shape->built_in_properties_.find(property_key) != shape->built_in_properties_.end()) {
-      return ScriptValue(ctx(), GetBindingProperty(key, FlushUICommandReason::kDependentsOnElement, exception_state));
-    }
-
-    if (shape->built_in_methods_.find(property_key) != shape->built_in_methods_.end()) {
-      if (cached_methods_.count(key) > 0) {
-        return cached_methods_[key];
-      }
-
-      auto func = CreateSyncMethodFunc(key);
-      cached_methods_[key] = func;
-      return func;
-    }
-
-    if (shape->built_in_async_methods_.find(property_key) != shape->built_in_async_methods_.end()) {
-      if (async_cached_methods_.count(key) > 0) {
-        return async_cached_methods_[key];
-      }
-
-      auto func = CreateAsyncMethodFunc(key);
-      async_cached_methods_[key] = CreateAsyncMethodFunc(key);
-      return func;
-    }
+    context_data->setWidgetElementPrototype(tagName().Impl(), JS_DupValue(ctx(), prototype));
+  } else {
+    context_data->setUnshapedWidgetElementPrototype(tagName().Impl(), JS_DupValue(ctx(), prototype), definitions);
   }
-
-  return ScriptValue::Undefined(ctx());
+  return prototype;
 }
 
-bool WidgetElement::SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state) {
-  if (!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(tagName().ToStdString(ctx()))) {
-    GetExecutingContext()->FlushUICommand(this, FlushUICommandReason::kDependentsOnElement);
-  }
+JSValue WidgetElement::CompileShapePrototype(const WidgetElementShape* shape) {
+  JSValue parent_prototype = GetExecutingContext()->contextData()->prototypeForType(GetWrapperTypeInfo());
+  JSValue prototype = JS_NewObjectProto(ctx(), parent_prototype);
 
-  auto shape =
-      GetExecutingContext()->dartIsolateContext()->EnsureData()->GetWidgetElementShape(tagName().ToStdString(ctx()));
-  // This property is defined in the Dart side
-  if (shape != nullptr && shape->built_in_properties_.count(key.ToStdString(ctx())) > 0) {
-    NativeValue result = SetBindingProperty(key, value.ToNative(ctx(), exception_state), exception_state);
-    return NativeValueConverter<NativeTypeBool>::FromNativeValue(result);
-  }
+  JS_DefinePropertyValue(ctx(), prototype, JS_ATOM_Symbol_toStringTag, tagName().ToQuickJS(ctx()),
+                         JS_PROP_CONFIGURABLE);
 
-  // This property is defined in WidgetElement.prototype, should return false to let it handled in the prototype
-  // methods.
-  JSValue prototypeObject = GetExecutingContext()->contextData()->prototypeForType(GetWrapperTypeInfo());
-  if (JS_HasProperty(ctx(), prototypeObject, key.Impl())) {
-    return false;
+  if (shape == nullptr) {
+    return prototype;
   }
 
-  // Nothing at all
-  unimplemented_properties_[key] = value;
-  return true;
-}
-
-bool WidgetElement::DeleteItem(const webf::AtomicString& key, webf::ExceptionState& exception_state) {
-  return true;
-}
-
-bool WidgetElement::IsWidgetElement() const {
-  return true;
-}
-
-void WidgetElement::Trace(GCVisitor* visitor) const {
-  HTMLElement::Trace(visitor);
-  for (auto& entry : unimplemented_properties_) {
-    entry.second.Trace(visitor);
+  for (auto& property : shape->built_in_properties_) {
+    JSAtom key = JS_NewAtomLen(ctx(), property.c_str(), property.length());
+    // The getter and setter keep the atom alive through their data, so the atom could be used as the magic value.
+    JSValue data = JS_AtomToString(ctx(), key);
+    JSValue getter = JS_NewCFunctionData(ctx(), PropertyGetterCallback, 0, static_cast<int>(key), 1, &data);
+    JSValue setter = JS_NewCFunctionData(ctx(), PropertySetterCallback, 1, static_cast<int>(key), 1, &data);
+    JS_DefinePropertyGetSet(ctx(), prototype, key, getter, setter, JS_PROP_ENUMERABLE | JS_PROP_CONFIGURABLE);
+    JS_FreeValue(ctx(), data);
+    JS_FreeAtom(ctx(), key);
   }
 
-  for (auto& entry : cached_methods_) {
-    entry.second.Trace(visitor);
-  }
+  auto define_methods = [this, prototype](const std::unordered_set<std::string>& methods, QJSFunctionCallback callback,
+                                          int32_t length) {
+    for (auto& method : methods) {
+      auto* data = new BindingObject::AnonymousFunctionData();
+      data->method_name = method;
+      JSValue function = QJSFunction::Create(ctx(), callback, length, data)->ToQuickJS();
+      JS_DefinePropertyValueStr(ctx(), prototype, method.c_str(), function,
+                                JS_PROP_WRITABLE | JS_PROP_ENUMERABLE | JS_PROP_CONFIGURABLE);
+    }
+  };
+  define_methods(shape->built_in_methods_, BindingObject::AnonymousFunctionCallback, 1);
+  define_methods(shape->built_in_async_methods_, BindingObject::AnonymousAsyncFunctionCallback, 4);
 
-  for (auto& entry : async_cached_methods_) {
-    entry.second.Trace(visitor);
-  }
-}
-
-void WidgetElement::CloneNonAttributePropertiesFrom(const Element& other, CloneChildrenFlag flag) {
-  auto* other_widget_element = DynamicTo<WidgetElement>(other);
-  if (other_widget_element) {
-    unimplemented_properties_ = other_widget_element->unimplemented_properties_;
-  }
+  return prototype;
 }
 
 const WidgetElementShape* WidgetElement::SaveWidgetElementsShapeData(const NativeValue* argv) {
@@ -185,18 +204,4 @@ const WidgetElementShape* WidgetElement::SaveWidgetElementsShapeData(const Nativ
   return shape.get();
 }
 
-ScriptValue WidgetElement::CreateSyncMethodFunc(const AtomicString& method_name) {
-  auto* data = new BindingObject::AnonymousFunctionData();
-  data->method_name = method_name.ToStdString(ctx());
-  return ScriptValue(ctx(),
-                     QJSFunction::Create(ctx(), BindingObject::AnonymousFunctionCallback, 1, data)->ToQuickJSUnsafe());
-}
-
-ScriptValue WidgetElement::CreateAsyncMethodFunc(const AtomicString& method_name) {
-  auto* data = new BindingObject::AnonymousFunctionData();
-  data->method_name = method_name.ToStdString(ctx());
-  return ScriptValue(
-      ctx(), QJSFunction::Create(ctx(), BindingObject::AnonymousAsyncFunctionCallback, 4, data)->ToQuickJSUnsafe());
-}
-
-}  // namespace webf
\ No newline at end of file
+}  // namespace webf
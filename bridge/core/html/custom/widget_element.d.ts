@@ -1,6 +1,5 @@
 import {HTMLElement} from "../html_element";
 
 interface WidgetElement extends HTMLElement {
-    [key: string]: any;
     new(): void;
 }
\ No newline at end of file
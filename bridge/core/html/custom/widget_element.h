@@ -5,8 +5,6 @@
 #ifndef WEBF_CORE_DOM_WIDGET_ELEMENT_H_
 #define WEBF_CORE_DOM_WIDGET_ELEMENT_H_
 
-#include <set>
-#include <unordered_map>
 #include "core/html/html_element.h"
 
 namespace webf {
@@ -15,6 +13,10 @@ namespace webf {
 //
 // There must be a corresponding Dart WidgetElement class implements the properties and methods with this element.
 // The WidgetElement class in C++ is a wrapper and proxy all operations to the dart side.
+//
+// The shape of the dart class is fetched once per tag name and compiled into a prototype object, which holds an
+// accessor for every property and a function for every method. Each element of that tag uses the compiled prototype,
+// so property lookups go through the regular QuickJS prototype chain instead of an exotic hook.
 class WidgetElement : public HTMLElement {
   DEFINE_WRAPPERTYPEINFO();
 
@@ -24,26 +26,31 @@ class WidgetElement : public HTMLElement {
 
   static bool IsValidName(const AtomicString& name);
 
-  bool NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state);
-  void NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState&);
-
-  ScriptValue item(const AtomicString& key, ExceptionState& exception_state);
-  bool SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state);
-  bool DeleteItem(const AtomicString& key, ExceptionState& exception_state);
-
   bool IsWidgetElement() const override;
 
   void CloneNonAttributePropertiesFrom(const Element&, CloneChildrenFlag) override;
 
-  void Trace(GCVisitor* visitor) const override;
+ protected:
+  JSValue QuickJSObjectPrototype() override;
 
  private:
-  ScriptValue CreateSyncMethodFunc(const AtomicString& method_name);
-  ScriptValue CreateAsyncMethodFunc(const AtomicString& method_name);
+  static JSValue PropertyGetterCallback(JSContext* ctx,
+                                        JSValueConst this_val,
+                                        int argc,
+                                        JSValueConst* argv,
+                                        int magic,
+                                        JSValue* func_data);
+  static JSValue PropertySetterCallback(JSContext* ctx,
+                                        JSValueConst this_val,
+                                        int argc,
+                                        JSValueConst* argv,
+                                        int magic,
+                                        JSValue* func_data);
+
+  // Returns a new reference to the prototype compiled from the dart side shape of this tag.
+  JSValue ShapePrototype();
+  JSValue CompileShapePrototype(const WidgetElementShape* shape);
   const WidgetElementShape* SaveWidgetElementsShapeData(const NativeValue* argv);
-  std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> cached_methods_;
-  std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> async_cached_methods_;
-  std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> unimplemented_properties_;
 };
 
 template <>
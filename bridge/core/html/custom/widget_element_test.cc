@@ -3,7 +3,9 @@
  */
 
 #include "widget_element.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
+#include "webf_bridge.h"
 #include "webf_test_env.h"
 
 using namespace webf;
@@ -49,3 +51,146 @@ TEST(WidgetElement, getPropertyWithSymbolToStringTag) {
 
   EXPECT_EQ(errorCalled, false);
 }
+
+namespace {
+
+int widget_property_reads = 0;
+
+// Dart side of the widget elements: every property reads 42 and every sync method returns its argument count.
+void InvokeWidgetElementBinding(double contextId,
+                                int64_t profile_id,
+                                const NativeBindingObject* binding_object,
+                                NativeValue* return_value,
+                                NativeValue* method,
+                                int32_t argc,
+                                const NativeValue* argv) {
+  for (int32_t i = 0; i < argc; i++) {
+    if (argv[i].tag == NativeTag::TAG_STRING)
+      delete reinterpret_cast<AutoFreeNativeString*>(argv[i].u.ptr);
+  }
+  if (method->tag != NativeTag::TAG_INT)
+    return;
+  switch (method->u.int64) {
+    case BindingMethodCallOperations::kGetProperty:
+      widget_property_reads++;
+      *return_value = Native_NewFloat64(42);
+      break;
+    case BindingMethodCallOperations::kAnonymousFunctionCall:
+      // The first argument is the method name.
+      *return_value = Native_NewFloat64(argc - 1);
+      break;
+  }
+}
+
+std::string widget_test_logs;
+
+std::unique_ptr<WebFTestEnv> InitWidgetElementTest() {
+  widget_test_logs.clear();
+  widget_property_reads = 0;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    widget_test_logs += message + ";";
+  };
+  return TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    ADD_FAILURE() << errmsg;
+  });
+}
+
+// Append an element of the tag to body and route its binding calls to InvokeWidgetElementBinding.
+void AppendWidgetElement(WebFTestEnv* env, const std::string& tag) {
+  std::string code = "document.body.appendChild(document.createElement('" + tag + "'));";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  auto* element = To<Element>(env->page()->executingContext()->document()->body()->lastChild());
+  element->bindingObject()->invoke_bindings_methods_from_native = InvokeWidgetElementBinding;
+}
+
+}  // namespace
+
+TEST(WidgetElement, shapeAccessors) {
+  TEST_registerWidgetElementShape("flutter-shape-accessor", {"value"}, {}, {});
+  auto env = InitWidgetElementTest();
+  AppendWidgetElement(env.get(), "flutter-shape-accessor");
+  const char* code = R"(
+const el = document.body.lastChild;
+console.log(el.value);
+el.value = 1;
+console.log(el.hasOwnProperty('value'));
+console.log(Object.keys(el).length);
+console.log(Object.getOwnPropertyDescriptor(el, 'value') === undefined);
+let names = [];
+for (let name in el) { if (name === 'value') names.push(name); }
+console.log(names.join(','));
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  // Dart properties are inherited accessors: enumerable by for-in but not own keys of the element.
+  EXPECT_EQ(widget_test_logs, "42;false;0;true;value;");
+}
+
+TEST(WidgetElement, cloneCopiesOnlyExpandos) {
+  TEST_registerWidgetElementShape("flutter-shape-clone", {"value"}, {}, {});
+  auto env = InitWidgetElementTest();
+  AppendWidgetElement(env.get(), "flutter-shape-clone");
+  const char* code = R"(
+const el = document.body.lastChild;
+el.foo = 'bar';
+const clone = el.cloneNode();
+console.log(clone.foo);
+console.log(clone.hasOwnProperty('value'));
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  // The dart properties are not read to clone the element.
+  EXPECT_EQ(widget_property_reads, 0);
+  EXPECT_EQ(widget_test_logs, "bar;false;");
+}
+
+TEST(WidgetElement, shapeMethods) {
+  TEST_registerWidgetElementShape("flutter-shape-method", {}, {"play"}, {"load"});
+  auto env = InitWidgetElementTest();
+  AppendWidgetElement(env.get(), "flutter-shape-method");
+  const char* code = R"(
+const el = document.body.lastChild;
+console.log(el.play(1, 2));
+console.log(typeof el.load);
+const other = document.createElement('flutter-shape-method');
+console.log(Object.getPrototypeOf(other) === Object.getPrototypeOf(el));
+console.log(other.play === el.play);
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(widget_test_logs, "2;function;true;true;");
+}
+
+TEST(WidgetElement, unknownTagKeepsExpandos) {
+  auto env = InitWidgetElementTest();
+  const char* code = R"(
+const el = document.createElement('flutter-shape-unknown');
+console.log(el.value === undefined);
+el.foo = 'bar';
+console.log(Object.keys(el).join(','));
+console.log(el.cloneNode().foo);
+console.log(Object.prototype.toString.call(el));
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(widget_test_logs, "true;foo;bar;[object FLUTTER-SHAPE-UNKNOWN];");
+}
+
+TEST(WidgetElement, missingShapeIsCachedUntilWidgetElementDefined) {
+  auto env = InitWidgetElementTest();
+  auto context = env->page()->executingContext();
+  const char* code = "globalThis.before = document.createElement('flutter-shape-late');";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // Dart side knows the shape now, but the tag is only asked again once a custom element is defined.
+  TEST_registerWidgetElementShape("flutter-shape-late", {"value"}, {}, {});
+  const char* middle = "globalThis.middle = document.createElement('flutter-shape-late');";
+  env->page()->evaluateScript(middle, strlen(middle), "vm://", 0);
+
+  markWidgetElementDefined(context->dartIsolateContext());
+  const char* check = R"(
+const after = document.createElement('flutter-shape-late');
+console.log('value' in before);
+console.log('value' in middle);
+console.log('value' in after);
+)";
+  env->page()->evaluateScript(check, strlen(check), "vm://", 0);
+  EXPECT_EQ(widget_test_logs, "false;false;true;");
+}
@@ -3,6 +3,8 @@
  */
 
 #include "html_element.h"
+#include "bindings/qjs/native_string_utils.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 
@@ -27,3 +29,107 @@ TEST(HTMLElement, globalEventHandlerRegistered) {
 
   EXPECT_EQ(errorCalled, false);
 }
+
+namespace {
+
+// Emulates the dart side of an image: the pending commands must have been flushed before a property is read.
+ExecutingContext* image_context = nullptr;
+std::string image_src;
+
+void InvokeImageBinding(double contextId,
+                        int64_t profile_id,
+                        const NativeBindingObject* binding_object,
+                        NativeValue* return_value,
+                        NativeValue* method,
+                        int32_t argc,
+                        const NativeValue* argv) {
+  for (int32_t i = 0; i < argc; i++) {
+    if (argv[i].tag == NativeTag::TAG_STRING)
+      delete reinterpret_cast<AutoFreeNativeString*>(argv[i].u.ptr);
+  }
+  if (method->tag == NativeTag::TAG_INT && method->u.int64 == BindingMethodCallOperations::kGetProperty &&
+      image_context->uiCommandBuffer()->empty()) {
+    *return_value = Native_NewCString(image_src);
+  }
+}
+
+}  // namespace
+
+TEST(HTMLElement, bindingPropertySetIsDeferred) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    EXPECT_STREQ(message.c_str(), "https://example.com/a.png");
+    logCalled = true;
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->executingContext();
+  const char* code =
+      "let img = document.createElement('img'); document.body.appendChild(img); img.src = "
+      "'https://example.com/a.png';";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  int set_property_count = 0;
+  for (UICommandItem* item : TEST_getUICommandItems(context)) {
+    if (item->type != (int32_t)UICommand::kSetProperty)
+      continue;
+    set_property_count++;
+    // Dart side owns the value once the command is read, free it as dart side does.
+    auto* value = reinterpret_cast<NativeValue*>(item->nativePtr2);
+    EXPECT_EQ(value->tag, NativeTag::TAG_STRING);
+    auto* src = reinterpret_cast<AutoFreeNativeString*>(value->u.ptr);
+    image_src = nativeStringToStdString(src);
+    delete src;
+    free(value);
+    item->nativePtr2 = 0;
+  }
+  EXPECT_EQ(set_property_count, 1);
+
+  // Reading the property back flushes the deferred write to dart side first.
+  image_context = context;
+  auto* img = To<Element>(context->document()->body()->lastChild());
+  auto invoke_from_native = img->bindingObject()->invoke_bindings_methods_from_native;
+  img->bindingObject()->invoke_bindings_methods_from_native = InvokeImageBinding;
+  const char* read = "console.log(img.src);";
+  env->page()->evaluateScript(read, strlen(read), "vm://", 0);
+  img->bindingObject()->invoke_bindings_methods_from_native = invoke_from_native;
+
+  EXPECT_EQ(logCalled, true);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(HTMLElement, styleSheetIsParsedWhenTheTextChanges) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = env->page()->executingContext();
+  context->uiCommandBuffer()->clear();
+  const char* code = R"(
+const style = document.createElement('style');
+style.appendChild(document.createTextNode('.a { color: red }'));
+style.firstChild.data = '.a { color: red }';
+style.firstChild.data = 'div { span { color: blue } }';
+document.head.appendChild(style);
+)";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  std::vector<uint32_t*> rule_sets;
+  for (UICommandItem* item : TEST_getUICommandItems(context)) {
+    if (item->type == (int32_t)UICommand::kSetStyleSheet)
+      rule_sets.push_back(reinterpret_cast<uint32_t*>(item->nativePtr2));
+  }
+  context->uiCommandBuffer()->clear();
+
+  // The same text is not parsed again and the nested rules are left to the Dart parser.
+  ASSERT_EQ(rule_sets.size(), 2);
+  ASSERT_NE(rule_sets[0], nullptr);
+  EXPECT_EQ(rule_sets[0][2], 1);
+  EXPECT_EQ(rule_sets[1], nullptr);
+  free(rule_sets[0]);
+  EXPECT_EQ(errorCalled, false);
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "html_style_element.h"
+#include "core/css/parser/css_parser.h"
+#include "core/dom/text.h"
+#include "core/executing_context.h"
+#include "html_names.h"
+#include "qjs_html_style_element.h"
+
+namespace webf {
+
+HTMLStyleElement::HTMLStyleElement(Document& document) : HTMLElement(html_names::kstyle, &document) {}
+
+void HTMLStyleElement::ChildrenChanged(const ChildrenChange& change) {
+  HTMLElement::ChildrenChanged(change);
+  UpdateStyleSheet();
+}
+
+void HTMLStyleElement::UpdateStyleSheet() {
+  // The sheet is the text of the child text nodes, the same as collectElementChildText() in Dart.
+  std::u16string text;
+  for (Node* child = firstChild(); child != nullptr; child = child->nextSibling()) {
+    auto* text_node = DynamicTo<Text>(child);
+    if (text_node == nullptr || text_node->data().IsEmpty())
+      continue;
+    StringView data = text_node->data().ToStringView();
+    if (data.Is8Bit()) {
+      auto* characters = reinterpret_cast<const uint8_t*>(data.Characters8());
+      text.append(characters, characters + data.length());
+    } else {
+      text.append(data.Characters16(), data.length());
+    }
+  }
+  if (text == sheet_text_)
+    return;
+  sheet_text_ = std::move(text);
+
+  // A nullptr rule set makes the Dart side parse the text itself.
+  uint32_t* rule_set = CSSParser::ParseStyleSheet(sheet_text_);
+  GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kSetStyleSheet, nullptr, bindingObject(), rule_set);
+}
+
+}  // namespace webf
@@ -0,0 +1,6 @@
+import {HTMLElement} from "./html_element";
+
+interface HTMLStyleElement extends HTMLElement {
+  type: DartImpl<string>;
+  new(): void;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_CORE_HTML_HTML_STYLE_ELEMENT_H_
+#define BRIDGE_CORE_HTML_HTML_STYLE_ELEMENT_H_
+
+#include <string>
+#include "html_element.h"
+
+namespace webf {
+
+// The text of the element is parsed on the JS thread and the rules are sent with UICommand::kSetStyleSheet, so the UI
+// thread does not tokenize style sheets.
+class HTMLStyleElement : public HTMLElement {
+  DEFINE_WRAPPERTYPEINFO();
+
+ public:
+  using ImplType = HTMLStyleElement*;
+  explicit HTMLStyleElement(Document& document);
+
+  void ChildrenChanged(const ChildrenChange& change) override;
+
+ private:
+  void UpdateStyleSheet();
+
+  // The text of the last parsed sheet.
+  std::u16string sheet_text_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_HTML_HTML_STYLE_ELEMENT_H_
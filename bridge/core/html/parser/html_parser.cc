@@ -151,12 +151,12 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
       }
 
       if (!trim(html).empty()) {
-        root_node->GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps("HTMLParser::parse");
+        root_node->GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kHTMLParserParse);
 
         GumboOutput* htmlTree = parse(html, isHTMLFragment);
 
         root_node->GetExecutingContext()->dartIsolateContext()->profiler()->FinishTrackSteps();
-        root_node->GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps("HTMLParser::traverseHTML");
+        root_node->GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kHTMLParserTraverseHTML);
 
         traverseHTML(root_container_node, htmlTree->root);
         // Free gumbo parse nodes.
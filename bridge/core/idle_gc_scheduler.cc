@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "idle_gc_scheduler.h"
+#include "core/executing_context.h"
+#include "foundation/trace_event.h"
+
+namespace webf {
+
+void IdleGCScheduler::ApplyHeapPolicy(const NativeHeapPolicy& policy) {
+  JSRuntime* runtime = context_->dartIsolateContext()->runtime();
+
+  if (policy.initial_gc_threshold > 0) {
+    JS_SetGCThreshold(runtime, policy.initial_gc_threshold);
+  }
+  if (policy.gc_growth_factor > 0) {
+    JS_SetGCGrowthFactor(runtime, policy.gc_growth_factor);
+  }
+  if (policy.memory_limit > 0) {
+    memory_limit_ = policy.memory_limit;
+    JS_SetMemoryLimit(runtime, policy.memory_limit);
+  }
+  if (policy.idle_gc_budget_us > 0) {
+    idle_gc_budget_us_ = policy.idle_gc_budget_us;
+  }
+  memory_pressure_callback_ = policy.memory_pressure_callback;
+}
+
+void IdleGCScheduler::ScheduleIdleGC() {
+  // Only one pending idle task for each page, the frames flushed before it runs share the same collection.
+  if (pending_.exchange(true)) {
+    return;
+  }
+
+  context_->dartIsolateContext()->dispatcher()->PostToJs(context_->isDedicated(),
+                                                         static_cast<int32_t>(context_->contextId()), RunIdleGC,
+                                                         this, context_->contextId());
+}
+
+void IdleGCScheduler::RunIdleGC(IdleGCScheduler* scheduler, double context_id) {
+  // The page may be disposed before the idle task runs.
+  if (!isContextValid(context_id))
+    return;
+  scheduler->pending_ = false;
+  scheduler->CollectIfNeeded();
+}
+
+void IdleGCScheduler::CollectIfNeeded() {
+  JSRuntime* runtime = context_->dartIsolateContext()->runtime();
+
+  size_t malloc_size = JS_GetMallocSize(runtime);
+  size_t threshold = JS_GetGCThreshold(runtime);
+  if (malloc_size < threshold * kIdleGCThresholdRatio)
+    return;
+
+  WEBF_TRACE_SCOPE(kIdleGC);
+  // The full collection is skipped when the last one would not fit in the budget, only count the ones which ran.
+  if (JS_RunGCWithBudget(runtime, idle_gc_budget_us_)) {
+    idle_collection_count_++;
+  }
+  CheckMemoryPressure(runtime);
+}
+
+void IdleGCScheduler::CheckMemoryPressure(JSRuntime* runtime) {
+  if (memory_limit_ <= 0 || memory_pressure_callback_ == nullptr)
+    return;
+
+  auto malloc_size = static_cast<int64_t>(JS_GetMallocSize(runtime));
+  bool under_pressure = malloc_size >= memory_limit_ * kMemoryPressureRatio;
+
+  // Notify only when entering the pressure state to avoid flooding dart side every frame.
+  if (under_pressure && !under_pressure_) {
+    context_->dartIsolateContext()->dispatcher()->PostToDart(context_->isDedicated(), memory_pressure_callback_,
+                                                             context_->contextId(), malloc_size, memory_limit_);
+  }
+  under_pressure_ = under_pressure;
+}
+
+}  // namespace webf
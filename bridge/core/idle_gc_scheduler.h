@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_IDLE_GC_SCHEDULER_H_
+#define WEBF_CORE_IDLE_GC_SCHEDULER_H_
+
+#include <include/webf_bridge.h>
+#include <quickjs/quickjs.h>
+#include <atomic>
+#include <cstdint>
+
+namespace webf {
+
+class ExecutingContext;
+
+// Moves JS garbage collection into the idle gap between frames.
+// Once dart side had consumed the UI commands of a frame, a collection bounded by the idle budget is scheduled
+// on the JS thread when the heap gets close to the automatic GC threshold, which pushes the threshold away so the
+// allocation triggered GC is less likely to land in the middle of the next frame.
+class IdleGCScheduler {
+ public:
+  // Collect in idle time once the heap reaches this ratio of the automatic GC threshold.
+  static constexpr double kIdleGCThresholdRatio = 0.75;
+  // Report memory pressure to dart side once the heap still reaches this ratio of the hard limit after collecting.
+  static constexpr double kMemoryPressureRatio = 0.8;
+  static constexpr int64_t kDefaultIdleGCBudgetUs = 4000;
+
+  explicit IdleGCScheduler(ExecutingContext* context) : context_(context) {}
+
+  // Apply the per-page heap policy to the runtime, must be called in the JS thread.
+  void ApplyHeapPolicy(const NativeHeapPolicy& policy);
+  // Called after the UI commands of a frame had been flushed, could be called from the dart thread. Without a dedicated
+  // thread the collection runs inline, so only call it when the UI thread is idle.
+  void ScheduleIdleGC();
+
+  // Number of full collections which actually ran in the idle gap.
+  uint32_t idleCollectionCount() const { return idle_collection_count_; }
+
+ private:
+  static void RunIdleGC(IdleGCScheduler* scheduler, double context_id);
+  void CollectIfNeeded();
+  void CheckMemoryPressure(JSRuntime* runtime);
+
+  ExecutingContext* context_;
+  int64_t idle_gc_budget_us_{kDefaultIdleGCBudgetUs};
+  int64_t memory_limit_{0};
+  MemoryPressureCallback memory_pressure_callback_{nullptr};
+  std::atomic<bool> pending_{false};
+  bool under_pressure_{false};
+  uint32_t idle_collection_count_{0};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_IDLE_GC_SCHEDULER_H_
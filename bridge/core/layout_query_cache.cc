@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "layout_query_cache.h"
+#include "binding_call_methods.h"
+
+namespace webf {
+
+const std::vector<AtomicString>* LayoutQueryCache::PropertyGroupOf(const AtomicString& prop) {
+  if (UNLIKELY(property_groups_.empty())) {
+    InitializePropertyGroups();
+  }
+
+  for (auto& group : property_groups_) {
+    for (auto& name : group) {
+      if (name == prop)
+        return &group;
+    }
+  }
+  return nullptr;
+}
+
+bool LayoutQueryCache::GetProperty(const BindingObject* object, const AtomicString& prop, NativeValue* result) {
+  EnsureValid();
+
+  auto entry = entries_.find(object);
+  if (entry != entries_.end()) {
+    auto property = entry->second.properties.find(prop.Impl());
+    if (property != entry->second.properties.end()) {
+      hit_count_.fetch_add(1, std::memory_order_relaxed);
+      *result = property->second;
+      return true;
+    }
+  }
+
+  miss_count_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void LayoutQueryCache::SetProperty(const BindingObject* object, const AtomicString& prop, const NativeValue& value) {
+  switch (value.tag) {
+    case NativeTag::TAG_INT:
+    case NativeTag::TAG_FLOAT64:
+    case NativeTag::TAG_BOOL:
+    case NativeTag::TAG_NULL:
+      break;
+    default:
+      return;
+  }
+
+  EnsureValid();
+  entries_[object].properties[prop.Impl()] = value;
+}
+
+bool LayoutQueryCache::GetBoundingClientRect(const BindingObject* object, BoundingClientRectData* result) {
+  EnsureValid();
+
+  auto entry = entries_.find(object);
+  if (entry != entries_.end() && entry->second.has_rect) {
+    hit_count_.fetch_add(1, std::memory_order_relaxed);
+    *result = entry->second.rect;
+    return true;
+  }
+
+  miss_count_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void LayoutQueryCache::SetBoundingClientRect(const BindingObject* object, const BoundingClientRectData& rect) {
+  EnsureValid();
+  Entry& entry = entries_[object];
+  entry.has_rect = true;
+  entry.rect = rect;
+}
+
+void LayoutQueryCache::ResetCounters() {
+  hit_count_.store(0, std::memory_order_relaxed);
+  miss_count_.store(0, std::memory_order_relaxed);
+}
+
+void LayoutQueryCache::EnsureValid() {
+  uint64_t generation = layout_generation_.load(std::memory_order_relaxed);
+  if (LIKELY(!dirty_ && generation == snapshot_generation_))
+    return;
+
+  entries_.clear();
+  snapshot_generation_ = generation;
+  dirty_ = false;
+}
+
+void LayoutQueryCache::InitializePropertyGroups() {
+  property_groups_ = {
+      {binding_call_methods::koffsetTop, binding_call_methods::koffsetLeft, binding_call_methods::koffsetWidth,
+       binding_call_methods::koffsetHeight},
+      {binding_call_methods::kclientTop, binding_call_methods::kclientLeft, binding_call_methods::kclientWidth,
+       binding_call_methods::kclientHeight},
+      {binding_call_methods::kscrollTop, binding_call_methods::kscrollLeft, binding_call_methods::kscrollWidth,
+       binding_call_methods::kscrollHeight},
+      {binding_call_methods::kscrollX, binding_call_methods::kscrollY, binding_call_methods::kpageXOffset,
+       binding_call_methods::kpageYOffset},
+  };
+}
+
+}  // namespace webf
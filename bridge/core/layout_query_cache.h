@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_LAYOUT_QUERY_CACHE_H_
+#define WEBF_CORE_LAYOUT_QUERY_CACHE_H_
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+#include "core/dom/legacy/bounding_client_rect.h"
+#include "foundation/native_value.h"
+
+namespace webf {
+
+class BindingObject;
+class ExecutingContext;
+
+// Snapshot of the layout results read by JS between two layout passes.
+//
+// Layout dependent queries such as offsetTop or getBoundingClientRect need to flush the UI commands and wait for
+// dart side to layout. Once dart side had answered, the results stay the same until the next layout pass, so the
+// results are kept here and repeated reads are served without calling to dart. When one property of an object
+// misses, the properties of its metrics family (offset*, client*, scroll* or the window scroll offsets) are fetched by
+// one call. The other families and the bounding rect are only fetched when they are read.
+//
+// The snapshot is dropped when dart side marks layout dirty after each frame, and whenever the JS side might have
+// changed the layout: recording UI commands, calling methods or setting properties on dart side and receiving calls
+// from dart side.
+class LayoutQueryCache {
+ public:
+  explicit LayoutQueryCache(ExecutingContext* context) : context_(context) {}
+
+  // Could be called from the dart thread.
+  void MarkLayoutDirty() { layout_generation_.fetch_add(1, std::memory_order_relaxed); }
+  void Invalidate() { dirty_ = true; }
+
+  // Returns the layout properties fetched together with prop, or nullptr if prop could not be cached.
+  const std::vector<AtomicString>* PropertyGroupOf(const AtomicString& prop);
+
+  bool GetProperty(const BindingObject* object, const AtomicString& prop, NativeValue* result);
+  // Only scalar values are kept.
+  void SetProperty(const BindingObject* object, const AtomicString& prop, const NativeValue& value);
+
+  bool GetBoundingClientRect(const BindingObject* object, BoundingClientRectData* result);
+  void SetBoundingClientRect(const BindingObject* object, const BoundingClientRectData& rect);
+
+  uint64_t hitCount() const { return hit_count_.load(std::memory_order_relaxed); }
+  uint64_t missCount() const { return miss_count_.load(std::memory_order_relaxed); }
+  void ResetCounters();
+
+ private:
+  struct Entry {
+    std::unordered_map<JSAtom, NativeValue> properties;
+    bool has_rect{false};
+    BoundingClientRectData rect{};
+  };
+
+  // Drop the snapshot when the layout could have been changed since it was recorded.
+  void EnsureValid();
+  void InitializePropertyGroups();
+
+  ExecutingContext* context_;
+  std::atomic<uint64_t> layout_generation_{0};
+  uint64_t snapshot_generation_{0};
+  bool dirty_{false};
+  std::unordered_map<const BindingObject*, Entry> entries_;
+  std::vector<std::vector<AtomicString>> property_groups_;
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_LAYOUT_QUERY_CACHE_H_
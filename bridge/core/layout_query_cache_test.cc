@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "layout_query_cache.h"
+#include "binding_call_methods.h"
+#include "core/html/html_body_element.h"
+#include "gtest/gtest.h"
+#include "include/webf_bridge.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+int layout_properties_calls = 0;
+
+// Answer the layout properties as 1, 2, 3 ... in the order they were requested.
+void InvokeLayoutProperties(double contextId,
+                            int64_t profile_id,
+                            const NativeBindingObject* binding_object,
+                            NativeValue* return_value,
+                            NativeValue* method,
+                            int32_t argc,
+                            const NativeValue* argv) {
+  for (int32_t i = 0; i < argc; i++) {
+    if (argv[i].tag == NativeTag::TAG_STRING)
+      delete reinterpret_cast<AutoFreeNativeString*>(argv[i].u.ptr);
+  }
+  if (method->tag != NativeTag::TAG_INT || method->u.int64 != BindingMethodCallOperations::kGetLayoutProperties)
+    return;
+
+  layout_properties_calls++;
+  auto* values = static_cast<NativeValue*>(dart_malloc(sizeof(NativeValue) * argc));
+  for (int32_t i = 0; i < argc; i++) {
+    values[i] = Native_NewFloat64(i + 1);
+  }
+  *return_value = Native_NewList(argc, values);
+}
+
+double GetLayoutProperty(BindingObject* object, const AtomicString& prop) {
+  ExceptionState exception_state;
+  NativeValue result = object->GetBindingProperty(prop, FlushUICommandReason::kDependentsOnLayout, exception_state);
+  EXPECT_FALSE(exception_state.HasException());
+  EXPECT_EQ(result.tag, NativeTag::TAG_FLOAT64);
+  return result.u.float64;
+}
+
+}  // namespace
+
+TEST(LayoutQueryCache, hitBetweenLayouts) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto* cache = context->layoutQueryCache();
+  auto* body = context->document()->body();
+  cache->ResetCounters();
+
+  cache->SetProperty(body, binding_call_methods::koffsetTop, Native_NewFloat64(10));
+  NativeValue result;
+  EXPECT_TRUE(cache->GetProperty(body, binding_call_methods::koffsetTop, &result));
+  EXPECT_EQ(result.u.float64, 10);
+  EXPECT_TRUE(cache->GetProperty(body, binding_call_methods::koffsetTop, &result));
+  EXPECT_FALSE(cache->GetProperty(body, binding_call_methods::koffsetLeft, &result));
+
+  // Only scalar values are kept.
+  cache->SetProperty(body, binding_call_methods::koffsetLeft, Native_NewList(0, nullptr));
+  EXPECT_FALSE(cache->GetProperty(body, binding_call_methods::koffsetLeft, &result));
+
+  EXPECT_EQ(cache->hitCount(), 2u);
+  EXPECT_EQ(cache->missCount(), 2u);
+}
+
+TEST(LayoutQueryCache, missAfterUICommand) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto* cache = context->layoutQueryCache();
+  auto* body = context->document()->body();
+
+  cache->SetProperty(body, binding_call_methods::koffsetTop, Native_NewFloat64(10));
+  const char* code = "document.body.appendChild(document.createElement('div'));";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  NativeValue result;
+  EXPECT_FALSE(cache->GetProperty(body, binding_call_methods::koffsetTop, &result));
+}
+
+TEST(LayoutQueryCache, missAfterMethodCall) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto* cache = context->layoutQueryCache();
+  auto* body = context->document()->body();
+
+  cache->SetProperty(body, binding_call_methods::koffsetTop, Native_NewFloat64(10));
+  // Layout queries keep the snapshot, other methods implemented at dart side may change the layout.
+  ExceptionState exception_state;
+  body->InvokeBindingMethod(binding_call_methods::kgetBoundingClientRect, 0, nullptr,
+                            FlushUICommandReason::kDependentsOnLayout, exception_state);
+  NativeValue result;
+  EXPECT_TRUE(cache->GetProperty(body, binding_call_methods::koffsetTop, &result));
+
+  body->InvokeBindingMethod(binding_call_methods::kscrollBy, 0, nullptr, FlushUICommandReason::kStandard,
+                            exception_state);
+  EXPECT_FALSE(cache->GetProperty(body, binding_call_methods::koffsetTop, &result));
+}
+
+TEST(LayoutQueryCache, missAfterMarkLayoutDirty) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto* cache = context->layoutQueryCache();
+  auto* body = context->document()->body();
+
+  BoundingClientRectData rect{};
+  rect.width = 100;
+  cache->SetBoundingClientRect(body, rect);
+  BoundingClientRectData cached_rect{};
+  EXPECT_TRUE(cache->GetBoundingClientRect(body, &cached_rect));
+  EXPECT_EQ(cached_rect.width, 100);
+
+  // Dart side bumps the layout generation after each frame.
+  markLayoutDirty(env->page());
+  EXPECT_FALSE(cache->GetBoundingClientRect(body, &cached_rect));
+}
+
+TEST(LayoutQueryCache, fetchPropertyGroupByOneCall) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto* body = context->document()->body();
+  auto invoke_from_native = body->bindingObject()->invoke_bindings_methods_from_native;
+  body->bindingObject()->invoke_bindings_methods_from_native = InvokeLayoutProperties;
+  layout_properties_calls = 0;
+
+  const std::vector<AtomicString>* group =
+      context->layoutQueryCache()->PropertyGroupOf(binding_call_methods::koffsetLeft);
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(group->size(), 4);
+  const std::vector<AtomicString>* client_group =
+      context->layoutQueryCache()->PropertyGroupOf(binding_call_methods::kclientWidth);
+  EXPECT_NE(client_group, group);
+  EXPECT_NE(context->layoutQueryCache()->PropertyGroupOf(binding_call_methods::kscrollTop), group);
+  EXPECT_NE(context->layoutQueryCache()->PropertyGroupOf(binding_call_methods::kscrollTop), client_group);
+  EXPECT_EQ(context->layoutQueryCache()->PropertyGroupOf(binding_call_methods::kscrollX),
+            context->layoutQueryCache()->PropertyGroupOf(binding_call_methods::kpageYOffset));
+
+  // The whole group is filled by the first miss, the other properties of the group are served from the cache.
+  for (size_t i = 0; i < group->size(); i++) {
+    EXPECT_EQ(GetLayoutProperty(body, (*group)[i]), static_cast<double>(i + 1));
+  }
+  EXPECT_EQ(layout_properties_calls, 1);
+
+  // The other families are only fetched when they are read.
+  EXPECT_EQ(GetLayoutProperty(body, binding_call_methods::kclientWidth), 3);
+  EXPECT_EQ(layout_properties_calls, 2);
+
+  markLayoutDirty(env->page());
+  EXPECT_EQ(GetLayoutProperty(body, binding_call_methods::koffsetLeft), 2);
+  EXPECT_EQ(layout_properties_calls, 3);
+  body->bindingObject()->invoke_bindings_methods_from_native = invoke_from_native;
+}
@@ -51,7 +51,11 @@ bool WebFPage::parseHTML(const char* code, size_t length) {
       return false;
     }
 
-    context_->dartIsolateContext()->profiler()->StartTrackSteps("HTMLParser::parseHTML");
+    if (auto* recorder = context_->replayRecorder()) {
+      recorder->RecordParseHTML(code, length);
+    }
+
+    context_->dartIsolateContext()->profiler()->StartTrackSteps(TraceLabel::kHTMLParserParseHTML);
     HTMLParser::parseHTML(code, length, context_->document()->documentElement());
     context_->dartIsolateContext()->profiler()->FinishTrackSteps();
   }
@@ -115,12 +119,18 @@ bool WebFPage::evaluateScript(const char* script,
                               int startLine) {
   if (!context_->IsContextValid())
     return false;
+  if (auto* recorder = context_->replayRecorder()) {
+    recorder->RecordEvaluateScript(script, script_len, url, startLine);
+  }
   return context_->EvaluateJavaScript(script, script_len, parsed_bytecodes, bytecode_len, url, startLine);
 }
 
 void WebFPage::evaluateScript(const char* script, size_t length, const char* url, int startLine) {
   if (!context_->IsContextValid())
     return;
+  if (auto* recorder = context_->replayRecorder()) {
+    recorder->RecordEvaluateScript(script, length, url, startLine);
+  }
   context_->EvaluateJavaScript(script, length, url, startLine);
 }
 
@@ -133,6 +143,9 @@ uint8_t* WebFPage::dumpByteCode(const char* script, size_t length, const char* u
 bool WebFPage::evaluateByteCode(uint8_t* bytes, size_t byteLength) {
   if (!context_->IsContextValid())
     return false;
+  if (auto* recorder = context_->replayRecorder()) {
+    recorder->RecordEvaluateByteCode(bytes, byteLength);
+  }
   return context_->EvaluateByteCode(bytes, byteLength);
 }
 
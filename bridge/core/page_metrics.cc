@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "page_metrics.h"
+
+#include "core/binding_object.h"
+#include "core/dart_methods.h"
+#include "core/executing_context.h"
+
+namespace webf {
+
+namespace {
+
+const char* kFlushReasonNames[PageMetrics::kFlushReasonBitCount] = {"standard", "", "dependentsOnElement",
+                                                                     "dependentsOnLayout", "dependentsAll"};
+const char* kBindingOperationNames[PageMetrics::kBindingOperationCount] = {
+    "getProperty",           "setProperty",           "getAllPropertyNames",
+    "anonymousFunctionCall", "asyncAnonymousFunction", "getLayoutProperties"};
+
+static_assert(1 << (PageMetrics::kFlushReasonBitCount - 1) == kDependentsAll, "Every flush reason needs a counter");
+static_assert(BindingMethodCallOperations::kGetLayoutProperties + 1 == PageMetrics::kBindingOperationCount,
+              "Every binding operation needs a histogram");
+
+}  // namespace
+
+void PageMetrics::RecordFlushUICommand(uint32_t reason, bool synced) {
+  flush_count_.Increment();
+  if (synced) {
+    flush_sync_count_.Increment();
+  }
+  for (uint32_t i = 0; i < kFlushReasonBitCount; i++) {
+    if (reason & (1 << i)) {
+      flush_reason_count_[i].Increment();
+    }
+  }
+}
+
+void PageMetrics::RecordBindingMethodCall(const AtomicString& method, uint64_t latency_us) {
+  // The JS thread is the only one inserting methods, so looking up without the lock is safe.
+  auto it = binding_methods_.find(method.Impl());
+  if (UNLIKELY(it == binding_methods_.end())) {
+    auto entry = std::make_unique<MethodEntry>(method, method.ToStdString(context_->ctx()));
+    std::lock_guard<std::mutex> lock(methods_mutex_);
+    it = binding_methods_.emplace(method.Impl(), std::move(entry)).first;
+  }
+  it->second->latency_us.Record(latency_us);
+}
+
+void PageMetrics::RecordBindingOperationCall(uint32_t operation, uint64_t latency_us) {
+  assert(operation < kBindingOperationCount);
+  binding_operation_latency_us_[operation].Record(latency_us);
+}
+
+std::string PageMetrics::ToJSON() {
+  std::string result = "{";
+  AppendMetricJSON(result, "uiCommands", ui_command_count_.value());
+  AppendMetricJSON(result, "flushUICommand", flush_count_.value());
+  AppendMetricJSON(result, "flushUICommandSynced", flush_sync_count_.value());
+  result += R"("flushUICommandReasons":{)";
+  for (uint32_t i = 0; i < kFlushReasonBitCount; i++) {
+    if (kFlushReasonNames[i][0] == '\0')
+      continue;
+    AppendMetricJSON(result, kFlushReasonNames[i], flush_reason_count_[i].value());
+  }
+  result.back() = '}';
+  result += ',';
+  AppendMetricJSON(result, "uiCommandSyncSize", ui_command_sync_size_);
+  AppendMetricJSON(result, "layoutQueryCacheHits", context_->layoutQueryCache()->hitCount());
+  AppendMetricJSON(result, "layoutQueryCacheMisses", context_->layoutQueryCache()->missCount());
+
+  result += R"("bindingOperationsUs":{)";
+  for (uint32_t i = 0; i < kBindingOperationCount; i++) {
+    AppendMetricJSON(result, kBindingOperationNames[i], binding_operation_latency_us_[i]);
+  }
+  result.back() = '}';
+  result += ',';
+
+  result += R"("bindingMethodsUs":{)";
+  {
+    std::lock_guard<std::mutex> lock(methods_mutex_);
+    for (auto& entry : binding_methods_) {
+      AppendMetricJSON(result, entry.second->name.c_str(), entry.second->latency_us);
+    }
+  }
+  if (result.back() == ',') {
+    result.pop_back();
+  }
+  result += "}}";
+  return result;
+}
+
+void PageMetrics::Reset() {
+  context_->layoutQueryCache()->ResetCounters();
+  ui_command_count_.Reset();
+  flush_count_.Reset();
+  flush_sync_count_.Reset();
+  for (auto& counter : flush_reason_count_) {
+    counter.Reset();
+  }
+  ui_command_sync_size_.Reset();
+  for (auto& histogram : binding_operation_latency_us_) {
+    histogram.Reset();
+  }
+  std::lock_guard<std::mutex> lock(methods_mutex_);
+  for (auto& entry : binding_methods_) {
+    entry.second->latency_us.Reset();
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_PAGE_METRICS_H_
+#define WEBF_CORE_PAGE_METRICS_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "bindings/qjs/atomic_string.h"
+#include "foundation/metrics.h"
+
+namespace webf {
+
+class ExecutingContext;
+
+// Counters and latency histograms of the bridge traffic of a page.
+// Metrics are recorded in the JS thread and could be exported from the dart thread at any time.
+class PageMetrics {
+ public:
+  // Bit positions of FlushUICommandReason.
+  static constexpr uint32_t kFlushReasonBitCount = 5;
+  // Number of BindingMethodCallOperations.
+  static constexpr uint32_t kBindingOperationCount = 6;
+
+  explicit PageMetrics(ExecutingContext* context) : context_(context) {}
+
+  void RecordUICommand() { ui_command_count_.Increment(); }
+  void RecordFlushUICommand(uint32_t reason, bool synced);
+  // Number of commands moved into the buffer which can be read by dart side.
+  void RecordUICommandSync(size_t command_size) { ui_command_sync_size_.Record(command_size); }
+  void RecordBindingMethodCall(const AtomicString& method, uint64_t latency_us);
+  void RecordBindingOperationCall(uint32_t operation, uint64_t latency_us);
+
+  std::string ToJSON();
+  void Reset();
+
+ private:
+  struct MethodEntry {
+    MethodEntry(const AtomicString& method, std::string&& name) : method(method), name(std::move(name)) {}
+    AtomicString method;
+    std::string name;
+    MetricHistogram latency_us;
+  };
+
+  ExecutingContext* context_;
+  MetricCounter ui_command_count_;
+  MetricCounter flush_count_;
+  MetricCounter flush_sync_count_;
+  MetricCounter flush_reason_count_[kFlushReasonBitCount];
+  MetricHistogram ui_command_sync_size_;
+  MetricHistogram binding_operation_latency_us_[kBindingOperationCount];
+  // Guards the insertion of methods against exporting, the JS thread looks up without it and the histograms are lock
+  // free.
+  std::mutex methods_mutex_;
+  std::unordered_map<JSAtom, std::unique_ptr<MethodEntry>> binding_methods_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_PAGE_METRICS_H_
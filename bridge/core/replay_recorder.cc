@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "replay_recorder.h"
+#include "core/dom/events/event.h"
+#include "core/dom/events/event_target.h"
+#include "core/events/animation_event.h"
+#include "core/events/close_event.h"
+#include "core/events/gesture_event.h"
+#include "core/events/hashchange_event.h"
+#include "core/events/input_event.h"
+#include "core/events/intersection_change_event.h"
+#include "core/events/keyboard_event.h"
+#include "core/events/pointer_event.h"
+#include "core/events/touch_event.h"
+#include "core/events/transition_event.h"
+#include "core/executing_context.h"
+
+namespace webf {
+
+namespace {
+
+// Fills the init dictionary of an event from its native fields. The dictionary has no prototype, so neither reading
+// the event nor stringifying the dictionary runs any script of the page.
+class EventInitBuilder {
+ public:
+  explicit EventInitBuilder(JSContext* ctx) : ctx_(ctx), init_(JS_NewObjectProto(ctx, JS_NULL)) {}
+  ~EventInitBuilder() { JS_FreeValue(ctx_, init_); }
+
+  void Set(const char* key, bool value) { JS_SetPropertyStr(ctx_, init_, key, JS_NewBool(ctx_, value)); }
+  void Set(const char* key, double value) { JS_SetPropertyStr(ctx_, init_, key, JS_NewFloat64(ctx_, value)); }
+  void Set(const char* key, const AtomicString& value) { JS_SetPropertyStr(ctx_, init_, key, value.ToQuickJS(ctx_)); }
+
+  JSValueConst init() const { return init_; }
+
+ private:
+  JSContext* ctx_;
+  JSValue init_;
+};
+
+void CollectMouseEventInit(MouseEvent* event, EventInitBuilder& init) {
+  init.Set("altKey", event->altKey());
+  init.Set("ctrlKey", event->ctrlKey());
+  init.Set("metaKey", event->metaKey());
+  init.Set("shiftKey", event->shiftKey());
+  init.Set("button", event->button());
+  init.Set("buttons", event->buttons());
+  init.Set("clientX", event->clientX());
+  init.Set("clientY", event->clientY());
+  init.Set("movementX", event->movementX());
+  init.Set("movementY", event->movementY());
+  init.Set("offsetX", event->offsetX());
+  init.Set("offsetY", event->offsetY());
+  init.Set("pageX", event->pageX());
+  init.Set("pageY", event->pageY());
+  init.Set("screenX", event->screenX());
+  init.Set("screenY", event->screenY());
+  init.Set("x", event->x());
+  init.Set("y", event->y());
+
+  if (!event->IsPointerEvent())
+    return;
+  auto* pointer_event = static_cast<PointerEvent*>(event);
+  init.Set("width", pointer_event->width());
+  init.Set("height", pointer_event->height());
+  init.Set("isPrimary", pointer_event->isPrimary());
+  init.Set("pointerId", pointer_event->pointerId());
+  init.Set("pointerType", pointer_event->pointerType());
+  init.Set("pressure", pointer_event->pressure());
+  init.Set("tangentialPressure", pointer_event->tangentialPressure());
+  init.Set("tiltX", pointer_event->tiltX());
+  init.Set("tiltY", pointer_event->tiltY());
+  init.Set("twist", pointer_event->twist());
+}
+
+// Only the primitive values are kept, the targets, views and touch lists are resolved again when the event is
+// dispatched.
+void CollectEventInit(Event* event, EventInitBuilder& init) {
+  init.Set("bubbles", event->bubbles());
+  init.Set("cancelable", event->cancelable());
+
+  if (event->IsUiEvent()) {
+    auto* ui_event = static_cast<UIEvent*>(event);
+    init.Set("detail", ui_event->detail());
+    init.Set("which", ui_event->which());
+  }
+
+  if (event->IsMouseEvent()) {
+    CollectMouseEventInit(static_cast<MouseEvent*>(event), init);
+  } else if (event->IsKeyboardEvent()) {
+    auto* keyboard_event = static_cast<KeyboardEvent*>(event);
+    init.Set("altKey", keyboard_event->altKey());
+    init.Set("ctrlKey", keyboard_event->ctrlKey());
+    init.Set("metaKey", keyboard_event->metaKey());
+    init.Set("shiftKey", keyboard_event->shiftKey());
+    init.Set("charCode", keyboard_event->charCode());
+    init.Set("code", keyboard_event->code());
+    init.Set("isComposing", keyboard_event->isComposing());
+    init.Set("key", keyboard_event->key());
+    init.Set("keyCode", keyboard_event->keyCode());
+    init.Set("location", keyboard_event->location());
+    init.Set("repeat", keyboard_event->repeat());
+  } else if (event->IsTouchEvent()) {
+    auto* touch_event = static_cast<TouchEvent*>(event);
+    init.Set("altKey", touch_event->altKey());
+    init.Set("ctrlKey", touch_event->ctrlKey());
+    init.Set("metaKey", touch_event->metaKey());
+    init.Set("shiftKey", touch_event->shiftKey());
+  } else if (event->IsInputEvent()) {
+    auto* input_event = static_cast<InputEvent*>(event);
+    init.Set("inputType", input_event->inputType());
+    init.Set("data", input_event->data());
+  } else if (event->IsGestureEvent()) {
+    auto* gesture_event = static_cast<GestureEvent*>(event);
+    init.Set("deltaX", gesture_event->deltaX());
+    init.Set("deltaY", gesture_event->deltaY());
+    init.Set("velocityX", gesture_event->velocityX());
+    init.Set("velocityY", gesture_event->velocityY());
+    init.Set("scale", gesture_event->scale());
+    init.Set("rotation", gesture_event->rotation());
+  } else if (event->IsCloseEvent()) {
+    auto* close_event = static_cast<CloseEvent*>(event);
+    init.Set("code", static_cast<double>(close_event->code()));
+    init.Set("reason", close_event->reason());
+    init.Set("wasClean", close_event->wasClean());
+  } else if (event->IsHashChangeEvent()) {
+    auto* hash_change_event = static_cast<HashchangeEvent*>(event);
+    init.Set("newURL", hash_change_event->newURL());
+    init.Set("oldURL", hash_change_event->oldURL());
+  } else if (event->IsIntersectionchangeEvent()) {
+    init.Set("intersectionRatio", static_cast<IntersectionChangeEvent*>(event)->intersectionRatio());
+  } else if (event->IsTransitionEvent()) {
+    auto* transition_event = static_cast<TransitionEvent*>(event);
+    init.Set("elapsedTime", transition_event->elapsedTime());
+    init.Set("propertyName", transition_event->propertyName());
+    init.Set("pseudoElement", transition_event->pseudoElement());
+  } else if (event->IsAnimationEvent()) {
+    auto* animation_event = static_cast<AnimationEvent*>(event);
+    init.Set("animationName", animation_event->animationName());
+    init.Set("elapsedTime", animation_event->elapsedTime());
+    init.Set("pseudoElement", animation_event->pseudoElement());
+  }
+}
+
+}  // namespace
+
+ReplayRecorder::ReplayRecorder(ExecutingContext* context) : context_(context) {}
+
+ReplayRecorder::~ReplayRecorder() = default;
+
+bool ReplayRecorder::Open(const std::string& path) {
+  start_ = std::chrono::steady_clock::now();
+  return writer_.Open(path);
+}
+
+ReplayRecord ReplayRecorder::NewRecord(ReplayRecordType type) const {
+  ReplayRecord record;
+  record.type = type;
+  record.time =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count();
+  return record;
+}
+
+void ReplayRecorder::RecordStart(const ReplayIds& next_ids) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kStart);
+  record.data = std::to_string(next_ids.event_target) + " " + std::to_string(next_ids.scheduled_callback) + " " +
+                std::to_string(next_ids.module_invocation);
+  writer_.Write(record);
+}
+
+void ReplayRecorder::RecordEvaluateScript(const char* code, size_t length, const char* url, int start_line) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kEvaluateScript);
+  record.id = start_line;
+  if (url != nullptr)
+    record.name = url;
+  record.data.assign(code, length);
+  writer_.Write(record);
+}
+
+void ReplayRecorder::RecordEvaluateByteCode(const uint8_t* bytes, size_t length) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kEvaluateByteCode);
+  record.data.assign(reinterpret_cast<const char*>(bytes), length);
+  writer_.Write(record);
+}
+
+void ReplayRecorder::RecordParseHTML(const char* code, size_t length) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kParseHTML);
+  record.data.assign(code, length);
+  writer_.Write(record);
+}
+
+void ReplayRecorder::RecordDispatchEvent(EventTarget* target, Event* event, bool is_capture) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kDispatchEvent);
+  record.id = target->eventTargetId();
+  record.number = is_capture ? 1 : 0;
+  record.name = event->type().ToStdString(context_->ctx());
+  record.data = event->GetWrapperTypeInfo()->className;
+  record.data.push_back('\0');
+  record.data += EventInitToJSON(event);
+  writer_.Write(record);
+}
+
+void ReplayRecorder::RecordTimer(int64_t scheduled_callback_id) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kTimer);
+  record.id = scheduled_callback_id;
+  writer_.Write(record);
+}
+
+void ReplayRecorder::RecordAnimationFrame(int64_t scheduled_callback_id, double high_res_time_stamp) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kAnimationFrame);
+  record.id = scheduled_callback_id;
+  record.number = high_res_time_stamp;
+  writer_.Write(record);
+}
+
+void ReplayRecorder::RecordModuleCallback(int64_t invocation_id, const char* errmsg, const ScriptValue* result) {
+  ReplayRecord record = NewRecord(ReplayRecordType::kModuleCallback);
+  record.id = invocation_id;
+  if (errmsg != nullptr) {
+    record.name = errmsg;
+  } else if (result != nullptr && !result->IsEmpty()) {
+    record.data = ToJSON(result->QJSValue());
+  }
+  writer_.Write(record);
+}
+
+std::string ReplayRecorder::ToJSON(JSValueConst value) {
+  JSContext* ctx = context_->ctx();
+  JSValue json = JS_JSONStringify(ctx, value, JS_NULL, JS_NULL);
+  std::string result;
+  if (JS_IsString(json)) {
+    const char* str = JS_ToCString(ctx, json);
+    result = str;
+    JS_FreeCString(ctx, str);
+  } else if (JS_IsException(json)) {
+    // Throws from getters or toJSON are not the concern of the page, drop them to keep the page state untouched.
+    JS_FreeValue(ctx, JS_GetException(ctx));
+  }
+  JS_FreeValue(ctx, json);
+  return result;
+}
+
+std::string ReplayRecorder::EventInitToJSON(Event* event) {
+  EventInitBuilder init(context_->ctx());
+  CollectEventInit(event, init);
+  std::string json = ToJSON(init.init());
+  return json.empty() ? "{}" : json;
+}
+
+}  // namespace webf
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_REPLAY_RECORDER_H_
+#define WEBF_CORE_REPLAY_RECORDER_H_
+
+#include <quickjs/quickjs.h>
+#include <chrono>
+#include <string>
+#include "foundation/replay_trace.h"
+
+namespace webf {
+
+class ExecutingContext;
+class Event;
+class EventTarget;
+class ScriptValue;
+
+// The next ids to be allocated by the context. Replay traces refer the objects by these ids, which are allocated in
+// creation order and are stable when the inputs are replayed from the same point.
+struct ReplayIds {
+  int64_t event_target{0};
+  int64_t scheduled_callback{0};
+  int64_t module_invocation{0};
+};
+
+// Writes the inputs the page receives from dart side into a trace file, `webf_replay` feeds the trace back to a page
+// running with the mocked dart methods of the unit test environment.
+//
+// Event targets, timers, frame callbacks and module invocations are referred by the ids allocated by the context,
+// which are the same when the trace is replayed from the beginning of the page. So the recording should be started
+// right after the page is allocated.
+class ReplayRecorder {
+ public:
+  explicit ReplayRecorder(ExecutingContext* context);
+  ~ReplayRecorder();
+
+  bool Open(const std::string& path);
+
+  void RecordStart(const ReplayIds& next_ids);
+
+  void RecordEvaluateScript(const char* code, size_t length, const char* url, int start_line);
+  void RecordEvaluateByteCode(const uint8_t* bytes, size_t length);
+  void RecordParseHTML(const char* code, size_t length);
+  void RecordDispatchEvent(EventTarget* target, Event* event, bool is_capture);
+  void RecordTimer(int64_t scheduled_callback_id);
+  void RecordAnimationFrame(int64_t scheduled_callback_id, double high_res_time_stamp);
+  void RecordModuleCallback(int64_t invocation_id, const char* errmsg, const ScriptValue* result);
+
+ private:
+  ReplayRecord NewRecord(ReplayRecordType type) const;
+  // Returns an empty string when the value could not be serialized.
+  std::string ToJSON(JSValueConst value);
+  // Serializes the primitive properties of the event as the init dictionary of its constructor.
+  std::string EventInitToJSON(Event* event);
+
+  ExecutingContext* context_;
+  ReplayTraceWriter writer_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_REPLAY_RECORDER_H_
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "replay_recorder.h"
+#include "core/dom/document.h"
+#include "core/dom/events/event.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(ReplayRecorder, recordsScriptsAndTimers) {
+  std::string path = ::testing::TempDir() + "replay_recorder_test.trace";
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  int64_t next_scheduled_callback_id = context->replayIds().scheduled_callback;
+  ASSERT_TRUE(context->StartReplayRecording(path));
+
+  const char* code = "setTimeout(() => { console.log('fired'); }, 0);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  TEST_runLoop(context);
+  context->StopReplayRecording();
+
+  ReplayTraceReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ReplayRecord record;
+
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(record.type, ReplayRecordType::kStart);
+
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(record.type, ReplayRecordType::kEvaluateScript);
+  EXPECT_EQ(record.name, "vm://");
+  EXPECT_EQ(record.data, code);
+
+  // Timers scheduled before the recording started could be fired as well.
+  bool timer_recorded = false;
+  while (reader.Next(&record)) {
+    if (record.type == ReplayRecordType::kTimer && record.id == next_scheduled_callback_id)
+      timer_recorded = true;
+  }
+  EXPECT_TRUE(timer_recorded);
+  remove(path.c_str());
+}
+
+TEST(ReplayRecorder, timersAreFiredByScheduledCallbackId) {
+  static bool fired = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) { fired = true; });
+  auto* context = env->page()->executingContext();
+  int64_t next_scheduled_callback_id = context->replayIds().scheduled_callback;
+
+  const char* code = "setTimeout(() => { throw new Error('fired'); }, 1000);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_FALSE(TEST_fireTimer(context, next_scheduled_callback_id + 1));
+  EXPECT_TRUE(TEST_fireTimer(context, next_scheduled_callback_id));
+  EXPECT_TRUE(fired);
+  EXPECT_FALSE(TEST_fireTimer(context, next_scheduled_callback_id));
+}
+
+TEST(ReplayRecorder, eventInitIsReadWithoutRunningPageScripts) {
+  std::string path = ::testing::TempDir() + "replay_recorder_event_test.trace";
+  static bool errorCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) { errorCalled = true; });
+  auto* context = env->page()->executingContext();
+  ASSERT_TRUE(context->StartReplayRecording(path));
+
+  // Getters and toJSON patched by the page should not be called by the recorder.
+  const char* code =
+      "Object.defineProperty(InputEvent.prototype, 'data', { get() { throw new Error('data'); } });"
+      "Object.prototype.toJSON = function() { throw new Error('toJSON'); };"
+      "var event = new InputEvent('input', { detail: 2, inputType: 'insertText', data: 'a' });"
+      "event.expando = 1;";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  JSValue event_object = JS_GetPropertyStr(context->ctx(), context->Global(), "event");
+  auto* event = toScriptWrappable<Event>(event_object);
+  context->replayRecorder()->RecordDispatchEvent(context->document(), event, false);
+  JS_FreeValue(context->ctx(), event_object);
+  context->StopReplayRecording();
+  EXPECT_EQ(errorCalled, false);
+
+  ReplayTraceReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ReplayRecord record;
+  bool event_recorded = false;
+  while (reader.Next(&record)) {
+    if (record.type != ReplayRecordType::kDispatchEvent)
+      continue;
+    event_recorded = true;
+    EXPECT_EQ(record.name, "input");
+    size_t separator = record.data.find('\0');
+    ASSERT_NE(separator, std::string::npos);
+    EXPECT_EQ(record.data.substr(0, separator), "InputEvent");
+    std::string init = record.data.substr(separator + 1);
+    EXPECT_NE(init.find("\"detail\":2"), std::string::npos);
+    EXPECT_NE(init.find("\"inputType\":\"insertText\""), std::string::npos);
+    EXPECT_NE(init.find("\"data\":\"a\""), std::string::npos);
+    EXPECT_EQ(init.find("expando"), std::string::npos);
+  }
+  EXPECT_TRUE(event_recorded);
+  remove(path.c_str());
+}
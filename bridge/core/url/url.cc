@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "url.h"
+#include "bindings/qjs/cppgc/gc_visitor.h"
+#include "core/executing_context.h"
+#include "url_search_params.h"
+#include "usv_string.h"
+
+namespace webf {
+
+URL* URL::Create(ExecutingContext* context, const AtomicString& url, ExceptionState& exception_state) {
+  URLRecord record;
+  if (!URLParser::Parse(ToUSVString(context->ctx(), url), nullptr, record)) {
+    exception_state.ThrowException(context->ctx(), ErrorType::TypeError, "Failed to construct 'URL': Invalid URL");
+    return nullptr;
+  }
+  return MakeGarbageCollected<URL>(context->ctx(), std::move(record));
+}
+
+URL* URL::Create(ExecutingContext* context,
+                 const AtomicString& url,
+                 const ScriptValue& base,
+                 ExceptionState& exception_state) {
+  if (base.IsUndefined())
+    return Create(context, url, exception_state);
+
+  std::string base_string = ToUSVString(context->ctx(), base.QJSValue(), exception_state);
+  if (exception_state.HasException())
+    return nullptr;
+  URLRecord base_record;
+  if (!URLParser::Parse(base_string, nullptr, base_record)) {
+    exception_state.ThrowException(context->ctx(), ErrorType::TypeError,
+                                   "Failed to construct 'URL': Invalid base URL");
+    return nullptr;
+  }
+  URLRecord record;
+  if (!URLParser::Parse(ToUSVString(context->ctx(), url), &base_record, record)) {
+    exception_state.ThrowException(context->ctx(), ErrorType::TypeError, "Failed to construct 'URL': Invalid URL");
+    return nullptr;
+  }
+  return MakeGarbageCollected<URL>(context->ctx(), std::move(record));
+}
+
+URL::URL(JSContext* ctx, URLRecord&& record) : ScriptWrappable(ctx), record_(std::move(record)) {}
+
+AtomicString URL::href() const {
+  if (!href_valid_) {
+    href_ = UTF8ToAtomicString(ctx(), record_.Serialize());
+    href_valid_ = true;
+  }
+  return href_;
+}
+
+void URL::setHref(const AtomicString& value, ExceptionState& exception_state) {
+  URLRecord record;
+  if (!URLParser::Parse(ToUSVString(ctx(), value), nullptr, record)) {
+    exception_state.ThrowException(ctx(), ErrorType::TypeError,
+                                   "Failed to set the 'href' property on 'URL': Invalid URL");
+    return;
+  }
+  record_ = std::move(record);
+  RecordChanged();
+  if (search_params_ != nullptr)
+    search_params_->SetFromQuery(record_.query);
+}
+
+AtomicString URL::origin() const {
+  return UTF8ToAtomicString(ctx(), record_.SerializeOrigin());
+}
+
+AtomicString URL::protocol() const {
+  return UTF8ToAtomicString(ctx(), record_.scheme + ":");
+}
+
+void URL::setProtocol(const AtomicString& value, ExceptionState& exception_state) {
+  URLParser::Parse(ToUSVString(ctx(), value) + ":", nullptr, record_, URLParser::State::kSchemeStart);
+  RecordChanged();
+}
+
+AtomicString URL::username() const {
+  return UTF8ToAtomicString(ctx(), record_.username);
+}
+
+void URL::setUsername(const AtomicString& value, ExceptionState& exception_state) {
+  if (record_.CannotHaveUsernamePasswordPort())
+    return;
+  record_.username = URLParser::EncodeUserinfo(ToUSVString(ctx(), value));
+  RecordChanged();
+}
+
+AtomicString URL::password() const {
+  return UTF8ToAtomicString(ctx(), record_.password);
+}
+
+void URL::setPassword(const AtomicString& value, ExceptionState& exception_state) {
+  if (record_.CannotHaveUsernamePasswordPort())
+    return;
+  record_.password = URLParser::EncodeUserinfo(ToUSVString(ctx(), value));
+  RecordChanged();
+}
+
+AtomicString URL::host() const {
+  if (!record_.has_host)
+    return AtomicString::Empty();
+  if (record_.port < 0)
+    return UTF8ToAtomicString(ctx(), record_.host);
+  return UTF8ToAtomicString(ctx(), record_.host + ":" + std::to_string(record_.port));
+}
+
+void URL::setHost(const AtomicString& value, ExceptionState& exception_state) {
+  if (record_.has_opaque_path)
+    return;
+  URLParser::Parse(ToUSVString(ctx(), value), nullptr, record_, URLParser::State::kHost);
+  RecordChanged();
+}
+
+AtomicString URL::hostname() const {
+  if (!record_.has_host)
+    return AtomicString::Empty();
+  return UTF8ToAtomicString(ctx(), record_.host);
+}
+
+void URL::setHostname(const AtomicString& value, ExceptionState& exception_state) {
+  if (record_.has_opaque_path)
+    return;
+  URLParser::Parse(ToUSVString(ctx(), value), nullptr, record_, URLParser::State::kHostname);
+  RecordChanged();
+}
+
+AtomicString URL::port() const {
+  if (record_.port < 0)
+    return AtomicString::Empty();
+  return UTF8ToAtomicString(ctx(), std::to_string(record_.port));
+}
+
+void URL::setPort(const AtomicString& value, ExceptionState& exception_state) {
+  if (record_.CannotHaveUsernamePasswordPort())
+    return;
+  std::string input = ToUSVString(ctx(), value);
+  if (input.empty()) {
+    record_.port = -1;
+  } else {
+    URLParser::Parse(input, nullptr, record_, URLParser::State::kPort);
+  }
+  RecordChanged();
+}
+
+AtomicString URL::pathname() const {
+  return UTF8ToAtomicString(ctx(), record_.SerializePath());
+}
+
+void URL::setPathname(const AtomicString& value, ExceptionState& exception_state) {
+  if (record_.has_opaque_path)
+    return;
+  record_.path.clear();
+  URLParser::Parse(ToUSVString(ctx(), value), nullptr, record_, URLParser::State::kPathStart);
+  RecordChanged();
+}
+
+AtomicString URL::search() const {
+  if (!record_.has_query || record_.query.empty())
+    return AtomicString::Empty();
+  return UTF8ToAtomicString(ctx(), "?" + record_.query);
+}
+
+void URL::setSearch(const AtomicString& value, ExceptionState& exception_state) {
+  std::string input = ToUSVString(ctx(), value);
+  RecordChanged();
+  if (input.empty()) {
+    record_.has_query = false;
+    record_.query.clear();
+    if (search_params_ != nullptr)
+      search_params_->SetFromQuery(input);
+    return;
+  }
+  if (input[0] == '?')
+    input.erase(0, 1);
+  record_.has_query = true;
+  record_.query.clear();
+  URLParser::Parse(input, nullptr, record_, URLParser::State::kQuery);
+  if (search_params_ != nullptr)
+    search_params_->SetFromQuery(input);
+}
+
+URLSearchParams* URL::searchParams() {
+  if (search_params_ == nullptr)
+    search_params_ = URLSearchParams::Create(GetExecutingContext(), this, record_.query);
+  return search_params_;
+}
+
+AtomicString URL::hash() const {
+  if (!record_.has_fragment || record_.fragment.empty())
+    return AtomicString::Empty();
+  return UTF8ToAtomicString(ctx(), "#" + record_.fragment);
+}
+
+void URL::setHash(const AtomicString& value, ExceptionState& exception_state) {
+  std::string input = ToUSVString(ctx(), value);
+  RecordChanged();
+  if (input.empty()) {
+    record_.has_fragment = false;
+    record_.fragment.clear();
+    return;
+  }
+  if (input[0] == '#')
+    input.erase(0, 1);
+  record_.has_fragment = true;
+  record_.fragment.clear();
+  URLParser::Parse(input, nullptr, record_, URLParser::State::kFragment);
+}
+
+AtomicString URL::toString(ExceptionState& exception_state) const {
+  return href();
+}
+
+AtomicString URL::toJSON(ExceptionState& exception_state) const {
+  return href();
+}
+
+void URL::SetQueryFromSearchParams(const std::string& query) {
+  record_.has_query = !query.empty();
+  record_.query = query;
+  RecordChanged();
+}
+
+void URL::Trace(GCVisitor* visitor) const {
+  visitor->TraceMember(search_params_);
+}
+
+}  // namespace webf
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_URL_URL_H_
+#define WEBF_CORE_URL_URL_H_
+
+#include "bindings/qjs/cppgc/member.h"
+#include "bindings/qjs/script_value.h"
+#include "bindings/qjs/script_wrappable.h"
+#include "url_parser.h"
+
+namespace webf {
+
+class URLSearchParams;
+
+// https://url.spec.whatwg.org/#url-class
+// The setters modify the parsed record in place with the state overrides of the parser, so href is only serialized
+// again when it is read.
+class URL : public ScriptWrappable {
+  DEFINE_WRAPPERTYPEINFO();
+
+ public:
+  using ImplType = URL*;
+
+  static URL* Create(ExecutingContext* context, const AtomicString& url, ExceptionState& exception_state);
+  static URL* Create(ExecutingContext* context,
+                     const AtomicString& url,
+                     const ScriptValue& base,
+                     ExceptionState& exception_state);
+
+  URL(JSContext* ctx, URLRecord&& record);
+
+  AtomicString href() const;
+  void setHref(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString origin() const;
+  AtomicString protocol() const;
+  void setProtocol(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString username() const;
+  void setUsername(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString password() const;
+  void setPassword(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString host() const;
+  void setHost(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString hostname() const;
+  void setHostname(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString port() const;
+  void setPort(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString pathname() const;
+  void setPathname(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString search() const;
+  void setSearch(const AtomicString& value, ExceptionState& exception_state);
+  URLSearchParams* searchParams();
+  AtomicString hash() const;
+  void setHash(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString toString(ExceptionState& exception_state) const;
+  AtomicString toJSON(ExceptionState& exception_state) const;
+
+  const URLRecord& Record() const { return record_; }
+  // Called by searchParams when its list is changed.
+  void SetQueryFromSearchParams(const std::string& query);
+
+  void Trace(GCVisitor* visitor) const override;
+
+ private:
+  void RecordChanged() { href_valid_ = false; }
+
+  URLRecord record_;
+  mutable AtomicString href_;
+  mutable bool href_valid_{false};
+  Member<URLSearchParams> search_params_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_URL_URL_H_
@@ -0,0 +1,1297 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "url_parser.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include "foundation/ascii_types.h"
+
+namespace webf {
+
+namespace {
+
+constexpr int kEOF = -1;
+
+// https://url.spec.whatwg.org/#percent-encoded-bytes, every set contains the C0 controls and the non-ASCII bytes.
+enum EncodeSet : uint8_t {
+  kC0ControlSet = 1 << 0,
+  kFragmentSet = 1 << 1,
+  kQuerySet = 1 << 2,
+  kSpecialQuerySet = 1 << 3,
+  kPathSet = 1 << 4,
+  kUserinfoSet = 1 << 5,
+  kComponentSet = 1 << 6,
+  kFormSet = 1 << 7,
+};
+
+struct EncodeSetTable {
+  uint8_t sets[256];
+
+  constexpr EncodeSetTable() : sets() {
+    for (int c = 0; c < 256; c++) {
+      if (c < 0x20 || c > 0x7e) {
+        sets[c] = 0xff;
+        continue;
+      }
+      bool fragment = c == ' ' || c == '"' || c == '<' || c == '>' || c == '`';
+      bool query = c == ' ' || c == '"' || c == '#' || c == '<' || c == '>';
+      bool special_query = query || c == '\'';
+      bool path = query || c == '?' || c == '^' || c == '`' || c == '{' || c == '}';
+      bool userinfo = path || c == '/' || c == ':' || c == ';' || c == '=' || c == '@' || (c >= '[' && c <= ']') ||
+                      c == '|';
+      bool component = userinfo || c == '$' || c == '%' || c == '&' || c == '+' || c == ',';
+      bool form = component || c == '!' || c == '\'' || c == '(' || c == ')' || c == '~';
+      sets[c] = (fragment ? kFragmentSet : 0) | (query ? kQuerySet : 0) | (special_query ? kSpecialQuerySet : 0) |
+                (path ? kPathSet : 0) | (userinfo ? kUserinfoSet : 0) | (component ? kComponentSet : 0) |
+                (form ? kFormSet : 0);
+    }
+  }
+};
+
+constexpr EncodeSetTable kEncodeSets;
+
+constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+inline void PercentEncode(uint8_t c, EncodeSet set, std::string& result) {
+  if (kEncodeSets.sets[c] & set) {
+    result += '%';
+    result += kHexDigits[c >> 4];
+    result += kHexDigits[c & 0xf];
+  } else {
+    result += static_cast<char>(c);
+  }
+}
+
+void PercentEncode(const std::string& input, EncodeSet set, std::string& result) {
+  for (char c : input)
+    PercentEncode(static_cast<uint8_t>(c), set, result);
+}
+
+inline int HexValue(int c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+inline int ToASCIILower(int c) {
+  return IsASCIIUpper(c) ? c | 0x20 : c;
+}
+
+// Decodes one code point as the UTF-8 decoder of the Encoding spec does, returns the number of bytes consumed. An
+// invalid sequence is decoded to U+FFFD and only its maximal subpart is consumed.
+size_t DecodeUTF8(const uint8_t* p, const uint8_t* end, uint32_t& code_point) {
+  uint8_t lead = p[0];
+  if (lead < 0x80) {
+    code_point = lead;
+    return 1;
+  }
+  size_t needed;
+  uint8_t lower = 0x80;
+  uint8_t upper = 0xbf;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    needed = 1;
+    code_point = lead & 0x1f;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    needed = 2;
+    code_point = lead & 0xf;
+    if (lead == 0xe0)
+      lower = 0xa0;
+    if (lead == 0xed)
+      upper = 0x9f;
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    needed = 3;
+    code_point = lead & 0x7;
+    if (lead == 0xf0)
+      lower = 0x90;
+    if (lead == 0xf4)
+      upper = 0x8f;
+  } else {
+    code_point = 0xfffd;
+    return 1;
+  }
+  size_t i = 1;
+  for (; i <= needed; i++) {
+    if (p + i >= end || p[i] < lower || p[i] > upper) {
+      code_point = 0xfffd;
+      return i;
+    }
+    code_point = code_point << 6 | (p[i] & 0x3f);
+    lower = 0x80;
+    upper = 0xbf;
+  }
+  return i;
+}
+
+bool IsSpecialScheme(const std::string& scheme) {
+  return scheme == "http" || scheme == "https" || scheme == "ws" || scheme == "wss" || scheme == "ftp" ||
+         scheme == "file";
+}
+
+int32_t DefaultPort(const std::string& scheme) {
+  if (scheme == "http" || scheme == "ws")
+    return 80;
+  if (scheme == "https" || scheme == "wss")
+    return 443;
+  if (scheme == "ftp")
+    return 21;
+  return -1;
+}
+
+bool IsForbiddenHostCodePoint(uint8_t c) {
+  switch (c) {
+    case 0x00:
+    case '\t':
+    case '\n':
+    case '\r':
+    case ' ':
+    case '#':
+    case '/':
+    case ':':
+    case '<':
+    case '>':
+    case '?':
+    case '@':
+    case '[':
+    case '\\':
+    case ']':
+    case '^':
+    case '|':
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsForbiddenDomainCodePoint(uint8_t c) {
+  return IsForbiddenHostCodePoint(c) || c <= 0x1f || c == '%' || c == 0x7f;
+}
+
+bool IsWindowsDriveLetter(const std::string& string) {
+  return string.size() == 2 && IsASCIIAlpha(string[0]) && (string[1] == ':' || string[1] == '|');
+}
+
+bool IsNormalizedWindowsDriveLetter(const std::string& string) {
+  return string.size() == 2 && IsASCIIAlpha(string[0]) && string[1] == ':';
+}
+
+// https://url.spec.whatwg.org/#start-with-a-windows-drive-letter
+bool StartsWithWindowsDriveLetter(const std::string& input, ptrdiff_t pointer) {
+  ptrdiff_t remaining = static_cast<ptrdiff_t>(input.size()) - pointer;
+  if (remaining < 2 || !IsASCIIAlpha(input[pointer]) || (input[pointer + 1] != ':' && input[pointer + 1] != '|'))
+    return false;
+  if (remaining == 2)
+    return true;
+  char c = input[pointer + 2];
+  return c == '/' || c == '\\' || c == '?' || c == '#';
+}
+
+bool IsSingleDotSegment(const std::string& segment) {
+  return segment == "." || (segment.size() == 3 && segment[0] == '%' && segment[1] == '2' &&
+                            (segment[2] == 'e' || segment[2] == 'E'));
+}
+
+bool IsDoubleDotSegment(const std::string& segment) {
+  switch (segment.size()) {
+    case 2:
+      return segment == "..";
+    case 4:
+      return (IsSingleDotSegment(segment.substr(0, 1)) && IsSingleDotSegment(segment.substr(1))) ||
+             (IsSingleDotSegment(segment.substr(0, 3)) && IsSingleDotSegment(segment.substr(3)));
+    case 6:
+      return IsSingleDotSegment(segment.substr(0, 3)) && IsSingleDotSegment(segment.substr(3));
+    default:
+      return false;
+  }
+}
+
+// https://url.spec.whatwg.org/#shorten-a-urls-path
+void ShortenPath(URLRecord& url) {
+  if (url.scheme == "file" && url.path.size() == 1 && IsNormalizedWindowsDriveLetter(url.path[0]))
+    return;
+  if (!url.path.empty())
+    url.path.pop_back();
+}
+
+std::vector<std::string> Split(const std::string& string, char separator) {
+  std::vector<std::string> result;
+  size_t start = 0;
+  while (true) {
+    size_t position = string.find(separator, start);
+    if (position == std::string::npos) {
+      result.emplace_back(string, start);
+      return result;
+    }
+    result.emplace_back(string, start, position - start);
+    start = position + 1;
+  }
+}
+
+// https://url.spec.whatwg.org/#ipv4-number-parser, large numbers are saturated since they are only compared with the
+// limits of the parts.
+bool ParseIPv4Number(const std::string& input, uint64_t& number) {
+  if (input.empty())
+    return false;
+  size_t start = 0;
+  int radix = 10;
+  if (input.size() >= 2 && input[0] == '0' && (input[1] == 'x' || input[1] == 'X')) {
+    start = 2;
+    radix = 16;
+  } else if (input.size() >= 2 && input[0] == '0') {
+    start = 1;
+    radix = 8;
+  }
+  number = 0;
+  for (size_t i = start; i < input.size(); i++) {
+    int digit = HexValue(input[i]);
+    if (digit < 0 || digit >= radix)
+      return false;
+    number = number * radix + digit;
+    if (number > 0xffffffffff)
+      number = 0xffffffffff;
+  }
+  return true;
+}
+
+// https://url.spec.whatwg.org/#ends-in-a-number-checker
+bool EndsInANumber(const std::string& domain) {
+  std::vector<std::string> parts = Split(domain, '.');
+  if (parts.back().empty()) {
+    if (parts.size() == 1)
+      return false;
+    parts.pop_back();
+  }
+  const std::string& last = parts.back();
+  bool digits = !last.empty();
+  for (char c : last)
+    digits &= IsASCIIDigit(c);
+  uint64_t number;
+  return digits || ParseIPv4Number(last, number);
+}
+
+// https://url.spec.whatwg.org/#concept-ipv4-parser
+bool ParseIPv4(const std::string& input, uint32_t& address) {
+  std::vector<std::string> parts = Split(input, '.');
+  if (parts.back().empty() && parts.size() > 1)
+    parts.pop_back();
+  if (parts.size() > 4)
+    return false;
+  uint64_t numbers[4];
+  for (size_t i = 0; i < parts.size(); i++) {
+    if (!ParseIPv4Number(parts[i], numbers[i]))
+      return false;
+  }
+  size_t last = parts.size() - 1;
+  for (size_t i = 0; i < last; i++) {
+    if (numbers[i] > 255)
+      return false;
+  }
+  if (numbers[last] >= uint64_t{1} << (8 * (4 - last)))
+    return false;
+  uint64_t ipv4 = numbers[last];
+  for (size_t i = 0; i < last; i++)
+    ipv4 += numbers[i] << (8 * (3 - i));
+  address = static_cast<uint32_t>(ipv4);
+  return true;
+}
+
+std::string SerializeIPv4(uint32_t address) {
+  std::string result;
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    result += std::to_string(address >> shift & 0xff);
+    if (shift > 0)
+      result += '.';
+  }
+  return result;
+}
+
+// https://url.spec.whatwg.org/#concept-ipv6-parser
+bool ParseIPv6(const std::string& input, uint16_t address[8]) {
+  memset(address, 0, sizeof(uint16_t) * 8);
+  int piece_index = 0;
+  int compress = -1;
+  size_t pointer = 0;
+  size_t length = input.size();
+  auto at = [&](size_t i) -> int { return i < length ? static_cast<uint8_t>(input[i]) : kEOF; };
+
+  if (at(pointer) == ':') {
+    if (at(pointer + 1) != ':')
+      return false;
+    pointer += 2;
+    compress = ++piece_index;
+  }
+  while (at(pointer) != kEOF) {
+    if (piece_index == 8)
+      return false;
+    if (at(pointer) == ':') {
+      if (compress != -1)
+        return false;
+      pointer++;
+      compress = ++piece_index;
+      continue;
+    }
+    int value = 0;
+    int digits = 0;
+    while (digits < 4 && HexValue(at(pointer)) >= 0) {
+      value = value * 0x10 + HexValue(at(pointer));
+      pointer++;
+      digits++;
+    }
+    if (at(pointer) == '.') {
+      if (digits == 0)
+        return false;
+      pointer -= digits;
+      if (piece_index > 6)
+        return false;
+      int numbers_seen = 0;
+      while (at(pointer) != kEOF) {
+        int ipv4_piece = -1;
+        if (numbers_seen > 0) {
+          if (at(pointer) == '.' && numbers_seen < 4)
+            pointer++;
+          else
+            return false;
+        }
+        if (!IsASCIIDigit(at(pointer)))
+          return false;
+        while (IsASCIIDigit(at(pointer))) {
+          int number = at(pointer) - '0';
+          if (ipv4_piece == -1)
+            ipv4_piece = number;
+          else if (ipv4_piece == 0)
+            return false;
+          else
+            ipv4_piece = ipv4_piece * 10 + number;
+          if (ipv4_piece > 255)
+            return false;
+          pointer++;
+        }
+        address[piece_index] = address[piece_index] * 0x100 + ipv4_piece;
+        numbers_seen++;
+        if (numbers_seen == 2 || numbers_seen == 4)
+          piece_index++;
+      }
+      if (numbers_seen != 4)
+        return false;
+      break;
+    } else if (at(pointer) == ':') {
+      pointer++;
+      if (at(pointer) == kEOF)
+        return false;
+    } else if (at(pointer) != kEOF) {
+      return false;
+    }
+    address[piece_index++] = value;
+  }
+  if (compress != -1) {
+    int swaps = piece_index - compress;
+    piece_index = 7;
+    while (piece_index != 0 && swaps > 0) {
+      std::swap(address[piece_index], address[compress + swaps - 1]);
+      piece_index--;
+      swaps--;
+    }
+  } else if (piece_index != 8) {
+    return false;
+  }
+  return true;
+}
+
+// https://url.spec.whatwg.org/#concept-ipv6-serializer
+std::string SerializeIPv6(const uint16_t address[8]) {
+  // The first longest run of two or more zero pieces is compressed.
+  int compress = -1;
+  int longest = 1;
+  for (int i = 0; i < 8;) {
+    if (address[i] != 0) {
+      i++;
+      continue;
+    }
+    int start = i;
+    while (i < 8 && address[i] == 0)
+      i++;
+    if (i - start > longest) {
+      longest = i - start;
+      compress = start;
+    }
+  }
+
+  static const char kLowerHexDigits[] = "0123456789abcdef";
+  std::string result = "[";
+  bool ignore_zero = false;
+  for (int i = 0; i < 8; i++) {
+    if (ignore_zero && address[i] == 0)
+      continue;
+    ignore_zero = false;
+    if (i == compress) {
+      result += i == 0 ? "::" : ":";
+      ignore_zero = true;
+      continue;
+    }
+    bool leading = true;
+    for (int shift = 12; shift >= 0; shift -= 4) {
+      int digit = address[i] >> shift & 0xf;
+      if (leading && digit == 0 && shift > 0)
+        continue;
+      leading = false;
+      result += kLowerHexDigits[digit];
+    }
+    if (i != 7)
+      result += ':';
+  }
+  result += ']';
+  return result;
+}
+
+// https://datatracker.ietf.org/doc/html/rfc3492#section-6.3
+constexpr uint32_t kPunycodeBase = 36;
+constexpr uint32_t kPunycodeTMin = 1;
+constexpr uint32_t kPunycodeTMax = 26;
+
+uint32_t PunycodeAdapt(uint32_t delta, uint32_t points, bool first_time) {
+  delta = first_time ? delta / 700 : delta / 2;
+  delta += delta / points;
+  uint32_t k = 0;
+  while (delta > ((kPunycodeBase - kPunycodeTMin) * kPunycodeTMax) / 2) {
+    delta /= kPunycodeBase - kPunycodeTMin;
+    k += kPunycodeBase;
+  }
+  return k + (kPunycodeBase - kPunycodeTMin + 1) * delta / (delta + 38);
+}
+
+char PunycodeDigit(uint32_t digit) {
+  return static_cast<char>(digit < 26 ? 'a' + digit : '0' + digit - 26);
+}
+
+bool PunycodeEncode(const std::vector<uint32_t>& input, std::string& result) {
+  uint32_t n = 0x80;
+  uint32_t delta = 0;
+  uint32_t bias = 72;
+  uint32_t basic = 0;
+  for (uint32_t code_point : input) {
+    if (code_point < 0x80) {
+      result += static_cast<char>(code_point);
+      basic++;
+    }
+  }
+  if (basic > 0)
+    result += '-';
+
+  uint32_t handled = basic;
+  while (handled < input.size()) {
+    uint32_t m = UINT32_MAX;
+    for (uint32_t code_point : input) {
+      if (code_point >= n && code_point < m)
+        m = code_point;
+    }
+    if (m - n > (UINT32_MAX - delta) / (handled + 1))
+      return false;
+    delta += (m - n) * (handled + 1);
+    n = m;
+    for (uint32_t code_point : input) {
+      if (code_point < n && ++delta == 0)
+        return false;
+      if (code_point != n)
+        continue;
+      uint32_t q = delta;
+      for (uint32_t k = kPunycodeBase;; k += kPunycodeBase) {
+        uint32_t t = k <= bias ? kPunycodeTMin : (k >= bias + kPunycodeTMax ? kPunycodeTMax : k - bias);
+        if (q < t)
+          break;
+        result += PunycodeDigit(t + (q - t) % (kPunycodeBase - t));
+        q = (q - t) / (kPunycodeBase - t);
+      }
+      result += PunycodeDigit(q);
+      bias = PunycodeAdapt(delta, handled + 1, handled == basic);
+      delta = 0;
+      handled++;
+    }
+    delta++;
+    n++;
+  }
+  return true;
+}
+
+// A subset of the UTS #46 mapping: ASCII upper case letters, the full width forms of ASCII, the ideographic full stops
+// and the Latin-1 upper case letters are mapped, and the default ignorable soft hyphen and zero width characters are
+// removed.
+uint32_t MapDomainCodePoint(uint32_t code_point) {
+  if (code_point >= 0xff01 && code_point <= 0xff5e)
+    code_point -= 0xfee0;
+  if (code_point == 0x3002 || code_point == 0xff61)
+    return '.';
+  if (IsASCIIUpper(code_point) || (code_point >= 0xc0 && code_point <= 0xde && code_point != 0xd7))
+    return code_point + 0x20;
+  return code_point;
+}
+
+bool IsIgnoredDomainCodePoint(uint32_t code_point) {
+  return code_point == 0xad || (code_point >= 0x200b && code_point <= 0x200d) || code_point == 0x2060 ||
+         code_point == 0xfeff || (code_point >= 0xfe00 && code_point <= 0xfe0f);
+}
+
+// https://url.spec.whatwg.org/#concept-domain-to-ascii
+bool DomainToASCII(const std::string& domain, std::string& result) {
+  bool ascii = true;
+  for (char c : domain)
+    ascii &= IsASCII(static_cast<uint8_t>(c));
+
+  result.clear();
+  if (ascii) {
+    result.reserve(domain.size());
+    for (char c : domain)
+      result += static_cast<char>(ToASCIILower(c));
+  } else {
+    auto* p = reinterpret_cast<const uint8_t*>(domain.data());
+    auto* end = p + domain.size();
+    std::vector<uint32_t> label;
+    bool label_is_ascii = true;
+    auto flush_label = [&]() {
+      if (label_is_ascii) {
+        for (uint32_t code_point : label)
+          result += static_cast<char>(code_point);
+        return true;
+      }
+      result += "xn--";
+      return PunycodeEncode(label, result);
+    };
+    while (p < end) {
+      uint32_t code_point;
+      p += DecodeUTF8(p, end, code_point);
+      if (code_point == 0xfffd)
+        return false;
+      if (IsIgnoredDomainCodePoint(code_point))
+        continue;
+      code_point = MapDomainCodePoint(code_point);
+      if (code_point == '.') {
+        if (!flush_label())
+          return false;
+        result += '.';
+        label.clear();
+        label_is_ascii = true;
+        continue;
+      }
+      label.push_back(code_point);
+      label_is_ascii &= code_point < 0x80;
+    }
+    if (!flush_label())
+      return false;
+  }
+
+  if (result.empty())
+    return false;
+  for (char c : result) {
+    if (IsForbiddenDomainCodePoint(static_cast<uint8_t>(c)))
+      return false;
+  }
+  return true;
+}
+
+// https://url.spec.whatwg.org/#concept-host-parser
+bool ParseHost(const std::string& input, bool is_opaque, std::string& host) {
+  if (!input.empty() && input[0] == '[') {
+    uint16_t address[8];
+    if (input.back() != ']' || !ParseIPv6(input.substr(1, input.size() - 2), address))
+      return false;
+    host = SerializeIPv6(address);
+    return true;
+  }
+
+  if (is_opaque) {
+    // https://url.spec.whatwg.org/#concept-opaque-host-parser
+    for (char c : input) {
+      if (IsForbiddenHostCodePoint(static_cast<uint8_t>(c)))
+        return false;
+    }
+    host.clear();
+    PercentEncode(input, kC0ControlSet, host);
+    return true;
+  }
+
+  std::string domain;
+  URLParser::PercentDecode(input.data(), input.size(), false, domain);
+  std::string ascii_domain;
+  if (!DomainToASCII(domain, ascii_domain))
+    return false;
+  if (EndsInANumber(ascii_domain)) {
+    uint32_t address;
+    if (!ParseIPv4(ascii_domain, address))
+      return false;
+    host = SerializeIPv4(address);
+    return true;
+  }
+  host = std::move(ascii_domain);
+  return true;
+}
+
+// Removes the leading and trailing C0 controls and spaces, and all the tabs and newlines.
+const std::string& PreprocessInput(const std::string& input, bool trim, std::string& buffer) {
+  size_t begin = 0;
+  size_t end = input.size();
+  if (trim) {
+    while (begin < end && static_cast<uint8_t>(input[begin]) <= 0x20)
+      begin++;
+    while (end > begin && static_cast<uint8_t>(input[end - 1]) <= 0x20)
+      end--;
+  }
+  bool has_tab_or_newline = false;
+  for (size_t i = begin; i < end; i++) {
+    char c = input[i];
+    has_tab_or_newline |= c == '\t' || c == '\n' || c == '\r';
+  }
+  if (begin == 0 && end == input.size() && !has_tab_or_newline)
+    return input;
+
+  buffer.reserve(end - begin);
+  for (size_t i = begin; i < end; i++) {
+    char c = input[i];
+    if (c != '\t' && c != '\n' && c != '\r')
+      buffer += c;
+  }
+  return buffer;
+}
+
+}  // namespace
+
+bool URLRecord::IsSpecial() const {
+  return IsSpecialScheme(scheme);
+}
+
+std::string URLRecord::Serialize() const {
+  std::string result = scheme;
+  result += ':';
+  if (has_host) {
+    result += "//";
+    if (IncludesCredentials()) {
+      result += username;
+      if (!password.empty()) {
+        result += ':';
+        result += password;
+      }
+      result += '@';
+    }
+    result += host;
+    if (port != -1) {
+      result += ':';
+      result += std::to_string(port);
+    }
+  } else if (!has_opaque_path && path.size() > 1 && path[0].empty()) {
+    result += "/.";
+  }
+  result += SerializePath();
+  if (has_query) {
+    result += '?';
+    result += query;
+  }
+  if (has_fragment) {
+    result += '#';
+    result += fragment;
+  }
+  return result;
+}
+
+std::string URLRecord::SerializePath() const {
+  if (has_opaque_path)
+    return path[0];
+  std::string result;
+  for (const std::string& segment : path) {
+    result += '/';
+    result += segment;
+  }
+  return result;
+}
+
+std::string URLRecord::SerializeOrigin() const {
+  if (scheme == "blob") {
+    URLRecord path_url;
+    if (URLParser::Parse(SerializePath(), nullptr, path_url) &&
+        (path_url.scheme == "http" || path_url.scheme == "https")) {
+      return path_url.SerializeOrigin();
+    }
+    return "null";
+  }
+  if (scheme != "http" && scheme != "https" && scheme != "ws" && scheme != "wss" && scheme != "ftp")
+    return "null";
+  std::string result = scheme + "://" + host;
+  if (port != -1) {
+    result += ':';
+    result += std::to_string(port);
+  }
+  return result;
+}
+
+bool URLParser::Parse(const std::string& raw_input, const URLRecord* base, URLRecord& url, State state_override) {
+  bool has_override = state_override != State::kNoOverride;
+  std::string preprocessed;
+  const std::string& input = PreprocessInput(raw_input, !has_override, preprocessed);
+  const auto length = static_cast<ptrdiff_t>(input.size());
+  auto at = [&](ptrdiff_t i) -> int { return i < length ? static_cast<uint8_t>(input[i]) : kEOF; };
+
+  State state = has_override ? state_override : State::kSchemeStart;
+  std::string buffer;
+  bool at_sign_seen = false;
+  bool inside_brackets = false;
+  bool password_token_seen = false;
+
+  for (ptrdiff_t pointer = 0;; pointer++) {
+    int c = at(pointer);
+    switch (state) {
+      case State::kNoOverride:
+        return false;
+      case State::kSchemeStart:
+        if (IsASCIIAlpha(c)) {
+          buffer += static_cast<char>(ToASCIILower(c));
+          state = State::kScheme;
+        } else if (!has_override) {
+          state = State::kNoScheme;
+          pointer--;
+        } else {
+          return false;
+        }
+        break;
+      case State::kScheme:
+        if (IsASCIIAlphanumeric(c) || c == '+' || c == '-' || c == '.') {
+          buffer += static_cast<char>(ToASCIILower(c));
+        } else if (c == ':') {
+          if (has_override) {
+            if (url.IsSpecial() != IsSpecialScheme(buffer))
+              return true;
+            if ((url.IncludesCredentials() || url.port != -1) && buffer == "file")
+              return true;
+            if (url.scheme == "file" && url.has_host && url.host.empty())
+              return true;
+          }
+          url.scheme = std::move(buffer);
+          buffer.clear();
+          if (has_override) {
+            if (url.port == DefaultPort(url.scheme))
+              url.port = -1;
+            return true;
+          }
+          if (url.scheme == "file") {
+            state = State::kFile;
+          } else if (url.IsSpecial() && base != nullptr && base->scheme == url.scheme) {
+            state = State::kSpecialRelativeOrAuthority;
+          } else if (url.IsSpecial()) {
+            state = State::kSpecialAuthoritySlashes;
+          } else if (at(pointer + 1) == '/') {
+            state = State::kPathOrAuthority;
+            pointer++;
+          } else {
+            url.has_opaque_path = true;
+            url.path.assign(1, std::string());
+            state = State::kOpaquePath;
+          }
+        } else if (!has_override) {
+          buffer.clear();
+          state = State::kNoScheme;
+          pointer = -1;
+        } else {
+          return false;
+        }
+        break;
+      case State::kNoScheme:
+        if (base == nullptr || (base->has_opaque_path && c != '#'))
+          return false;
+        if (base->has_opaque_path) {
+          url.scheme = base->scheme;
+          url.has_opaque_path = true;
+          url.path = base->path;
+          url.has_query = base->has_query;
+          url.query = base->query;
+          url.has_fragment = true;
+          url.fragment.clear();
+          state = State::kFragment;
+        } else {
+          state = base->scheme == "file" ? State::kFile : State::kRelative;
+          pointer--;
+        }
+        break;
+      case State::kSpecialRelativeOrAuthority:
+        if (c == '/' && at(pointer + 1) == '/') {
+          state = State::kSpecialAuthorityIgnoreSlashes;
+          pointer++;
+        } else {
+          state = State::kRelative;
+          pointer--;
+        }
+        break;
+      case State::kPathOrAuthority:
+        if (c == '/') {
+          state = State::kAuthority;
+        } else {
+          state = State::kPath;
+          pointer--;
+        }
+        break;
+      case State::kRelative:
+        url.scheme = base->scheme;
+        if (c == '/' || (url.IsSpecial() && c == '\\')) {
+          state = State::kRelativeSlash;
+        } else {
+          url.username = base->username;
+          url.password = base->password;
+          url.has_host = base->has_host;
+          url.host = base->host;
+          url.port = base->port;
+          url.path = base->path;
+          url.has_query = base->has_query;
+          url.query = base->query;
+          if (c == '?') {
+            url.has_query = true;
+            url.query.clear();
+            state = State::kQuery;
+          } else if (c == '#') {
+            url.has_fragment = true;
+            url.fragment.clear();
+            state = State::kFragment;
+          } else if (c != kEOF) {
+            url.has_query = false;
+            url.query.clear();
+            ShortenPath(url);
+            state = State::kPath;
+            pointer--;
+          }
+        }
+        break;
+      case State::kRelativeSlash:
+        if (url.IsSpecial() && (c == '/' || c == '\\')) {
+          state = State::kSpecialAuthorityIgnoreSlashes;
+        } else if (c == '/') {
+          state = State::kAuthority;
+        } else {
+          url.username = base->username;
+          url.password = base->password;
+          url.has_host = base->has_host;
+          url.host = base->host;
+          url.port = base->port;
+          state = State::kPath;
+          pointer--;
+        }
+        break;
+      case State::kSpecialAuthoritySlashes:
+        state = State::kSpecialAuthorityIgnoreSlashes;
+        if (c == '/' && at(pointer + 1) == '/')
+          pointer++;
+        else
+          pointer--;
+        break;
+      case State::kSpecialAuthorityIgnoreSlashes:
+        if (c != '/' && c != '\\') {
+          state = State::kAuthority;
+          pointer--;
+        }
+        break;
+      case State::kAuthority:
+        if (c == '@') {
+          if (at_sign_seen)
+            buffer.insert(0, "%40");
+          at_sign_seen = true;
+          for (char b : buffer) {
+            if (b == ':' && !password_token_seen) {
+              password_token_seen = true;
+              continue;
+            }
+            PercentEncode(static_cast<uint8_t>(b), kUserinfoSet, password_token_seen ? url.password : url.username);
+          }
+          buffer.clear();
+        } else if (c == kEOF || c == '/' || c == '?' || c == '#' || (url.IsSpecial() && c == '\\')) {
+          if (at_sign_seen && buffer.empty())
+            return false;
+          pointer -= static_cast<ptrdiff_t>(buffer.size()) + 1;
+          buffer.clear();
+          state = State::kHost;
+        } else {
+          buffer += static_cast<char>(c);
+        }
+        break;
+      case State::kHost:
+      case State::kHostname:
+        if (has_override && url.scheme == "file") {
+          pointer--;
+          state = State::kFileHost;
+        } else if (c == ':' && !inside_brackets) {
+          if (buffer.empty() || state_override == State::kHostname)
+            return false;
+          std::string host;
+          if (!ParseHost(buffer, !url.IsSpecial(), host))
+            return false;
+          url.has_host = true;
+          url.host = std::move(host);
+          buffer.clear();
+          state = State::kPort;
+        } else if (c == kEOF || c == '/' || c == '?' || c == '#' || (url.IsSpecial() && c == '\\')) {
+          pointer--;
+          if (url.IsSpecial() && buffer.empty())
+            return false;
+          if (has_override && buffer.empty() && (url.IncludesCredentials() || url.port != -1))
+            return false;
+          std::string host;
+          if (!ParseHost(buffer, !url.IsSpecial(), host))
+            return false;
+          url.has_host = true;
+          url.host = std::move(host);
+          buffer.clear();
+          state = State::kPathStart;
+          if (has_override)
+            return true;
+        } else {
+          if (c == '[')
+            inside_brackets = true;
+          else if (c == ']')
+            inside_brackets = false;
+          buffer += static_cast<char>(c);
+        }
+        break;
+      case State::kPort:
+        if (IsASCIIDigit(c)) {
+          buffer += static_cast<char>(c);
+        } else if (c == kEOF || c == '/' || c == '?' || c == '#' || (url.IsSpecial() && c == '\\') || has_override) {
+          if (!buffer.empty()) {
+            int32_t port = 0;
+            for (char digit : buffer) {
+              port = port * 10 + (digit - '0');
+              if (port > 65535)
+                return false;
+            }
+            url.port = port == DefaultPort(url.scheme) ? -1 : port;
+            buffer.clear();
+            if (has_override)
+              return true;
+          }
+          if (has_override)
+            return false;
+          state = State::kPathStart;
+          pointer--;
+        } else {
+          return false;
+        }
+        break;
+      case State::kFile:
+        url.scheme = "file";
+        url.has_host = true;
+        url.host.clear();
+        if (c == '/' || c == '\\') {
+          state = State::kFileSlash;
+        } else if (base != nullptr && base->scheme == "file") {
+          url.has_host = base->has_host;
+          url.host = base->host;
+          url.path = base->path;
+          url.has_query = base->has_query;
+          url.query = base->query;
+          if (c == '?') {
+            url.has_query = true;
+            url.query.clear();
+            state = State::kQuery;
+          } else if (c == '#') {
+            url.has_fragment = true;
+            url.fragment.clear();
+            state = State::kFragment;
+          } else if (c != kEOF) {
+            url.has_query = false;
+            url.query.clear();
+            if (!StartsWithWindowsDriveLetter(input, pointer))
+              ShortenPath(url);
+            else
+              url.path.clear();
+            state = State::kPath;
+            pointer--;
+          }
+        } else {
+          state = State::kPath;
+          pointer--;
+        }
+        break;
+      case State::kFileSlash:
+        if (c == '/' || c == '\\') {
+          state = State::kFileHost;
+        } else {
+          if (base != nullptr && base->scheme == "file") {
+            url.has_host = base->has_host;
+            url.host = base->host;
+            if (!StartsWithWindowsDriveLetter(input, pointer) && !base->path.empty() &&
+                IsNormalizedWindowsDriveLetter(base->path[0])) {
+              url.path.push_back(base->path[0]);
+            }
+          }
+          state = State::kPath;
+          pointer--;
+        }
+        break;
+      case State::kFileHost:
+        if (c == kEOF || c == '/' || c == '\\' || c == '?' || c == '#') {
+          pointer--;
+          if (!has_override && IsWindowsDriveLetter(buffer)) {
+            // The buffer is not reset here and instead used in the path state.
+            state = State::kPath;
+          } else if (buffer.empty()) {
+            url.has_host = true;
+            url.host.clear();
+            if (has_override)
+              return true;
+            state = State::kPathStart;
+          } else {
+            std::string host;
+            if (!ParseHost(buffer, !url.IsSpecial(), host))
+              return false;
+            if (host == "localhost")
+              host.clear();
+            url.has_host = true;
+            url.host = std::move(host);
+            if (has_override)
+              return true;
+            buffer.clear();
+            state = State::kPathStart;
+          }
+        } else {
+          buffer += static_cast<char>(c);
+        }
+        break;
+      case State::kPathStart:
+        if (url.IsSpecial()) {
+          state = State::kPath;
+          if (c != '/' && c != '\\')
+            pointer--;
+        } else if (!has_override && c == '?') {
+          url.has_query = true;
+          url.query.clear();
+          state = State::kQuery;
+        } else if (!has_override && c == '#') {
+          url.has_fragment = true;
+          url.fragment.clear();
+          state = State::kFragment;
+        } else if (c != kEOF) {
+          state = State::kPath;
+          if (c != '/')
+            pointer--;
+        } else if (has_override && !url.has_host) {
+          url.path.emplace_back();
+        }
+        break;
+      case State::kPath: {
+        bool slash = c == '/' || (url.IsSpecial() && c == '\\');
+        if (c == kEOF || slash || (!has_override && (c == '?' || c == '#'))) {
+          if (IsDoubleDotSegment(buffer)) {
+            ShortenPath(url);
+            if (!slash)
+              url.path.emplace_back();
+          } else if (IsSingleDotSegment(buffer)) {
+            if (!slash)
+              url.path.emplace_back();
+          } else {
+            if (url.scheme == "file" && url.path.empty() && IsWindowsDriveLetter(buffer))
+              buffer[1] = ':';
+            url.path.push_back(std::move(buffer));
+          }
+          buffer.clear();
+          if (c == '?') {
+            url.has_query = true;
+            url.query.clear();
+            state = State::kQuery;
+          } else if (c == '#') {
+            url.has_fragment = true;
+            url.fragment.clear();
+            state = State::kFragment;
+          }
+        } else {
+          PercentEncode(static_cast<uint8_t>(c), kPathSet, buffer);
+        }
+        break;
+      }
+      case State::kOpaquePath:
+        if (c == '?') {
+          url.has_query = true;
+          url.query.clear();
+          state = State::kQuery;
+        } else if (c == '#') {
+          url.has_fragment = true;
+          url.fragment.clear();
+          state = State::kFragment;
+        } else if (c == ' ') {
+          int next = at(pointer + 1);
+          url.path[0] += next == '?' || next == '#' ? "%20" : " ";
+        } else if (c != kEOF) {
+          PercentEncode(static_cast<uint8_t>(c), kC0ControlSet, url.path[0]);
+        }
+        break;
+      case State::kQuery:
+        // The encoding of the query is always UTF-8, so the input bytes are percent-encoded directly.
+        if (!has_override && c == '#') {
+          url.has_fragment = true;
+          url.fragment.clear();
+          state = State::kFragment;
+        } else if (c != kEOF) {
+          PercentEncode(static_cast<uint8_t>(c), url.IsSpecial() ? kSpecialQuerySet : kQuerySet, url.query);
+        }
+        break;
+      case State::kFragment:
+        if (c != kEOF)
+          PercentEncode(static_cast<uint8_t>(c), kFragmentSet, url.fragment);
+        break;
+    }
+    if (pointer >= length)
+      break;
+  }
+  return true;
+}
+
+std::vector<std::pair<std::string, std::string>> URLParser::ParseURLEncoded(const char* data, size_t length) {
+  std::vector<std::pair<std::string, std::string>> result;
+  const char* end = data + length;
+  const char* p = data;
+  while (p < end) {
+    auto* sequence_end = static_cast<const char*>(memchr(p, '&', end - p));
+    if (sequence_end == nullptr)
+      sequence_end = end;
+    if (sequence_end != p) {
+      auto* name_end = static_cast<const char*>(memchr(p, '=', sequence_end - p));
+      const char* value_begin = name_end == nullptr ? sequence_end : name_end + 1;
+      if (name_end == nullptr)
+        name_end = sequence_end;
+      result.emplace_back();
+      PercentDecode(p, name_end - p, true, result.back().first);
+      PercentDecode(value_begin, sequence_end - value_begin, true, result.back().second);
+      SanitizeUTF8(result.back().first);
+      SanitizeUTF8(result.back().second);
+    }
+    p = sequence_end + 1;
+  }
+  return result;
+}
+
+std::string URLParser::SerializeURLEncoded(const std::vector<std::pair<std::string, std::string>>& list) {
+  std::string result;
+  for (const auto& entry : list) {
+    if (!result.empty())
+      result += '&';
+    for (char c : entry.first) {
+      if (c == ' ')
+        result += '+';
+      else
+        PercentEncode(static_cast<uint8_t>(c), kFormSet, result);
+    }
+    result += '=';
+    for (char c : entry.second) {
+      if (c == ' ')
+        result += '+';
+      else
+        PercentEncode(static_cast<uint8_t>(c), kFormSet, result);
+    }
+  }
+  return result;
+}
+
+void URLParser::PercentDecode(const char* data, size_t length, bool plus_as_space, std::string& result) {
+  const char* end = data + length;
+  const char* p = data;
+  while (p < end) {
+    const char* run = p;
+    if (plus_as_space) {
+      while (p < end && *p != '%' && *p != '+')
+        p++;
+    } else {
+      p = static_cast<const char*>(memchr(p, '%', end - p));
+      if (p == nullptr)
+        p = end;
+    }
+    result.append(run, p - run);
+    if (p == end)
+      break;
+    if (*p == '+') {
+      result += ' ';
+      p++;
+      continue;
+    }
+    int high = end - p >= 3 ? HexValue(p[1]) : -1;
+    int low = high >= 0 ? HexValue(p[2]) : -1;
+    if (low >= 0) {
+      result += static_cast<char>(high << 4 | low);
+      p += 3;
+    } else {
+      result += '%';
+      p++;
+    }
+  }
+}
+
+std::string URLParser::EncodeUserinfo(const std::string& input) {
+  std::string result;
+  PercentEncode(input, kUserinfoSet, result);
+  return result;
+}
+
+void AppendUTF8(uint32_t code_point, std::string& result) {
+  if (code_point < 0x80) {
+    result += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    result += static_cast<char>(0xc0 | code_point >> 6);
+    result += static_cast<char>(0x80 | (code_point & 0x3f));
+  } else if (code_point < 0x10000) {
+    result += static_cast<char>(0xe0 | code_point >> 12);
+    result += static_cast<char>(0x80 | (code_point >> 6 & 0x3f));
+    result += static_cast<char>(0x80 | (code_point & 0x3f));
+  } else {
+    result += static_cast<char>(0xf0 | code_point >> 18);
+    result += static_cast<char>(0x80 | (code_point >> 12 & 0x3f));
+    result += static_cast<char>(0x80 | (code_point >> 6 & 0x3f));
+    result += static_cast<char>(0x80 | (code_point & 0x3f));
+  }
+}
+
+void SanitizeUTF8(std::string& string) {
+  auto* begin = reinterpret_cast<const uint8_t*>(string.data());
+  auto* end = begin + string.size();
+  const uint8_t* p = begin;
+  while (p < end) {
+    if (*p < 0x80) {
+      p++;
+      continue;
+    }
+    uint32_t code_point;
+    size_t consumed = DecodeUTF8(p, end, code_point);
+    if (code_point == 0xfffd && !(consumed == 3 && p[0] == 0xef && p[1] == 0xbf && p[2] == 0xbd))
+      break;
+    p += consumed;
+  }
+  if (p == end)
+    return;
+
+  std::string result(begin, p);
+  while (p < end) {
+    uint32_t code_point;
+    p += DecodeUTF8(p, end, code_point);
+    AppendUTF8(code_point, result);
+  }
+  string = std::move(result);
+}
+
+bool LessThanInUTF16(const std::string& a, const std::string& b) {
+  size_t length = std::min(a.size(), b.size());
+  size_t i = 0;
+  while (i < length && a[i] == b[i])
+    i++;
+  if (i == length)
+    return a.size() < b.size();
+  // Both strings share the bytes before i, so they have the same code point boundaries there.
+  while (i > 0 && (static_cast<uint8_t>(a[i]) & 0xc0) == 0x80)
+    i--;
+  uint32_t code_point_a;
+  uint32_t code_point_b;
+  DecodeUTF8(reinterpret_cast<const uint8_t*>(a.data()) + i, reinterpret_cast<const uint8_t*>(a.data()) + a.size(),
+             code_point_a);
+  DecodeUTF8(reinterpret_cast<const uint8_t*>(b.data()) + i, reinterpret_cast<const uint8_t*>(b.data()) + b.size(),
+             code_point_b);
+  // The supplementary code points are encoded as surrogates in UTF-16, which are less than U+E000 to U+FFFF.
+  if ((code_point_a >= 0x10000) != (code_point_b >= 0x10000)) {
+    uint32_t unit_a = code_point_a >= 0x10000 ? 0xd800 : code_point_a;
+    uint32_t unit_b = code_point_b >= 0x10000 ? 0xd800 : code_point_b;
+    return unit_a < unit_b;
+  }
+  return code_point_a < code_point_b;
+}
+
+}  // namespace webf
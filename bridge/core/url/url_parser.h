@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_URL_URL_PARSER_H_
+#define WEBF_CORE_URL_URL_PARSER_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace webf {
+
+// https://url.spec.whatwg.org/#concept-url
+// All the strings are UTF-8, the components are stored percent-encoded as the parser outputs them.
+struct URLRecord {
+  std::string scheme;
+  std::string username;
+  std::string password;
+  // The serialized host, IPv6 addresses are stored with the brackets.
+  bool has_host = false;
+  std::string host;
+  // -1 is the null port.
+  int32_t port = -1;
+  // An opaque path is stored as the only element of path.
+  bool has_opaque_path = false;
+  std::vector<std::string> path;
+  bool has_query = false;
+  std::string query;
+  bool has_fragment = false;
+  std::string fragment;
+
+  bool IsSpecial() const;
+  bool IncludesCredentials() const { return !username.empty() || !password.empty(); }
+  bool CannotHaveUsernamePasswordPort() const { return !has_host || host.empty() || scheme == "file"; }
+
+  // https://url.spec.whatwg.org/#concept-url-serializer
+  std::string Serialize() const;
+  // https://url.spec.whatwg.org/#url-path-serializer
+  std::string SerializePath() const;
+  // https://url.spec.whatwg.org/#ascii-serialization-of-an-origin
+  std::string SerializeOrigin() const;
+};
+
+// https://url.spec.whatwg.org/#url-parsing
+class URLParser {
+ public:
+  enum class State {
+    kNoOverride,
+    kSchemeStart,
+    kScheme,
+    kNoScheme,
+    kSpecialRelativeOrAuthority,
+    kPathOrAuthority,
+    kRelative,
+    kRelativeSlash,
+    kSpecialAuthoritySlashes,
+    kSpecialAuthorityIgnoreSlashes,
+    kAuthority,
+    kHost,
+    kHostname,
+    kPort,
+    kFile,
+    kFileSlash,
+    kFileHost,
+    kPathStart,
+    kPath,
+    kOpaquePath,
+    kQuery,
+    kFragment,
+  };
+
+  // Runs the basic URL parser on the UTF-8 input, returns false on failure. With a state override the url is modified
+  // in place as the setters of URL do, and could be partially modified when false is returned.
+  static bool Parse(const std::string& input,
+                    const URLRecord* base,
+                    URLRecord& url,
+                    State state_override = State::kNoOverride);
+
+  // https://url.spec.whatwg.org/#concept-urlencoded-parser
+  static std::vector<std::pair<std::string, std::string>> ParseURLEncoded(const char* data, size_t length);
+  // https://url.spec.whatwg.org/#concept-urlencoded-serializer
+  static std::string SerializeURLEncoded(const std::vector<std::pair<std::string, std::string>>& list);
+
+  // Appends the percent-decoded bytes of [data, data + length) to result, decodes '+' to space when plus_as_space is
+  // true. The bytes are appended directly when there is nothing to decode.
+  static void PercentDecode(const char* data, size_t length, bool plus_as_space, std::string& result);
+  // Percent-encodes the UTF-8 input with the userinfo percent-encode set, which the username and password setters use.
+  static std::string EncodeUserinfo(const std::string& input);
+};
+
+// Appends the UTF-8 encoding of the Unicode scalar value to result.
+void AppendUTF8(uint32_t code_point, std::string& result);
+
+// Replaces the invalid sequences of the UTF-8 string with U+FFFD, as UTF-8 decoding without BOM does.
+void SanitizeUTF8(std::string& string);
+
+// Compares the UTF-8 strings by the code units of their UTF-16 encodings, which is how the names of URLSearchParams
+// are sorted.
+bool LessThanInUTF16(const std::string& a, const std::string& b);
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_URL_URL_PARSER_H_
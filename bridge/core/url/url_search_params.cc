@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "url_search_params.h"
+#include <algorithm>
+#include "bindings/qjs/cppgc/gc_visitor.h"
+#include "bindings/qjs/qjs_engine_patch.h"
+#include "core/executing_context.h"
+#include "qjs_url_search_params.h"
+#include "url.h"
+#include "url_parser.h"
+#include "usv_string.h"
+
+namespace webf {
+
+namespace {
+
+void RethrowException(JSContext* ctx, ExceptionState& exception_state) {
+  JSValue error = JS_GetException(ctx);
+  exception_state.ThrowException(ctx, error);
+  JS_FreeValue(ctx, error);
+}
+
+// Runs the callback with each value of the iterable, stops when an exception is thrown.
+// https://tc39.es/ecma262/#sec-iterabletolist
+template <typename Callback>
+void IterateValues(JSContext* ctx,
+                   JSValue iterable,
+                   JSValue iterator_method,
+                   ExceptionState& exception_state,
+                   const Callback& callback) {
+  JSValue iterator = JS_Call(ctx, iterator_method, iterable, 0, nullptr);
+  if (JS_IsException(iterator)) {
+    RethrowException(ctx, exception_state);
+    return;
+  }
+  JSValue next = JS_GetPropertyStr(ctx, iterator, "next");
+  bool js_exception = JS_IsException(next);
+  while (!js_exception && !exception_state.HasException()) {
+    JSValue result = JS_Call(ctx, next, iterator, 0, nullptr);
+    if (JS_IsException(result)) {
+      js_exception = true;
+      break;
+    }
+    if (!JS_IsObject(result)) {
+      JS_FreeValue(ctx, result);
+      exception_state.ThrowException(ctx, ErrorType::TypeError, "The iterator result is not an object.");
+      break;
+    }
+    int done = JS_ToBool(ctx, JS_GetPropertyStr(ctx, result, "done"));
+    JSValue value = done ? JS_UNDEFINED : JS_GetPropertyStr(ctx, result, "value");
+    JS_FreeValue(ctx, result);
+    if (done < 0 || JS_IsException(value)) {
+      js_exception = true;
+      break;
+    }
+    if (done)
+      break;
+    callback(value);
+    JS_FreeValue(ctx, value);
+  }
+  if (js_exception)
+    RethrowException(ctx, exception_state);
+  JS_FreeValue(ctx, next);
+  JS_FreeValue(ctx, iterator);
+}
+
+JSValue NewString(JSContext* ctx, const std::string& string) {
+  return JS_NewStringLen(ctx, string.data(), string.size());
+}
+
+}  // namespace
+
+URLSearchParams* URLSearchParams::Create(ExecutingContext* context, ExceptionState& exception_state) {
+  return MakeGarbageCollected<URLSearchParams>(context->ctx());
+}
+
+URLSearchParams* URLSearchParams::Create(ExecutingContext* context,
+                                         const ScriptValue& init,
+                                         ExceptionState& exception_state) {
+  JSContext* ctx = context->ctx();
+  auto* params = MakeGarbageCollected<URLSearchParams>(ctx);
+  JSValue value = init.QJSValue();
+  if (JS_IsUndefined(value))
+    return params;
+
+  if (QJSURLSearchParams::HasInstance(context, value)) {
+    params->list_ = toScriptWrappable<URLSearchParams>(value)->list_;
+    return params;
+  }
+
+  if (JS_IsObject(value)) {
+    JSValue iterator_method = JS_GetProperty(ctx, value, JS_ATOM_Symbol_iterator);
+    if (JS_IsException(iterator_method)) {
+      RethrowException(ctx, exception_state);
+      return nullptr;
+    }
+    if (JS_IsUndefined(iterator_method) || JS_IsNull(iterator_method)) {
+      params->InitFromRecord(value, exception_state);
+    } else {
+      params->InitFromSequence(value, iterator_method, exception_state);
+      JS_FreeValue(ctx, iterator_method);
+    }
+    return exception_state.HasException() ? nullptr : params;
+  }
+
+  std::string query = ToUSVString(ctx, value, exception_state);
+  if (exception_state.HasException())
+    return nullptr;
+  size_t start = !query.empty() && query[0] == '?' ? 1 : 0;
+  params->list_ = URLParser::ParseURLEncoded(query.data() + start, query.size() - start);
+  return params;
+}
+
+URLSearchParams* URLSearchParams::Create(ExecutingContext* context, URL* url, const std::string& query) {
+  auto* params = MakeGarbageCollected<URLSearchParams>(context->ctx());
+  params->list_ = URLParser::ParseURLEncoded(query.data(), query.size());
+  params->url_ = url;
+  return params;
+}
+
+URLSearchParams::URLSearchParams(JSContext* ctx) : ScriptWrappable(ctx) {}
+
+void URLSearchParams::InitFromSequence(JSValue init, JSValue iterator_method, ExceptionState& exception_state) {
+  JSContext* ctx = this->ctx();
+  IterateValues(ctx, init, iterator_method, exception_state, [&](JSValue pair) {
+    JSValue pair_iterator_method =
+        JS_IsObject(pair) ? JS_GetProperty(ctx, pair, JS_ATOM_Symbol_iterator) : JS_UNDEFINED;
+    if (JS_IsException(pair_iterator_method)) {
+      RethrowException(ctx, exception_state);
+      return;
+    }
+    if (!JS_IsFunction(ctx, pair_iterator_method)) {
+      JS_FreeValue(ctx, pair_iterator_method);
+      exception_state.ThrowException(ctx, ErrorType::TypeError,
+                                     "Failed to construct 'URLSearchParams': The provided value cannot be converted "
+                                     "to a sequence.");
+      return;
+    }
+    std::vector<std::string> strings;
+    IterateValues(ctx, pair, pair_iterator_method, exception_state, [&](JSValue item) {
+      std::string string = ToUSVString(ctx, item, exception_state);
+      strings.push_back(std::move(string));
+    });
+    JS_FreeValue(ctx, pair_iterator_method);
+    if (exception_state.HasException())
+      return;
+    if (strings.size() != 2) {
+      exception_state.ThrowException(
+          ctx, ErrorType::TypeError,
+          "Failed to construct 'URLSearchParams': Sequence initializer must only contain pair elements.");
+      return;
+    }
+    list_.emplace_back(std::move(strings[0]), std::move(strings[1]));
+  });
+}
+
+void URLSearchParams::InitFromRecord(JSValue init, ExceptionState& exception_state) {
+  JSContext* ctx = this->ctx();
+  JSPropertyEnum* properties;
+  uint32_t length;
+  if (JS_GetOwnPropertyNames(ctx, &properties, &length, init, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0) {
+    RethrowException(ctx, exception_state);
+    return;
+  }
+  for (uint32_t i = 0; i < length && !exception_state.HasException(); i++) {
+    JSValue key = JS_AtomToString(ctx, properties[i].atom);
+    JSValue value = JS_GetProperty(ctx, init, properties[i].atom);
+    if (JS_IsException(value)) {
+      RethrowException(ctx, exception_state);
+    } else {
+      std::string name = ToUSVString(ctx, key, exception_state);
+      std::string string = ToUSVString(ctx, value, exception_state);
+      list_.emplace_back(std::move(name), std::move(string));
+    }
+    JS_FreeValue(ctx, key);
+    JS_FreeValue(ctx, value);
+  }
+  for (uint32_t i = 0; i < length; i++)
+    JS_FreeAtom(ctx, properties[i].atom);
+  js_free(ctx, properties);
+}
+
+void URLSearchParams::append(const AtomicString& name, const AtomicString& value, ExceptionState& exception_state) {
+  list_.emplace_back(ToUSVString(ctx(), name), ToUSVString(ctx(), value));
+  Update();
+}
+
+void URLSearchParams::deleteForBinding(const AtomicString& name, ExceptionState& exception_state) {
+  RemoveAll(ToUSVString(ctx(), name), nullptr);
+  Update();
+}
+
+void URLSearchParams::deleteForBinding(const AtomicString& name,
+                                       const ScriptValue& value,
+                                       ExceptionState& exception_state) {
+  if (value.IsUndefined()) {
+    deleteForBinding(name, exception_state);
+    return;
+  }
+  std::string string = ToUSVString(ctx(), value.QJSValue(), exception_state);
+  if (exception_state.HasException())
+    return;
+  RemoveAll(ToUSVString(ctx(), name), &string);
+  Update();
+}
+
+AtomicString URLSearchParams::get(const AtomicString& name, ExceptionState& exception_state) const {
+  std::string key = ToUSVString(ctx(), name);
+  for (const auto& entry : list_) {
+    if (entry.first == key)
+      return UTF8ToAtomicString(ctx(), entry.second);
+  }
+  return AtomicString::Null();
+}
+
+std::vector<AtomicString> URLSearchParams::getAll(const AtomicString& name, ExceptionState& exception_state) const {
+  std::string key = ToUSVString(ctx(), name);
+  std::vector<AtomicString> result;
+  for (const auto& entry : list_) {
+    if (entry.first == key)
+      result.emplace_back(UTF8ToAtomicString(ctx(), entry.second));
+  }
+  return result;
+}
+
+bool URLSearchParams::has(const AtomicString& name, ExceptionState& exception_state) const {
+  std::string key = ToUSVString(ctx(), name);
+  return std::any_of(list_.begin(), list_.end(), [&](const auto& entry) { return entry.first == key; });
+}
+
+bool URLSearchParams::has(const AtomicString& name, const ScriptValue& value, ExceptionState& exception_state) const {
+  if (value.IsUndefined())
+    return has(name, exception_state);
+  std::string string = ToUSVString(ctx(), value.QJSValue(), exception_state);
+  if (exception_state.HasException())
+    return false;
+  std::string key = ToUSVString(ctx(), name);
+  return std::any_of(list_.begin(), list_.end(),
+                     [&](const auto& entry) { return entry.first == key && entry.second == string; });
+}
+
+void URLSearchParams::set(const AtomicString& name, const AtomicString& value, ExceptionState& exception_state) {
+  std::string key = ToUSVString(ctx(), name);
+  auto it = std::find_if(list_.begin(), list_.end(), [&](const auto& entry) { return entry.first == key; });
+  if (it == list_.end()) {
+    list_.emplace_back(std::move(key), ToUSVString(ctx(), value));
+  } else {
+    it->second = ToUSVString(ctx(), value);
+    list_.erase(std::remove_if(it + 1, list_.end(), [&](const auto& entry) { return entry.first == key; }),
+                list_.end());
+  }
+  Update();
+}
+
+void URLSearchParams::sort(ExceptionState& exception_state) {
+  std::stable_sort(list_.begin(), list_.end(),
+                   [](const auto& a, const auto& b) { return LessThanInUTF16(a.first, b.first); });
+  Update();
+}
+
+void URLSearchParams::forEach(const std::shared_ptr<QJSFunction>& callback, ExceptionState& exception_state) {
+  forEach(callback, ScriptValue::Undefined(ctx()), exception_state);
+}
+
+void URLSearchParams::forEach(const std::shared_ptr<QJSFunction>& callback,
+                              const ScriptValue& this_arg,
+                              ExceptionState& exception_state) {
+  if (callback == nullptr) {
+    exception_state.ThrowException(ctx(), ErrorType::TypeError,
+                                   "Failed to execute 'forEach' on 'URLSearchParams': The callback provided as "
+                                   "parameter 1 is not a function.");
+    return;
+  }
+  // The callback could change the list, so the entries are read by the index as the spec does.
+  JSValue function = callback->ToQuickJSUnsafe();
+  for (size_t i = 0; i < list_.size(); i++) {
+    JSValue arguments[] = {NewString(ctx(), list_[i].second), NewString(ctx(), list_[i].first), ToQuickJS()};
+    JSValue result = JS_Call(ctx(), function, this_arg.QJSValue(), 3, arguments);
+    for (JSValue argument : arguments)
+      JS_FreeValue(ctx(), argument);
+    if (JS_IsException(result)) {
+      RethrowException(ctx(), exception_state);
+      return;
+    }
+    JS_FreeValue(ctx(), result);
+  }
+}
+
+ScriptValue URLSearchParams::entries(ExceptionState& exception_state) {
+  return CreateIterator(IterationKind::kEntries);
+}
+
+ScriptValue URLSearchParams::keys(ExceptionState& exception_state) {
+  return CreateIterator(IterationKind::kKeys);
+}
+
+ScriptValue URLSearchParams::values(ExceptionState& exception_state) {
+  return CreateIterator(IterationKind::kValues);
+}
+
+ScriptValue URLSearchParams::Symbol_iterator() {
+  JSValue entries = JS_GetPropertyStr(ctx(), ToQuickJSUnsafe(), "entries");
+  ScriptValue result(ctx(), entries);
+  JS_FreeValue(ctx(), entries);
+  return result;
+}
+
+AtomicString URLSearchParams::toString(ExceptionState& exception_state) const {
+  return UTF8ToAtomicString(ctx(), URLParser::SerializeURLEncoded(list_));
+}
+
+void URLSearchParams::SetFromQuery(const std::string& query) {
+  list_ = URLParser::ParseURLEncoded(query.data(), query.size());
+}
+
+void URLSearchParams::Trace(GCVisitor* visitor) const {
+  visitor->TraceMember(url_);
+}
+
+void URLSearchParams::RemoveAll(const std::string& name, const std::string* value) {
+  list_.erase(std::remove_if(list_.begin(), list_.end(),
+                             [&](const auto& entry) {
+                               return entry.first == name && (value == nullptr || entry.second == *value);
+                             }),
+              list_.end());
+}
+
+// The iterators walk a snapshot of the list taken when they are created, which are the iterators of an array of the
+// entries.
+ScriptValue URLSearchParams::CreateIterator(IterationKind kind) {
+  JSContext* ctx = this->ctx();
+  JSValue array = JS_NewArray(ctx);
+  for (uint32_t i = 0; i < list_.size(); i++) {
+    JSValue item;
+    switch (kind) {
+      case IterationKind::kEntries:
+        item = JS_NewArray(ctx);
+        JS_SetPropertyUint32(ctx, item, 0, NewString(ctx, list_[i].first));
+        JS_SetPropertyUint32(ctx, item, 1, NewString(ctx, list_[i].second));
+        break;
+      case IterationKind::kKeys:
+        item = NewString(ctx, list_[i].first);
+        break;
+      case IterationKind::kValues:
+        item = NewString(ctx, list_[i].second);
+        break;
+    }
+    JS_SetPropertyUint32(ctx, array, i, item);
+  }
+  JSValue iterator_method = JS_GetProperty(ctx, array, JS_ATOM_Symbol_iterator);
+  JSValue iterator = JS_Call(ctx, iterator_method, array, 0, nullptr);
+  JS_FreeValue(ctx, iterator_method);
+  JS_FreeValue(ctx, array);
+  ScriptValue result(ctx, iterator);
+  JS_FreeValue(ctx, iterator);
+  return result;
+}
+
+void URLSearchParams::Update() {
+  if (url_ != nullptr)
+    url_->SetQueryFromSearchParams(URLParser::SerializeURLEncoded(list_));
+}
+
+}  // namespace webf
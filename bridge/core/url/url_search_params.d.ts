@@ -0,0 +1,17 @@
+interface URLSearchParams {
+  readonly size: int64;
+  append(name: string, value: string): void;
+  delete(name: string, value?: any): void;
+  get(name: string): string | null;
+  getAll(name: string): string[];
+  has(name: string, value?: any): boolean;
+  set(name: string, value: string): void;
+  sort(): void;
+  forEach(callback: Function, thisArg?: any): void;
+  entries(): any;
+  keys(): any;
+  values(): any;
+  toString(): string;
+  readonly [Symbol.iterator]: any;
+  new(init?: any): URLSearchParams;
+}
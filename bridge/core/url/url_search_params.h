@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_URL_URL_SEARCH_PARAMS_H_
+#define WEBF_CORE_URL_URL_SEARCH_PARAMS_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "bindings/qjs/cppgc/member.h"
+#include "bindings/qjs/qjs_function.h"
+#include "bindings/qjs/script_value.h"
+#include "bindings/qjs/script_wrappable.h"
+
+namespace webf {
+
+class URL;
+
+// https://url.spec.whatwg.org/#interface-urlsearchparams
+// The names and values are stored in UTF-8 and only converted to JS strings when they are read.
+class URLSearchParams : public ScriptWrappable {
+  DEFINE_WRAPPERTYPEINFO();
+
+ public:
+  using ImplType = URLSearchParams*;
+  using List = std::vector<std::pair<std::string, std::string>>;
+
+  static URLSearchParams* Create(ExecutingContext* context, ExceptionState& exception_state);
+  static URLSearchParams* Create(ExecutingContext* context, const ScriptValue& init, ExceptionState& exception_state);
+  // Creates the searchParams of the url, which is updated when the list is changed.
+  static URLSearchParams* Create(ExecutingContext* context, URL* url, const std::string& query);
+
+  explicit URLSearchParams(JSContext* ctx);
+
+  int64_t size() const { return list_.size(); }
+  void append(const AtomicString& name, const AtomicString& value, ExceptionState& exception_state);
+  void deleteForBinding(const AtomicString& name, ExceptionState& exception_state);
+  void deleteForBinding(const AtomicString& name, const ScriptValue& value, ExceptionState& exception_state);
+  AtomicString get(const AtomicString& name, ExceptionState& exception_state) const;
+  std::vector<AtomicString> getAll(const AtomicString& name, ExceptionState& exception_state) const;
+  bool has(const AtomicString& name, ExceptionState& exception_state) const;
+  bool has(const AtomicString& name, const ScriptValue& value, ExceptionState& exception_state) const;
+  void set(const AtomicString& name, const AtomicString& value, ExceptionState& exception_state);
+  void sort(ExceptionState& exception_state);
+  void forEach(const std::shared_ptr<QJSFunction>& callback, ExceptionState& exception_state);
+  void forEach(const std::shared_ptr<QJSFunction>& callback,
+               const ScriptValue& this_arg,
+               ExceptionState& exception_state);
+  ScriptValue entries(ExceptionState& exception_state);
+  ScriptValue keys(ExceptionState& exception_state);
+  ScriptValue values(ExceptionState& exception_state);
+  ScriptValue Symbol_iterator();
+  AtomicString toString(ExceptionState& exception_state) const;
+
+  const List& GetList() const { return list_; }
+  // Replaces the list when the query of the associated URL is set.
+  void SetFromQuery(const std::string& query);
+
+  void Trace(GCVisitor* visitor) const override;
+
+ private:
+  enum class IterationKind { kEntries, kKeys, kValues };
+
+  void InitFromSequence(JSValue init, JSValue iterator_method, ExceptionState& exception_state);
+  void InitFromRecord(JSValue init, ExceptionState& exception_state);
+  void RemoveAll(const std::string& name, const std::string* value);
+  ScriptValue CreateIterator(IterationKind kind);
+  // https://url.spec.whatwg.org/#concept-urlsearchparams-update
+  void Update();
+
+  List list_;
+  Member<URL> url_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_URL_URL_SEARCH_PARAMS_H_
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "usv_string.h"
+#include "bindings/qjs/qjs_engine_patch.h"
+#include "url_parser.h"
+
+namespace webf {
+
+namespace {
+
+std::string StringToUSV(JSString* p) {
+  std::string result;
+  if (!p->is_wide_char) {
+    const uint8_t* characters = p->u.str8;
+    size_t ascii_length = 0;
+    while (ascii_length < p->len && characters[ascii_length] < 0x80)
+      ascii_length++;
+    result.reserve(p->len + (p->len - ascii_length));
+    result.append(reinterpret_cast<const char*>(characters), ascii_length);
+    for (size_t i = ascii_length; i < p->len; i++)
+      AppendUTF8(characters[i], result);
+    return result;
+  }
+
+  const uint16_t* characters = p->u.str16;
+  result.reserve(p->len);
+  for (size_t i = 0; i < p->len; i++) {
+    uint32_t c = characters[i];
+    if (c >= 0xd800 && c <= 0xdfff) {
+      if (c <= 0xdbff && i + 1 < p->len && characters[i + 1] >= 0xdc00 && characters[i + 1] <= 0xdfff) {
+        c = 0x10000 + ((c - 0xd800) << 10) + (characters[i + 1] - 0xdc00);
+        i++;
+      } else {
+        c = 0xfffd;
+      }
+    }
+    AppendUTF8(c, result);
+  }
+  return result;
+}
+
+}  // namespace
+
+std::string ToUSVString(JSContext* ctx, const AtomicString& string) {
+  JSValue value = string.ToQuickJS(ctx);
+  std::string result = JS_IsString(value) ? StringToUSV(JS_VALUE_GET_STRING(value)) : "";
+  JS_FreeValue(ctx, value);
+  return result;
+}
+
+std::string ToUSVString(JSContext* ctx, JSValue value, ExceptionState& exception_state) {
+  if (JS_IsString(value))
+    return StringToUSV(JS_VALUE_GET_STRING(value));
+  JSValue string = JS_ToString(ctx, value);
+  if (JS_IsException(string)) {
+    JSValue error = JS_GetException(ctx);
+    exception_state.ThrowException(ctx, error);
+    JS_FreeValue(ctx, error);
+    return "";
+  }
+  std::string result = StringToUSV(JS_VALUE_GET_STRING(string));
+  JS_FreeValue(ctx, string);
+  return result;
+}
+
+AtomicString UTF8ToAtomicString(JSContext* ctx, const std::string& string) {
+  bool ascii = true;
+  for (char c : string)
+    ascii &= static_cast<uint8_t>(c) < 0x80;
+  if (ascii)
+    return AtomicString(ctx, string);
+
+  JSValue value = JS_NewStringLen(ctx, string.data(), string.size());
+  AtomicString result(ctx, value);
+  JS_FreeValue(ctx, value);
+  return result;
+}
+
+}  // namespace webf
@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_URL_USV_STRING_H_
+#define WEBF_CORE_URL_USV_STRING_H_
+
+#include <quickjs/quickjs.h>
+#include <string>
+#include "bindings/qjs/atomic_string.h"
+#include "bindings/qjs/exception_state.h"
+
+namespace webf {
+
+// Converts the string value to a USVString encoded in UTF-8, the lone surrogates are replaced with U+FFFD.
+// https://webidl.spec.whatwg.org/#js-usvstring
+std::string ToUSVString(JSContext* ctx, const AtomicString& string);
+// Converts any value with ToString() first, which could throw.
+std::string ToUSVString(JSContext* ctx, JSValue value, ExceptionState& exception_state);
+
+// Creates an AtomicString from UTF-8, which has the right length for non-ASCII strings.
+AtomicString UTF8ToAtomicString(JSContext* ctx, const std::string& string);
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_URL_USV_STRING_H_
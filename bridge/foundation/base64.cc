@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "base64.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define WEBF_BASE64_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define WEBF_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace webf {
+
+namespace {
+
+// The kernels encode whole groups of 3 bytes and return the number of bytes consumed, or decode whole groups of 4
+// characters until the first group with a character out of the alphabet, padding included, and return the number of
+// characters consumed. What is left is handled by modp_b64.
+using EncodeKernel = size_t (*)(char* dest, const uint8_t* src, size_t length);
+using DecodeKernel = size_t (*)(uint8_t* dest, const char* src, size_t length);
+
+struct Base64Kernels {
+  EncodeKernel encode{nullptr};
+  DecodeKernel decode{nullptr};
+};
+
+#if WEBF_BASE64_X86
+
+// The encoders follow "Faster Base64 Encoding and Decoding using AVX2 Instructions" by Wojciech Muła and Daniel Lemire:
+// the 3 bytes of each group are shuffled into a 32 bits lane as [b1, b0, b2, b1], the 4 sextets are moved to the low
+// bits of each byte by multiplications, then translated to the alphabet by adding an offset looked up by the range of
+// the sextet.
+__attribute__((target("ssse3"))) inline __m128i EncodeSSSE3Block(__m128i input) {
+  input = _mm_shuffle_epi8(input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+  __m128i t1 = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+  __m128i indices = _mm_or_si128(t0, t1);
+
+  // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12.
+  __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  ranges = _mm_or_si128(ranges, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+  const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, ranges));
+}
+
+__attribute__((target("ssse3"))) size_t EncodeSSSE3(char* dest, const uint8_t* src, size_t length) {
+  size_t i = 0;
+  // Each block loads 16 bytes and consumes 12 of them.
+  for (; length - i >= 16; i += 12, dest += 16) {
+    __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), EncodeSSSE3Block(input));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t EncodeAVX2(char* dest, const uint8_t* src, size_t length) {
+  const __m256i shuffle =
+      _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m256i offsets =
+      _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+  size_t i = 0;
+  // Each block loads 12 bytes into each 128 bits lane, the load of the high lane reads 4 bytes past the block.
+  for (; length - i >= 28; i += 24, dest += 32) {
+    __m256i input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12)), 1);
+    input = _mm256_shuffle_epi8(input, shuffle);
+    __m256i t0 =
+        _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+    __m256i t1 =
+        _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+    __m256i indices = _mm256_or_si256(t0, t1);
+    __m256i ranges = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    ranges = _mm256_or_si256(
+        ranges, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest),
+                        _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, ranges)));
+  }
+  return i + EncodeSSSE3(dest, src + i, length - i);
+}
+
+// The decoders validate the characters by the bits looked up with the low and high nibbles, which have a common bit
+// only for characters out of the alphabet, and translate the characters to sextets by an offset looked up with the
+// high nibble, '/' is the only character which needs its own offset. The sextets are packed by multiply-adds.
+__attribute__((target("ssse3"))) size_t DecodeSSSE3(uint8_t* dest, const char* src, size_t length) {
+  const __m128i lut_lo =
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m128i lut_hi =
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask_2f = _mm_set1_epi8(0x2f);
+  const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  size_t i = 0;
+  // Each block stores 16 bytes and produces 12 of them, 20 characters left guarantee the capacity of dest.
+  for (; length - i >= 20; i += 16, dest += 12) {
+    __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), mask_2f);
+    __m128i lo_nibbles = _mm_and_si128(input, mask_2f);
+    __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xffff)
+      break;
+    __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(input, mask_2f), hi_nibbles));
+    __m128i sextets = _mm_add_epi8(input, roll);
+    __m128i merged = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_shuffle_epi8(merged, pack));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t DecodeAVX2(uint8_t* dest, const char* src, size_t length) {
+  const __m256i lut_lo = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a));
+  const __m256i lut_hi = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+  const __m256i lut_roll =
+      _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+  const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+  const __m256i pack =
+      _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  size_t i = 0;
+  // Each block stores 32 bytes and produces 24 of them, 40 characters left guarantee the capacity of dest.
+  for (; length - i >= 40; i += 32, dest += 24) {
+    __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), mask_2f);
+    __m256i lo_nibbles = _mm256_and_si256(input, mask_2f);
+    __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+    if (!_mm256_testz_si256(lo, hi))
+      break;
+    __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(input, mask_2f), hi_nibbles));
+    __m256i sextets = _mm256_add_epi8(input, roll);
+    __m256i merged = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+    merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+    merged = _mm256_shuffle_epi8(merged, pack);
+    merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), merged);
+  }
+  return i + DecodeSSSE3(dest, src + i, length - i);
+}
+
+Base64Kernels SelectKernels() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return {EncodeAVX2, DecodeAVX2};
+  if (__builtin_cpu_supports("ssse3"))
+    return {EncodeSSSE3, DecodeSSSE3};
+  return {};
+}
+
+#elif WEBF_BASE64_NEON
+
+constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// The sextet of each ASCII character, 0xff for the characters out of the alphabet.
+struct DecodeTable {
+  uint8_t values[128];
+  constexpr DecodeTable() : values() {
+    for (uint8_t& value : values)
+      value = 0xff;
+    for (int i = 0; i < 64; i++)
+      values[static_cast<uint8_t>(kAlphabet[i])] = i;
+  }
+};
+constexpr DecodeTable kDecodeTable;
+
+// Deinterleaves 48 bytes into 3 vectors of the first, second and third bytes of the groups, and interleaves the 4
+// vectors of characters back to 64 characters, so no shuffles are needed.
+size_t EncodeNEON(char* dest, const uint8_t* src, size_t length) {
+  const uint8x16x4_t alphabet = vld1q_u8_x4(reinterpret_cast<const uint8_t*>(kAlphabet));
+  const uint8x16_t mask = vdupq_n_u8(0x3f);
+  size_t i = 0;
+  for (; length - i >= 48; i += 48, dest += 64) {
+    uint8x16x3_t input = vld3q_u8(src + i);
+    uint8x16x4_t output;
+    output.val[0] = vshrq_n_u8(input.val[0], 2);
+    output.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(input.val[0], 4), vshrq_n_u8(input.val[1], 4)), mask);
+    output.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(input.val[1], 2), vshrq_n_u8(input.val[2], 6)), mask);
+    output.val[3] = vandq_u8(input.val[2], mask);
+    for (auto& value : output.val)
+      value = vqtbl4q_u8(alphabet, value);
+    vst4q_u8(reinterpret_cast<uint8_t*>(dest), output);
+  }
+  return i;
+}
+
+size_t DecodeNEON(uint8_t* dest, const char* src, size_t length) {
+  const uint8x16x4_t table_lo = vld1q_u8_x4(kDecodeTable.values);
+  const uint8x16x4_t table_hi = vld1q_u8_x4(kDecodeTable.values + 64);
+  const uint8x16_t offset = vdupq_n_u8(64);
+  const uint8x16_t non_ascii = vdupq_n_u8(0x80);
+  size_t i = 0;
+  for (; length - i >= 64; i += 64, dest += 48) {
+    uint8x16x4_t input = vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16_t invalid = vdupq_n_u8(0);
+    for (auto& value : input.val) {
+      // Indices out of the table give 0 for the lookup and keep the value for the extension, the characters out of
+      // ASCII are marked invalid separately.
+      uint8x16_t sextet = vqtbx4q_u8(vqtbl4q_u8(table_lo, value), table_hi, vsubq_u8(value, offset));
+      invalid = vorrq_u8(invalid, vorrq_u8(sextet, vtstq_u8(value, non_ascii)));
+      value = sextet;
+    }
+    if (vmaxvq_u8(invalid) > 63)
+      break;
+    uint8x16x3_t output;
+    output.val[0] = vorrq_u8(vshlq_n_u8(input.val[0], 2), vshrq_n_u8(input.val[1], 4));
+    output.val[1] = vorrq_u8(vshlq_n_u8(input.val[1], 4), vshrq_n_u8(input.val[2], 2));
+    output.val[2] = vorrq_u8(vshlq_n_u8(input.val[2], 6), input.val[3]);
+    vst3q_u8(dest, output);
+  }
+  return i;
+}
+
+Base64Kernels SelectKernels() {
+  return {EncodeNEON, DecodeNEON};
+}
+
+#else
+
+Base64Kernels SelectKernels() {
+  return {};
+}
+
+#endif
+
+const Base64Kernels& Kernels() {
+  static const Base64Kernels kernels = SelectKernels();
+  return kernels;
+}
+
+}  // namespace
+
+size_t Base64::Encode(char* dest, const uint8_t* src, size_t length) {
+  size_t consumed = 0;
+  if (EncodeKernel encode = Kernels().encode)
+    consumed = encode(dest, src, length);
+  size_t written = consumed / 3 * 4;
+  return written +
+         modp_b64_encode_data(dest + written, reinterpret_cast<const char*>(src + consumed), length - consumed);
+}
+
+size_t Base64::Decode(uint8_t* dest, const char* src, size_t length, ModpDecodePolicy policy) {
+  size_t consumed = 0;
+  if (DecodeKernel decode = Kernels().decode)
+    consumed = decode(dest, src, length);
+  // The groups decoded by the kernels are all in the alphabet, so the validation of the padding and the length by
+  // modp_b64 gives the same result for the rest, whose length has the same remainder of 4.
+  size_t written = consumed / 4 * 3;
+  size_t rest = modp_b64_decode(reinterpret_cast<char*>(dest + written), src + consumed, length - consumed, policy);
+  if (rest == MODP_B64_ERROR)
+    return MODP_B64_ERROR;
+  return written + rest;
+}
+
+}  // namespace webf
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_FOUNDATION_BASE64_H_
+#define WEBF_FOUNDATION_BASE64_H_
+
+#include <modp_b64/modp_b64.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace webf {
+
+// Base64 codec with the standard alphabet, producing the same results as modp_b64 for every input and policy.
+//
+// The bulk of the data is processed 12 to 48 bytes at a time by SIMD kernels: AVX2 or SSSE3 selected at runtime on x86
+// and NEON on arm64. The tails, the padding and the blocks with invalid characters are handled by modp_b64, which is
+// also used alone when the CPU has no supported instruction set.
+class Base64 {
+ public:
+  static size_t EncodedLength(size_t length) { return modp_b64_encode_data_len(length); }
+  // Writes EncodedLength(length) characters to dest without a null terminator, returns the number of characters.
+  static size_t Encode(char* dest, const uint8_t* src, size_t length);
+
+  // The capacity of the dest buffer of Decode(), the kernels could write garbage bytes after the decoded bytes up to
+  // the capacity.
+  static size_t DecodedCapacity(size_t length) { return modp_b64_decode_len(length); }
+  // Returns the number of decoded bytes, or MODP_B64_ERROR if src is not encoded correctly for the policy.
+  static size_t Decode(uint8_t* dest, const char* src, size_t length, ModpDecodePolicy policy);
+};
+
+}  // namespace webf
+
+#endif  // WEBF_FOUNDATION_BASE64_H_
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "base64.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+static const ModpDecodePolicy kPolicies[] = {ModpDecodePolicy::kStrict, ModpDecodePolicy::kForgiving,
+                                             ModpDecodePolicy::kNoPaddingValidation};
+
+static void ExpectSameDecoding(const std::string& input) {
+  for (ModpDecodePolicy policy : kPolicies) {
+    std::vector<char> expected(modp_b64_decode_len(input.size()));
+    std::vector<uint8_t> actual(Base64::DecodedCapacity(input.size()));
+    size_t expected_size = modp_b64_decode(expected.data(), input.data(), input.size(), policy);
+    size_t actual_size = Base64::Decode(actual.data(), input.data(), input.size(), policy);
+    ASSERT_EQ(actual_size, expected_size) << input;
+    if (expected_size != MODP_B64_ERROR) {
+      EXPECT_EQ(memcmp(actual.data(), expected.data(), expected_size), 0) << input;
+    }
+  }
+}
+
+TEST(Base64, encodeMatchesModp) {
+  std::mt19937 random(1);
+  for (size_t length = 0; length < 1000; length++) {
+    std::vector<uint8_t> data(length);
+    for (uint8_t& byte : data)
+      byte = random();
+    std::string expected(modp_b64_encode_data_len(length), 0);
+    std::string actual(Base64::EncodedLength(length), 0);
+    modp_b64_encode_data(expected.data(), reinterpret_cast<const char*>(data.data()), length);
+    EXPECT_EQ(Base64::Encode(actual.data(), data.data(), length), actual.size());
+    EXPECT_EQ(actual, expected);
+    ExpectSameDecoding(actual);
+  }
+}
+
+TEST(Base64, decodeInvalidInputMatchesModp) {
+  std::mt19937 random(2);
+  const char kCorruptions[] = "=\n !-_\x80\xff";
+  for (int i = 0; i < 2000; i++) {
+    size_t length = random() % 300;
+    std::vector<uint8_t> data(length);
+    for (uint8_t& byte : data)
+      byte = random();
+    std::string encoded(Base64::EncodedLength(length), 0);
+    Base64::Encode(encoded.data(), data.data(), length);
+    if (!encoded.empty())
+      encoded[random() % encoded.size()] = kCorruptions[random() % (sizeof(kCorruptions) - 1)];
+    encoded.append(random() % 3, '=');
+    ExpectSameDecoding(encoded);
+  }
+}
+
+TEST(Base64, decodeEveryCharacterInBlocks) {
+  for (size_t position = 0; position < 64; position++) {
+    for (int c = 0; c < 256; c++) {
+      std::string input(96, 'Q');
+      input[position] = static_cast<char>(c);
+      ExpectSameDecoding(input);
+    }
+  }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "metrics.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+namespace webf {
+
+uint32_t MetricHistogram::BucketIndex(uint64_t value) {
+  if (value < kSubBucketCount)
+    return static_cast<uint32_t>(value);
+
+  uint32_t exponent = 63 - __builtin_clzll(value);
+  if (exponent > kMaxExponent)
+    return kBucketCount - 1;
+  uint32_t sub_bucket = (value >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t MetricHistogram::BucketLowerBound(uint32_t index) {
+  if (index < kSubBucketCount)
+    return index;
+
+  uint32_t exponent = index / kSubBucketCount + kSubBucketBits - 1;
+  uint64_t sub_bucket = index % kSubBucketCount;
+  return (kSubBucketCount + sub_bucket) << (exponent - kSubBucketBits);
+}
+
+void MetricHistogram::Record(uint64_t value) {
+  buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t current_max = max_.load(std::memory_order_relaxed);
+  while (value > current_max && !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t MetricHistogram::Percentile(double percentile) const {
+  uint64_t total = count();
+  if (total == 0)
+    return 0;
+
+  auto target = static_cast<uint64_t>(total * percentile / 100.0);
+  if (target >= total)
+    target = total - 1;
+
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < kBucketCount; i++) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen > target)
+      return BucketLowerBound(i);
+  }
+  return max();
+}
+
+void MetricHistogram::Reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+void MetricHistogram::AppendJSON(std::string& out) const {
+  char buffer[192];
+  snprintf(buffer, sizeof(buffer),
+           R"({"count":%)" PRIu64 R"(,"sum":%)" PRIu64 R"(,"max":%)" PRIu64 R"(,"p50":%)" PRIu64
+           R"(,"p90":%)" PRIu64 R"(,"p99":%)" PRIu64 "}",
+           count(), sum(), max(), Percentile(50), Percentile(90), Percentile(99));
+  out += buffer;
+}
+
+void AppendMetricJSON(std::string& out, const char* name, uint64_t value) {
+  out += '"';
+  out += name;
+  out += "\":";
+  out += std::to_string(value);
+  out += ',';
+}
+
+void AppendMetricJSON(std::string& out, const char* name, const MetricHistogram& histogram) {
+  out += '"';
+  out += name;
+  out += "\":";
+  histogram.AppendJSON(out);
+  out += ',';
+}
+
+}  // namespace webf
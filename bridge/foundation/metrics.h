@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_FOUNDATION_METRICS_H_
+#define WEBF_FOUNDATION_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "foundation/macros.h"
+
+namespace webf {
+
+// Monotonic counter which can be updated from any thread.
+class MetricCounter {
+ public:
+  MetricCounter() = default;
+  WEBF_DISALLOW_COPY_ASSIGN_AND_MOVE(MetricCounter);
+
+  FORCE_INLINE void Increment(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+  void Reset() { value_.store(0, std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+// HDR style histogram with a fixed memory footprint.
+// Values are bucketed with 8 linear sub buckets for each power of two, which keeps the relative error of the
+// percentiles under 12.5%. Values larger than 2^40 are clamped into the last bucket. Recording is lock free.
+class MetricHistogram {
+ public:
+  static constexpr uint32_t kSubBucketBits = 3;
+  static constexpr uint32_t kSubBucketCount = 1 << kSubBucketBits;
+  static constexpr uint32_t kMaxExponent = 40;
+  static constexpr uint32_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+  MetricHistogram() = default;
+  WEBF_DISALLOW_COPY_ASSIGN_AND_MOVE(MetricHistogram);
+
+  void Record(uint64_t value);
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+  // Lower bound of the bucket holding the given percentile, percentile is in [0, 100].
+  uint64_t Percentile(double percentile) const;
+  void Reset();
+
+  // {"count":1,"sum":1,"max":1,"p50":1,"p90":1,"p99":1}
+  void AppendJSON(std::string& out) const;
+
+  static uint32_t BucketIndex(uint64_t value);
+  static uint64_t BucketLowerBound(uint32_t index);
+
+ private:
+  std::atomic<uint64_t> buckets_[kBucketCount]{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+// Measure the elapsed microseconds of a scope into a histogram.
+class ScopedMetricTimer {
+  WEBF_DISALLOW_COPY_ASSIGN_AND_MOVE(ScopedMetricTimer);
+
+ public:
+  explicit ScopedMetricTimer(MetricHistogram* histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedMetricTimer() {
+    histogram_->Record(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count());
+  }
+
+ private:
+  MetricHistogram* histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Helpers to write metrics as JSON members: "name":value,
+void AppendMetricJSON(std::string& out, const char* name, uint64_t value);
+void AppendMetricJSON(std::string& out, const char* name, const MetricHistogram& histogram);
+
+}  // namespace webf
+
+#endif  // WEBF_FOUNDATION_METRICS_H_
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "metrics.h"
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(MetricHistogram, bucketBoundsContainValue) {
+  for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 100ull, 1000ull, 123456ull, 1ull << 39}) {
+    uint32_t index = MetricHistogram::BucketIndex(value);
+    EXPECT_LE(MetricHistogram::BucketLowerBound(index), value);
+    if (index + 1 < MetricHistogram::kBucketCount) {
+      EXPECT_GT(MetricHistogram::BucketLowerBound(index + 1), value);
+    }
+  }
+  EXPECT_EQ(MetricHistogram::BucketIndex(UINT64_MAX), MetricHistogram::kBucketCount - 1);
+}
+
+TEST(MetricHistogram, percentiles) {
+  MetricHistogram histogram;
+  for (uint64_t i = 1; i <= 1000; i++) {
+    histogram.Record(i);
+  }
+  EXPECT_EQ(histogram.count(), 1000);
+  EXPECT_EQ(histogram.sum(), 500500);
+  EXPECT_EQ(histogram.max(), 1000);
+  // The relative error is bounded by the sub bucket width.
+  EXPECT_NEAR(histogram.Percentile(50), 500, 500 / 8);
+  EXPECT_NEAR(histogram.Percentile(99), 990, 990 / 8);
+
+  std::string json;
+  histogram.AppendJSON(json);
+  EXPECT_EQ(json.find(R"({"count":1000,"sum":500500,"max":1000,)"), 0);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.Percentile(50), 0);
+}
+
+TEST(MetricCounter, incrementFromThreads) {
+  MetricCounter counter;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&counter]() {
+      for (int j = 0; j < 1000; j++) {
+        counter.Increment();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.value(), 4000);
+}
@@ -68,7 +68,7 @@ ProfileOpItem::ProfileOpItem(WebFProfiler* owner) : owner_(owner) {
   stopwatch_.Begin();
 }
 
-void ProfileOpItem::RecordStep(const std::string& label, const std::shared_ptr<ProfileStep>& step) {
+void ProfileOpItem::RecordStep(const std::shared_ptr<ProfileStep>& step) {
   bool is_child_step = false;
   if (!step_stack_.empty()) {
     is_child_step = true;
@@ -81,8 +81,6 @@ void ProfileOpItem::RecordStep(const std::string& label, const std::shared_ptr<P
   }
 
   step_stack_.emplace(step);
-  //  assert(step_map_.count(label) == 0);
-  //  step_map_[label] = step;
 }
 
 void ProfileOpItem::FinishStep() {
@@ -114,6 +112,7 @@ ScriptValue ProfileOpItem::ToJSON(JSContext* ctx, const std::string& path, bool
 WebFProfiler::WebFProfiler(bool enable) : enabled_(enable) {}
 
 void WebFProfiler::StartTrackInitialize() {
+  TraceRecorder::Begin(TraceLabel::kInitialize);
   if (UNLIKELY(enabled_)) {
     std::shared_ptr<ProfileOpItem> profile_item = std::make_shared<ProfileOpItem>(this);
     profile_stacks_.emplace(profile_item);
@@ -122,6 +121,7 @@ void WebFProfiler::StartTrackInitialize() {
 }
 
 void WebFProfiler::FinishTrackInitialize() {
+  TraceRecorder::End();
   if (UNLIKELY(enabled_)) {
     auto&& profile_item = profile_stacks_.top();
     profile_item->stopwatch_.End();
@@ -130,6 +130,7 @@ void WebFProfiler::FinishTrackInitialize() {
 }
 
 void WebFProfiler::StartTrackEvaluation(int64_t evaluate_id) {
+  TraceRecorder::Begin(TraceLabel::kEvaluation);
   if (UNLIKELY(enabled_)) {
     std::shared_ptr<ProfileOpItem> profile_item = std::make_shared<ProfileOpItem>(this);
     assert(evaluate_profile_items_.count(evaluate_id) == 0);
@@ -139,6 +140,7 @@ void WebFProfiler::StartTrackEvaluation(int64_t evaluate_id) {
 }
 
 void WebFProfiler::FinishTrackEvaluation(int64_t evaluate_id) {
+  TraceRecorder::End();
   if (UNLIKELY(enabled_)) {
     auto&& profile_item = evaluate_profile_items_[evaluate_id];
     profile_item->stopwatch_.End();
@@ -147,6 +149,7 @@ void WebFProfiler::FinishTrackEvaluation(int64_t evaluate_id) {
 }
 
 void WebFProfiler::StartTrackAsyncEvaluation() {
+  TraceRecorder::Begin(TraceLabel::kAsyncEvaluation);
   if (UNLIKELY(enabled_)) {
     std::shared_ptr<ProfileOpItem> profile_item = std::make_shared<ProfileOpItem>(this);
     async_evaluate_profile_items.emplace_back(profile_item);
@@ -155,6 +158,7 @@ void WebFProfiler::StartTrackAsyncEvaluation() {
 }
 
 void WebFProfiler::FinishTrackAsyncEvaluation() {
+  TraceRecorder::End();
   if (UNLIKELY(enabled_)) {
     auto&& profile_item = profile_stacks_.top();
     profile_item->stopwatch_.End();
@@ -162,36 +166,40 @@ void WebFProfiler::FinishTrackAsyncEvaluation() {
   }
 }
 
-void WebFProfiler::StartTrackSteps(const std::string& label) {
+void WebFProfiler::StartTrackSteps(TraceLabel label) {
+  TraceRecorder::Begin(label);
   if (UNLIKELY(enabled_)) {
     assert_m(!profile_stacks_.empty(), "Tracks not started");
 
     auto&& current_profile = profile_stacks_.top();
 
-    auto step = std::make_shared<ProfileStep>(current_profile.get(), label);
-    current_profile->RecordStep(label, step);
+    auto step = std::make_shared<ProfileStep>(current_profile.get(), TraceLabelName(label));
+    current_profile->RecordStep(step);
   }
 }
 
 void WebFProfiler::FinishTrackSteps() {
+  TraceRecorder::End();
   if (UNLIKELY(enabled_)) {
     auto&& current_profile = profile_stacks_.top();
     current_profile->FinishStep();
   }
 }
 
-void WebFProfiler::StartTrackLinkSteps(const std::string& label) {
+void WebFProfiler::StartTrackLinkSteps(TraceLabel label) {
+  TraceRecorder::Begin(label);
   if (UNLIKELY(enabled_)) {
     auto&& current_profile = profile_stacks_.top();
 
     assert(current_profile != nullptr);
 
-    auto step = std::make_shared<LinkProfileStep>(current_profile.get(), label);
-    current_profile->RecordStep(label, step);
+    auto step = std::make_shared<LinkProfileStep>(current_profile.get(), TraceLabelName(label));
+    current_profile->RecordStep(step);
   }
 }
 
 void WebFProfiler::FinishTrackLinkSteps() {
+  TraceRecorder::End();
   if (UNLIKELY(enabled_)) {
     auto&& current_profile = profile_stacks_.top();
     current_profile->FinishStep();
@@ -13,6 +13,7 @@
 #include <vector>
 #include "bindings/qjs/script_value.h"
 #include "foundation/stop_watch.h"
+#include "foundation/trace_event.h"
 
 namespace webf {
 
@@ -55,7 +56,7 @@ class ProfileOpItem {
  public:
   explicit ProfileOpItem(WebFProfiler* owner);
 
-  void RecordStep(const std::string& label, const std::shared_ptr<ProfileStep>& step);
+  void RecordStep(const std::shared_ptr<ProfileStep>& step);
   void FinishStep();
 
   ScriptValue ToJSON(JSContext* ctx, const std::string& path, bool should_link);
@@ -68,7 +69,6 @@ class ProfileOpItem {
  private:
   Stopwatch stopwatch_;
 
-  std::unordered_map<std::string, std::shared_ptr<ProfileStep>> step_map_;
   std::stack<std::shared_ptr<ProfileStep>> step_stack_;
   std::vector<std::shared_ptr<ProfileStep>> steps_;
   friend WebFProfiler;
@@ -88,10 +88,12 @@ class WebFProfiler {
   void StartTrackAsyncEvaluation();
   void FinishTrackAsyncEvaluation();
 
-  void StartTrackSteps(const std::string& label);
+  // Steps are also recorded by TraceRecorder when tracing is enabled. Labels are static ids, so nothing is allocated
+  // when both of them are disabled.
+  void StartTrackSteps(TraceLabel label);
   void FinishTrackSteps();
 
-  void StartTrackLinkSteps(const std::string& label);
+  void StartTrackLinkSteps(TraceLabel label);
   void FinishTrackLinkSteps();
 
   int64_t link_id() {
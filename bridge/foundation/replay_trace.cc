@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "replay_trace.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+
+namespace webf {
+
+namespace {
+
+constexpr size_t kMagicLength = sizeof(ReplayTraceWriter::kMagic) - 1;
+
+template <typename T>
+void AppendScalar(std::string& out, T value) {
+  static_assert(std::is_trivially_copyable<T>::value, "Only scalars could be appended.");
+  char bytes[sizeof(T)];
+  memcpy(bytes, &value, sizeof(T));
+  out.append(bytes, sizeof(T));
+}
+
+void AppendString(std::string& out, const std::string& value) {
+  AppendScalar<uint32_t>(out, static_cast<uint32_t>(value.size()));
+  out.append(value);
+}
+
+template <typename T>
+bool ReadScalar(const char** cursor, const char* end, T* value) {
+  if (end - *cursor < static_cast<ptrdiff_t>(sizeof(T)))
+    return false;
+  memcpy(value, *cursor, sizeof(T));
+  *cursor += sizeof(T);
+  return true;
+}
+
+bool ReadString(const char** cursor, const char* end, std::string* value) {
+  uint32_t length;
+  if (!ReadScalar(cursor, end, &length) || end - *cursor < static_cast<ptrdiff_t>(length))
+    return false;
+  value->assign(*cursor, length);
+  *cursor += length;
+  return true;
+}
+
+}  // namespace
+
+void ReplayRecord::Encode(std::string& out) const {
+  AppendScalar(out, static_cast<uint8_t>(type));
+  AppendScalar(out, time);
+  AppendScalar(out, id);
+  AppendScalar(out, number);
+  AppendString(out, name);
+  AppendString(out, data);
+}
+
+bool ReplayRecord::Decode(const char** cursor, const char* end, ReplayRecord* record) {
+  uint8_t type;
+  if (!ReadScalar(cursor, end, &type) || type < static_cast<uint8_t>(ReplayRecordType::kStart) ||
+      type > static_cast<uint8_t>(ReplayRecordType::kModuleCallback))
+    return false;
+  record->type = static_cast<ReplayRecordType>(type);
+  return ReadScalar(cursor, end, &record->time) && ReadScalar(cursor, end, &record->id) &&
+         ReadScalar(cursor, end, &record->number) && ReadString(cursor, end, &record->name) &&
+         ReadString(cursor, end, &record->data);
+}
+
+ReplayTraceWriter::~ReplayTraceWriter() {
+  Close();
+}
+
+bool ReplayTraceWriter::Open(const std::string& path) {
+  Close();
+  file_ = fopen(path.c_str(), "wb");
+  if (file_ == nullptr)
+    return false;
+  fwrite(kMagic, 1, kMagicLength, file_);
+  return true;
+}
+
+void ReplayTraceWriter::Write(const ReplayRecord& record) {
+  if (file_ == nullptr)
+    return;
+  buffer_.clear();
+  record.Encode(buffer_);
+  fwrite(buffer_.data(), 1, buffer_.size(), file_);
+}
+
+void ReplayTraceWriter::Close() {
+  if (file_ == nullptr)
+    return;
+  fclose(file_);
+  file_ = nullptr;
+}
+
+bool ReplayTraceReader::Open(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+    return false;
+  std::stringstream content;
+  content << file.rdbuf();
+  return Load(content.str());
+}
+
+bool ReplayTraceReader::Load(std::string content) {
+  if (content.size() < kMagicLength || memcmp(content.data(), ReplayTraceWriter::kMagic, kMagicLength) != 0)
+    return false;
+  content_ = std::move(content);
+  offset_ = kMagicLength;
+  return true;
+}
+
+bool ReplayTraceReader::Next(ReplayRecord* record) {
+  const char* cursor = content_.data() + offset_;
+  const char* end = content_.data() + content_.size();
+  if (cursor == end || !ReplayRecord::Decode(&cursor, end, record))
+    return false;
+  offset_ = cursor - content_.data();
+  return true;
+}
+
+}  // namespace webf
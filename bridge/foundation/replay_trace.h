@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_FOUNDATION_REPLAY_TRACE_H_
+#define WEBF_FOUNDATION_REPLAY_TRACE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "foundation/macros.h"
+
+namespace webf {
+
+// The inputs a page receives from dart side. Replaying them in order against a fresh page reproduces the same
+// javascript execution without flutter.
+enum class ReplayRecordType : uint8_t {
+  kStart = 1,
+  kEvaluateScript = 2,
+  kEvaluateByteCode = 3,
+  kParseHTML = 4,
+  kDispatchEvent = 5,
+  kTimer = 6,
+  kAnimationFrame = 7,
+  kModuleCallback = 8,
+};
+
+// The meaning of the fields depends on the type:
+//  kStart:            data = `<event target id> <scheduled callback id> <module invocation id>`, the next ids of the
+//                     context when the recording started. Ids allocated before are the ones of the objects created
+//                     by the context itself and are the same in every environment, later ids are rebased.
+//  kEvaluateScript:   name = source url, data = script, id = start line.
+//  kEvaluateByteCode: data = bytecode.
+//  kParseHTML:        data = html.
+//  kDispatchEvent:    id = event target id, name = event type, data = `interface\0init json`, number = isCapture.
+//  kTimer:            id = scheduled callback id of the timer.
+//  kAnimationFrame:   id = scheduled callback id of the frame callback, number = high resolution timestamp.
+//  kModuleCallback:   id = module invocation id, name = error message, data = result json.
+struct ReplayRecord {
+  ReplayRecordType type{ReplayRecordType::kStart};
+  // Microseconds since the recording started.
+  int64_t time{0};
+  int64_t id{0};
+  double number{0};
+  std::string name;
+  std::string data;
+
+  // Appends the binary form of the record to |out|.
+  void Encode(std::string& out) const;
+  // Reads a record at |*cursor| and advances it, returns false when the input is truncated or malformed.
+  static bool Decode(const char** cursor, const char* end, ReplayRecord* record);
+};
+
+// Trace file layout: the 8 bytes magic with the format version followed by the encoded records.
+// All integers are little endian, strings are length prefixed with uint32.
+class ReplayTraceWriter {
+ public:
+  static constexpr char kMagic[] = "WEBFRP01";
+
+  ReplayTraceWriter() = default;
+  ~ReplayTraceWriter();
+  WEBF_DISALLOW_COPY_ASSIGN_AND_MOVE(ReplayTraceWriter);
+
+  bool Open(const std::string& path);
+  bool IsOpen() const { return file_ != nullptr; }
+  void Write(const ReplayRecord& record);
+  void Close();
+
+ private:
+  FILE* file_{nullptr};
+  std::string buffer_;
+};
+
+class ReplayTraceReader {
+ public:
+  ReplayTraceReader() = default;
+  WEBF_DISALLOW_COPY_ASSIGN_AND_MOVE(ReplayTraceReader);
+
+  // Loads the whole trace into memory, returns false when the file is missing or has an unknown version.
+  bool Open(const std::string& path);
+  bool Load(std::string content);
+  // Returns false at the end of the trace or at the first malformed record.
+  bool Next(ReplayRecord* record);
+
+ private:
+  std::string content_;
+  size_t offset_{0};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_FOUNDATION_REPLAY_TRACE_H_
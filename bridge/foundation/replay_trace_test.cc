@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "replay_trace.h"
+#include <cstdio>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(ReplayTrace, recordRoundTrip) {
+  ReplayRecord record;
+  record.type = ReplayRecordType::kDispatchEvent;
+  record.time = 1234;
+  record.id = 42;
+  record.number = 1;
+  record.name = "click";
+  record.data = std::string("MouseEvent\0{\"clientX\":10}", 26);
+
+  std::string encoded;
+  record.Encode(encoded);
+
+  ReplayRecord decoded;
+  const char* cursor = encoded.data();
+  EXPECT_TRUE(ReplayRecord::Decode(&cursor, encoded.data() + encoded.size(), &decoded));
+  EXPECT_EQ(cursor, encoded.data() + encoded.size());
+  EXPECT_EQ(decoded.type, ReplayRecordType::kDispatchEvent);
+  EXPECT_EQ(decoded.time, 1234);
+  EXPECT_EQ(decoded.id, 42);
+  EXPECT_EQ(decoded.number, 1);
+  EXPECT_EQ(decoded.name, "click");
+  EXPECT_EQ(decoded.data, record.data);
+}
+
+TEST(ReplayTrace, truncatedRecordIsRejected) {
+  ReplayRecord record;
+  record.type = ReplayRecordType::kEvaluateScript;
+  record.data = "console.log(1)";
+  std::string encoded;
+  record.Encode(encoded);
+
+  ReplayRecord decoded;
+  const char* cursor = encoded.data();
+  EXPECT_FALSE(ReplayRecord::Decode(&cursor, encoded.data() + encoded.size() - 1, &decoded));
+}
+
+TEST(ReplayTrace, writeAndReadFile) {
+  std::string path = ::testing::TempDir() + "replay_trace_test.trace";
+  {
+    ReplayTraceWriter writer;
+    ASSERT_TRUE(writer.Open(path));
+    for (int i = 0; i < 3; i++) {
+      ReplayRecord record;
+      record.type = ReplayRecordType::kTimer;
+      record.id = i;
+      writer.Write(record);
+    }
+  }
+
+  ReplayTraceReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ReplayRecord record;
+  int count = 0;
+  while (reader.Next(&record)) {
+    EXPECT_EQ(record.type, ReplayRecordType::kTimer);
+    EXPECT_EQ(record.id, count++);
+  }
+  EXPECT_EQ(count, 3);
+  remove(path.c_str());
+}
+
+TEST(ReplayTrace, unknownVersionIsRejected) {
+  ReplayTraceReader reader;
+  EXPECT_FALSE(reader.Load("WEBFRP99"));
+  EXPECT_TRUE(reader.Load("WEBFRP01"));
+  ReplayRecord record;
+  EXPECT_FALSE(reader.Next(&record));
+}
@@ -11,19 +11,41 @@ namespace webf {
 
 SharedUICommand::SharedUICommand(ExecutingContext* context)
     : context_(context),
-      active_buffer(std::make_unique<UICommandBuffer>(context)),
-      reserve_buffer_(std::make_unique<UICommandBuffer>(context)),
-      waiting_buffer_(std::make_unique<UICommandBuffer>(context)),
-      ui_command_sync_strategy_(std::make_unique<UICommandSyncStrategy>(this)),
-      is_blocking_writing_(false) {}
+      reserve_buffer_(std::make_unique<UICommandBuffer>(context, &chunk_pool_)),
+      waiting_buffer_(std::make_unique<UICommandBuffer>(context, &chunk_pool_)),
+      ui_command_sync_strategy_(std::make_unique<UICommandSyncStrategy>(this)) {
+  // The queue always keeps an already consumed chunk at the head, so both threads never touch the same pointer.
+  publish_tail_ = consume_head_ = chunk_pool_.Allocate();
+}
+
+SharedUICommand::~SharedUICommand() {
+  UICommandChunk* chunk = consume_head_;
+  while (chunk != nullptr) {
+    UICommandChunk* next = chunk->next.load(std::memory_order_acquire);
+    delete chunk;
+    chunk = next;
+  }
+}
 
 void SharedUICommand::AddCommand(UICommand type,
                                  std::unique_ptr<SharedNativeString>&& args_01,
                                  NativeBindingObject* native_binding_object,
                                  void* nativePtr2,
                                  bool request_ui_update) {
+  AddCommandWithImmediate(type, 0, std::move(args_01), native_binding_object, nativePtr2, request_ui_update);
+}
+
+void SharedUICommand::AddCommandWithImmediate(UICommand type,
+                                              int64_t immediate,
+                                              std::unique_ptr<SharedNativeString>&& args_01,
+                                              NativeBindingObject* native_binding_object,
+                                              void* nativePtr2,
+                                              bool request_ui_update) {
+  context_->metrics()->RecordUICommand();
+  context_->layoutQueryCache()->Invalidate();
   if (!context_->isDedicated()) {
-    active_buffer->addCommand(type, std::move(args_01), native_binding_object, nativePtr2, request_ui_update);
+    reserve_buffer_->addCommand(type, std::move(args_01), native_binding_object, nativePtr2, request_ui_update,
+                                immediate);
     return;
   }
 
@@ -31,56 +53,83 @@ void SharedUICommand::AddCommand(UICommand type,
     SyncToActive();
   }
 
-  ui_command_sync_strategy_->RecordUICommand(type, args_01, native_binding_object, nativePtr2, request_ui_update);
+  if (type == UICommand::kSetProperty) {
+    has_pending_property_sets_ = true;
+  }
+
+  ui_command_sync_strategy_->RecordUICommand(type, args_01, native_binding_object, nativePtr2, request_ui_update,
+                                             immediate);
 }
 
-// first called by dart to being read commands.
-void* SharedUICommand::data() {
-  // simply spin wait for the swapBuffers to finish.
-  while (is_blocking_writing_.load(std::memory_order::memory_order_acquire)) {
+int64_t SharedUICommand::InternString(const AtomicString& string, std::unique_ptr<SharedNativeString>& args_01) {
+  auto it = interned_strings_.find(string);
+  if (it != interned_strings_.end())
+    return it->second;
+
+  int64_t id = static_cast<int64_t>(interned_strings_.size());
+  interned_strings_.emplace(string, id);
+  args_01 = string.ToNativeString(context_->ctx());
+  return id;
+}
+
+// first called by dart to being read commands, returns the first chunk of the published commands.
+UICommandChunk* SharedUICommand::data() {
+  // Commands are recorded and read in the same thread without dedicated JS thread.
+  if (!context_->isDedicated()) {
+    Publish();
+  }
+
+  UICommandChunk* first = consume_head_->next.load(std::memory_order_acquire);
+  reading_tail_ = nullptr;
+  reading_size_ = 0;
+  reading_kind_flag_ = 0;
+
+  for (UICommandChunk* chunk = first; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+    reading_tail_ = chunk;
+    reading_size_ += chunk->size;
+    reading_kind_flag_ |= chunk->kind_flag;
   }
 
-  return active_buffer->data();
+  return first;
 }
 
 uint32_t SharedUICommand::kindFlag() {
-  return active_buffer->kindFlag();
+  return reading_kind_flag_;
 }
 
 // second called by dart to get the size of commands.
 int64_t SharedUICommand::size() {
-  return active_buffer->size();
+  return reading_size_;
 }
 
-// third called by dart to clear commands.
+// third called by dart to release the chunks had been read.
 void SharedUICommand::clear() {
-  active_buffer->clear();
+  if (reading_tail_ == nullptr) {
+    data();
+  }
+  if (reading_tail_ == nullptr)
+    return;
+
+  // The last read chunk becomes the new head, the JS thread may still be linking new chunks after it.
+  UICommandChunk* chunk = consume_head_;
+  while (chunk != reading_tail_) {
+    UICommandChunk* next = chunk->next.load(std::memory_order_acquire);
+    chunk_pool_.Recycle(chunk);
+    chunk = next;
+  }
+  consume_head_ = reading_tail_;
+  reading_tail_ = nullptr;
+  reading_size_ = 0;
+  reading_kind_flag_ = 0;
 }
 
 // called by c++ to check if there are commands.
 bool SharedUICommand::empty() {
-  if (context_->isDedicated()) {
-    return reserve_buffer_->empty() && waiting_buffer_->empty();
-  }
-
-  return active_buffer->empty();
+  return reserve_buffer_->empty() && waiting_buffer_->empty();
 }
 
 void SharedUICommand::SyncToReserve() {
-  if (waiting_buffer_->empty())
-    return;
-
-  size_t waiting_size = waiting_buffer_->size();
-  size_t origin_reserve_size = reserve_buffer_->size();
-
-  if (reserve_buffer_->empty()) {
-    swap(reserve_buffer_, waiting_buffer_);
-  } else {
-    appendCommand(reserve_buffer_, waiting_buffer_);
-  }
-
-  assert(waiting_buffer_->empty());
-  assert(reserve_buffer_->size() == waiting_size + origin_reserve_size);
+  reserve_buffer_->Append(*waiting_buffer_);
 }
 
 void SharedUICommand::ConfigureSyncCommandBufferSize(size_t size) {
@@ -91,36 +140,35 @@ void SharedUICommand::SyncToActive() {
   SyncToReserve();
 
   assert(waiting_buffer_->empty());
+  has_pending_property_sets_ = false;
 
   if (reserve_buffer_->empty())
     return;
 
   ui_command_sync_strategy_->Reset();
   context_->dartMethodPtr()->requestBatchUpdate(context_->isDedicated(), context_->contextId());
-
-  size_t reserve_size = reserve_buffer_->size();
-  size_t origin_active_size = active_buffer->size();
-  appendCommand(active_buffer, reserve_buffer_);
-  assert(reserve_buffer_->empty());
-  assert(active_buffer->size() == reserve_size + origin_active_size);
-}
-
-void SharedUICommand::swap(std::unique_ptr<UICommandBuffer>& target, std::unique_ptr<UICommandBuffer>& original) {
-  is_blocking_writing_.store(true, std::memory_order::memory_order_release);
-  std::swap(target, original);
-  is_blocking_writing_.store(false, std::memory_order::memory_order_release);
+  context_->metrics()->RecordUICommandSync(reserve_buffer_->size());
+  Publish();
 }
 
-void SharedUICommand::appendCommand(std::unique_ptr<UICommandBuffer>& target,
-                                    std::unique_ptr<UICommandBuffer>& original) {
-  is_blocking_writing_.store(true, std::memory_order::memory_order_release);
-
-  UICommandItem* command_item = original->data();
-  target->addCommands(command_item, original->size());
+void SharedUICommand::Publish() {
+  if (reserve_buffer_->empty())
+    return;
 
-  original->clear();
+  // The commands are disposed by the finalizers after the context is invalidated, the DOM tree is gone by then.
+  if (context_->IsContextValid()) {
+    if (int64_t* roots = context_->TakeStyleDirtyRoots()) {
+      // In front of the batch, so the recorded commands keep their places and dart side knows the recalc of the
+      // attribute changes is deferred to the roots before it applies them.
+      reserve_buffer_->PrependCommand(UICommand::kStyleDirtyRoots, nullptr, roots);
+    }
+  }
 
-  is_blocking_writing_.store(false, std::memory_order::memory_order_release);
+  UICommandChunk* tail;
+  UICommandChunk* head = reserve_buffer_->TakeChunks(&tail);
+  // Release the items and links of the chunks to the dart thread.
+  publish_tail_->next.store(head, std::memory_order_release);
+  publish_tail_ = tail;
 }
 
-}  // namespace webf
\ No newline at end of file
+}  // namespace webf
@@ -7,6 +7,8 @@
 
 #include <atomic>
 #include <memory>
+#include <unordered_map>
+#include "bindings/qjs/atomic_string.h"
 #include "foundation/native_type.h"
 #include "foundation/ui_command_buffer.h"
 #include "foundation/ui_command_strategy.h"
@@ -15,36 +17,62 @@ namespace webf {
 
 struct NativeBindingObject;
 
+// UI commands recorded in the JS thread are handed over to the dart thread through a single producer single consumer
+// queue of UICommandChunk. Syncing links the recorded chunks to the end of the queue and dart side walks the chunks
+// in place, so a large batch of commands is published in O(1) and no thread waits for the other one.
 class SharedUICommand : public DartReadable {
  public:
   SharedUICommand(ExecutingContext* context);
+  ~SharedUICommand();
 
   void AddCommand(UICommand type,
                   std::unique_ptr<SharedNativeString>&& args_01,
                   NativeBindingObject* native_binding_object,
                   void* nativePtr2,
                   bool request_ui_update = true);
+  // Records a command with a typed immediate operand, see UICommandItem::immediate.
+  void AddCommandWithImmediate(UICommand type,
+                               int64_t immediate,
+                               std::unique_ptr<SharedNativeString>&& args_01,
+                               NativeBindingObject* native_binding_object,
+                               void* nativePtr2,
+                               bool request_ui_update = true);
 
-  void* data();
+  // Returns the id of the string for the immediate operand. Dart side keeps the strings of the page by id, so the
+  // string is only sent as args_01 of the first command using the id, which is set to args_01 here.
+  int64_t InternString(const AtomicString& string, std::unique_ptr<SharedNativeString>& args_01);
+
+  UICommandChunk* data();
   uint32_t kindFlag();
   int64_t size();
   bool empty();
   void clear();
   void SyncToActive();
   void SyncToReserve();
-
   void ConfigureSyncCommandBufferSize(size_t size);
+  // Property sets are write-behind, anything reading back from dart needs them published first.
+  bool HasPendingPropertySets() const { return has_pending_property_sets_; }
 
  private:
-  void swap(std::unique_ptr<UICommandBuffer>& original, std::unique_ptr<UICommandBuffer>& target);
-  void appendCommand(std::unique_ptr<UICommandBuffer>& original, std::unique_ptr<UICommandBuffer>& target);
-  std::unique_ptr<UICommandBuffer> active_buffer = nullptr;    // The ui commands which accessible from Dart side
-  std::unique_ptr<UICommandBuffer> reserve_buffer_ = nullptr;  // The ui commands which are ready to swap to active.
+  void Publish();
+
+  ExecutingContext* context_;
+  // Keep the pool above the buffers, the chunks of the buffers are recycled into the pool when released.
+  UICommandChunkPool chunk_pool_;
+  std::unique_ptr<UICommandBuffer> reserve_buffer_ = nullptr;  // The ui commands which are ready to publish to dart.
   std::unique_ptr<UICommandBuffer> waiting_buffer_ =
       nullptr;  // The ui commands which recorded from JS operations and sync to reserve_buffer by once.
-  std::atomic<bool> is_blocking_writing_;
-  ExecutingContext* context_;
+  // The last published chunk, only accessed by the JS thread.
+  UICommandChunk* publish_tail_{nullptr};
+  // The chunk before the first unread chunk, only accessed by the dart thread.
+  UICommandChunk* consume_head_{nullptr};
+  // The chunks seen by dart side between data() and clear().
+  UICommandChunk* reading_tail_{nullptr};
+  int64_t reading_size_{0};
+  uint32_t reading_kind_flag_{0};
   std::unique_ptr<UICommandSyncStrategy> ui_command_sync_strategy_ = nullptr;
+  bool has_pending_property_sets_{false};
+  std::unordered_map<AtomicString, int64_t, AtomicString::KeyHasher> interned_strings_;
   friend class UICommandBuffer;
   friend class UICommandSyncStrategy;
 };
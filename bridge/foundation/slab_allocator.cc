@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "slab_allocator.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#if ENABLE_MI_MALLOC
+#include <mimalloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(_WIN32)
+#include <malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace webf {
+
+namespace {
+
+// Same bookkeeping overhead as QuickJS counts for the system allocated blocks.
+constexpr size_t kSystemMallocOverhead = 8;
+constexpr size_t kSlabHeaderSize = 64;
+
+constexpr uint32_t kSizeClasses[SlabAllocator::kSizeClassCount] = {
+    16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640, 768, 896, 1024,
+};
+
+// Index by (size + 15) / 16.
+struct SizeClassTable {
+  uint8_t index[SlabAllocator::kMaxSlabAllocationSize / 16 + 1];
+
+  constexpr SizeClassTable() : index() {
+    uint32_t size_class = 0;
+    for (uint32_t i = 0; i <= SlabAllocator::kMaxSlabAllocationSize / 16; i++) {
+      while (kSizeClasses[size_class] < i * 16)
+        size_class++;
+      index[i] = size_class;
+    }
+  }
+};
+
+constexpr SizeClassTable kSizeClassTable;
+
+inline uint32_t SizeClassOf(size_t size) {
+  return kSizeClassTable.index[(size + 15) >> 4];
+}
+
+void* SystemMalloc(size_t size) {
+#if ENABLE_MI_MALLOC
+  return mi_malloc(size);
+#else
+  return malloc(size);
+#endif
+}
+
+void* SystemRealloc(void* ptr, size_t size) {
+#if ENABLE_MI_MALLOC
+  return mi_realloc(ptr, size);
+#else
+  return realloc(ptr, size);
+#endif
+}
+
+void SystemFree(void* ptr) {
+#if ENABLE_MI_MALLOC
+  mi_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+size_t SystemUsableSize(const void* ptr) {
+#if ENABLE_MI_MALLOC
+  return mi_usable_size(ptr);
+#elif defined(__APPLE__)
+  return malloc_size(ptr);
+#elif defined(_WIN32)
+  return _msize(const_cast<void*>(ptr));
+#else
+  return malloc_usable_size(const_cast<void*>(ptr));
+#endif
+}
+
+void* AllocateSlabMemory() {
+#if ENABLE_MI_MALLOC
+  return mi_malloc_aligned(SlabAllocator::kSlabSize, SlabAllocator::kSlabSize);
+#elif defined(_WIN32)
+  return _aligned_malloc(SlabAllocator::kSlabSize, SlabAllocator::kSlabSize);
+#else
+  void* memory = nullptr;
+  if (posix_memalign(&memory, SlabAllocator::kSlabSize, SlabAllocator::kSlabSize) != 0)
+    return nullptr;
+  return memory;
+#endif
+}
+
+void FreeSlabMemory(void* memory) {
+#if ENABLE_MI_MALLOC
+  mi_free(memory);
+#elif defined(_WIN32)
+  _aligned_free(memory);
+#else
+  free(memory);
+#endif
+}
+
+inline size_t HashSlabAddress(uintptr_t address, size_t mask) {
+  return static_cast<size_t>(((address / SlabAllocator::kSlabSize) * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+}
+
+thread_local SlabAllocator* current_allocator{nullptr};
+
+}  // namespace
+
+struct SlabAllocator::FreeBlock {
+  FreeBlock* next;
+};
+
+// Lives at the beginning of each slab, the blocks follow it.
+struct SlabAllocator::Slab {
+  Slab* prev;
+  Slab* next;
+  FreeBlock* free_list;
+  char* bump;
+  char* end;
+  uint32_t size_class;
+  uint32_t used;
+  bool available;
+};
+
+SlabAllocator::SlabAllocator() = default;
+
+SlabAllocator::~SlabAllocator() {
+  for (size_t i = 0; i < slab_table_size_; i++) {
+    if (slab_table_[i] != 0) {
+      FreeSlabMemory(reinterpret_cast<void*>(slab_table_[i]));
+    }
+  }
+  free(slab_table_);
+}
+
+SlabAllocator* SlabAllocator::Current() {
+  return current_allocator;
+}
+
+void SlabAllocator::SetCurrent(SlabAllocator* allocator) {
+  current_allocator = allocator;
+}
+
+void* SlabAllocator::Allocate(size_t size) {
+  if (current_allocator != nullptr)
+    return current_allocator->Alloc(size);
+  return SystemMalloc(size);
+}
+
+void SlabAllocator::Free(void* ptr) {
+  if (current_allocator != nullptr) {
+    current_allocator->Release(ptr);
+    return;
+  }
+  SystemFree(ptr);
+}
+
+void* SlabAllocator::Alloc(size_t size) {
+  if (size > kMaxSlabAllocationSize)
+    return SystemMalloc(size);
+
+  uint32_t size_class = SizeClassOf(size);
+  Slab* slab = available_[size_class];
+  if (slab == nullptr) {
+    slab = NewSlab(size_class);
+    if (slab == nullptr)
+      return nullptr;
+  }
+
+  void* block;
+  if (slab->free_list != nullptr) {
+    block = slab->free_list;
+    slab->free_list = slab->free_list->next;
+  } else {
+    block = slab->bump;
+    slab->bump += kSizeClasses[size_class];
+  }
+  slab->used++;
+
+  // Unlink the full slab, it will be back once one of its blocks had been released.
+  if (slab->free_list == nullptr && slab->bump + kSizeClasses[size_class] > slab->end) {
+    available_[size_class] = slab->next;
+    if (slab->next != nullptr)
+      slab->next->prev = nullptr;
+    slab->next = nullptr;
+    slab->available = false;
+  }
+
+  return block;
+}
+
+void* SlabAllocator::Realloc(void* ptr, size_t size) {
+  if (ptr == nullptr)
+    return Alloc(size);
+
+  Slab* slab = FindSlab(ptr);
+  if (slab == nullptr) {
+    if (size > kMaxSlabAllocationSize)
+      return SystemRealloc(ptr, size);
+  } else if (size <= kSizeClasses[slab->size_class]) {
+    return ptr;
+  }
+
+  void* new_ptr = Alloc(size);
+  if (new_ptr == nullptr)
+    return nullptr;
+  size_t old_size = slab != nullptr ? kSizeClasses[slab->size_class] : SystemUsableSize(ptr);
+  memcpy(new_ptr, ptr, old_size < size ? old_size : size);
+  Release(ptr);
+  return new_ptr;
+}
+
+void SlabAllocator::Release(void* ptr) {
+  if (ptr == nullptr)
+    return;
+
+  Slab* slab = FindSlab(ptr);
+  if (slab == nullptr) {
+    SystemFree(ptr);
+    return;
+  }
+
+  auto* block = static_cast<FreeBlock*>(ptr);
+  block->next = slab->free_list;
+  slab->free_list = block;
+  slab->used--;
+
+  Slab*& head = available_[slab->size_class];
+  if (!slab->available) {
+    slab->prev = nullptr;
+    slab->next = head;
+    if (head != nullptr)
+      head->prev = slab;
+    head = slab;
+    slab->available = true;
+  }
+
+  // Keep the last slab of the size class to avoid allocating a new one on the next allocation.
+  if (slab->used == 0 && (slab->prev != nullptr || slab->next != nullptr)) {
+    ReleaseSlab(slab);
+  }
+}
+
+size_t SlabAllocator::UsableSize(const void* ptr) const {
+  Slab* slab = FindSlab(ptr);
+  if (slab != nullptr)
+    return kSizeClasses[slab->size_class];
+  return SystemUsableSize(ptr);
+}
+
+bool SlabAllocator::Owns(const void* ptr) const {
+  return FindSlab(ptr) != nullptr;
+}
+
+SlabAllocator::Slab* SlabAllocator::NewSlab(uint32_t size_class) {
+  static_assert(sizeof(Slab) <= kSlabHeaderSize, "Slab header must fit in kSlabHeaderSize");
+  void* memory = AllocateSlabMemory();
+  if (memory == nullptr)
+    return nullptr;
+
+  auto* slab = static_cast<Slab*>(memory);
+  slab->prev = nullptr;
+  slab->next = nullptr;
+  slab->free_list = nullptr;
+  slab->bump = static_cast<char*>(memory) + kSlabHeaderSize;
+  slab->end = static_cast<char*>(memory) + kSlabSize;
+  slab->size_class = size_class;
+  slab->used = 0;
+  slab->available = true;
+  available_[size_class] = slab;
+
+  InsertSlab(reinterpret_cast<uintptr_t>(memory));
+  return slab;
+}
+
+void SlabAllocator::ReleaseSlab(Slab* slab) {
+  if (slab->prev != nullptr)
+    slab->prev->next = slab->next;
+  else
+    available_[slab->size_class] = slab->next;
+  if (slab->next != nullptr)
+    slab->next->prev = slab->prev;
+
+  RemoveSlab(reinterpret_cast<uintptr_t>(slab));
+  FreeSlabMemory(slab);
+}
+
+void SlabAllocator::InsertSlab(uintptr_t address) {
+  // Keep the load factor under 1/2.
+  if ((slab_count_ + 1) * 2 > slab_table_size_) {
+    size_t old_size = slab_table_size_;
+    uintptr_t* old_table = slab_table_;
+    slab_table_size_ = old_size == 0 ? 64 : old_size * 2;
+    slab_table_ = static_cast<uintptr_t*>(calloc(slab_table_size_, sizeof(uintptr_t)));
+    for (size_t i = 0; i < old_size; i++) {
+      if (old_table[i] == 0)
+        continue;
+      size_t index = HashSlabAddress(old_table[i], slab_table_size_ - 1);
+      while (slab_table_[index] != 0)
+        index = (index + 1) & (slab_table_size_ - 1);
+      slab_table_[index] = old_table[i];
+    }
+    free(old_table);
+  }
+
+  size_t mask = slab_table_size_ - 1;
+  size_t index = HashSlabAddress(address, mask);
+  while (slab_table_[index] != 0)
+    index = (index + 1) & mask;
+  slab_table_[index] = address;
+  slab_count_++;
+}
+
+void SlabAllocator::RemoveSlab(uintptr_t address) {
+  size_t mask = slab_table_size_ - 1;
+  size_t index = HashSlabAddress(address, mask);
+  while (slab_table_[index] != address)
+    index = (index + 1) & mask;
+
+  // Backward shift the following entries of the probe sequence to fill the hole.
+  size_t hole = index;
+  size_t next = (hole + 1) & mask;
+  while (slab_table_[next] != 0) {
+    size_t home = HashSlabAddress(slab_table_[next], mask);
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      slab_table_[hole] = slab_table_[next];
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+  slab_table_[hole] = 0;
+  slab_count_--;
+}
+
+SlabAllocator::Slab* SlabAllocator::FindSlab(const void* ptr) const {
+  if (slab_count_ == 0)
+    return nullptr;
+  uintptr_t address = reinterpret_cast<uintptr_t>(ptr) & ~(kSlabSize - 1);
+  size_t mask = slab_table_size_ - 1;
+  size_t index = HashSlabAddress(address, mask);
+  while (slab_table_[index] != 0) {
+    if (slab_table_[index] == address)
+      return reinterpret_cast<Slab*>(address);
+    index = (index + 1) & mask;
+  }
+  return nullptr;
+}
+
+static size_t AccountedSize(SlabAllocator* allocator, const void* ptr) {
+  return allocator->Owns(ptr) ? allocator->UsableSize(ptr) : SystemUsableSize(ptr) + kSystemMallocOverhead;
+}
+
+static void* js_slab_malloc(JSMallocState* s, size_t size) {
+  auto* allocator = static_cast<SlabAllocator*>(s->opaque);
+  assert(size != 0);
+
+  if (s->malloc_size + size > s->malloc_limit)
+    return nullptr;
+
+  void* ptr = allocator->Alloc(size);
+  if (ptr == nullptr)
+    return nullptr;
+
+  s->malloc_count++;
+  s->malloc_size += AccountedSize(allocator, ptr);
+  return ptr;
+}
+
+static void js_slab_free(JSMallocState* s, void* ptr) {
+  if (ptr == nullptr)
+    return;
+  auto* allocator = static_cast<SlabAllocator*>(s->opaque);
+
+  s->malloc_count--;
+  s->malloc_size -= AccountedSize(allocator, ptr);
+  allocator->Release(ptr);
+}
+
+static void* js_slab_realloc(JSMallocState* s, void* ptr, size_t size) {
+  auto* allocator = static_cast<SlabAllocator*>(s->opaque);
+
+  if (ptr == nullptr) {
+    if (size == 0)
+      return nullptr;
+    return js_slab_malloc(s, size);
+  }
+
+  size_t old_size = AccountedSize(allocator, ptr);
+  if (size == 0) {
+    s->malloc_count--;
+    s->malloc_size -= old_size;
+    allocator->Release(ptr);
+    return nullptr;
+  }
+  if (s->malloc_size + size - old_size > s->malloc_limit)
+    return nullptr;
+
+  ptr = allocator->Realloc(ptr, size);
+  if (ptr == nullptr)
+    return nullptr;
+
+  s->malloc_size += AccountedSize(allocator, ptr) - old_size;
+  return ptr;
+}
+
+static size_t js_slab_malloc_usable_size(const void* ptr) {
+  if (current_allocator != nullptr)
+    return current_allocator->UsableSize(ptr);
+  return SystemUsableSize(ptr);
+}
+
+const JSMallocFunctions* SlabAllocator::MallocFunctions() {
+  static const JSMallocFunctions malloc_functions = {
+      js_slab_malloc,
+      js_slab_free,
+      js_slab_realloc,
+      js_slab_malloc_usable_size,
+  };
+  return &malloc_functions;
+}
+
+}  // namespace webf
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_FOUNDATION_SLAB_ALLOCATOR_H_
+#define WEBF_FOUNDATION_SLAB_ALLOCATOR_H_
+
+#include <quickjs/quickjs.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "foundation/macros.h"
+
+namespace webf {
+
+// Size-class slab allocator for the small objects of a JS thread.
+//
+// Allocations up to kMaxSlabAllocationSize are rounded up to a size class and carved out of 64KB slabs, each slab
+// only holds blocks of one size class. Larger allocations fall through to the system allocator.
+// One allocator is bound to the JSRuntime of each JS thread, which is not thread safe and must only be used in the
+// thread it belongs to. All slabs are released at once when the runtime is finalized.
+class SlabAllocator {
+ public:
+  static constexpr size_t kSlabSize = 64 * 1024;
+  static constexpr size_t kMaxSlabAllocationSize = 1024;
+  static constexpr uint32_t kSizeClassCount = 20;
+
+  SlabAllocator();
+  ~SlabAllocator();
+  WEBF_DISALLOW_COPY_ASSIGN_AND_MOVE(SlabAllocator);
+
+  // The allocator bound to the current thread, nullptr if there is no JS runtime in this thread.
+  static SlabAllocator* Current();
+  static void SetCurrent(SlabAllocator* allocator);
+
+  // Allocate from the allocator of current thread, fallback to the system allocator if there is no one.
+  static void* Allocate(size_t size);
+  static void Free(void* ptr);
+
+  // Malloc functions which route the allocations of a JSRuntime into the allocator passed as the opaque of
+  // JS_NewRuntime2. The allocator must also be the current one of the thread, js_malloc_usable_size has no opaque.
+  static const JSMallocFunctions* MallocFunctions();
+
+  void* Alloc(size_t size);
+  void* Realloc(void* ptr, size_t size);
+  void Release(void* ptr);
+  size_t UsableSize(const void* ptr) const;
+  // Whether the pointer are allocated from the slabs of this allocator.
+  bool Owns(const void* ptr) const;
+
+  size_t slabCount() const { return slab_count_; }
+
+ private:
+  struct FreeBlock;
+  struct Slab;
+
+  Slab* NewSlab(uint32_t size_class);
+  void ReleaseSlab(Slab* slab);
+  void InsertSlab(uintptr_t address);
+  void RemoveSlab(uintptr_t address);
+  Slab* FindSlab(const void* ptr) const;
+
+  // Slabs which still have free blocks for each size class.
+  Slab* available_[kSizeClassCount]{};
+  // Open addressing hash set of the slab addresses, used to tell the blocks of the slabs apart from the system
+  // allocated memory.
+  uintptr_t* slab_table_{nullptr};
+  size_t slab_table_size_{0};
+  size_t slab_count_{0};
+};
+
+template <typename T, typename = void>
+struct IsSlabAllocated : std::false_type {};
+
+template <typename T>
+struct IsSlabAllocated<T, std::void_t<typename T::IsSlabAllocatedMarker>> : std::true_type {};
+
+// WEBF_SLAB_ALLOCATED(): Opt a GarbageCollected class into the slab allocator of the JS thread.
+// MakeGarbageCollected will place the object into the slabs and delete will return it back.
+#define WEBF_SLAB_ALLOCATED()                                                   \
+ public:                                                                        \
+  using IsSlabAllocatedMarker = int;                                            \
+  static void operator delete(void* ptr) noexcept { SlabAllocator::Free(ptr); } \
+                                                                                \
+ private:
+
+}  // namespace webf
+
+#endif  // WEBF_FOUNDATION_SLAB_ALLOCATOR_H_
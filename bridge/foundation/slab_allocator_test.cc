@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "slab_allocator.h"
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(SlabAllocator, smallAllocationsShareSlabs) {
+  SlabAllocator allocator;
+  std::vector<void*> blocks;
+  for (int i = 0; i < 1000; i++) {
+    void* ptr = allocator.Alloc(40);
+    memset(ptr, i & 0xff, 40);
+    EXPECT_TRUE(allocator.Owns(ptr));
+    EXPECT_EQ(allocator.UsableSize(ptr), 48);
+    blocks.push_back(ptr);
+  }
+  EXPECT_EQ(allocator.slabCount(), 1);
+
+  for (void* ptr : blocks) {
+    allocator.Release(ptr);
+  }
+  // The last slab of a size class are kept for reuse.
+  EXPECT_EQ(allocator.slabCount(), 1);
+}
+
+TEST(SlabAllocator, largeAllocationsFallbackToSystem) {
+  SlabAllocator allocator;
+  void* ptr = allocator.Alloc(SlabAllocator::kMaxSlabAllocationSize + 1);
+  EXPECT_FALSE(allocator.Owns(ptr));
+  allocator.Release(ptr);
+  EXPECT_EQ(allocator.slabCount(), 0);
+}
+
+TEST(SlabAllocator, reallocKeepsContent) {
+  SlabAllocator allocator;
+  auto* ptr = static_cast<char*>(allocator.Alloc(10));
+  strcpy(ptr, "helloworld");
+  // Grow inside the same size class.
+  EXPECT_EQ(allocator.Realloc(ptr, 16), ptr);
+  ptr = static_cast<char*>(allocator.Realloc(ptr, 4096));
+  EXPECT_FALSE(allocator.Owns(ptr));
+  EXPECT_EQ(strncmp(ptr, "helloworld", 10), 0);
+  ptr = static_cast<char*>(allocator.Realloc(ptr, 100));
+  EXPECT_TRUE(allocator.Owns(ptr));
+  EXPECT_EQ(strncmp(ptr, "helloworld", 10), 0);
+  allocator.Release(ptr);
+}
+
+TEST(SlabAllocator, jsRuntime) {
+  SlabAllocator allocator;
+  SlabAllocator::SetCurrent(&allocator);
+  JSRuntime* runtime = JS_NewRuntime2(SlabAllocator::MallocFunctions(), &allocator);
+  JSContext* ctx = JS_NewContext(runtime);
+  const char* code = "let list = []; for (let i = 0; i < 10000; i++) { list.push({ i, name: 'item' + i }); } list.length";
+  JSValue result = JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL);
+  int32_t length;
+  JS_ToInt32(ctx, &length, result);
+  EXPECT_EQ(length, 10000);
+  EXPECT_GT(allocator.slabCount(), 0);
+  JS_FreeValue(ctx, result);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+  SlabAllocator::SetCurrent(nullptr);
+}
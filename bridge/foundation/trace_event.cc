@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "trace_event.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace webf {
+
+namespace {
+
+constexpr const char* kTraceLabelNames[] = {
+#define DEFINE_TRACE_LABEL_NAME(id, name) name,
+    WEBF_TRACE_LABELS(DEFINE_TRACE_LABEL_NAME)
+#undef DEFINE_TRACE_LABEL_NAME
+};
+
+static_assert(sizeof(kTraceLabelNames) / sizeof(kTraceLabelNames[0]) ==
+                  static_cast<size_t>(TraceLabel::kLabelCount),
+              "Every trace label needs a name");
+
+// Single producer ring buffer, only the owner thread writes into it.
+// Every thread naming itself gets one, so the events are allocated on the first event recorded while tracing.
+struct TraceBuffer {
+  ~TraceBuffer() { delete[] events.load(std::memory_order_relaxed); }
+
+  std::atomic<uint64_t> head{0};
+  std::atomic<TraceEvent*> events{nullptr};
+  int32_t thread_id;
+  std::string thread_name;
+};
+
+std::mutex buffers_mutex;
+// Buffers are kept after their threads exited, so the events of a disposed JS thread can still be exported.
+std::vector<std::shared_ptr<TraceBuffer>> buffers;
+std::atomic<uint64_t> next_flow_id{1};
+thread_local std::shared_ptr<TraceBuffer> current_buffer;
+
+TraceBuffer* EnsureCurrentBuffer() {
+  if (UNLIKELY(current_buffer == nullptr)) {
+    current_buffer = std::make_shared<TraceBuffer>();
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    current_buffer->thread_id = static_cast<int32_t>(buffers.size()) + 1;
+    current_buffer->thread_name = "Thread " + std::to_string(current_buffer->thread_id);
+    buffers.emplace_back(current_buffer);
+  }
+  return current_buffer.get();
+}
+
+int64_t NowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void AppendEscapedString(std::string& out, const std::string& value) {
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+}
+
+void AppendEvent(std::string& out, const TraceBuffer& buffer, const TraceEvent& event) {
+  char tmp[256];
+  double ts = event.timestamp_ns / 1000.0;
+  const char* name = TraceLabelName(event.label);
+  switch (event.phase) {
+    case TracePhase::kBegin:
+      snprintf(tmp, sizeof(tmp), R"({"name":"%s","cat":"webf","ph":"B","ts":%.3f,"pid":1,"tid":%d},)", name, ts,
+               buffer.thread_id);
+      break;
+    case TracePhase::kEnd:
+      snprintf(tmp, sizeof(tmp), R"({"ph":"E","ts":%.3f,"pid":1,"tid":%d},)", ts, buffer.thread_id);
+      break;
+    case TracePhase::kFlowStart:
+      snprintf(tmp, sizeof(tmp), R"({"name":"%s","cat":"webf","ph":"s","id":%)" PRIu64
+                                 R"(,"ts":%.3f,"pid":1,"tid":%d},)",
+               name, event.flow_id, ts, buffer.thread_id);
+      break;
+    case TracePhase::kFlowEnd:
+      snprintf(tmp, sizeof(tmp), R"({"name":"%s","cat":"webf","ph":"f","bp":"e","id":%)" PRIu64
+                                 R"(,"ts":%.3f,"pid":1,"tid":%d},)",
+               name, event.flow_id, ts, buffer.thread_id);
+      break;
+  }
+  out += tmp;
+}
+
+}  // namespace
+
+std::atomic<bool> TraceRecorder::enabled_{false};
+
+const char* TraceLabelName(TraceLabel label) {
+  return kTraceLabelNames[static_cast<size_t>(label)];
+}
+
+void TraceRecorder::SetEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Record(TraceLabel label, TracePhase phase, uint64_t flow_id) {
+  TraceBuffer* buffer = EnsureCurrentBuffer();
+  TraceEvent* events = buffer->events.load(std::memory_order_relaxed);
+  if (UNLIKELY(events == nullptr)) {
+    events = new TraceEvent[kBufferCapacity];
+    buffer->events.store(events, std::memory_order_release);
+  }
+  uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  TraceEvent& event = events[head & (kBufferCapacity - 1)];
+  event.timestamp_ns = NowNanoseconds();
+  event.flow_id = flow_id;
+  event.label = label;
+  event.phase = phase;
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+uint64_t TraceRecorder::FlowStart(TraceLabel label) {
+  if (LIKELY(!IsEnabled()))
+    return 0;
+  uint64_t flow_id = next_flow_id.fetch_add(1, std::memory_order_relaxed);
+  Record(label, TracePhase::kFlowStart, flow_id);
+  return flow_id;
+}
+
+void TraceRecorder::SetThreadName(const std::string& name) {
+  TraceBuffer* buffer = EnsureCurrentBuffer();
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  buffer->thread_name = name;
+}
+
+std::string TraceRecorder::ToChromeTraceJSON() {
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+
+  std::string result = R"({"displayTimeUnit":"ms","traceEvents":[)";
+  for (auto& buffer : buffers) {
+    result += R"({"name":"thread_name","ph":"M","pid":1,"tid":)" + std::to_string(buffer->thread_id) +
+              R"(,"args":{"name":")";
+    AppendEscapedString(result, buffer->thread_name);
+    result += R"("}},)";
+
+    // Events of the running threads may be overwritten while exporting, the ones out of the ring are skipped.
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    TraceEvent* events = buffer->events.load(std::memory_order_acquire);
+    if (events == nullptr)
+      continue;
+    uint64_t begin = head > kBufferCapacity ? head - kBufferCapacity : 0;
+    for (uint64_t i = begin; i < head; i++) {
+      AppendEvent(result, *buffer, events[i & (kBufferCapacity - 1)]);
+    }
+  }
+  if (result.back() == ',') {
+    result.pop_back();
+  }
+  result += "]}";
+  return result;
+}
+
+void TraceRecorder::Clear() {
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  for (auto& buffer : buffers) {
+    buffer->head.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_FOUNDATION_TRACE_EVENT_H_
+#define WEBF_FOUNDATION_TRACE_EVENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "foundation/macros.h"
+
+namespace webf {
+
+// Static labels of the trace events, the ids are recorded instead of strings.
+#define WEBF_TRACE_LABELS(V)                                                    \
+  V(kNone, "")                                                                  \
+  V(kInitialize, "Initialize")                                                  \
+  V(kEvaluation, "Evaluation")                                                  \
+  V(kAsyncEvaluation, "AsyncEvaluation")                                        \
+  V(kJSCall, "JS_Call")                                                         \
+  V(kJSEval, "JS_Eval")                                                         \
+  V(kJSEvalFunction, "JS_EvalFunction")                                         \
+  V(kJSExecutePendingJob, "JS_ExecutePendingJob")                               \
+  V(kJSWriteObject, "JS_WriteObject")                                           \
+  V(kWebFPageInitialize, "WebFPage::Initialize")                                \
+  V(kHTMLParserParseHTML, "HTMLParser::parseHTML")                              \
+  V(kHTMLParserParse, "HTMLParser::parse")                                      \
+  V(kHTMLParserTraverseHTML, "HTMLParser::traverseHTML")                        \
+  V(kInvokeBindingMethod, "BindingObject::InvokeBindingMethod")                 \
+  V(kGetBindingProperty, "BindingObject::GetBindingProperty")                   \
+  V(kCallToDart, "Call To Dart")                                                \
+  V(kHandleDispatchEventFromDart, "EventTarget::HandleDispatchEventFromDart")   \
+  V(kHandleRAFTransientCallback, "handleRAFTransientCallback")                  \
+  V(kHandleInvokeModuleTransientCallback, "handleInvokeModuleTransientCallback") \
+  V(kHandleTimerCallback, "handleTimerCallback")                                \
+  V(kInstallBindings, "ExecutingContext::InstallBindings")                      \
+  V(kInstallDocument, "ExecutingContext::InstallDocument")                      \
+  V(kInstallGlobal, "ExecutingContext::InstallGlobal")                          \
+  V(kInstallPerformance, "ExecutingContext::InstallPerformance")                \
+  V(kInitWebFPolyFill, "ExecutingContext::initWebFPolyFill")                    \
+  V(kInitializePlugin, "ExecutingContext::InitializePlugin")                    \
+  V(kEvaluateJavaScript, "ExecutingContext::EvaluateJavaScript")                \
+  V(kEvaluateByteCode, "ExecutingContext::EvaluateByteCode")                    \
+  V(kDrainMicrotasks, "ExecutingContext::DrainMicrotasks")                      \
+  V(kIdleGC, "IdleGCScheduler::CollectIfNeeded")                                \
+  V(kJSThreadTask, "Looper::RunTask")                                           \
+  V(kDartTask, "Dispatcher::RunDartTask")                                       \
+  V(kPostToDartSync, "Dispatcher::PostToDartSync")                              \
+  V(kPostToJsSync, "Looper::PostMessageSync")
+
+enum class TraceLabel : uint16_t {
+#define DEFINE_TRACE_LABEL(id, name) id,
+  WEBF_TRACE_LABELS(DEFINE_TRACE_LABEL)
+#undef DEFINE_TRACE_LABEL
+      kLabelCount
+};
+
+const char* TraceLabelName(TraceLabel label);
+
+enum class TracePhase : uint8_t {
+  kBegin,
+  kEnd,
+  // Flow events link the sync call on the waiting thread with the task executed by the other thread.
+  kFlowStart,
+  kFlowEnd,
+};
+
+// Fixed size record of the per-thread ring buffer.
+struct TraceEvent {
+  int64_t timestamp_ns;
+  uint64_t flow_id;
+  TraceLabel label;
+  TracePhase phase;
+};
+
+// Low overhead tracing for the JS and Dart threads.
+//
+// Every thread records into its own ring buffer without locks, old events are overwritten once the buffer is full.
+// When tracing is disabled, recording costs a relaxed atomic load. The recorded events are exported as Chrome Trace
+// Event JSON, which can be loaded into chrome://tracing or Perfetto UI.
+class TraceRecorder {
+  WEBF_STATIC_ONLY(TraceRecorder);
+
+ public:
+  static constexpr size_t kBufferCapacity = 1 << 15;
+
+  FORCE_INLINE static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+  static void SetEnabled(bool enabled);
+
+  FORCE_INLINE static void Begin(TraceLabel label) {
+    if (UNLIKELY(IsEnabled()))
+      Record(label, TracePhase::kBegin, 0);
+  }
+  FORCE_INLINE static void End(TraceLabel label = TraceLabel::kNone) {
+    if (UNLIKELY(IsEnabled()))
+      Record(label, TracePhase::kEnd, 0);
+  }
+  // Returns 0 when tracing is disabled.
+  static uint64_t FlowStart(TraceLabel label);
+  FORCE_INLINE static void FlowEnd(TraceLabel label, uint64_t flow_id) {
+    if (UNLIKELY(flow_id != 0 && IsEnabled()))
+      Record(label, TracePhase::kFlowEnd, flow_id);
+  }
+
+  // Name of current thread in the exported trace.
+  static void SetThreadName(const std::string& name);
+
+  // Export the events of all threads in Chrome Trace Event format.
+  static std::string ToChromeTraceJSON();
+  // Drop the recorded events, should be called while tracing is disabled.
+  static void Clear();
+
+ private:
+  static void Record(TraceLabel label, TracePhase phase, uint64_t flow_id);
+
+  static std::atomic<bool> enabled_;
+};
+
+class TraceScope {
+  WEBF_DISALLOW_COPY_ASSIGN_AND_MOVE(TraceScope);
+
+ public:
+  explicit TraceScope(TraceLabel label) : label_(label) { TraceRecorder::Begin(label); }
+  ~TraceScope() { TraceRecorder::End(label_); }
+
+ private:
+  TraceLabel label_;
+};
+
+#define WEBF_TRACE_SCOPE_CONCAT_INTERNAL(a, b) a##b
+#define WEBF_TRACE_SCOPE_CONCAT(a, b) WEBF_TRACE_SCOPE_CONCAT_INTERNAL(a, b)
+#define WEBF_TRACE_SCOPE(label) \
+  ::webf::TraceScope WEBF_TRACE_SCOPE_CONCAT(trace_scope_, __LINE__)(::webf::TraceLabel::label)
+
+}  // namespace webf
+
+#endif  // WEBF_FOUNDATION_TRACE_EVENT_H_
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "trace_event.h"
+#include <thread>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(TraceRecorder, recordNothingWhenDisabled) {
+  TraceRecorder::Clear();
+  { WEBF_TRACE_SCOPE(kJSCall); }
+  EXPECT_EQ(TraceRecorder::ToChromeTraceJSON().find("JS_Call"), std::string::npos);
+}
+
+TEST(TraceRecorder, exportFlowBetweenThreads) {
+  TraceRecorder::Clear();
+  TraceRecorder::SetEnabled(true);
+  {
+    WEBF_TRACE_SCOPE(kPostToJsSync);
+    uint64_t flow_id = TraceRecorder::FlowStart(TraceLabel::kPostToJsSync);
+    EXPECT_NE(flow_id, 0);
+    std::thread worker([flow_id]() {
+      TraceRecorder::SetThreadName("JS Worker Test");
+      TraceRecorder::FlowEnd(TraceLabel::kPostToJsSync, flow_id);
+      WEBF_TRACE_SCOPE(kJSThreadTask);
+    });
+    worker.join();
+  }
+  TraceRecorder::SetEnabled(false);
+
+  std::string json = TraceRecorder::ToChromeTraceJSON();
+  EXPECT_NE(json.find(R"("name":"JS Worker Test")"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph":"s")"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph":"f")"), std::string::npos);
+  EXPECT_NE(json.find("Looper::RunTask"), std::string::npos);
+  TraceRecorder::Clear();
+}
+
+TEST(TraceRecorder, exportNamedThreadWithoutEvents) {
+  TraceRecorder::Clear();
+  std::thread worker([]() {
+    TraceRecorder::SetThreadName("Idle Worker Test");
+    WEBF_TRACE_SCOPE(kJSThreadTask);
+  });
+  worker.join();
+
+  std::string json = TraceRecorder::ToChromeTraceJSON();
+  EXPECT_NE(json.find(R"("name":"Idle Worker Test")"), std::string::npos);
+  EXPECT_EQ(json.find("Looper::RunTask"), std::string::npos);
+}
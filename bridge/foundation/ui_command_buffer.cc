@@ -31,9 +31,12 @@ UICommandKind GetKindFromUICommand(UICommand command) {
       return UICommandKind::kEvent;
     case UICommand::kSetStyle:
     case UICommand::kClearStyle:
+    case UICommand::kStyleDirtyRoots:
+    case UICommand::kSetStyleSheet:
       return UICommandKind::kStyleUpdate;
     case UICommand::kSetAttribute:
     case UICommand::kRemoveAttribute:
+    case UICommand::kSetProperty:
       return UICommandKind::kAttributeUpdate;
     case UICommand::kDisposeBindingObject:
       return UICommandKind::kDisposeBindingObject;
@@ -43,26 +46,75 @@ UICommandKind GetKindFromUICommand(UICommand command) {
   }
 }
 
-UICommandBuffer::UICommandBuffer(ExecutingContext* context)
-    : context_(context), buffer_((UICommandItem*)malloc(sizeof(UICommandItem) * MAXIMUM_UI_COMMAND_SIZE)) {}
+UICommandChunkPool::~UICommandChunkPool() {
+  ReleaseList(free_list_);
+  ReleaseList(recycled_.exchange(nullptr, std::memory_order_acquire));
+}
+
+UICommandChunk* UICommandChunkPool::Allocate() {
+  if (free_list_ == nullptr) {
+    free_list_ = recycled_.exchange(nullptr, std::memory_order_acquire);
+  }
+
+  if (free_list_ == nullptr) {
+    return new UICommandChunk();
+  }
+
+  UICommandChunk* chunk = free_list_;
+  free_list_ = chunk->next.load(std::memory_order_relaxed);
+  pooled_count_.fetch_sub(1, std::memory_order_relaxed);
+  chunk->next.store(nullptr, std::memory_order_relaxed);
+  chunk->size = 0;
+  chunk->kind_flag = 0;
+  return chunk;
+}
+
+void UICommandChunkPool::Recycle(UICommandChunk* chunk) {
+  if (pooled_count_.load(std::memory_order_relaxed) >= kMaxPooledChunks) {
+    delete chunk;
+    return;
+  }
+
+  pooled_count_.fetch_add(1, std::memory_order_relaxed);
+  // Only the JS thread takes the chunks out and it always takes the whole list, so there is no ABA problem.
+  UICommandChunk* head = recycled_.load(std::memory_order_relaxed);
+  do {
+    chunk->next.store(head, std::memory_order_relaxed);
+  } while (!recycled_.compare_exchange_weak(head, chunk, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void UICommandChunkPool::ReleaseList(UICommandChunk* chunk) {
+  while (chunk != nullptr) {
+    UICommandChunk* next = chunk->next.load(std::memory_order_relaxed);
+    delete chunk;
+    chunk = next;
+  }
+}
+
+UICommandBuffer::UICommandBuffer(ExecutingContext* context, UICommandChunkPool* chunk_pool)
+    : context_(context), chunk_pool_(chunk_pool) {}
 
 UICommandBuffer::~UICommandBuffer() {
-  free(buffer_);
+  clear();
 }
 
 void UICommandBuffer::addCommand(UICommand command,
                                  std::unique_ptr<SharedNativeString>&& args_01,
                                  void* nativePtr,
                                  void* nativePtr2,
-                                 bool request_ui_update) {
-  UICommandItem item{static_cast<int32_t>(command), args_01.get(), nativePtr, nativePtr2};
-  updateFlags(command);
+                                 bool request_ui_update,
+                                 int64_t immediate) {
+  UICommandItem item{static_cast<int32_t>(command), args_01.get(), nativePtr, nativePtr2, immediate};
   addCommand(item, request_ui_update);
+  updateFlags(command);
 }
 
 void UICommandBuffer::updateFlags(UICommand command) {
   UICommandKind type = GetKindFromUICommand(command);
   kind_flag = kind_flag | type;
+  if (tail_ != nullptr) {
+    tail_->kind_flag |= type;
+  }
 }
 
 void UICommandBuffer::addCommand(const UICommandItem& item, bool request_ui_update) {
@@ -70,9 +122,14 @@ void UICommandBuffer::addCommand(const UICommandItem& item, bool request_ui_upda
     return;
   }
 
-  if (size_ >= max_size_) {
-    buffer_ = (UICommandItem*)realloc(buffer_, sizeof(UICommandItem) * max_size_ * 2);
-    max_size_ = max_size_ * 2;
+  if (tail_ == nullptr || tail_->size == UICommandChunk::kCapacity) {
+    UICommandChunk* chunk = chunk_pool_->Allocate();
+    if (tail_ == nullptr) {
+      head_ = chunk;
+    } else {
+      tail_->next.store(chunk, std::memory_order_relaxed);
+    }
+    tail_ = chunk;
   }
 
 #if FLUTTER_BACKEND
@@ -82,34 +139,49 @@ void UICommandBuffer::addCommand(const UICommandItem& item, bool request_ui_upda
   }
 #endif
 
-  buffer_[size_] = item;
+  tail_->items[tail_->size] = item;
+  tail_->size++;
   size_++;
 }
 
-void UICommandBuffer::addCommands(const webf::UICommandItem* items, int64_t item_size, bool request_ui_update) {
+void UICommandBuffer::PrependCommand(UICommand type, void* nativePtr, void* nativePtr2) {
   if (UNLIKELY(!context_->dartIsolateContext()->valid())) {
     return;
   }
 
-  int64_t target_size = size_ + item_size;
-  if (target_size > max_size_) {
-    buffer_ = (UICommandItem*)realloc(buffer_, sizeof(UICommandItem) * target_size * 2);
-    max_size_ = target_size * 2;
+  UICommandChunk* chunk = chunk_pool_->Allocate();
+  chunk->items[0] = UICommandItem{static_cast<int32_t>(type), nullptr, nativePtr, nativePtr2};
+  chunk->size = 1;
+  chunk->kind_flag = GetKindFromUICommand(type);
+  chunk->next.store(head_, std::memory_order_relaxed);
+  head_ = chunk;
+  if (tail_ == nullptr) {
+    tail_ = chunk;
   }
+  size_++;
+  kind_flag |= chunk->kind_flag;
+}
 
-#if FLUTTER_BACKEND
-  if (UNLIKELY(request_ui_update && !update_batched_ && context_->IsContextValid())) {
-    context_->dartMethodPtr()->requestBatchUpdate(context_->isDedicated(), context_->contextId());
-    update_batched_ = true;
-  }
-#endif
+void UICommandBuffer::Append(UICommandBuffer& other) {
+  if (other.empty())
+    return;
 
-  std::memcpy(buffer_ + size_, items, sizeof(UICommandItem) * item_size);
-  size_ = target_size;
+  if (tail_ == nullptr) {
+    head_ = other.head_;
+  } else {
+    tail_->next.store(other.head_, std::memory_order_relaxed);
+  }
+  tail_ = other.tail_;
+  size_ += other.size_;
+  kind_flag |= other.kind_flag;
+  other.reset();
 }
 
-UICommandItem* UICommandBuffer::data() {
-  return buffer_;
+UICommandChunk* UICommandBuffer::TakeChunks(UICommandChunk** tail) {
+  UICommandChunk* head = head_;
+  *tail = tail_;
+  reset();
+  return head;
 }
 
 uint32_t UICommandBuffer::kindFlag() {
@@ -125,7 +197,18 @@ bool UICommandBuffer::empty() {
 }
 
 void UICommandBuffer::clear() {
-  memset(buffer_, 0, sizeof(UICommandItem) * size_);
+  UICommandChunk* chunk = head_;
+  while (chunk != nullptr) {
+    UICommandChunk* next = chunk->next.load(std::memory_order_relaxed);
+    chunk_pool_->Recycle(chunk);
+    chunk = next;
+  }
+  reset();
+}
+
+void UICommandBuffer::reset() {
+  head_ = nullptr;
+  tail_ = nullptr;
   size_ = 0;
   kind_flag = 0;
   update_batched_ = false;
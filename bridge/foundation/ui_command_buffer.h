@@ -6,7 +6,9 @@
 #ifndef BRIDGE_FOUNDATION_UI_COMMAND_BUFFER_H_
 #define BRIDGE_FOUNDATION_UI_COMMAND_BUFFER_H_
 
+#include <atomic>
 #include <cinttypes>
+#include <cstddef>
 #include "bindings/qjs/native_string_utils.h"
 
 namespace webf {
@@ -43,24 +45,83 @@ enum class UICommand {
   kCreateDocumentFragment,
   kCreateSVGElement,
   kCreateElementNS,
+  // Write-behind property set of a binding object, args_01 holds the property name and nativePtr2 a NativeValue.
+  kSetProperty,
+  // The topmost nodes whose style changed since the last batch, put in front of the batch when it is published so
+  // dart side defers the style recalc of the attribute commands to these roots. nativePtr2 holds a malloc'd int64
+  // array of the node count followed by the NativeBindingObject pointers of the nodes.
+  kStyleDirtyRoots,
+  // The rules of a <style> element parsed by CSSParser, nativePtr2 holds the malloc'd rule set or nullptr when the
+  // sheet is left to the Dart parser.
+  kSetStyleSheet,
   kFinishRecordingCommand,
 };
 
-#define MAXIMUM_UI_COMMAND_SIZE 2048
+// The immediate operand of kInsertAdjacentNode, keep in sync with the table in ui_command.dart.
+enum class InsertAdjacentPosition : int64_t { kBeforeBegin, kAfterBegin, kBeforeEnd, kAfterEnd };
 
 struct UICommandItem {
   UICommandItem() = default;
-  explicit UICommandItem(int32_t type, SharedNativeString* args_01, void* nativePtr, void* nativePtr2)
+  explicit UICommandItem(int32_t type,
+                         SharedNativeString* args_01,
+                         void* nativePtr,
+                         void* nativePtr2,
+                         int64_t immediate = 0)
       : type(type),
         string_01(reinterpret_cast<int64_t>(args_01 != nullptr ? args_01->string() : nullptr)),
         args_01_length(args_01 != nullptr ? args_01->length() : 0),
         nativePtr(reinterpret_cast<int64_t>(nativePtr)),
-        nativePtr2(reinterpret_cast<int64_t>(nativePtr2)){};
+        nativePtr2(reinterpret_cast<int64_t>(nativePtr2)),
+        immediate(immediate){};
   int32_t type{0};
   int32_t args_01_length{0};
   int64_t string_01{0};
   int64_t nativePtr{0};
   int64_t nativePtr2{0};
+  // A typed operand which is decoded by dart side with a table instead of being sent as a string: the
+  // InsertAdjacentPosition of kInsertAdjacentNode and the interned event type id of kAddEvent and kRemoveEvent, see
+  // SharedUICommand::InternString.
+  int64_t immediate{0};
+};
+
+// Fixed size block of UI commands. Commands are handed over to dart side by linking the chunks instead of copying
+// the items, dart side reads the items in place.
+// The header is read through Dart FFI, keep the layout in sync with to_native.dart.
+struct UICommandChunk {
+  static constexpr int64_t kCapacity = 512;
+
+  // Padded to 8 bytes on 32-bit platforms, dart side reads it as a pointer sized integer.
+  alignas(8) std::atomic<UICommandChunk*> next{nullptr};
+  alignas(8) int64_t size{0};
+  int64_t kind_flag{0};
+  UICommandItem items[kCapacity];
+};
+
+static_assert(offsetof(UICommandChunk, next) == 0, "Keep the layout of UICommandChunk in sync with to_native.dart");
+static_assert(offsetof(UICommandChunk, size) == 8, "Keep the layout of UICommandChunk in sync with to_native.dart");
+static_assert(offsetof(UICommandChunk, items) == 24, "Keep the layout of UICommandChunk in sync with to_native.dart");
+
+// Chunks are allocated by the JS thread and recycled by the thread which consumed them.
+class UICommandChunkPool {
+ public:
+  // Chunks above this count are released to the system after a large mutation burst.
+  static constexpr int64_t kMaxPooledChunks = 32;
+
+  UICommandChunkPool() = default;
+  ~UICommandChunkPool();
+
+  // Must be called in the JS thread.
+  UICommandChunk* Allocate();
+  // Could be called from any thread.
+  void Recycle(UICommandChunk* chunk);
+
+ private:
+  static void ReleaseList(UICommandChunk* chunk);
+
+  // Owned by the JS thread.
+  UICommandChunk* free_list_{nullptr};
+  std::atomic<UICommandChunk*> recycled_{nullptr};
+  std::atomic<int64_t> pooled_count_{0};
 };
 
 UICommandKind GetKindFromUICommand(UICommand type);
@@ -68,30 +129,38 @@ UICommandKind GetKindFromUICommand(UICommand type);
 class UICommandBuffer {
  public:
   UICommandBuffer() = delete;
-  explicit UICommandBuffer(ExecutingContext* context);
+  explicit UICommandBuffer(ExecutingContext* context, UICommandChunkPool* chunk_pool);
   ~UICommandBuffer();
   void addCommand(UICommand type,
                   std::unique_ptr<SharedNativeString>&& args_01,
                   void* nativePtr,
                   void* nativePtr2,
-                  bool request_ui_update = true);
-  UICommandItem* data();
+                  bool request_ui_update = true,
+                  int64_t immediate = 0);
   uint32_t kindFlag();
   int64_t size();
   bool empty();
   void clear();
 
+  // Put a command in front of the recorded ones. It takes a chunk of its own, so keep it for rare commands.
+  void PrependCommand(UICommand type, void* nativePtr, void* nativePtr2);
+  // Move the commands of other to the end of this buffer by linking the chunks.
+  void Append(UICommandBuffer& other);
+  // Detach all chunks from the buffer, returns nullptr when the buffer is empty.
+  UICommandChunk* TakeChunks(UICommandChunk** tail);
+
  private:
   void addCommand(const UICommandItem& item, bool request_ui_update = true);
-  void addCommands(const UICommandItem* items, int64_t item_size, bool request_ui_update = true);
   void updateFlags(UICommand command);
+  void reset();
 
   ExecutingContext* context_{nullptr};
-  UICommandItem* buffer_{nullptr};
+  UICommandChunkPool* chunk_pool_{nullptr};
+  UICommandChunk* head_{nullptr};
+  UICommandChunk* tail_{nullptr};
   uint32_t kind_flag{0};
   bool update_batched_{false};
   int64_t size_{0};
-  int64_t max_size_{MAXIMUM_UI_COMMAND_SIZE};
   friend class SharedUICommand;
 };
 
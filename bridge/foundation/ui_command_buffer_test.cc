@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_buffer.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(UICommandChunkPool, reuseChunksRecycledByOtherThread) {
+  UICommandChunkPool pool;
+  UICommandChunk* chunk = pool.Allocate();
+  chunk->size = 10;
+  chunk->kind_flag = UICommandKind::kNodeCreation;
+
+  std::thread consumer([&pool, chunk]() { pool.Recycle(chunk); });
+  consumer.join();
+
+  UICommandChunk* reused = pool.Allocate();
+  EXPECT_EQ(reused, chunk);
+  EXPECT_EQ(reused->size, 0);
+  EXPECT_EQ(reused->kind_flag, 0);
+  EXPECT_EQ(reused->next.load(), nullptr);
+  pool.Recycle(reused);
+}
+
+TEST(UICommandChunkPool, releaseChunksAboveLimit) {
+  UICommandChunkPool pool;
+  std::vector<UICommandChunk*> chunks;
+  for (int i = 0; i < UICommandChunkPool::kMaxPooledChunks * 2; i++) {
+    chunks.emplace_back(pool.Allocate());
+  }
+  for (auto* chunk : chunks) {
+    pool.Recycle(chunk);
+  }
+
+  int reused = 0;
+  std::vector<UICommandChunk*> allocated;
+  for (int i = 0; i < UICommandChunkPool::kMaxPooledChunks * 2; i++) {
+    UICommandChunk* chunk = pool.Allocate();
+    if (std::find(chunks.begin(), chunks.end(), chunk) != chunks.end()) {
+      reused++;
+    }
+    allocated.emplace_back(chunk);
+  }
+  EXPECT_EQ(reused, UICommandChunkPool::kMaxPooledChunks);
+  for (auto* chunk : allocated) {
+    pool.Recycle(chunk);
+  }
+}
@@ -52,7 +52,8 @@ void UICommandSyncStrategy::RecordUICommand(UICommand type,
                                             std::unique_ptr<SharedNativeString>& args_01,
                                             NativeBindingObject* native_binding_object,
                                             void* native_ptr2,
-                                            bool request_ui_update) {
+                                            bool request_ui_update,
+                                            int64_t immediate) {
   switch (type) {
     case UICommand::kStartRecordingCommand:
     case UICommand::kCreateDocument:
@@ -60,7 +61,7 @@ void UICommandSyncStrategy::RecordUICommand(UICommand type,
     case UICommand::kRemoveAttribute: {
       SyncToReserve();
       host_->reserve_buffer_->addCommand(type, std::move(args_01), native_binding_object, native_ptr2,
-                                         request_ui_update);
+                                         request_ui_update, immediate);
       break;
     }
     case UICommand::kCreateElement:
@@ -72,7 +73,7 @@ void UICommandSyncStrategy::RecordUICommand(UICommand type,
     case UICommand::kRemoveNode:
     case UICommand::kCloneNode: {
       host_->waiting_buffer_->addCommand(type, std::move(args_01), native_binding_object, native_ptr2,
-                                         request_ui_update);
+                                         request_ui_update, immediate);
 
       RecordOperationForPointer(native_binding_object);
       SyncToReserveIfNecessary();
@@ -82,16 +83,19 @@ void UICommandSyncStrategy::RecordUICommand(UICommand type,
     case UICommand::kSetStyle:
     case UICommand::kClearStyle:
     case UICommand::kSetAttribute:
+    case UICommand::kSetProperty:
+    case UICommand::kStyleDirtyRoots:
+    case UICommand::kSetStyleSheet:
     case UICommand::kRemoveEvent:
     case UICommand::kAddEvent:
     case UICommand::kDisposeBindingObject: {
       host_->waiting_buffer_->addCommand(type, std::move(args_01), native_binding_object, native_ptr2,
-                                         request_ui_update);
+                                         request_ui_update, immediate);
       break;
     }
     case UICommand::kInsertAdjacentNode: {
       host_->waiting_buffer_->addCommand(type, std::move(args_01), native_binding_object, native_ptr2,
-                                         request_ui_update);
+                                         request_ui_update, immediate);
 
       RecordOperationForPointer(native_binding_object);
       RecordOperationForPointer((NativeBindingObject*)native_ptr2);
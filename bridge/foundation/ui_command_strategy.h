@@ -33,7 +33,8 @@ class UICommandSyncStrategy {
                        std::unique_ptr<SharedNativeString>& args_01,
                        NativeBindingObject* native_ptr,
                        void* native_ptr2,
-                       bool request_ui_update);
+                       bool request_ui_update,
+                       int64_t immediate);
   void ConfigWaitingBufferSize(size_t size);
 
  private:
@@ -30,6 +30,23 @@ struct WebFInfo {
   const char* system_name{nullptr};
 };
 
+// Invoked on the Dart thread when the JS heap of a page stays close to its hard limit after an idle collection.
+typedef void (*MemoryPressureCallback)(double context_id, int64_t malloc_size, int64_t memory_limit);
+
+// Per-page JS heap policy, passed to allocateNewPage. Zero fields keep the engine defaults.
+// Pages scheduled on the same JS thread share one JSRuntime, so the last page allocated on a thread wins.
+struct NativeHeapPolicy {
+  // Heap size in bytes which triggers the first automatic GC.
+  int64_t initial_gc_threshold{0};
+  // The next automatic GC triggers once the heap grows to (size after last GC) * gc_growth_factor.
+  double gc_growth_factor{0};
+  // Hard limit of the JS heap in bytes, allocations beyond it throw an out of memory exception.
+  int64_t memory_limit{0};
+  // Time budget in microseconds for a collection running in the idle gap after a frame.
+  int64_t idle_gc_budget_us{0};
+  MemoryPressureCallback memory_pressure_callback{nullptr};
+};
+
 typedef void (*Task)(void*);
 typedef std::function<void(bool)> DartWork;
 typedef void (*AllocateNewPageCallback)(Dart_Handle dart_handle, void*);
@@ -39,6 +56,7 @@ typedef void (*EvaluateQuickjsByteCodeCallback)(Dart_Handle dart_handle, int8_t)
 typedef void (*DumpQuickjsByteCodeCallback)(Dart_Handle);
 typedef void (*ParseHTMLCallback)(Dart_Handle);
 typedef void (*EvaluateScriptsCallback)(Dart_Handle dart_handle, int8_t);
+typedef void (*StartReplayRecordingCallback)(Dart_Handle dart_handle, int8_t);
 
 WEBF_EXPORT_C
 void* initDartIsolateContextSync(int64_t dart_port,
@@ -50,6 +68,7 @@ WEBF_EXPORT_C
 void allocateNewPage(double thread_identity,
                      int32_t sync_buffer_size,
                      void* dart_isolate_context,
+                     NativeHeapPolicy* heap_policy,
                      Dart_Handle dart_handle,
                      AllocateNewPageCallback result_callback);
 
@@ -123,10 +142,34 @@ void collectNativeProfileData(void* ptr, const char** data, uint32_t* len);
 WEBF_EXPORT_C
 void clearNativeProfileData(void* ptr);
 
+WEBF_EXPORT_C
+void setNativeTracingEnabled(int8_t enabled);
+WEBF_EXPORT_C
+void collectNativeTraceData(const char** data, uint32_t* len);
+WEBF_EXPORT_C
+void clearNativeTraceData();
+
+// Export the bridge metrics as JSON, the metrics of the page are included when page is not null.
+WEBF_EXPORT_C
+void collectNativeMetrics(void* dart_isolate_context, void* page, const char** data, uint32_t* len);
+WEBF_EXPORT_C
+void resetNativeMetrics(void* dart_isolate_context, void* page);
+// Record the inputs of the page into a trace file which could be replayed by webf_replay without flutter.
+// The trace only replays when the recording starts right after the page is allocated. The recorder is swapped at the
+// JS thread, result_callback reports whether the trace file was opened.
+WEBF_EXPORT_C
+void startReplayRecording(void* page,
+                          const char* path,
+                          Dart_Handle dart_handle,
+                          StartReplayRecordingCallback result_callback);
+WEBF_EXPORT_C
+void stopReplayRecording(void* page);
+
 WEBF_EXPORT_C
 WebFInfo* getWebFInfo();
 WEBF_EXPORT_C
 void dispatchUITask(void* page, void* context, void* callback);
+// Returns the first UICommandChunk of the published commands, the chunks are valid until clearUICommandItems.
 WEBF_EXPORT_C
 void* getUICommandItems(void* page);
 WEBF_EXPORT_C
@@ -136,6 +179,15 @@ WEBF_EXPORT_C
 int64_t getUICommandItemSize(void* page);
 WEBF_EXPORT_C
 void clearUICommandItems(void* page);
+// Called by dart side from an idle task for the pages without a dedicated JS thread.
+WEBF_EXPORT_C
+void scheduleIdleGC(void* page);
+// Called by dart side after each layout pass, drops the layout results cached at native side.
+WEBF_EXPORT_C
+void markLayoutDirty(void* page);
+// Called by dart side after a custom element is defined, the widget element tags without a shape are asked again.
+WEBF_EXPORT_C
+void markWidgetElementDefined(void* dart_isolate_context);
 WEBF_EXPORT_C
 void registerPluginByteCode(uint8_t* bytes, int32_t length, const char* pluginName);
 WEBF_EXPORT_C
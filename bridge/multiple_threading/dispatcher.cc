@@ -20,8 +20,10 @@ Dispatcher::~Dispatcher() {}
 
 void Dispatcher::AllocateNewJSThread(int32_t js_context_id) {
   assert(js_threads_.count(js_context_id) == 0);
-  js_threads_[js_context_id] = std::make_unique<Looper>(js_context_id);
-  js_threads_[js_context_id]->Start();
+  auto looper = std::make_unique<Looper>(js_context_id);
+  looper->Start();
+  std::lock_guard<std::mutex> lock(js_threads_mutex_);
+  js_threads_[js_context_id] = std::move(looper);
 }
 
 bool Dispatcher::IsThreadGroupExist(int32_t js_context_id) {
@@ -43,6 +45,7 @@ void Dispatcher::KillJSThreadSync(int32_t js_context_id) {
       true, js_context_id, [](bool cancel, Looper* looper) { looper->ExecuteOpaqueFinalizer(); },
       js_threads_[js_context_id].get());
   looper->Stop();
+  std::lock_guard<std::mutex> lock(js_threads_mutex_);
   js_threads_.erase(js_context_id);
 }
 
@@ -96,6 +99,48 @@ std::unique_ptr<Looper>& Dispatcher::looper(int32_t js_context_id) {
   return js_threads_[js_context_id];
 }
 
+std::string Dispatcher::MetricsToJSON() {
+  static const char* task_type_names[] = {"postToDart", "postToDartSync", "postToJs", "postToJsSync"};
+  static_assert(sizeof(task_type_names) / sizeof(task_type_names[0]) ==
+                    static_cast<size_t>(DispatcherTaskType::kTaskTypeCount),
+                "Every task type needs a name");
+
+  std::string result = R"({"tasks":{)";
+  for (size_t i = 0; i < static_cast<size_t>(DispatcherTaskType::kTaskTypeCount); i++) {
+    AppendMetricJSON(result, task_type_names[i], task_counts_[i].value());
+  }
+  result.back() = '}';
+  result += ',';
+  AppendMetricJSON(result, "dartSyncWaitUs", dart_sync_wait_us_);
+  result += R"("jsThreads":{)";
+  // Metrics could be collected while a page is allocating or killing its JS thread.
+  std::lock_guard<std::mutex> lock(js_threads_mutex_);
+  for (auto& thread : js_threads_) {
+    result += '"' + std::to_string(thread.first) + "\":{";
+    AppendMetricJSON(result, "queueDepth", thread.second->queueDepth());
+    AppendMetricJSON(result, "taskDurationUs", thread.second->taskDuration());
+    AppendMetricJSON(result, "syncWaitUs", thread.second->syncWait());
+    result.back() = '}';
+    result += ',';
+  }
+  if (result.back() == ',') {
+    result.pop_back();
+  }
+  result += "}}";
+  return result;
+}
+
+void Dispatcher::ResetMetrics() {
+  for (auto& counter : task_counts_) {
+    counter.Reset();
+  }
+  dart_sync_wait_us_.Reset();
+  std::lock_guard<std::mutex> lock(js_threads_mutex_);
+  for (auto& thread : js_threads_) {
+    thread.second->ResetMetrics();
+  }
+}
+
 // run in the cpp thread
 bool Dispatcher::NotifyDart(const DartWork* work_ptr, bool is_sync) {
   const intptr_t work_addr = reinterpret_cast<intptr_t>(work_ptr);
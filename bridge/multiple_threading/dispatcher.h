@@ -10,6 +10,7 @@
 #include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -29,6 +30,14 @@ namespace webf {
 
 namespace multi_threading {
 
+enum class DispatcherTaskType : uint8_t {
+  kPostToDart,
+  kPostToDartSync,
+  kPostToJs,
+  kPostToJsSync,
+  kTaskTypeCount,
+};
+
 /**
  * @brief thread dispatcher, used to dispatch tasks to dart thread or js thread.
  *
@@ -48,8 +57,13 @@ class Dispatcher {
 
   std::unique_ptr<Looper>& looper(int32_t js_context_id);
 
+  // Export the task counters and the latency histograms of the dispatcher and all JS threads as JSON.
+  std::string MetricsToJSON();
+  void ResetMetrics();
+
   template <typename Func, typename... Args>
   void PostToDart(bool dedicated_thread, Func&& func, Args&&... args) {
+    CountTask(DispatcherTaskType::kPostToDart);
     if (!dedicated_thread) {
       std::invoke(std::forward<Func>(func), std::forward<Args>(args)...);
       return;
@@ -64,6 +78,7 @@ class Dispatcher {
 
   template <typename Func, typename... Args>
   void PostToDartAndCallback(bool dedicated_thread, Func&& func, Callback callback, Args&&... args) {
+    CountTask(DispatcherTaskType::kPostToDart);
     if (!dedicated_thread) {
       std::invoke(std::forward<Func>(func), std::forward<Args>(args)...);
       callback();
@@ -81,6 +96,7 @@ class Dispatcher {
   template <typename Func, typename... Args>
   auto PostToDartSync(bool dedicated_thread, double js_context_id, Func&& func, Args&&... args)
       -> std::invoke_result_t<Func, bool, Args...> {
+    CountTask(DispatcherTaskType::kPostToDartSync);
     if (!dedicated_thread) {
       return std::invoke(std::forward<Func>(func), false, std::forward<Args>(args)...);
     }
@@ -89,13 +105,17 @@ class Dispatcher {
         std::make_shared<ConcreteSyncTask<Func, Args...>>(std::forward<Func>(func), std::forward<Args>(args)...);
     auto thread_group_id = static_cast<int32_t>(js_context_id);
     auto& looper = js_threads_[thread_group_id];
-    const DartWork work = [task, &looper](bool cancel) {
+    TraceRecorder::Begin(TraceLabel::kPostToDartSync);
+    uint64_t trace_flow_id = TraceRecorder::FlowStart(TraceLabel::kPostToDartSync);
+    const DartWork work = [task, &looper, trace_flow_id](bool cancel) {
 #if ENABLE_LOG
       WEBF_LOG(WARN) << " BLOCKED THREAD " << std::this_thread::get_id() << " HAD BEEN RESUMED"
                      << " is_cancel: " << cancel;
 #endif
 
       looper->is_blocked_ = false;
+      TraceRecorder::FlowEnd(TraceLabel::kPostToDartSync, trace_flow_id);
+      WEBF_TRACE_SCOPE(kDartTask);
       (*task)(cancel);
     };
 
@@ -105,12 +125,17 @@ class Dispatcher {
     bool success = NotifyDart(work_ptr, true);
     if (!success) {
       pending_dart_tasks_.erase(work_ptr);
+      TraceRecorder::End(TraceLabel::kPostToDartSync);
       return std::invoke(std::forward<Func>(func), true, std::forward<Args>(args)...);
     }
 
     looper->is_blocked_ = true;
-    task->wait();
+    {
+      ScopedMetricTimer timer(&dart_sync_wait_us_);
+      task->wait();
+    }
     pending_dart_tasks_.erase(work_ptr);
+    TraceRecorder::End(TraceLabel::kPostToDartSync);
 
     return task->getResult();
   }
@@ -133,6 +158,7 @@ class Dispatcher {
 
   template <typename Func, typename... Args>
   void PostToJs(bool dedicated_thread, int32_t js_context_id, Func&& func, Args&&... args) {
+    CountTask(DispatcherTaskType::kPostToJs);
     if (!dedicated_thread) {
       std::invoke(std::forward<Func>(func), std::forward<Args>(args)...);
       return;
@@ -149,6 +175,7 @@ class Dispatcher {
                            Func&& func,
                            Callback&& callback,
                            Args&&... args) {
+    CountTask(DispatcherTaskType::kPostToJs);
     if (!dedicated_thread) {
       std::invoke(std::forward<Func>(func), std::forward<Args>(args)...);
       callback();
@@ -164,6 +191,7 @@ class Dispatcher {
   template <typename Func, typename... Args>
   auto PostToJsSync(bool dedicated_thread, int32_t js_context_id, Func&& func, Args&&... args)
       -> std::invoke_result_t<Func, bool, Args...> {
+    CountTask(DispatcherTaskType::kPostToJsSync);
     if (!dedicated_thread) {
       return std::invoke(std::forward<Func>(func), false, std::forward<Args>(args)...);
     }
@@ -175,6 +203,7 @@ class Dispatcher {
 
  private:
   bool NotifyDart(const DartWork* work_ptr, bool is_sync);
+  FORCE_INLINE void CountTask(DispatcherTaskType type) { task_counts_[static_cast<size_t>(type)].Increment(); }
 
   void FinalizeAllJSThreads(Callback callback);
   void StopAllJSThreads();
@@ -182,7 +211,12 @@ class Dispatcher {
  private:
   Dart_Port dart_port_;
   std::unordered_map<int32_t, std::unique_ptr<Looper>> js_threads_;
+  // Guards inserting and erasing JS threads against exporting their metrics.
+  std::mutex js_threads_mutex_;
   std::set<DartWork*> pending_dart_tasks_;
+  MetricCounter task_counts_[static_cast<size_t>(DispatcherTaskType::kTaskTypeCount)];
+  // Time the JS thread was blocked by PostToDartSync, in microseconds.
+  MetricHistogram dart_sync_wait_us_;
   friend Looper;
 };
 
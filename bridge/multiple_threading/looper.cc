@@ -32,6 +32,7 @@ void Looper::Start() {
     worker_ = std::thread([this] {
       std::string thread_name = "JS Worker " + std::to_string(js_id_);
       setThreadName(thread_name.c_str());
+      TraceRecorder::SetThreadName(thread_name);
       this->Run();
     });
   }
@@ -66,6 +67,9 @@ void Looper::Run() {
       }
     }
     if (task != nullptr && running_) {
+      TraceRecorder::FlowEnd(TraceLabel::kPostToJsSync, task->trace_flow_id);
+      WEBF_TRACE_SCOPE(kJSThreadTask);
+      ScopedMetricTimer timer(&task_duration_us_);
       (*task)(false);
     }
   }
@@ -88,6 +92,12 @@ void Looper::ExecuteOpaqueFinalizer() {
   opaque_finalizer_(opaque_);
 }
 
+void Looper::ResetMetrics() {
+  queue_depth_.Reset();
+  task_duration_us_.Reset();
+  sync_wait_us_.Reset();
+}
+
 }  // namespace multi_threading
 
 }  // namespace webf
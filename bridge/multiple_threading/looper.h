@@ -12,6 +12,7 @@
 #include <thread>
 
 #include "foundation/logging.h"
+#include "foundation/metrics.h"
 #include "task.h"
 
 namespace webf {
@@ -39,6 +40,7 @@ class Looper {
     {
       std::unique_lock<std::mutex> lock(mutex_);
       tasks_.emplace(std::move(task));
+      queue_depth_.Record(tasks_.size());
     }
     cv_.notify_one();
   }
@@ -50,6 +52,7 @@ class Looper {
     {
       std::unique_lock<std::mutex> lock(mutex_);
       tasks_.emplace(std::move(task));
+      queue_depth_.Record(tasks_.size());
     }
     cv_.notify_one();
   }
@@ -59,12 +62,19 @@ class Looper {
     auto task =
         std::make_shared<ConcreteSyncTask<Func, Args...>>(std::forward<Func>(func), std::forward<Args>(args)...);
     auto task_copy = task;
+    TraceRecorder::Begin(TraceLabel::kPostToJsSync);
+    task->trace_flow_id = TraceRecorder::FlowStart(TraceLabel::kPostToJsSync);
     {
       std::unique_lock<std::mutex> lock(mutex_);
       tasks_.emplace(std::move(task));
+      queue_depth_.Record(tasks_.size());
     }
     cv_.notify_one();
-    task_copy->wait();
+    {
+      ScopedMetricTimer timer(&sync_wait_us_);
+      task_copy->wait();
+    }
+    TraceRecorder::End(TraceLabel::kPostToJsSync);
 
     return task_copy->getResult();
   }
@@ -78,6 +88,14 @@ class Looper {
 
   void ExecuteOpaqueFinalizer();
 
+  // Number of pending tasks observed when a task is posted.
+  const MetricHistogram& queueDepth() const { return queue_depth_; }
+  // Time spent in running a task on the JS thread, in microseconds.
+  const MetricHistogram& taskDuration() const { return task_duration_us_; }
+  // Time the posting thread was blocked by PostMessageSync, in microseconds.
+  const MetricHistogram& syncWait() const { return sync_wait_us_; }
+  void ResetMetrics();
+
  private:
   void Run();
 
@@ -91,6 +109,9 @@ class Looper {
   OpaqueFinalizer opaque_finalizer_;
   int32_t js_id_;
   std::atomic<bool> is_blocked_;
+  MetricHistogram queue_depth_;
+  MetricHistogram task_duration_us_;
+  MetricHistogram sync_wait_us_;
   friend Dispatcher;
 };
 
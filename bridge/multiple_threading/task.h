@@ -11,6 +11,7 @@
 #include <future>
 
 #include "foundation/logging.h"
+#include "foundation/trace_event.h"
 
 namespace webf {
 
@@ -22,6 +23,9 @@ class Task {
  public:
   virtual ~Task() = default;
   virtual void operator()(bool cancel = false) = 0;
+
+  // Links the task with the sync call waiting for it in the exported trace, 0 when tracing is disabled.
+  uint64_t trace_flow_id{0};
 };
 
 template <typename Func, typename... Args>
@@ -5,7 +5,6 @@
 
 // Forked from https://github.com/driverdan/node-XMLHttpRequest/blob/master/lib/XMLHttpRequest.js
 
-import { URL } from './url';
 import { navigator } from './navigator';
 import { initPropertyHandlersForEventTargets } from './helpers';
 
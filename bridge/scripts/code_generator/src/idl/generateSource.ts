@@ -329,9 +329,16 @@ if (UNLIKELY(exception_state.HasException())) {
 }`;
 }
 
+// Methods named after C++ keywords, such as URLSearchParams.delete(), are implemented as <name>ForBinding().
+const cppKeywords = new Set(['default', 'delete', 'new', 'operator', 'switch', 'this']);
+
+function generateMethodIdentifier(name: string) {
+  return cppKeywords.has(name) ? name + 'ForBinding' : name;
+}
+
 function generateCallMethodName(name: string) {
   if (name === 'constructor') return 'Create';
-  return name;
+  return generateMethodIdentifier(name);
 }
 
 function generateDartImplCallCode(blob: IDLBlob, declare: FunctionDeclaration, isLayoutIndependent: boolean, args: FunctionArguments[]): string {
@@ -443,7 +450,7 @@ ${optionalArgumentsInit.join('\n')}
 function generateOverLoadSwitchBody(overloadMethods: FunctionDeclaration[]) {
   let callBodyList = overloadMethods.map((overload, index) => {
     return `if (${overload.args.length} == argc) {
-  return ${overload.name}_overload_${index}(ctx, this_val, argc, argv);
+  return ${generateMethodIdentifier(overload.name)}_overload_${index}(ctx, this_val, argc, argv);
 }
     `;
   });
@@ -451,7 +458,7 @@ function generateOverLoadSwitchBody(overloadMethods: FunctionDeclaration[]) {
   return `
 ${callBodyList.join('\n')}
 
-return ${overloadMethods[0].name}_overload_${0}(ctx, this_val, argc, argv);
+return ${generateMethodIdentifier(overloadMethods[0].name)}_overload_${0}(ctx, this_val, argc, argv);
 `;
 }
 
@@ -579,7 +586,7 @@ export function generateCppSource(blob: IDLBlob, options: GenerateOptions) {
           } else {
             overloadMethods[method.name] = [method];
             filtedMethods.push(method);
-            options.classPropsInstallList.push(`{"${method.name}", ${method.name}, ${method.args.length}}`)
+            options.classPropsInstallList.push(`{"${method.name}", ${generateMethodIdentifier(method.name)}, ${method.args.length}}`)
           }
         }
 
@@ -655,6 +662,7 @@ const WrapperTypeInfo& ${className}::wrapper_type_info_ = QJS${className}::wrapp
           generateCoreTypeValue,
           generateRawTypeValue,
           generateOverLoadSwitchBody,
+          generateMethodIdentifier,
           isTypeNeedAllocate,
           overloadMethods,
           isJSArrayBuiltInProps,
@@ -21,6 +21,7 @@
 #include "core/input/touch_list.h"
 #include "core/dom/static_node_list.h"
 #include "core/html/html_all_collection.h"
+#include "core/geometry/dom_matrix.h"
 #include "defined_properties.h"
 
 namespace webf {
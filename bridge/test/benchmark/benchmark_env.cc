@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "benchmark_env.h"
+
+namespace webf {
+
+WebFTestEnv* BenchmarkEnv() {
+  static std::unique_ptr<WebFTestEnv> env = TEST_init();
+  return env.get();
+}
+
+ExecutingContext* BenchmarkContext() {
+  return BenchmarkEnv()->page()->executingContext();
+}
+
+void BenchmarkEvaluate(const std::string& code) {
+  BenchmarkContext()->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+  BenchmarkReleaseUICommands();
+}
+
+void BenchmarkReleaseUICommands() {
+  BenchmarkContext()->uiCommandBuffer()->clear();
+}
+
+}  // namespace webf
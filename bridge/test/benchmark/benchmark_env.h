@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_TEST_BENCHMARK_BENCHMARK_ENV_H_
+#define BRIDGE_TEST_BENCHMARK_BENCHMARK_ENV_H_
+
+#include <string>
+#include "webf_test_env.h"
+
+namespace webf {
+
+// The page shared by all benchmarks, dart methods are mocked by webf_test_env.
+WebFTestEnv* BenchmarkEnv();
+ExecutingContext* BenchmarkContext();
+
+// Evaluates the script in the shared page and releases the UI commands it recorded afterwards, as dart side does
+// after each frame. Otherwise the command buffer keeps growing between iterations.
+void BenchmarkEvaluate(const std::string& code);
+void BenchmarkReleaseUICommands();
+
+}  // namespace webf
+
+#endif  // BRIDGE_TEST_BENCHMARK_BENCHMARK_ENV_H_
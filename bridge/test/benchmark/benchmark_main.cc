@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+// Entry of webf_benchmark, all regular google benchmark flags are supported. Use
+//   --benchmark_out=<file> --benchmark_out_format=json
+// to write machine-readable results, and compare a later run with them by
+//   --baseline=<file> [--regression_threshold=<percent>]
+// The run fails when the time of any benchmark grows more than the threshold (10% by default). The cpu time is compared
+// unless the benchmark measures real time, e.g. the latency of a sync call to another thread.
+
+namespace {
+
+constexpr char kBaselineFlag[] = "--baseline=";
+constexpr char kRegressionThresholdFlag[] = "--regression_threshold=";
+
+bool UseRealTime(const std::string& name) {
+  static const std::string suffix = "/real_time";
+  return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+double ToNanoseconds(double time, const std::string& unit) {
+  if (unit == "s")
+    return time * 1e9;
+  if (unit == "ms")
+    return time * 1e6;
+  if (unit == "us")
+    return time * 1e3;
+  return time;
+}
+
+// Reads the string value of |key| inside [begin, end) of a json object written by the google benchmark JSONReporter.
+bool ReadJSONString(const std::string& json, size_t begin, size_t end, const char* key, std::string* result) {
+  size_t pos = json.find(key, begin);
+  if (pos == std::string::npos || pos >= end)
+    return false;
+  pos = json.find('"', pos + strlen(key));
+  if (pos == std::string::npos || pos >= end)
+    return false;
+  result->clear();
+  for (pos++; pos < end && json[pos] != '"'; pos++) {
+    if (json[pos] == '\\' && pos + 1 < end)
+      pos++;
+    result->push_back(json[pos]);
+  }
+  return true;
+}
+
+bool ReadJSONNumber(const std::string& json, size_t begin, size_t end, const char* key, double* result) {
+  size_t pos = json.find(key, begin);
+  if (pos == std::string::npos || pos >= end)
+    return false;
+  pos = json.find(':', pos + strlen(key));
+  if (pos == std::string::npos || pos >= end)
+    return false;
+  *result = strtod(json.c_str() + pos + 1, nullptr);
+  return true;
+}
+
+// Returns the compared time in nanoseconds of every benchmark run in the baseline file.
+bool ReadBaseline(const std::string& path, std::map<std::string, double>* baseline) {
+  std::ifstream file(path);
+  if (!file.is_open())
+    return false;
+  std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  size_t pos = json.find("\"benchmarks\"");
+  if (pos == std::string::npos)
+    return false;
+
+  // The run objects are flat, user counters are written as plain fields of them.
+  while ((pos = json.find('{', pos)) != std::string::npos) {
+    size_t end = json.find('}', pos);
+    if (end == std::string::npos)
+      break;
+
+    std::string name;
+    std::string time_unit = "ns";
+    double time;
+    if (ReadJSONString(json, pos, end, "\"name\"", &name) &&
+        ReadJSONNumber(json, pos, end, UseRealTime(name) ? "\"real_time\"" : "\"cpu_time\"", &time)) {
+      ReadJSONString(json, pos, end, "\"time_unit\"", &time_unit);
+      (*baseline)[name] = ToNanoseconds(time, time_unit);
+    }
+    pos = end + 1;
+  }
+  return true;
+}
+
+// Prints the runs as the console reporter does and keeps their time for the baseline comparison.
+class CollectingReporter : public benchmark::ConsoleReporter {
+ public:
+  void ReportRuns(const std::vector<Run>& reports) override {
+    for (auto& run : reports) {
+      if (run.error_occurred || run.report_big_o || run.report_rms)
+        continue;
+      std::string name = run.benchmark_name();
+      double time = UseRealTime(name) ? run.GetAdjustedRealTime() : run.GetAdjustedCPUTime();
+      results_[name] = time * 1e9 / benchmark::GetTimeUnitMultiplier(run.time_unit);
+    }
+    ConsoleReporter::ReportRuns(reports);
+  }
+
+  const std::map<std::string, double>& results() const { return results_; }
+
+ private:
+  std::map<std::string, double> results_;
+};
+
+int CompareWithBaseline(const std::map<std::string, double>& baseline,
+                        const std::map<std::string, double>& results,
+                        double threshold) {
+  int regressions = 0;
+  printf("\n%-60s %14s %14s %9s\n", "Benchmark", "Baseline(ns)", "Current(ns)", "Change");
+  for (auto& entry : results) {
+    auto it = baseline.find(entry.first);
+    if (it == baseline.end() || it->second <= 0) {
+      printf("%-60s %14s %14.1f %9s\n", entry.first.c_str(), "-", entry.second, "new");
+      continue;
+    }
+    double change = (entry.second - it->second) / it->second * 100;
+    bool regressed = change > threshold;
+    if (regressed)
+      regressions++;
+    printf("%-60s %14.1f %14.1f %+8.1f%%%s\n", entry.first.c_str(), it->second, entry.second, change,
+           regressed ? "  REGRESSION" : "");
+  }
+  printf("\n%d benchmark(s) regressed more than %.1f%%.\n", regressions, threshold);
+  return regressions > 0 ? 1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string baseline_path;
+  double threshold = 10;
+
+  // Take out the flags unknown by google benchmark.
+  int remaining_argc = 0;
+  for (int i = 0; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg.rfind(kBaselineFlag, 0) == 0) {
+      baseline_path = arg.substr(strlen(kBaselineFlag));
+    } else if (arg.rfind(kRegressionThresholdFlag, 0) == 0) {
+      threshold = strtod(arg.c_str() + strlen(kRegressionThresholdFlag), nullptr);
+    } else {
+      argv[remaining_argc++] = argv[i];
+    }
+  }
+  argc = remaining_argc;
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  if (baseline_path.empty()) {
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+  }
+
+  std::map<std::string, double> baseline;
+  if (!ReadBaseline(baseline_path, &baseline)) {
+    fprintf(stderr, "Can not read the baseline results from %s\n", baseline_path.c_str());
+    return 1;
+  }
+
+  CollectingReporter reporter;
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+  benchmark::Shutdown();
+  return CompareWithBaseline(baseline, reporter.results(), threshold);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "benchmark_env.h"
+
+using namespace webf;
+
+static void InlineStyleChurn(benchmark::State& state) {
+  BenchmarkEvaluate(R"(
+globalThis.__styleTarget = document.createElement('div');
+document.body.appendChild(__styleTarget);
+)");
+  std::string code = R"(
+(() => {
+const style = __styleTarget.style;
+for (let i = 0; i < 100; i ++) {
+  style.width = i + 'px';
+  style.height = (i * 2) + 'px';
+  style.backgroundColor = i % 2 ? 'red' : 'blue';
+  style.setProperty('transform', 'translate(' + i + 'px, 0)');
+  style.removeProperty('height');
+}
+style.cssText = 'color: red; margin: 0 auto;';
+})();
+)";
+  for (auto _ : state) {
+    BenchmarkEvaluate(code);
+  }
+}
+
+static void ClassListMutation(benchmark::State& state) {
+  BenchmarkEvaluate(R"(
+globalThis.__classTarget = document.createElement('div');
+__classTarget.className = 'card item';
+)");
+  std::string code = R"(
+(() => {
+const list = __classTarget.classList;
+for (let i = 0; i < 100; i ++) {
+  list.add('active', 'selected');
+  list.toggle('hidden');
+  list.contains('item');
+  list.remove('selected');
+  list.replace('active', 'inactive');
+  list.replace('inactive', 'active');
+}
+})();
+)";
+  for (auto _ : state) {
+    BenchmarkEvaluate(code);
+  }
+}
+
+static void AttributeMutation(benchmark::State& state) {
+  BenchmarkEvaluate("globalThis.__attributeTarget = document.createElement('div');");
+  std::string code = R"(
+(() => {
+const element = __attributeTarget;
+for (let i = 0; i < 100; i ++) {
+  element.setAttribute('data-index', i);
+  element.setAttribute('aria-label', 'item ' + i);
+  element.getAttribute('data-index');
+  element.hasAttribute('aria-label');
+  element.removeAttribute('aria-label');
+}
+})();
+)";
+  for (auto _ : state) {
+    BenchmarkEvaluate(code);
+  }
+}
+
+// Dispatches a bubbling event from the leaf of a |depth| deep tree, every node has a capture and a bubble listener.
+static void DispatchEventDeepTree(benchmark::State& state) {
+  BenchmarkEvaluate(R"(
+globalThis.__eventCount = 0;
+globalThis.__buildEventTree = (depth) => {
+  let root = document.createElement('div');
+  let node = root;
+  for (let i = 0; i < depth; i ++) {
+    node.addEventListener('click', () => { __eventCount++; }, true);
+    node.addEventListener('click', () => { __eventCount++; });
+    let child = document.createElement('div');
+    node.appendChild(child);
+    node = child;
+  }
+  return node;
+};
+)");
+  BenchmarkEvaluate("globalThis.__eventLeaf = __buildEventTree(" + std::to_string(state.range(0)) + ");");
+  std::string code = R"(
+for (let i = 0; i < 10; i ++) {
+  __eventLeaf.dispatchEvent(new Event('click', { bubbles: true }));
+}
+)";
+  for (auto _ : state) {
+    BenchmarkEvaluate(code);
+  }
+}
+
+// Records attribute, child list and character data mutations and delivers them in the microtask checkpoint.
+static void MutationObserverDelivery(benchmark::State& state) {
+  BenchmarkEvaluate(R"(
+globalThis.__observedRecords = 0;
+globalThis.__observedTarget = document.createElement('div');
+globalThis.__observedText = document.createTextNode('text');
+__observedTarget.appendChild(__observedText);
+new MutationObserver((records) => { __observedRecords += records.length; })
+  .observe(__observedTarget, { attributes: true, attributeOldValue: true, childList: true, subtree: true,
+                               characterData: true });
+)");
+  std::string code = R"(
+(() => {
+for (let i = 0; i < 50; i ++) {
+  __observedTarget.setAttribute('data-index', i);
+  let child = document.createElement('span');
+  __observedTarget.appendChild(child);
+  __observedTarget.removeChild(child);
+  __observedText.data = 'text ' + i;
+}
+})();
+)";
+  auto context = BenchmarkContext();
+  for (auto _ : state) {
+    BenchmarkEvaluate(code);
+    context->DrainMicrotasks();
+  }
+}
+
+BENCHMARK(InlineStyleChurn);
+BENCHMARK(ClassListMutation);
+BENCHMARK(AttributeMutation);
+BENCHMARK(DispatchEventDeepTree)->Arg(8)->Arg(32);
+BENCHMARK(MutationObserverDelivery);
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "benchmark_env.h"
+
+using namespace webf;
+
+// A news feed like document: a header with navigation, |articles| cards with images, inline styles and entities, a
+// data table and a form.
+static std::string BuildDocument(int64_t articles) {
+  std::string html = R"(<html><head><meta charset="utf-8"><title>Feed</title>
+<style>.card { padding: 8px; border: 1px solid #ddd; } .title { font-weight: bold; }</style></head><body>
+<header class="top-bar" id="header"><nav><ul>
+<li><a href="/">Home</a></li><li><a href="/news" class="active">News</a></li><li><a href="/about">About</a></li>
+</ul></nav></header><main id="feed">)";
+
+  for (int64_t i = 0; i < articles; i++) {
+    std::string index = std::to_string(i);
+    html += R"(<article class="card" data-id=")" + index + R"(" style="margin: 4px 0; display: flex;">
+<img src="https://example.com/thumb/)" + index + R"(.png" width="64" height="64" alt="thumbnail">
+<div class="content"><h2 class="title">Article )" + index + R"( &amp; friends</h2>
+<p>Lorem ipsum dolor sit amet, <em>consectetur</em> adipiscing elit, sed do <strong>eiusmod</strong> tempor
+incididunt ut labore et dolore magna aliqua. &copy; 2022</p>
+<span class="tag">tech</span><span class="tag">news</span><button type="button" onclick="void 0">Like</button>
+</div></article>)";
+  }
+
+  html += R"(</main><table><thead><tr><th>Name</th><th>Value</th></tr></thead><tbody>)";
+  for (int64_t i = 0; i < articles; i++) {
+    html += "<tr><td>row " + std::to_string(i) + "</td><td>" + std::to_string(i * 3) + "</td></tr>";
+  }
+  html += R"(</tbody></table>
+<form action="/subscribe"><input type="email" name="email" placeholder="Email"><input type="submit" value="Go">
+</form><footer><p>Footer text</p></footer></body></html>)";
+  return html;
+}
+
+static void ParseHTMLDocument(benchmark::State& state) {
+  auto* page = BenchmarkEnv()->page();
+  std::string html = BuildDocument(state.range(0));
+  for (auto _ : state) {
+    page->parseHTML(html.c_str(), html.size());
+    BenchmarkReleaseUICommands();
+  }
+  state.SetBytesProcessed(state.iterations() * html.size());
+}
+
+BENCHMARK(ParseHTMLDocument)->Arg(10)->Arg(100);
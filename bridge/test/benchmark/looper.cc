@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "multiple_threading/looper.h"
+
+using namespace webf;
+
+// Round trip of a sync task, the posting thread is blocked until the looper thread ran it.
+static void LooperPostMessageSync(benchmark::State& state) {
+  multi_threading::Looper looper(0);
+  looper.Start();
+  int64_t counter = 0;
+  for (auto _ : state) {
+    looper.PostMessageSync([](bool cancel, int64_t* counter) { (*counter)++; }, &counter);
+  }
+  looper.Stop();
+  benchmark::DoNotOptimize(counter);
+}
+
+// Posts |range(0)| async tasks and waits for the looper thread to drain them with a final sync task.
+static void LooperPostMessageBatch(benchmark::State& state) {
+  multi_threading::Looper looper(0);
+  looper.Start();
+  int64_t counter = 0;
+  int64_t count = state.range(0);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < count; i++) {
+      looper.PostMessage([](int64_t* counter) { (*counter)++; }, &counter);
+    }
+    looper.PostMessageSync([](bool cancel) {});
+  }
+  looper.Stop();
+  benchmark::DoNotOptimize(counter);
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(LooperPostMessageSync)->UseRealTime();
+BENCHMARK(LooperPostMessageBatch)->Arg(256)->UseRealTime();
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "benchmark_env.h"
+#include "bindings/qjs/script_value.h"
+
+using namespace webf;
+
+static ScriptValue EvaluateValue(const std::string& expression) {
+  BenchmarkEvaluate("globalThis.__nativeValue = " + expression + ";");
+  JSContext* ctx = BenchmarkContext()->ctx();
+  JSValue value = JS_GetPropertyStr(ctx, BenchmarkContext()->Global(), "__nativeValue");
+  ScriptValue result(ctx, value);
+  JS_FreeValue(ctx, value);
+  return result;
+}
+
+// Strings and json are taken over by the ScriptValue created from the native value, only the lists are left.
+static void ReleaseNativeList(const NativeValue& value) {
+  if (value.tag != NativeTag::TAG_LIST)
+    return;
+  auto* items = static_cast<NativeValue*>(value.u.ptr);
+  for (uint32_t i = 0; i < value.uint32; i++) {
+    ReleaseNativeList(items[i]);
+  }
+  delete[] items;
+}
+
+static void RoundTrip(benchmark::State& state, const ScriptValue& value) {
+  JSContext* ctx = BenchmarkContext()->ctx();
+  ExceptionState exception_state;
+  for (auto _ : state) {
+    NativeValue native_value = value.ToNative(ctx, exception_state);
+    ScriptValue result(ctx, native_value);
+    benchmark::DoNotOptimize(result.QJSValue());
+    ReleaseNativeList(native_value);
+  }
+}
+
+static void NativeValueStringRoundTrip(benchmark::State& state) {
+  RoundTrip(state, EvaluateValue("'The quick brown fox jumps over the lazy dog'.repeat(4)"));
+}
+
+static void NativeValueArrayRoundTrip(benchmark::State& state) {
+  RoundTrip(state, EvaluateValue("Array.from({ length: " + std::to_string(state.range(0)) +
+                                 " }, (_, i) => i % 3 === 0 ? 'item' + i : (i % 3 === 1 ? i * 0.5 : [i, true]))"));
+}
+
+static void NativeValueObjectRoundTrip(benchmark::State& state) {
+  RoundTrip(state, EvaluateValue("{ id: 1, name: 'card', tags: ['a', 'b', 'c'], rect: { x: 0.5, y: 10, width: 100 }, "
+                                 "visible: true, parent: null }"));
+}
+
+BENCHMARK(NativeValueStringRoundTrip);
+BENCHMARK(NativeValueArrayRoundTrip)->Arg(16)->Arg(256);
+BENCHMARK(NativeValueObjectRoundTrip);
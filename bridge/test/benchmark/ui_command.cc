@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "benchmark_env.h"
+#include "foundation/shared_ui_command.h"
+
+using namespace webf;
+
+// Records |range(0)| commands and hands them over to the reading side in the way dart side does for a frame.
+static void SharedUICommandThroughput(benchmark::State& state) {
+  auto context = BenchmarkContext();
+  SharedUICommand* buffer = context->uiCommandBuffer();
+  NativeBindingObject* binding_object = context->document()->bindingObject();
+  int64_t count = state.range(0);
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < count; i++) {
+      buffer->AddCommand(UICommand::kClearStyle, nullptr, binding_object, nullptr);
+    }
+    buffer->SyncToActive();
+
+    int64_t read = 0;
+    for (UICommandChunk* chunk = buffer->data(); chunk != nullptr; chunk = chunk->next) {
+      read += chunk->size;
+    }
+    benchmark::DoNotOptimize(read);
+    buffer->clear();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(SharedUICommandThroughput)->Arg(64)->Arg(4096);
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+// Replays a trace recorded by startReplayRecording against a page running with the mocked dart methods, so the
+// javascript side of a production page could be measured and bisected without flutter.
+//
+// Usage: webf_replay <trace> [--repeat=<n>]
+//
+// Prints a JSON report to stdout: the number of records replayed, the records whose target or callback could not be
+// found, the time spent in the JS thread by record type and the page metrics, which include the UI command volume and
+// the sync calls to dart.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "bindings/qjs/cppgc/mutation_scope.h"
+#include "core/dom/events/event.h"
+#include "core/dom/events/event_target.h"
+#include "core/frame/window.h"
+#include "event_type_names.h"
+#include "foundation/replay_trace.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+// Indexed by ReplayRecordType.
+constexpr const char* kRecordTypeNames[] = {
+    "", "start", "evaluateScript", "evaluateByteCode", "parseHTML", "dispatchEvent", "timer", "animationFrame",
+    "moduleCallback",
+};
+constexpr size_t kRecordTypeCount = sizeof(kRecordTypeNames) / sizeof(kRecordTypeNames[0]);
+
+struct ReplayReport {
+  uint64_t records{0};
+  uint64_t unmatched{0};
+  uint64_t js_time_us[kRecordTypeCount]{};
+  uint64_t count[kRecordTypeCount]{};
+};
+
+// Maps the ids of the recording to the ids of the replaying page, see ReplayRecordType::kStart.
+struct IdBase {
+  int64_t recorded{0};
+  int64_t replaying{0};
+  int64_t Rebase(int64_t id) const { return id < recorded ? id : id - recorded + replaying; }
+};
+
+struct ReplayState {
+  IdBase event_target;
+  IdBase scheduled_callback;
+  IdBase module_invocation;
+};
+
+void ReadStartRecord(ExecutingContext* context, const ReplayRecord& record, ReplayState* state) {
+  long long event_target = 0, scheduled_callback = 0, module_invocation = 0;
+  sscanf(record.data.c_str(), "%lld %lld %lld", &event_target, &scheduled_callback, &module_invocation);
+  const ReplayIds& next_ids = context->replayIds();
+  state->event_target = {event_target, next_ids.event_target};
+  state->scheduled_callback = {scheduled_callback, next_ids.scheduled_callback};
+  state->module_invocation = {module_invocation, next_ids.module_invocation};
+}
+
+bool DispatchEvent(ExecutingContext* context, EventTarget* target, const ReplayRecord& record) {
+  JSContext* ctx = context->ctx();
+  size_t separator = record.data.find('\0');
+  std::string interface_name = record.data.substr(0, separator);
+  std::string init = separator == std::string::npos ? "{}" : record.data.substr(separator + 1);
+
+  MemberMutationScope mutation_scope{context};
+
+  JSValue constructor = JS_GetPropertyStr(ctx, context->Global(), interface_name.c_str());
+  if (!JS_IsConstructor(ctx, constructor)) {
+    JS_FreeValue(ctx, constructor);
+    constructor = JS_GetPropertyStr(ctx, context->Global(), "Event");
+  }
+  JSValue arguments[] = {JS_NewStringLen(ctx, record.name.c_str(), record.name.size()),
+                         JS_ParseJSON(ctx, init.c_str(), init.size(), "")};
+  JSValue event_object = JS_CallConstructor(ctx, constructor, 2, arguments);
+  JS_FreeValue(ctx, constructor);
+  JS_FreeValue(ctx, arguments[0]);
+  JS_FreeValue(ctx, arguments[1]);
+  if (JS_IsException(event_object)) {
+    context->HandleException(&event_object);
+    return false;
+  }
+
+  // Same as EventTarget::HandleDispatchEventFromDart, dart side walks the event path and dispatches the event to each
+  // target, so each record is an at target dispatch.
+  auto* event = toScriptWrappable<Event>(event_object);
+  event->SetTarget(target);
+  event->SetCurrentTarget(target);
+  auto* window = DynamicTo<Window>(target);
+  if (window != nullptr && (event->type() == event_type_names::kload || event->type() == event_type_names::kgcopen)) {
+    window->OnLoadEventFired();
+  }
+
+  ExceptionState exception_state;
+  event->SetTrusted(false);
+  event->SetEventPhase(Event::kAtTarget);
+  target->FireEventListeners(*event, record.number != 0, exception_state);
+  event->SetEventPhase(0);
+  JS_FreeValue(ctx, event_object);
+
+  if (exception_state.HasException()) {
+    context->HandleException(exception_state);
+  }
+  return true;
+}
+
+bool ResolveModuleCallback(ExecutingContext* context, int64_t invocation_id, const ReplayRecord& record) {
+  if (!record.name.empty()) {
+    return TEST_resolveModuleCallback(context, invocation_id, record.name.c_str(), nullptr);
+  }
+
+  NativeValue data = Native_NewNull();
+  if (!record.data.empty()) {
+    ExceptionState exception_state;
+    ScriptValue value = ScriptValue::CreateJsonObject(context->ctx(), record.data.c_str(), record.data.size());
+    data = Native_NewJSON(context->ctx(), value, exception_state);
+  }
+  return TEST_resolveModuleCallback(context, invocation_id, nullptr, &data);
+}
+
+bool Replay(WebFPage* page, const ReplayRecord& record, ReplayState* state) {
+  ExecutingContext* context = page->executingContext();
+  switch (record.type) {
+    case ReplayRecordType::kStart:
+      ReadStartRecord(context, record, state);
+      return true;
+    case ReplayRecordType::kEvaluateScript:
+      page->evaluateScript(record.data.c_str(), record.data.size(), record.name.c_str(), static_cast<int>(record.id));
+      return true;
+    case ReplayRecordType::kEvaluateByteCode: {
+      std::string bytes = record.data;
+      return page->evaluateByteCode(reinterpret_cast<uint8_t*>(bytes.data()), bytes.size());
+    }
+    case ReplayRecordType::kParseHTML:
+      return page->parseHTML(record.data.c_str(), record.data.size());
+    case ReplayRecordType::kDispatchEvent: {
+      auto& targets = TEST_getEnv(context->uniqueId())->event_targets;
+      auto it = targets.find(state->event_target.Rebase(record.id));
+      return it != targets.end() && DispatchEvent(context, it->second, record);
+    }
+    case ReplayRecordType::kTimer:
+      return TEST_fireTimer(context, state->scheduled_callback.Rebase(record.id));
+    case ReplayRecordType::kAnimationFrame:
+      return TEST_fireAnimationFrame(context, state->scheduled_callback.Rebase(record.id), record.number);
+    case ReplayRecordType::kModuleCallback:
+      return ResolveModuleCallback(context, state->module_invocation.Rebase(record.id), record);
+  }
+  return false;
+}
+
+bool RunTrace(const std::string& path, ReplayReport* report) {
+  ReplayTraceReader reader;
+  if (!reader.Open(path)) {
+    std::cerr << "Failed to open replay trace " << path << std::endl;
+    return false;
+  }
+
+  auto env = TEST_init([](double contextId, const char* errmsg) { std::cerr << errmsg << std::endl; });
+  auto* page = env->page();
+  auto* context = page->executingContext();
+  context->metrics()->Reset();
+
+  ReplayState state;
+  ReplayRecord record;
+  while (reader.Next(&record)) {
+    auto start = std::chrono::steady_clock::now();
+    bool matched = Replay(page, record, &state);
+    context->DrainMicrotasks();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    auto type = static_cast<size_t>(record.type);
+    report->records++;
+    report->count[type]++;
+    report->js_time_us[type] += elapsed.count();
+    if (!matched)
+      report->unmatched++;
+
+    // Dart side consumes the UI commands every frame, drop them to keep the memory flat.
+    context->uiCommandBuffer()->clear();
+  }
+
+  std::cout << R"({"records":)" << report->records << R"(,"unmatched":)" << report->unmatched << R"(,"js_time_us":{)";
+  uint64_t total = 0;
+  for (size_t i = 1; i < kRecordTypeCount; i++) {
+    total += report->js_time_us[i];
+    std::cout << "\"" << kRecordTypeNames[i] << R"(":{"count":)" << report->count[i] << R"(,"time":)"
+              << report->js_time_us[i] << "},";
+  }
+  std::cout << R"("total":)" << total << R"(},"page":)" << context->metrics()->ToJSON() << "}" << std::endl;
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: webf_replay <trace> [--repeat=<n>]" << std::endl;
+    return 1;
+  }
+
+  int repeat = 1;
+  for (int i = 2; i < argc; i++) {
+    if (strncmp(argv[i], "--repeat=", 9) == 0) {
+      repeat = std::max(1, atoi(argv[i] + 9));
+    }
+  }
+
+  // Each run replays against a fresh page, so that the runs could be compared with each other.
+  for (int i = 0; i < repeat; i++) {
+    ReplayReport report;
+    if (!RunTrace(argv[1], &report))
+      return 1;
+  }
+  return 0;
+}
@@ -21,6 +21,16 @@ list(APPEND WEBF_UNIT_TEST_SOURCEURCE
   ./bindings/qjs/qjs_engine_patch_test.cc
   ./core/dom/events/custom_event_test.cc
   ./core/executing_context_test.cc
+  ./core/layout_query_cache_test.cc
+  ./core/replay_recorder_test.cc
+  ./core/fileapi/blob_test.cc
+  ./core/url/url_parser_test.cc
+  ./foundation/slab_allocator_test.cc
+  ./foundation/trace_event_test.cc
+  ./foundation/metrics_test.cc
+  ./foundation/replay_trace_test.cc
+  ./foundation/ui_command_buffer_test.cc
+  ./foundation/base64_test.cc
   ./core/frame/console_test.cc
   ./core/frame/module_manager_test.cc
   ./core/dom/events/event_target_test.cc
@@ -32,6 +42,9 @@ list(APPEND WEBF_UNIT_TEST_SOURCEURCE
   ./core/frame/dom_timer_test.cc
   ./core/frame/window_test.cc
   ./core/css/inline_css_style_declaration_test.cc
+  ./core/css/parser/css_parser_test.cc
+  ./core/css/parser/css_value_parser_test.cc
+  ./core/geometry/transformation_matrix_test.cc
   ./core/html/html_element_test.cc
   ./core/html/custom/widget_element_test.cc
   ./core/timing/performance_test.cc
@@ -82,7 +95,14 @@ add_executable(webf_benchmark
   ${BRIDGE_SOURCE}
   ./test/webf_test_env.cc
   ./test/webf_test_env.h
+  ./test/benchmark/benchmark_env.cc
+  ./test/benchmark/benchmark_main.cc
   ./test/benchmark/create_element.cc
+  ./test/benchmark/html_parser.cc
+  ./test/benchmark/dom_mutation.cc
+  ./test/benchmark/native_value.cc
+  ./test/benchmark/ui_command.cc
+  ./test/benchmark/looper.cc
 )
 target_include_directories(webf_benchmark PUBLIC
   ./third_party/googletest/googletest/include
@@ -93,6 +113,19 @@ target_link_libraries(webf_benchmark gtest gtest_main benchmark::benchmark  ${BR
 target_compile_definitions(webf_benchmark PUBLIC -DFLUTTER_BACKEND=0)
 target_compile_definitions(webf_benchmark PUBLIC -DUNIT_TEST=1)
 
+# Replay the traces recorded by startReplayRecording without flutter.
+add_executable(webf_replay
+  ${WEBF_TEST_SOURCE}
+  ${BRIDGE_SOURCE}
+  ./test/webf_test_env.cc
+  ./test/webf_test_env.h
+  ./test/run_replay.cc
+)
+target_include_directories(webf_replay PUBLIC ./third_party/googletest/googletest/include ${BRIDGE_INCLUDE} ./test)
+target_link_libraries(webf_replay gtest ${BRIDGE_LINK_LIBS})
+target_compile_definitions(webf_replay PUBLIC -DFLUTTER_BACKEND=0)
+target_compile_definitions(webf_replay PUBLIC -DUNIT_TEST=1)
+
 # Built libwebf_test.dylib library for integration test with flutter.
 add_library(webf_test SHARED ${WEBF_TEST_SOURCE})
 target_link_libraries(webf_test PRIVATE ${BRIDGE_LINK_LIBS} webf)
@@ -7,8 +7,10 @@
 #include <vector>
 
 #include "bindings/qjs/native_string_utils.h"
+#include "core/dom/element.h"
 #include "core/dom/frame_request_callback_collection.h"
 #include "core/frame/dom_timer.h"
+#include "core/frame/module_manager.h"
 #include "core/page.h"
 #include "foundation/native_string.h"
 #include "foundation/native_value_converter.h"
@@ -38,9 +40,17 @@ typedef struct {
   int32_t callbackId;
 } JSFrameCallback;
 
+typedef struct {
+  void* callbackContext;
+  double contextId;
+  AsyncModuleCallback callback;
+} JSModuleCallback;
+
 typedef struct JSThreadState {
   std::unordered_map<int32_t, JSOSTimer*> os_timers; /* list of timer.link */
   std::unordered_map<int32_t, JSFrameCallback*> os_frameCallbacks;
+  /* module callbacks by ModuleContext::invocation_id, resolved by TEST_resolveModuleCallback */
+  std::unordered_map<int64_t, JSModuleCallback> os_moduleCallbacks;
 } JSThreadState;
 
 static void unlink_timer(JSThreadState* ts, int32_t timerId) {
@@ -67,6 +77,12 @@ NativeValue* TEST_invokeModule(void* callbackContext,
   if (module == "MethodChannel") {
     NativeValue data = Native_NewCString("{\"result\": 1234}");
     callback(callbackContext, contextId, nullptr, &data, nullptr, nullptr);
+  } else if (module != "throwError" && callbackContext != nullptr) {
+    auto* module_context = static_cast<ModuleContext*>(callbackContext);
+    JSRuntime* rt = module_context->context->dartIsolateContext()->runtime();
+    if (auto* ts = static_cast<JSThreadState*>(JS_GetRuntimeOpaque(rt))) {
+      ts->os_moduleCallbacks[module_context->invocation_id] = {callbackContext, contextId, callback};
+    }
   }
 
   auto* result = static_cast<NativeValue*>(malloc(sizeof(NativeValue)));
@@ -179,7 +195,38 @@ void TEST_flushUICommand(double contextId) {
 
 void TEST_CreateBindingObject(double context_id, void* native_binding_object, int32_t type, void* args, int32_t argc) {}
 
-void TEST_GetWidgetElementShape() {}
+struct TEST_WidgetElementShape {
+  std::vector<std::string> properties;
+  std::vector<std::string> sync_methods;
+  std::vector<std::string> async_methods;
+};
+std::unordered_map<std::string, TEST_WidgetElementShape> test_widget_element_shapes;
+
+static NativeValue TEST_newStringList(const std::vector<std::string>& strings) {
+  auto* list = new NativeValue[strings.size()];
+  for (size_t i = 0; i < strings.size(); i++) {
+    list[i] = NativeValueConverter<NativeTypeString>::ToNativeValue(strings[i]);
+  }
+  return Native_NewList(strings.size(), list);
+}
+
+int8_t TEST_GetWidgetElementShape(double context_id, void* native_binding_object, NativeValue* value) {
+  auto* element = static_cast<Element*>(static_cast<NativeBindingObject*>(native_binding_object)->binding_target_);
+  auto it = test_widget_element_shapes.find(element->localName().ToStdString(element->ctx()));
+  if (it == test_widget_element_shapes.end())
+    return 0;
+  value[0] = TEST_newStringList(it->second.properties);
+  value[1] = TEST_newStringList(it->second.sync_methods);
+  value[2] = TEST_newStringList(it->second.async_methods);
+  return 1;
+}
+
+void TEST_registerWidgetElementShape(const std::string& local_name,
+                                     std::vector<std::string> properties,
+                                     std::vector<std::string> sync_methods,
+                                     std::vector<std::string> async_methods) {
+  test_widget_element_shapes[local_name] = {std::move(properties), std::move(sync_methods), std::move(async_methods)};
+}
 
 void TEST_onJsLog(double contextId, int32_t level, const char*) {}
 
@@ -289,6 +336,84 @@ void TEST_runLoop(webf::ExecutingContext* context) {
   }
 }
 
+bool TEST_fireTimer(webf::ExecutingContext* context, int64_t scheduled_callback_id) {
+  JSThreadState* ts = static_cast<JSThreadState*>(JS_GetRuntimeOpaque(context->dartIsolateContext()->runtime()));
+  for (auto& entry : ts->os_timers) {
+    JSOSTimer* th = entry.second;
+    if (th->timer->context() != context || th->timer->scheduledCallbackId() != scheduled_callback_id)
+      continue;
+
+    if (th->isInterval) {
+      th->func(th->timer, th->contextId, nullptr);
+    } else {
+      AsyncCallback func = th->func;
+      int32_t timerId = entry.first;
+      func(th->timer, th->contextId, nullptr);
+      unlink_timer(ts, timerId);
+    }
+    return true;
+  }
+  return false;
+}
+
+bool TEST_fireAnimationFrame(webf::ExecutingContext* context,
+                             int64_t scheduled_callback_id,
+                             double high_res_time_stamp) {
+  JSThreadState* ts = static_cast<JSThreadState*>(JS_GetRuntimeOpaque(context->dartIsolateContext()->runtime()));
+  for (auto& entry : ts->os_frameCallbacks) {
+    JSFrameCallback* th = entry.second;
+    if (th->callback->context() != context || th->callback->scheduledCallbackId() != scheduled_callback_id)
+      continue;
+
+    AsyncRAFCallback handler = th->handler;
+    th->handler = nullptr;
+    handler(th->callback, th->contextId, high_res_time_stamp, nullptr);
+    unlink_callback(ts, th);
+    return true;
+  }
+  return false;
+}
+
+bool TEST_resolveModuleCallback(webf::ExecutingContext* context,
+                                int64_t invocation_id,
+                                const char* errmsg,
+                                NativeValue* data) {
+  JSThreadState* ts = static_cast<JSThreadState*>(JS_GetRuntimeOpaque(context->dartIsolateContext()->runtime()));
+  auto it = ts->os_moduleCallbacks.find(invocation_id);
+  if (it == ts->os_moduleCallbacks.end())
+    return false;
+
+  JSModuleCallback module_callback = it->second;
+  ts->os_moduleCallbacks.erase(it);
+  NativeValue* result =
+      module_callback.callback(module_callback.callbackContext, module_callback.contextId, errmsg, data, nullptr, nullptr);
+  free(result);
+  return true;
+}
+
+std::vector<UICommandItem*> TEST_getUICommandItems(webf::ExecutingContext* context) {
+  std::vector<UICommandItem*> items;
+  for (UICommandChunk* chunk = context->uiCommandBuffer()->data(); chunk != nullptr; chunk = chunk->next) {
+    for (int64_t i = 0; i < chunk->size; i++) {
+      items.push_back(&chunk->items[i]);
+    }
+  }
+  return items;
+}
+
+std::vector<int64_t> TEST_takeStyleDirtyRoots(webf::ExecutingContext* context) {
+  std::vector<int64_t> roots;
+  for (UICommandItem* item : TEST_getUICommandItems(context)) {
+    if (item->type != (int32_t)UICommand::kStyleDirtyRoots)
+      continue;
+    auto* payload = reinterpret_cast<int64_t*>(item->nativePtr2);
+    roots.insert(roots.end(), payload + 1, payload + 1 + payload[0]);
+    free(payload);
+  }
+  context->uiCommandBuffer()->clear();
+  return roots;
+}
+
 void TEST_onJSLog(double contextId, int32_t level, const char*) {}
 void TEST_onMatchImageSnapshot(void* callbackContext,
                                double contextId,
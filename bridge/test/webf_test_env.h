@@ -19,6 +19,8 @@ using namespace webf;
 using TEST_OnEventTargetDisposed = void (*)(EventTarget* event_target);
 struct UnitTestEnv {
   TEST_OnEventTargetDisposed on_event_target_disposed{nullptr};
+  // Alive event targets by EventTarget::eventTargetId(), replay traces refer event targets by the id.
+  std::unordered_map<int64_t, EventTarget*> event_targets;
 };
 
 // Mock dart methods and add async timer to emulate webf environment in C++ unit test.
@@ -41,10 +43,24 @@ std::unique_ptr<WebFTestEnv> TEST_init(OnJSError onJsError);
 std::unique_ptr<WebFTestEnv> TEST_init();
 std::unique_ptr<WebFPage> TEST_allocateNewPage(OnJSError onJsError);
 void TEST_runLoop(ExecutingContext* context);
+// Fire the callbacks pending at the mocked dart side instead of waiting for TEST_runLoop, return false when the
+// callback is not pending.
+bool TEST_fireTimer(ExecutingContext* context, int64_t scheduled_callback_id);
+bool TEST_fireAnimationFrame(ExecutingContext* context, int64_t scheduled_callback_id, double high_res_time_stamp);
+bool TEST_resolveModuleCallback(ExecutingContext* context, int64_t invocation_id, const char* errmsg, NativeValue* data);
+// Read the published UI commands like dart side does, the items are valid until the buffer is cleared.
+std::vector<UICommandItem*> TEST_getUICommandItems(ExecutingContext* context);
+// Return the style dirty roots reported by the published UI commands and clear the buffer.
+std::vector<int64_t> TEST_takeStyleDirtyRoots(ExecutingContext* context);
 std::vector<uint64_t> TEST_getMockDartMethods(OnJSError onJSError);
 void TEST_mockTestEnvDartMethods(void* testContext, OnJSError onJSError);
 void TEST_registerEventTargetDisposedCallback(int32_t context_unique_id, TEST_OnEventTargetDisposed callback);
 std::shared_ptr<UnitTestEnv> TEST_getEnv(int32_t context_unique_id);
+// Shape reported by the mocked getWidgetElementShape for the widget elements of the tag, other tags have no shape.
+void TEST_registerWidgetElementShape(const std::string& local_name,
+                                     std::vector<std::string> properties,
+                                     std::vector<std::string> sync_methods,
+                                     std::vector<std::string> async_methods);
 }  // namespace webf
    // void TEST_dispatchEvent(int32_t contextId, EventTarget* eventTarget, const std::string type);
    // void TEST_callNativeMethod(void* nativePtr, void* returnValue, void* method, int32_t argc, void* argv);
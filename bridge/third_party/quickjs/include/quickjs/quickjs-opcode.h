@@ -364,6 +364,11 @@ DEF( typeof_is_function, 1, 1, 1, none)
 DEF(      get_field_ic, 5, 1, 1, none)
 DEF(     get_field2_ic, 5, 1, 2, none)
 DEF(      put_field_ic, 5, 2, 0, none)
+DEF(  get_var_undef_ic, 5, 0, 1, none)
+DEF(        get_var_ic, 5, 0, 1, none) /* must come after get_var_undef_ic */
+DEF(        put_var_ic, 5, 1, 0, none)
+DEF( put_var_strict_ic, 5, 2, 0, none)
+DEF(      check_var_ic, 5, 0, 1, none)
 DEF(      debugger, 1, 0, 0, none)
 
 #undef DEF
@@ -354,6 +354,9 @@ JSRuntime *JS_NewRuntime(void);
 void JS_SetRuntimeInfo(JSRuntime *rt, const char *info);
 void JS_SetMemoryLimit(JSRuntime *rt, size_t limit);
 void JS_SetGCThreshold(JSRuntime *rt, size_t gc_threshold);
+size_t JS_GetGCThreshold(JSRuntime *rt);
+void JS_SetGCGrowthFactor(JSRuntime *rt, double factor);
+size_t JS_GetMallocSize(JSRuntime *rt);
 void JS_TurnOffGC(JSRuntime *rt);
 void JS_TurnOnGC(JSRuntime *rt);
 /* use 0 to disable maximum stack size check */
@@ -370,6 +373,33 @@ void JS_MarkValue(JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark_func);
 void JS_RunGC(JSRuntime *rt);
 JS_BOOL JS_IsLiveObject(JSRuntime *rt, JSValueConst obj);
 
+typedef struct JSGCStats {
+  uint64_t full_collections;
+  uint64_t minor_collections;
+  uint64_t total_duration_us;
+  uint64_t total_bytes_freed;
+  /* statistics of the most recent collection */
+  JS_BOOL last_is_minor;
+  int64_t last_duration_us;
+  int64_t last_objects_scanned;
+  int64_t last_bytes_freed;
+  /* duration of the most recent full collection, used to estimate the
+     pause of the next one */
+  int64_t last_full_duration_us;
+} JSGCStats;
+
+/* Generational mode: automatic collections only scan the objects allocated
+   since the previous collection, and a full collection is run every
+   'minor_per_full' automatic collections. */
+void JS_SetGCGenerational(JSRuntime *rt, JS_BOOL enable, uint32_t minor_per_full);
+/* Collect the cycles made only of objects allocated since the last
+   collection. The survivors are promoted to the old generation. */
+void JS_RunMinorGC(JSRuntime *rt);
+/* Run a minor collection, followed by a full one if the previous full
+   collection fitted in 'budget_us'. Return TRUE if a full collection ran. */
+JS_BOOL JS_RunGCWithBudget(JSRuntime *rt, int64_t budget_us);
+void JS_GetGCStats(JSRuntime *rt, JSGCStats *s);
+
 JSContext *JS_NewContext(JSRuntime *rt);
 void JS_FreeContext(JSContext *s);
 JSContext *JS_DupContext(JSContext *ctx);
@@ -756,6 +786,17 @@ static inline int JS_SetProperty(JSContext* ctx, JSValueConst this_obj, JSAtom p
   return JS_SetPropertyInternal(ctx, this_obj, prop, val, JS_PROP_THROW, NULL);
 }
 
+typedef struct JSInlineCacheStats {
+  /* property and global variable lookups of the function served by its
+     inline cache, or falling back to a full lookup */
+  uint64_t hits;
+  uint64_t misses;
+  uint32_t slot_count; /* number of cached property names */
+} JSInlineCacheStats;
+
+/* Return FALSE if 'func' is not a bytecode function or has no inline cache. */
+JS_BOOL JS_GetFunctionICStats(JSContext *ctx, JSValueConst func, JSInlineCacheStats *s);
+
 int JS_SetPropertyUint32(JSContext* ctx, JSValueConst this_obj, uint32_t idx, JSValue val);
 int JS_SetPropertyInt64(JSContext* ctx, JSValueConst this_obj, int64_t idx, JSValue val);
 int JS_SetPropertyStr(JSContext* ctx, JSValueConst this_obj, const char* prop, JSValue val);
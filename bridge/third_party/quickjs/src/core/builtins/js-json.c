@@ -27,9 +27,11 @@
 #include "../convertion.h"
 #include "../exception.h"
 #include "../function.h"
+#include "../malloc.h"
 #include "../object.h"
 #include "../parser.h"
 #include "../runtime.h"
+#include "../shape.h"
 #include "../string.h"
 #include "../types.h"
 #include "js-array.h"
@@ -174,11 +176,657 @@ fail:
   return JS_EXCEPTION;
 }
 
+/* Fast path of JSON.parse for standard JSON. It parses the input in a
+   single pass without going through the tokenizer: strings are scanned 16
+   bytes at a time with SSE2 or NEON, ASCII strings without escapes are copied
+   directly, numbers are converted without js_atof when the result is exact,
+   and objects with the key set of an object seen earlier in the input reuse
+   its shape instead of inserting the properties one by one.
+
+   Whenever the input is not plain JSON or would be an error, the fast path
+   gives up and the input is parsed again by json_parse_value(), so the
+   accepted syntax and the error messages are the same. */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define JSON_KEY_CACHE_SIZE 256
+#define JSON_SHAPE_CACHE_SIZE 64
+/* the longest keys are not cached */
+#define JSON_KEY_CACHE_MAX_LEN 64
+
+typedef struct JSONKeyCacheEntry {
+  const uint8_t *str;
+  uint32_t len;
+  JSAtom atom;
+} JSONKeyCacheEntry;
+
+typedef struct JSONFastParser {
+  JSContext *ctx;
+  const uint8_t *p;
+  const uint8_t *end;
+  /* TRUE if the input must be parsed by the slow path */
+  BOOL unsupported;
+  /* parsed values and keys of the arrays and objects being parsed */
+  JSValue *values;
+  int value_count;
+  int value_size;
+  JSAtom *atoms;
+  int atom_count;
+  int atom_size;
+  JSONKeyCacheEntry keys[JSON_KEY_CACHE_SIZE];
+  JSShape *shapes[JSON_SHAPE_CACHE_SIZE];
+} JSONFastParser;
+
+/* 1.0e0 to 1.0e22 are exact doubles */
+static const double json_pow10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/* return the first '"', '\\', control or non ASCII character, or 'end' */
+static const uint8_t *json_scan_string(const uint8_t *p, const uint8_t *end)
+{
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('\"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i space = _mm_set1_epi8(0x20);
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    /* signed comparison: the non ASCII bytes are negative */
+    __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                             _mm_cmplt_epi8(v, space));
+    int mask = _mm_movemask_epi8(m);
+    if (mask)
+      return p + ctz32(mask);
+    p += 16;
+  }
+#elif defined(__ARM_NEON)
+  const uint8x16_t quote = vdupq_n_u8('\"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const int8x16_t space = vdupq_n_s8(0x20);
+  while (end - p >= 16) {
+    uint8x16_t v = vld1q_u8(p);
+    uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)),
+                            vcltq_s8(vreinterpretq_s8_u8(v), space));
+    uint8x8_t m8 = vorr_u8(vget_low_u8(m), vget_high_u8(m));
+    if (vget_lane_u64(vreinterpret_u64_u8(m8), 0))
+      break;
+    p += 16;
+  }
+#endif
+  while (p < end) {
+    uint8_t c = *p;
+    if (c == '\"' || c == '\\' || c < 0x20 || c >= 0x80)
+      break;
+    p++;
+  }
+  return p;
+}
+
+static inline const uint8_t *json_skip_spaces(const uint8_t *p, const uint8_t *end)
+{
+  while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+    p++;
+  return p;
+}
+
+static int json_fast_push_value(JSONFastParser *fp, JSValue val)
+{
+  if (JS_IsException(val))
+    return -1;
+  if (unlikely(fp->value_count >= fp->value_size)) {
+    if (js_resize_array(fp->ctx, (void **)&fp->values, sizeof(JSValue),
+                        &fp->value_size, fp->value_count + 1)) {
+      JS_FreeValue(fp->ctx, val);
+      return -1;
+    }
+  }
+  fp->values[fp->value_count++] = val;
+  return 0;
+}
+
+static int json_fast_push_atom(JSONFastParser *fp, JSAtom atom)
+{
+  if (unlikely(fp->atom_count >= fp->atom_size)) {
+    if (js_resize_array(fp->ctx, (void **)&fp->atoms, sizeof(JSAtom),
+                        &fp->atom_size, fp->atom_count + 1)) {
+      JS_FreeAtom(fp->ctx, atom);
+      return -1;
+    }
+  }
+  fp->atoms[fp->atom_count++] = atom;
+  return 0;
+}
+
+static int json_hex_digit(uint8_t c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+/* 'fp->p' is after the opening quote and 'q' at the first character which
+   is not copied as is. The string is decoded the same as js_parse_string()
+   for the escapes of JSON. */
+static JSValue json_fast_parse_escaped_string(JSONFastParser *fp, const uint8_t *q)
+{
+  StringBuffer b_s, *b = &b_s;
+  const uint8_t *p = fp->p, *p_next;
+  const uint8_t *end = fp->end;
+  uint32_t c;
+  int i, d;
+
+  if (string_buffer_init(fp->ctx, b, end - p < 32 ? (int)(end - p) : 32))
+    goto fail;
+  for (;;) {
+    if (string_buffer_write8(b, p, q - p))
+      goto fail;
+    p = q;
+    if (p >= end)
+      goto unsupported;
+    c = *p;
+    if (c == '\"')
+      break;
+    if (c == '\\') {
+      if (p + 1 >= end)
+        goto unsupported;
+      c = p[1];
+      p += 2;
+      switch (c) {
+        case '\"':
+        case '\\':
+        case '/':
+          break;
+        case 'b':
+          c = '\b';
+          break;
+        case 'f':
+          c = '\f';
+          break;
+        case 'n':
+          c = '\n';
+          break;
+        case 'r':
+          c = '\r';
+          break;
+        case 't':
+          c = '\t';
+          break;
+        case 'u':
+          if (end - p < 4)
+            goto unsupported;
+          c = 0;
+          for (i = 0; i < 4; i++) {
+            d = json_hex_digit(p[i]);
+            if (d < 0)
+              goto unsupported;
+            c = (c << 4) | d;
+          }
+          p += 4;
+          /* the surrogate pairs are written as two code units, which
+             gives the same string as combining them */
+          break;
+        default:
+          goto unsupported;
+      }
+    } else if (c >= 0x80) {
+      c = unicode_from_utf8(p, UTF8_CHAR_LEN_MAX, &p_next);
+      if (c > 0x10FFFF || p_next > end)
+        goto unsupported;
+      p = p_next;
+    } else {
+      /* control character */
+      goto unsupported;
+    }
+    if (string_buffer_putc(b, c))
+      goto fail;
+    q = json_scan_string(p, end);
+  }
+  fp->p = p + 1;
+  return string_buffer_end(b);
+unsupported:
+  fp->unsupported = TRUE;
+fail:
+  string_buffer_free(b);
+  return JS_EXCEPTION;
+}
+
+/* parse the string at 'fp->p', after the opening quote */
+static JSValue json_fast_parse_string(JSONFastParser *fp)
+{
+  const uint8_t *start = fp->p;
+  const uint8_t *q = json_scan_string(start, fp->end);
+  if (likely(q < fp->end && *q == '\"')) {
+    fp->p = q + 1;
+    return js_new_string8(fp->ctx, start, q - start);
+  }
+  return json_fast_parse_escaped_string(fp, q);
+}
+
+/* parse the key at 'fp->p', after the opening quote. The ASCII keys without
+   escapes are looked up in the key cache by their bytes. */
+static JSAtom json_fast_parse_key(JSONFastParser *fp)
+{
+  JSContext *ctx = fp->ctx;
+  const uint8_t *start = fp->p;
+  const uint8_t *q = json_scan_string(start, fp->end);
+  JSONKeyCacheEntry *e;
+  JSValue str;
+  JSAtom atom;
+  uint32_t len, h, i;
+
+  if (unlikely(q >= fp->end || *q != '\"')) {
+    str = json_fast_parse_escaped_string(fp, q);
+    if (JS_IsException(str))
+      return JS_ATOM_NULL;
+    atom = JS_ValueToAtom(ctx, str);
+    JS_FreeValue(ctx, str);
+    return atom;
+  }
+  fp->p = q + 1;
+  len = q - start;
+  if (len > JSON_KEY_CACHE_MAX_LEN)
+    return JS_NewAtomLen(ctx, (const char *)start, len);
+
+  h = len;
+  for (i = 0; i < len; i++)
+    h = h * 31 + start[i];
+  e = &fp->keys[(h ^ (h >> 8)) & (JSON_KEY_CACHE_SIZE - 1)];
+  if (e->atom != JS_ATOM_NULL && e->len == len && !memcmp(e->str, start, len))
+    return JS_DupAtom(ctx, e->atom);
+
+  atom = JS_NewAtomLen(ctx, (const char *)start, len);
+  if (atom == JS_ATOM_NULL)
+    return JS_ATOM_NULL;
+  JS_FreeAtom(ctx, e->atom);
+  e->str = start;
+  e->len = len;
+  e->atom = JS_DupAtom(ctx, atom);
+  return atom;
+}
+
+/* -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)? */
+static JSValue json_fast_parse_number(JSONFastParser *fp)
+{
+  const uint8_t *start = fp->p, *p = start, *end = fp->end;
+  const char *p_next;
+  uint64_t mantissa = 0;
+  int digits = 0, exponent = 0, exp_val = 0, exp_neg = 0;
+  BOOL negative = FALSE;
+  JSValue val;
+  double d;
+
+  if (*p == '-') {
+    negative = TRUE;
+    p++;
+  }
+  if (p >= end || !is_digit(*p))
+    goto unsupported;
+  if (*p == '0') {
+    p++;
+    if (p < end && is_digit(*p))
+      goto unsupported;
+  } else {
+    while (p < end && is_digit(*p)) {
+      if (digits < 19)
+        mantissa = mantissa * 10 + (*p - '0');
+      digits++;
+      p++;
+    }
+  }
+  if (p < end && *p == '.') {
+    p++;
+    if (p >= end || !is_digit(*p))
+      goto unsupported;
+    while (p < end && is_digit(*p)) {
+      if (digits < 19) {
+        mantissa = mantissa * 10 + (*p - '0');
+        exponent--;
+      }
+      digits += (digits > 0 || *p != '0');
+      p++;
+    }
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    p++;
+    if (p < end && (*p == '+' || *p == '-')) {
+      exp_neg = (*p == '-');
+      p++;
+    }
+    if (p >= end || !is_digit(*p))
+      goto unsupported;
+    while (p < end && is_digit(*p)) {
+      if (exp_val < 10000)
+        exp_val = exp_val * 10 + (*p - '0');
+      p++;
+    }
+    exponent += exp_neg ? -exp_val : exp_val;
+  }
+
+  if (digits <= 19 && mantissa <= ((uint64_t)1 << 53) &&
+      exponent >= -22 && exponent <= 22) {
+    /* exact, the mantissa and the power of ten are exact doubles */
+    d = (double)mantissa;
+    if (exponent < 0)
+      d /= json_pow10[-exponent];
+    else
+      d *= json_pow10[exponent];
+    if (negative)
+      d = -d;
+    fp->p = p;
+    return JS_NewFloat64(fp->ctx, d);
+  }
+  val = js_atof(fp->ctx, (const char *)start, &p_next, 10, 0);
+  if (JS_IsException(val))
+    return val;
+  if ((const uint8_t *)p_next != p) {
+    JS_FreeValue(fp->ctx, val);
+    goto unsupported;
+  }
+  fp->p = p;
+  return val;
+unsupported:
+  fp->unsupported = TRUE;
+  return JS_EXCEPTION;
+}
+
+static int json_fast_parse_value(JSONFastParser *fp);
+
+static uint32_t json_shape_cache_hash(const JSAtom *atoms, int count)
+{
+  uint32_t h = count;
+  int i;
+  for (i = 0; i < count; i++)
+    h = shape_hash(h, atoms[i]);
+  return get_shape_hash(h, 6);
+}
+
+/* create the object of the 'count' last keys and values, the values are
+   moved to the object */
+static JSValue json_fast_new_object(JSONFastParser *fp, int count)
+{
+  JSContext *ctx = fp->ctx;
+  JSAtom *atoms = fp->atoms + fp->atom_count - count;
+  JSValue *values = fp->values + fp->value_count - count;
+  JSShape **psh, *sh;
+  JSShapeProperty *prs;
+  JSObject *p;
+  JSValue obj;
+  int i;
+
+  psh = &fp->shapes[json_shape_cache_hash(atoms, count)];
+  sh = *psh;
+  if (sh && sh->prop_count == count) {
+    prs = get_shape_prop(sh);
+    for (i = 0; i < count; i++) {
+      if (prs[i].atom != atoms[i])
+        break;
+    }
+    if (i == count) {
+      obj = JS_NewObjectFromShape(ctx, js_dup_shape(sh), JS_CLASS_OBJECT);
+      if (JS_IsException(obj))
+        return obj;
+      p = JS_VALUE_GET_OBJ(obj);
+      for (i = 0; i < count; i++)
+        p->prop[i].u.value = values[i];
+      fp->value_count -= count;
+      return obj;
+    }
+  }
+
+  obj = JS_NewObject(ctx);
+  if (JS_IsException(obj))
+    return obj;
+  for (i = 0; i < count; i++) {
+    /* the values are owned by the object even if it fails */
+    fp->value_count--;
+    if (JS_DefinePropertyValue(ctx, obj, atoms[i], values[i], JS_PROP_C_W_E) < 0) {
+      for (i++; i < count; i++) {
+        JS_FreeValue(ctx, values[i]);
+        fp->value_count--;
+      }
+      JS_FreeValue(ctx, obj);
+      return JS_EXCEPTION;
+    }
+  }
+
+  /* cache the shape if it has exactly the keys, in order and with the
+     default flags, so that the next objects with the same keys are created
+     from it. The duplicated keys are left to the generic path. */
+  sh = JS_VALUE_GET_OBJ(obj)->shape;
+  if (count > 0 && sh->is_hashed && sh->prop_count == count && sh->deleted_prop_count == 0) {
+    prs = get_shape_prop(sh);
+    for (i = 0; i < count; i++) {
+      if (prs[i].atom != atoms[i] || (prs[i].flags & JS_PROP_TMASK) != 0 ||
+          (prs[i].flags & JS_PROP_C_W_E) != JS_PROP_C_W_E)
+        break;
+    }
+    if (i == count) {
+      js_free_shape_null(ctx->rt, *psh);
+      *psh = js_dup_shape(sh);
+    }
+  }
+  return obj;
+}
+
+/* create the array of the 'count' last values, the values are moved to the
+   array */
+static JSValue json_fast_new_array(JSONFastParser *fp, int count)
+{
+  JSContext *ctx = fp->ctx;
+  JSValue *values = fp->values + fp->value_count - count;
+  JSObject *p;
+  JSValue obj;
+  int i;
+
+  obj = JS_NewArray(ctx);
+  if (JS_IsException(obj))
+    return obj;
+  if (count > 0) {
+    p = JS_VALUE_GET_OBJ(obj);
+    if (expand_fast_array(ctx, p, count)) {
+      JS_FreeValue(ctx, obj);
+      return JS_EXCEPTION;
+    }
+    for (i = 0; i < count; i++)
+      p->u.array.u.values[i] = values[i];
+    p->u.array.count = count;
+    p->prop[0].u.value = JS_NewInt32(ctx, count);
+    fp->value_count -= count;
+  }
+  return obj;
+}
+
+static int json_fast_parse_object(JSONFastParser *fp)
+{
+  JSContext *ctx = fp->ctx;
+  int count = 0, i;
+  JSAtom atom;
+  JSValue obj;
+
+  fp->p = json_skip_spaces(fp->p + 1, fp->end);
+  if (fp->p < fp->end && *fp->p == '}') {
+    fp->p++;
+    return json_fast_push_value(fp, JS_NewObject(ctx));
+  }
+  for (;;) {
+    if (fp->p >= fp->end || *fp->p != '\"')
+      goto unsupported;
+    fp->p++;
+    atom = json_fast_parse_key(fp);
+    if (atom == JS_ATOM_NULL || json_fast_push_atom(fp, atom))
+      goto fail;
+    count++;
+    fp->p = json_skip_spaces(fp->p, fp->end);
+    if (fp->p >= fp->end || *fp->p != ':')
+      goto unsupported;
+    fp->p++;
+    if (json_fast_parse_value(fp))
+      goto fail;
+    fp->p = json_skip_spaces(fp->p, fp->end);
+    if (fp->p >= fp->end)
+      goto unsupported;
+    if (*fp->p == '}')
+      break;
+    if (*fp->p != ',')
+      goto unsupported;
+    fp->p = json_skip_spaces(fp->p + 1, fp->end);
+  }
+  fp->p++;
+  obj = json_fast_new_object(fp, count);
+  for (i = 0; i < count; i++)
+    JS_FreeAtom(ctx, fp->atoms[--fp->atom_count]);
+  return json_fast_push_value(fp, obj);
+unsupported:
+  fp->unsupported = TRUE;
+fail:
+  /* the keys and the values are freed by the caller */
+  return -1;
+}
+
+static int json_fast_parse_array(JSONFastParser *fp)
+{
+  int count = 0;
+
+  fp->p = json_skip_spaces(fp->p + 1, fp->end);
+  if (fp->p < fp->end && *fp->p == ']') {
+    fp->p++;
+    return json_fast_push_value(fp, JS_NewArray(fp->ctx));
+  }
+  for (;;) {
+    if (json_fast_parse_value(fp))
+      return -1;
+    count++;
+    fp->p = json_skip_spaces(fp->p, fp->end);
+    if (fp->p >= fp->end)
+      goto unsupported;
+    if (*fp->p == ']')
+      break;
+    if (*fp->p != ',')
+      goto unsupported;
+    fp->p++;
+  }
+  fp->p++;
+  return json_fast_push_value(fp, json_fast_new_array(fp, count));
+unsupported:
+  fp->unsupported = TRUE;
+  return -1;
+}
+
+static BOOL json_fast_match(JSONFastParser *fp, const char *str, int len)
+{
+  if (fp->end - fp->p < len || memcmp(fp->p, str, len))
+    return FALSE;
+  fp->p += len;
+  return TRUE;
+}
+
+/* parse the value at 'fp->p' and push it to 'fp->values' */
+static int json_fast_parse_value(JSONFastParser *fp)
+{
+  fp->p = json_skip_spaces(fp->p, fp->end);
+  if (fp->p >= fp->end)
+    goto unsupported;
+  switch (*fp->p) {
+    case '{':
+    case '[':
+      /* the slow path reports the stack overflow */
+      if (js_check_stack_overflow(fp->ctx->rt, 0))
+        goto unsupported;
+      if (*fp->p == '{')
+        return json_fast_parse_object(fp);
+      return json_fast_parse_array(fp);
+    case '\"':
+      fp->p++;
+      return json_fast_push_value(fp, json_fast_parse_string(fp));
+    case 't':
+      if (!json_fast_match(fp, "true", 4))
+        goto unsupported;
+      return json_fast_push_value(fp, JS_TRUE);
+    case 'f':
+      if (!json_fast_match(fp, "false", 5))
+        goto unsupported;
+      return json_fast_push_value(fp, JS_FALSE);
+    case 'n':
+      if (!json_fast_match(fp, "null", 4))
+        goto unsupported;
+      return json_fast_push_value(fp, JS_NULL);
+    case '-':
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+      return json_fast_push_value(fp, json_fast_parse_number(fp));
+    default:
+      break;
+  }
+unsupported:
+  fp->unsupported = TRUE;
+  return -1;
+}
+
+/* Return the parsed value, or JS_EXCEPTION with '*punsupported' set to TRUE
+   if the input must be parsed by the slow path. */
+static JSValue json_fast_parse(JSContext *ctx, const char *buf, size_t buf_len,
+                               BOOL *punsupported)
+{
+  JSONFastParser *fp;
+  JSValue val = JS_EXCEPTION;
+  int i, ret;
+
+  *punsupported = FALSE;
+  fp = js_mallocz(ctx, sizeof(*fp));
+  if (!fp)
+    return JS_EXCEPTION;
+  fp->ctx = ctx;
+  fp->p = (const uint8_t *)buf;
+  fp->end = fp->p + buf_len;
+
+  ret = json_fast_parse_value(fp);
+  if (ret == 0) {
+    fp->p = json_skip_spaces(fp->p, fp->end);
+    /* the identifiers and the numbers which are not followed by a
+       separator are also left to the slow path here */
+    if (fp->p != fp->end)
+      fp->unsupported = TRUE;
+    else
+      val = fp->values[--fp->value_count];
+  }
+  *punsupported = fp->unsupported;
+
+  for (i = 0; i < fp->value_count; i++)
+    JS_FreeValue(ctx, fp->values[i]);
+  for (i = 0; i < fp->atom_count; i++)
+    JS_FreeAtom(ctx, fp->atoms[i]);
+  for (i = 0; i < JSON_KEY_CACHE_SIZE; i++)
+    JS_FreeAtom(ctx, fp->keys[i].atom);
+  for (i = 0; i < JSON_SHAPE_CACHE_SIZE; i++)
+    js_free_shape_null(ctx->rt, fp->shapes[i]);
+  js_free(ctx, fp->values);
+  js_free(ctx, fp->atoms);
+  js_free(ctx, fp);
+  return val;
+}
+
 JSValue JS_ParseJSON2(JSContext *ctx, const char *buf, size_t buf_len,
                       const char *filename, int flags)
 {
   JSParseState s1, *s = &s1;
   JSValue val = JS_UNDEFINED;
+  BOOL unsupported;
+
+  if (!(flags & JS_PARSE_JSON_EXT)) {
+    val = json_fast_parse(ctx, buf, buf_len, &unsupported);
+    if (!unsupported)
+      return val;
+    val = JS_UNDEFINED;
+  }
 
   js_parse_init(ctx, s, buf, buf_len, filename);
   s->ext_json = ((flags & JS_PARSE_JSON_EXT) != 0);
@@ -580,6 +1228,383 @@ exception:
   return -1;
 }
 
+/* Fast path of JSON.stringify without replacer and indentation. Plain
+   objects, fast arrays and primitive values are written directly, the
+   quoted keys of the objects are cached on their shapes and the string runs
+   which need no escaping are copied in bulk. When anything could run user
+   code or behave differently (toJSON, getters, proxies, other classes,
+   array index keys, cycles), the value is written again by
+   js_json_to_str(), so the output is the same. */
+
+#define JSON_STRINGIFY_MAX_DEPTH 256
+/* returned when the value must be written by the generic path */
+#define JSON_STRINGIFY_UNSUPPORTED 1
+
+struct JSONShapeKeys {
+  /* the properties of the shape when the keys were built, the shape can be
+     modified in place when it is not shared */
+  int prop_count;
+  JSShapeProperty *props;
+  /* FALSE if the objects of the shape use the generic path */
+  BOOL fast;
+  /* the quoted keys followed by ':', the key of the property i is from
+     offsets[i] to offsets[i + 1], which is empty when it is not written */
+  JSValue keys;
+  uint32_t offsets[0];
+};
+
+typedef struct JSONFastStringify {
+  JSContext *ctx;
+  StringBuffer *b;
+  JSObject *object_proto;
+  JSObject *array_proto;
+} JSONFastStringify;
+
+void js_json_free_shape_keys(JSRuntime *rt, JSShape *sh)
+{
+  struct JSONShapeKeys *k = sh->json_keys;
+  int i;
+
+  if (!k)
+    return;
+  for (i = 0; i < k->prop_count; i++)
+    JS_FreeAtomRT(rt, k->props[i].atom);
+  JS_FreeValueRT(rt, k->keys);
+  js_free_rt(rt, k);
+  sh->json_keys = NULL;
+}
+
+static BOOL json_shape_keys_match(struct JSONShapeKeys *k, JSShape *sh)
+{
+  JSShapeProperty *prs = get_shape_prop(sh);
+  int i;
+
+  if (k->prop_count != sh->prop_count)
+    return FALSE;
+  for (i = 0; i < k->prop_count; i++) {
+    if (k->props[i].atom != prs[i].atom || k->props[i].flags != prs[i].flags)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/* return the keys of the shape, built when they are missing or stale */
+static struct JSONShapeKeys *json_get_shape_keys(JSContext *ctx, JSShape *sh)
+{
+  struct JSONShapeKeys *k = sh->json_keys;
+  StringBuffer b_s, *b = &b_s;
+  JSShapeProperty *prs;
+  JSValue key;
+  uint32_t num_key;
+  int i, n;
+
+  if (likely(k && json_shape_keys_match(k, sh)))
+    return k;
+  js_json_free_shape_keys(ctx->rt, sh);
+
+  n = sh->prop_count;
+  k = js_mallocz(ctx, sizeof(*k) + sizeof(uint32_t) * (n + 1) + sizeof(JSShapeProperty) * n);
+  if (!k)
+    return NULL;
+  k->prop_count = n;
+  k->props = (JSShapeProperty *)(k->offsets + n + 1);
+  k->fast = TRUE;
+  k->keys = JS_UNDEFINED;
+  prs = get_shape_prop(sh);
+  for (i = 0; i < n; i++) {
+    k->props[i] = prs[i];
+    JS_DupAtom(ctx, prs[i].atom);
+  }
+  sh->json_keys = k;
+
+  if (string_buffer_init(ctx, b, 16))
+    goto fail;
+  for (i = 0; i < n; i++) {
+    k->offsets[i] = b->len;
+    if (prs[i].atom == JS_ATOM_NULL || JS_AtomGetKind(ctx, prs[i].atom) != JS_ATOM_KIND_STRING)
+      continue;
+    if (prs[i].atom == JS_ATOM_toJSON) {
+      k->fast = FALSE;
+      break;
+    }
+    if (!(prs[i].flags & JS_PROP_ENUMERABLE))
+      continue;
+    /* the array index keys are enumerated first and the getters are
+       called */
+    if (JS_AtomIsArrayIndex(ctx, &num_key, prs[i].atom) ||
+        (prs[i].flags & JS_PROP_TMASK) != JS_PROP_NORMAL) {
+      k->fast = FALSE;
+      break;
+    }
+    key = JS_ToQuotedStringFree(ctx, JS_AtomToString(ctx, prs[i].atom));
+    if (JS_IsException(key) || string_buffer_concat_value_free(b, key) ||
+        string_buffer_putc8(b, ':'))
+      goto fail;
+  }
+  for (; i <= n; i++)
+    k->offsets[i] = b->len;
+  k->keys = string_buffer_end(b);
+  if (JS_IsException(k->keys)) {
+    k->keys = JS_UNDEFINED;
+    js_json_free_shape_keys(ctx->rt, sh);
+    return NULL;
+  }
+  return k;
+fail:
+  string_buffer_free(b);
+  js_json_free_shape_keys(ctx->rt, sh);
+  return NULL;
+}
+
+/* return the first '"', '\\' or control character, or 'end' */
+static const uint8_t *json_scan_escape8(const uint8_t *p, const uint8_t *end)
+{
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('\"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1f);
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    /* v <= 0x1f if max(v, 0x1f) == 0x1f, unsigned */
+    __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                             _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+    int mask = _mm_movemask_epi8(m);
+    if (mask)
+      return p + ctz32(mask);
+    p += 16;
+  }
+#elif defined(__ARM_NEON)
+  const uint8x16_t quote = vdupq_n_u8('\"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t space = vdupq_n_u8(0x20);
+  while (end - p >= 16) {
+    uint8x16_t v = vld1q_u8(p);
+    uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vcltq_u8(v, space));
+    uint8x8_t m8 = vorr_u8(vget_low_u8(m), vget_high_u8(m));
+    if (vget_lane_u64(vreinterpret_u64_u8(m8), 0))
+      break;
+    p += 16;
+  }
+#endif
+  while (p < end && *p != '\"' && *p != '\\' && *p >= 0x20)
+    p++;
+  return p;
+}
+
+/* same escapes as JS_ToQuotedString() */
+static void json_put_escape(StringBuffer *b, uint32_t c)
+{
+  static const char hex[] = "0123456789abcdef";
+  char buf[6];
+
+  switch (c) {
+    case '\t':
+      c = 't';
+      break;
+    case '\r':
+      c = 'r';
+      break;
+    case '\n':
+      c = 'n';
+      break;
+    case '\b':
+      c = 'b';
+      break;
+    case '\f':
+      c = 'f';
+      break;
+    case '\"':
+    case '\\':
+      break;
+    default:
+      buf[0] = '\\';
+      buf[1] = 'u';
+      buf[2] = hex[(c >> 12) & 0xf];
+      buf[3] = hex[(c >> 8) & 0xf];
+      buf[4] = hex[(c >> 4) & 0xf];
+      buf[5] = hex[c & 0xf];
+      string_buffer_write8(b, (const uint8_t *)buf, 6);
+      return;
+  }
+  string_buffer_putc8(b, '\\');
+  string_buffer_putc8(b, c);
+}
+
+static void json_put_quoted_string(StringBuffer *b, JSString *p)
+{
+  const uint8_t *s, *q, *end;
+  const uint16_t *str16;
+  uint32_t i, start, c;
+
+  string_buffer_putc8(b, '\"');
+  if (!p->is_wide_char) {
+    s = p->u.str8;
+    end = s + p->len;
+    for (;;) {
+      q = json_scan_escape8(s, end);
+      string_buffer_write8(b, s, q - s);
+      if (q == end)
+        break;
+      json_put_escape(b, *q);
+      s = q + 1;
+    }
+  } else {
+    str16 = p->u.str16;
+    for (i = start = 0; i < p->len;) {
+      c = str16[i];
+      if (c >= 0x20 && c != '\"' && c != '\\' && (c < 0xd800 || c >= 0xe000)) {
+        i++;
+        continue;
+      }
+      /* surrogate pair */
+      if (c >= 0xd800 && c < 0xdc00 && i + 1 < p->len &&
+          str16[i + 1] >= 0xdc00 && str16[i + 1] < 0xe000) {
+        i += 2;
+        continue;
+      }
+      string_buffer_write16(b, str16 + start, i - start);
+      json_put_escape(b, c);
+      start = ++i;
+    }
+    string_buffer_write16(b, str16 + start, i - start);
+  }
+  string_buffer_putc8(b, '\"');
+}
+
+static void json_put_int(StringBuffer *b, int32_t v)
+{
+  char buf[16];
+  char *q = buf + sizeof(buf);
+  uint32_t u = v < 0 ? -(uint32_t)v : (uint32_t)v;
+
+  do {
+    *--q = '0' + u % 10;
+    u /= 10;
+  } while (u);
+  if (v < 0)
+    *--q = '-';
+  string_buffer_write8(b, (const uint8_t *)q, buf + sizeof(buf) - q);
+}
+
+static int json_fast_put_value(JSONFastStringify *fs, JSValueConst val, int depth);
+
+static int json_fast_put_object(JSONFastStringify *fs, JSObject *p, int depth)
+{
+  struct JSONShapeKeys *k;
+  JSValue v;
+  BOOL has_content = FALSE;
+  int i, ret, tag;
+
+  k = json_get_shape_keys(fs->ctx, p->shape);
+  if (!k)
+    return -1;
+  if (!k->fast)
+    return JSON_STRINGIFY_UNSUPPORTED;
+  string_buffer_putc8(fs->b, '{');
+  for (i = 0; i < k->prop_count; i++) {
+    if (k->offsets[i] == k->offsets[i + 1])
+      continue;
+    v = p->prop[i].u.value;
+    tag = JS_VALUE_GET_TAG(v);
+    if (tag == JS_TAG_UNDEFINED || tag == JS_TAG_SYMBOL)
+      continue;
+    if (has_content)
+      string_buffer_putc8(fs->b, ',');
+    string_buffer_concat(fs->b, JS_VALUE_GET_STRING(k->keys), k->offsets[i], k->offsets[i + 1]);
+    ret = json_fast_put_value(fs, v, depth + 1);
+    if (ret)
+      return ret;
+    has_content = TRUE;
+  }
+  string_buffer_putc8(fs->b, '}');
+  return 0;
+}
+
+static int json_fast_put_array(JSONFastStringify *fs, JSObject *p, int depth)
+{
+  JSValue v;
+  uint32_t i;
+  int ret, tag;
+
+  /* the length may be larger than the elements */
+  if (!p->fast_array || JS_VALUE_GET_TAG(p->prop[0].u.value) != JS_TAG_INT ||
+      JS_VALUE_GET_INT(p->prop[0].u.value) != p->u.array.count ||
+      find_own_property1(p, JS_ATOM_toJSON))
+    return JSON_STRINGIFY_UNSUPPORTED;
+  string_buffer_putc8(fs->b, '[');
+  for (i = 0; i < p->u.array.count; i++) {
+    if (i > 0)
+      string_buffer_putc8(fs->b, ',');
+    v = p->u.array.u.values[i];
+    tag = JS_VALUE_GET_TAG(v);
+    if (tag == JS_TAG_UNDEFINED || tag == JS_TAG_SYMBOL) {
+      string_buffer_puts8(fs->b, "null");
+      continue;
+    }
+    ret = json_fast_put_value(fs, v, depth + 1);
+    if (ret)
+      return ret;
+  }
+  string_buffer_putc8(fs->b, ']');
+  return 0;
+}
+
+static int json_fast_put_value(JSONFastStringify *fs, JSValueConst val, int depth)
+{
+  char buf[JS_DTOA_BUF_SIZE];
+  JSObject *p;
+  double d;
+
+  switch (JS_VALUE_GET_NORM_TAG(val)) {
+    case JS_TAG_INT:
+      json_put_int(fs->b, JS_VALUE_GET_INT(val));
+      return 0;
+    case JS_TAG_FLOAT64:
+      d = JS_VALUE_GET_FLOAT64(val);
+      if (!isfinite(d))
+        return string_buffer_puts8(fs->b, "null");
+      js_dtoa1(buf, d, 10, 0, JS_DTOA_VAR_FORMAT);
+      return string_buffer_puts8(fs->b, buf);
+    case JS_TAG_BOOL:
+      return string_buffer_puts8(fs->b, JS_VALUE_GET_BOOL(val) ? "true" : "false");
+    case JS_TAG_NULL:
+      return string_buffer_puts8(fs->b, "null");
+    case JS_TAG_STRING:
+      json_put_quoted_string(fs->b, JS_VALUE_GET_STRING(val));
+      return 0;
+    case JS_TAG_OBJECT:
+      /* the cycles are reported by the generic path */
+      if (depth > JSON_STRINGIFY_MAX_DEPTH || js_check_stack_overflow(fs->ctx->rt, 0))
+        return JSON_STRINGIFY_UNSUPPORTED;
+      p = JS_VALUE_GET_OBJ(val);
+      if (p->class_id == JS_CLASS_OBJECT && p->shape->proto == fs->object_proto)
+        return json_fast_put_object(fs, p, depth);
+      if (p->class_id == JS_CLASS_ARRAY && p->shape->proto == fs->array_proto)
+        return json_fast_put_array(fs, p, depth);
+      return JSON_STRINGIFY_UNSUPPORTED;
+    default:
+      return JSON_STRINGIFY_UNSUPPORTED;
+  }
+}
+
+/* Return 0 if the value is written, JSON_STRINGIFY_UNSUPPORTED if it must
+   be written by the generic path or -1 on exception. */
+static int json_fast_stringify(JSContext *ctx, StringBuffer *b, JSValueConst val)
+{
+  JSONFastStringify fs_s, *fs = &fs_s;
+
+  fs->ctx = ctx;
+  fs->b = b;
+  fs->object_proto = JS_VALUE_GET_OBJ(ctx->class_proto[JS_CLASS_OBJECT]);
+  fs->array_proto = JS_VALUE_GET_OBJ(ctx->class_proto[JS_CLASS_ARRAY]);
+  /* toJSON() would be inherited by the objects */
+  if (find_own_property1(fs->object_proto, JS_ATOM_toJSON) ||
+      find_own_property1(fs->array_proto, JS_ATOM_toJSON) ||
+      fs->array_proto->shape->proto != fs->object_proto)
+    return JSON_STRINGIFY_UNSUPPORTED;
+  return json_fast_put_value(fs, val, 0);
+}
+
 JSValue JS_JSONStringify(JSContext *ctx, JSValueConst obj,
                          JSValueConst replacer, JSValueConst space0)
 {
@@ -680,6 +1705,19 @@ JSValue JS_JSONStringify(JSContext *ctx, JSValueConst obj,
   JS_FreeValue(ctx, space);
   if (JS_IsException(jsc->gap))
     goto exception;
+  if (JS_IsUndefined(jsc->replacer_func) && JS_IsUndefined(jsc->property_list) &&
+      JS_IsEmptyString(jsc->gap)) {
+    res = json_fast_stringify(ctx, jsc->b, obj);
+    if (res == 0) {
+      ret = string_buffer_end(jsc->b);
+      goto done;
+    }
+    if (res < 0)
+      goto exception;
+    /* start again with the generic path */
+    string_buffer_free(jsc->b);
+    string_buffer_init(ctx, jsc->b, 0);
+  }
   wrapper = JS_NewObject(ctx);
   if (JS_IsException(wrapper))
     goto exception;
@@ -27,5 +27,9 @@
 #define QUICKJS_JS_JSON_H
 
 #include "quickjs/quickjs.h"
+#include "../types.h"
+
+/* free the keys cached on the shape by JSON.stringify */
+void js_json_free_shape_keys(JSRuntime *rt, JSShape *sh);
 
 #endif
\ No newline at end of file
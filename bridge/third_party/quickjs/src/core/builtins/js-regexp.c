@@ -49,6 +49,40 @@ void js_regexp_finalizer(JSRuntime *rt, JSValue val)
   JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_STRING, re->pattern));
 }
 
+static void js_regexp_cache_entry_free(JSRuntime *rt, JSRegExpCacheEntry *entry)
+{
+  if (entry->pattern == NULL)
+    return;
+  JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_STRING, entry->pattern));
+  JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_STRING, entry->bytecode));
+  entry->pattern = NULL;
+  entry->bytecode = NULL;
+}
+
+void js_regexp_cache_free(JSRuntime *rt)
+{
+  int i;
+
+  for (i = 0; i < JS_REGEXP_CACHE_SIZE; i++)
+    js_regexp_cache_entry_free(rt, &rt->regexp_cache[i]);
+}
+
+/* The cache is direct mapped: a (pattern, flags) pair can only be stored in
+   the entry returned here, replacing the previous one. */
+static JSRegExpCacheEntry *js_regexp_cache_entry(JSRuntime *rt, JSString *pattern,
+                                                 int flags)
+{
+  return &rt->regexp_cache[hash_string(pattern, flags) & (JS_REGEXP_CACHE_SIZE - 1)];
+}
+
+static BOOL js_regexp_cache_entry_match(const JSRegExpCacheEntry *entry,
+                                        const JSString *pattern, int flags)
+{
+  return entry->pattern != NULL && entry->flags == flags &&
+         entry->pattern->len == pattern->len &&
+         js_string_memcmp(entry->pattern, pattern, pattern->len) == 0;
+}
+
 /* create a string containing the RegExp bytecode */
 JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
                                  JSValueConst flags)
@@ -59,6 +93,7 @@ JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
   size_t i, len;
   int re_bytecode_len;
   JSValue ret;
+  JSRegExpCacheEntry *entry;
   char error_msg[64];
 
   re_flags = 0;
@@ -100,6 +135,13 @@ JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
     JS_FreeCString(ctx, str);
   }
 
+  entry = NULL;
+  if (JS_VALUE_GET_TAG(pattern) == JS_TAG_STRING) {
+    entry = js_regexp_cache_entry(ctx->rt, JS_VALUE_GET_STRING(pattern), re_flags);
+    if (js_regexp_cache_entry_match(entry, JS_VALUE_GET_STRING(pattern), re_flags))
+      return JS_DupValue(ctx, JS_MKPTR(JS_TAG_STRING, entry->bytecode));
+  }
+
   str = JS_ToCStringLen2(ctx, &len, pattern, !(re_flags & LRE_FLAG_UTF16));
   if (!str)
     return JS_EXCEPTION;
@@ -113,6 +155,14 @@ JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
 
   ret = js_new_string8(ctx, re_bytecode_buf, re_bytecode_len);
   js_free(ctx, re_bytecode_buf);
+  if (entry && !JS_IsException(ret)) {
+    /* the bytecode is immutable, so it is shared by all the RegExp objects
+       created from the same source and flags */
+    js_regexp_cache_entry_free(ctx->rt, entry);
+    entry->pattern = JS_VALUE_GET_STRING(JS_DupValue(ctx, pattern));
+    entry->bytecode = JS_VALUE_GET_STRING(JS_DupValue(ctx, ret));
+    entry->flags = re_flags;
+  }
   return ret;
 }
 
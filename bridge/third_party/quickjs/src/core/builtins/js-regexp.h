@@ -32,5 +32,6 @@ JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
                                  JSValueConst flags);
 JSValue js_regexp_constructor_internal(JSContext *ctx, JSValueConst ctor,
                                               JSValue pattern, JSValue bc);
+void js_regexp_cache_free(JSRuntime *rt);
 
 #endif
\ No newline at end of file
@@ -862,10 +862,32 @@ restart:
       CASE(OP_check_var) : {
         int ret;
         JSAtom atom;
+        int32_t ic_offset;
         atom = get_u32(pc);
         pc += 4;
 
         ret = JS_CheckGlobalVar(ctx, atom);
+        if (ret < 0)
+          goto exception;
+        if (ic != NULL && (ic_offset = get_ic_slot(ic, atom)) >= 0) {
+          put_u8(pc - 5, OP_check_var_ic);
+          put_u32(pc - 4, ic_offset);
+          // safe free call because ic struct will retain atom
+          JS_FreeAtom(ctx, atom);
+        }
+        *sp++ = JS_NewBool(ctx, ret);
+      }
+      BREAK;
+
+      CASE(OP_check_var_ic) : {
+        int ret;
+        JSAtom atom;
+        int32_t ic_offset;
+        ic_offset = get_u32(pc);
+        atom = get_ic_atom(ic, ic_offset);
+        pc += 4;
+
+        ret = JS_CheckGlobalVarWithIC(ctx, atom, ic, ic_offset);
         if (ret < 0)
           goto exception;
         *sp++ = JS_NewBool(ctx, ret);
@@ -875,10 +897,32 @@ restart:
       CASE(OP_get_var_undef) : CASE(OP_get_var) : {
         JSValue val;
         JSAtom atom;
+        int32_t ic_offset;
         atom = get_u32(pc);
         pc += 4;
 
         val = JS_GetGlobalVar(ctx, atom, opcode - OP_get_var_undef);
+        if (unlikely(JS_IsException(val)))
+          goto exception;
+        if (ic != NULL && (ic_offset = get_ic_slot(ic, atom)) >= 0) {
+          put_u8(pc - 5, OP_get_var_undef_ic + (opcode - OP_get_var_undef));
+          put_u32(pc - 4, ic_offset);
+          // safe free call because ic struct will retain atom
+          JS_FreeAtom(ctx, atom);
+        }
+        *sp++ = val;
+      }
+      BREAK;
+
+      CASE(OP_get_var_undef_ic) : CASE(OP_get_var_ic) : {
+        JSValue val;
+        JSAtom atom;
+        int32_t ic_offset;
+        ic_offset = get_u32(pc);
+        atom = get_ic_atom(ic, ic_offset);
+        pc += 4;
+
+        val = JS_GetGlobalVarWithIC(ctx, atom, opcode - OP_get_var_undef_ic, ic, ic_offset);
         if (unlikely(JS_IsException(val)))
           goto exception;
         *sp++ = val;
@@ -888,6 +932,7 @@ restart:
       CASE(OP_put_var) : CASE(OP_put_var_init) : {
         int ret;
         JSAtom atom;
+        int32_t ic_offset;
         atom = get_u32(pc);
         pc += 4;
 
@@ -895,12 +940,34 @@ restart:
         sp--;
         if (unlikely(ret < 0))
           goto exception;
+        if (opcode == OP_put_var && ic != NULL && (ic_offset = get_ic_slot(ic, atom)) >= 0) {
+          put_u8(pc - 5, OP_put_var_ic);
+          put_u32(pc - 4, ic_offset);
+          // safe free call because ic struct will retain atom
+          JS_FreeAtom(ctx, atom);
+        }
+      }
+      BREAK;
+
+      CASE(OP_put_var_ic) : {
+        int ret;
+        JSAtom atom;
+        int32_t ic_offset;
+        ic_offset = get_u32(pc);
+        atom = get_ic_atom(ic, ic_offset);
+        pc += 4;
+
+        ret = JS_SetGlobalVarWithIC(ctx, atom, sp[-1], 0, ic, ic_offset);
+        sp--;
+        if (unlikely(ret < 0))
+          goto exception;
       }
       BREAK;
 
       CASE(OP_put_var_strict) : {
         int ret;
         JSAtom atom;
+        int32_t ic_offset;
         atom = get_u32(pc);
         pc += 4;
 
@@ -913,6 +980,32 @@ restart:
         sp -= 2;
         if (unlikely(ret < 0))
           goto exception;
+        if (ic != NULL && (ic_offset = get_ic_slot(ic, atom)) >= 0) {
+          put_u8(pc - 5, OP_put_var_strict_ic);
+          put_u32(pc - 4, ic_offset);
+          // safe free call because ic struct will retain atom
+          JS_FreeAtom(ctx, atom);
+        }
+      }
+      BREAK;
+
+      CASE(OP_put_var_strict_ic) : {
+        int ret;
+        JSAtom atom;
+        int32_t ic_offset;
+        ic_offset = get_u32(pc);
+        atom = get_ic_atom(ic, ic_offset);
+        pc += 4;
+
+        /* sp[-2] is JS_TRUE or JS_FALSE */
+        if (unlikely(!JS_VALUE_GET_INT(sp[-2]))) {
+          JS_ThrowReferenceErrorNotDefined(ctx, atom);
+          goto exception;
+        }
+        ret = JS_SetGlobalVarWithIC(ctx, atom, sp[-1], 2, ic, ic_offset);
+        sp -= 2;
+        if (unlikely(ret < 0))
+          goto exception;
       }
       BREAK;
 
@@ -482,6 +482,12 @@ void __JS_FreeValueRT(JSRuntime* rt, JSValue v) {
         if (rt->gc_phase == JS_GC_PHASE_NONE) {
           free_zero_refcount(rt);
         }
+      } else if (p->mark == 0) {
+        /* an object outside of the scanned set (e.g. an old object only
+           referenced by young cycles) is released by the cycles: free it
+           with them instead of waiting for the next full GC. */
+        list_del(&p->link);
+        list_add_tail(&p->link, &rt->tmp_obj_list);
       }
     } break;
     case JS_TAG_MODULE:
@@ -519,7 +525,21 @@ void __JS_FreeValue(JSContext* ctx, JSValue v) {
 void add_gc_object(JSRuntime* rt, JSGCObjectHeader* h, JSGCObjectTypeEnum type) {
   h->mark = 0;
   h->gc_obj_type = type;
-  list_add_tail(&h->link, &rt->gc_obj_list);
+  list_add_tail(&h->link, &rt->gc_young_obj_list);
+}
+
+/* move all the young objects at the end of gc_obj_list */
+void gc_promote_young_objects(JSRuntime* rt) {
+  struct list_head* young = &rt->gc_young_obj_list;
+  struct list_head* old = &rt->gc_obj_list;
+
+  if (list_empty(young))
+    return;
+  young->next->prev = old->prev;
+  old->prev->next = young->next;
+  young->prev->next = old;
+  old->prev = young->prev;
+  init_list_head(young);
 }
 
 void JS_MarkValue(JSRuntime* rt, JSValueConst val, JS_MarkFunc* mark_func) {
@@ -794,10 +814,146 @@ void gc_free_cycles(JSRuntime* rt) {
   init_list_head(&rt->gc_zero_ref_count_list);
 }
 
+/* Young objects are tagged with GC_MARK_YOUNG during a minor GC and with
+   GC_MARK_YOUNG_VISITED once their children have been decremented. Only the
+   references between young objects are removed, so a young object kept by
+   an old one (or by anything else) is never collected by a minor GC. */
+#define GC_MARK_YOUNG 2
+#define GC_MARK_YOUNG_VISITED 3
+
+/* monotonic clock: the wall clock may jump while a collection runs */
+static int64_t gc_get_time_us(void) {
+#if defined(_MSC_VER)
+  LARGE_INTEGER freq, counter;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&counter);
+  return (int64_t)(counter.QuadPart * 1000000 / freq.QuadPart);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+static void gc_update_stats(JSRuntime* rt, BOOL is_minor, int64_t start_time, size_t start_size, int64_t scanned) {
+  JSGCStats* s = &rt->gc_stats;
+  int64_t duration = gc_get_time_us() - start_time;
+  size_t end_size = rt->malloc_state.malloc_size;
+
+  s->last_is_minor = is_minor;
+  s->last_duration_us = duration;
+  s->last_objects_scanned = scanned;
+  s->last_bytes_freed = start_size > end_size ? start_size - end_size : 0;
+  s->total_duration_us += duration;
+  s->total_bytes_freed += s->last_bytes_freed;
+  if (is_minor) {
+    s->minor_collections++;
+  } else {
+    s->full_collections++;
+    s->last_full_duration_us = duration;
+  }
+}
+
+static void gc_decref_young_child(JSRuntime* rt, JSGCObjectHeader* p) {
+  if (p->mark < GC_MARK_YOUNG)
+    return;
+  assert(p->ref_count > 0);
+  p->ref_count--;
+  if (p->ref_count == 0 && p->mark == GC_MARK_YOUNG_VISITED) {
+    list_del(&p->link);
+    list_add_tail(&p->link, &rt->tmp_obj_list);
+  }
+}
+
+static void gc_scan_incref_young_child(JSRuntime* rt, JSGCObjectHeader* p) {
+  if (p->mark != GC_MARK_YOUNG_VISITED)
+    return;
+  p->ref_count++;
+  if (p->ref_count == 1) {
+    /* ref_count was 0: remove from tmp_obj_list and add at the end of
+       gc_young_obj_list */
+    list_del(&p->link);
+    list_add_tail(&p->link, &rt->gc_young_obj_list);
+  }
+}
+
+static void gc_scan_incref_young_child2(JSRuntime* rt, JSGCObjectHeader* p) {
+  if (p->mark == GC_MARK_YOUNG_VISITED)
+    p->ref_count++;
+}
+
+static int64_t gc_minor_collect(JSRuntime* rt) {
+  struct list_head *el, *el1;
+  JSGCObjectHeader* p;
+  int64_t scanned = 0;
+
+  init_list_head(&rt->tmp_obj_list);
+
+  list_for_each(el, &rt->gc_young_obj_list) {
+    p = list_entry(el, JSGCObjectHeader, link);
+    p->mark = GC_MARK_YOUNG;
+  }
+
+  /* same as gc_decref() restricted to the young generation */
+  list_for_each_safe(el, el1, &rt->gc_young_obj_list) {
+    p = list_entry(el, JSGCObjectHeader, link);
+    mark_children(rt, p, gc_decref_young_child);
+    p->mark = GC_MARK_YOUNG_VISITED;
+    scanned++;
+    if (p->ref_count == 0) {
+      list_del(&p->link);
+      list_add_tail(&p->link, &rt->tmp_obj_list);
+    }
+  }
+
+  /* same as gc_scan() restricted to the young generation */
+  list_for_each(el, &rt->gc_young_obj_list) {
+    p = list_entry(el, JSGCObjectHeader, link);
+    assert(p->ref_count > 0);
+    mark_children(rt, p, gc_scan_incref_young_child);
+  }
+  list_for_each(el, &rt->tmp_obj_list) {
+    p = list_entry(el, JSGCObjectHeader, link);
+    mark_children(rt, p, gc_scan_incref_young_child2);
+  }
+
+  /* the survivors become old objects */
+  list_for_each(el, &rt->gc_young_obj_list) {
+    p = list_entry(el, JSGCObjectHeader, link);
+    p->mark = 0;
+  }
+  gc_promote_young_objects(rt);
+
+  gc_free_cycles(rt);
+  return scanned;
+}
+
+void JS_RunMinorGC(JSRuntime* rt) {
+  int64_t start_time, scanned;
+  size_t start_size;
+
+  if (rt->gc_off || rt->gc_phase != JS_GC_PHASE_NONE)
+    return;
+
+  start_time = gc_get_time_us();
+  start_size = rt->malloc_state.malloc_size;
+  scanned = gc_minor_collect(rt);
+  gc_update_stats(rt, TRUE, start_time, start_size, scanned);
+}
+
 void JS_RunGC(JSRuntime* rt) {
+  struct list_head* el;
+  int64_t start_time, scanned = 0;
+  size_t start_size;
+
   /* Turn off the GC running for some special reasons. */
   if (rt->gc_off) return;
 
+  start_time = gc_get_time_us();
+  start_size = rt->malloc_state.malloc_size;
+  gc_promote_young_objects(rt);
+  rt->gc_minor_count = 0;
+
   /* decrement the reference of the children of each object. mark =
      1 after this pass. */
   gc_decref(rt);
@@ -805,8 +961,43 @@ void JS_RunGC(JSRuntime* rt) {
   /* keep the GC objects with a non zero refcount and their childs */
   gc_scan(rt);
 
+  list_for_each(el, &rt->tmp_obj_list) {
+    scanned++;
+  }
+  list_for_each(el, &rt->gc_obj_list) {
+    scanned++;
+  }
+
   /* free the GC objects in a cycle */
   gc_free_cycles(rt);
+
+  gc_update_stats(rt, FALSE, start_time, start_size, scanned);
+}
+
+BOOL JS_RunGCWithBudget(JSRuntime* rt, int64_t budget_us) {
+  int64_t start_time = gc_get_time_us();
+
+  JS_RunMinorGC(rt);
+  if (rt->gc_off)
+    return FALSE;
+  /* only run a full GC when the last one fitted in the remaining time */
+  if (rt->gc_stats.last_full_duration_us > budget_us - (gc_get_time_us() - start_time)) {
+    js_update_gc_threshold(rt);
+    return FALSE;
+  }
+  JS_RunGC(rt);
+  js_update_gc_threshold(rt);
+  return TRUE;
+}
+
+void JS_SetGCGenerational(JSRuntime* rt, BOOL enable, uint32_t minor_per_full) {
+  rt->gc_generational = enable;
+  rt->gc_minor_per_full = max_uint32(minor_per_full, 1);
+  rt->gc_minor_count = 0;
+}
+
+void JS_GetGCStats(JSRuntime* rt, JSGCStats* s) {
+  *s = rt->gc_stats;
 }
 
 void JS_TurnOffGC(JSRuntime *rt) {
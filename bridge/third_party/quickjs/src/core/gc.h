@@ -91,6 +91,7 @@ void gc_free_cycles(JSRuntime* rt);
     void free_var_ref(JSRuntime* rt, JSVarRef* var_ref);
 void free_object(JSRuntime* rt, JSObject* p);
 void add_gc_object(JSRuntime* rt, JSGCObjectHeader* h, JSGCObjectTypeEnum type);
+void gc_promote_young_objects(JSRuntime* rt);
 void set_cycle_flag(JSContext* ctx, JSValueConst obj);
 void remove_gc_object(JSGCObjectHeader* h);
 void js_regexp_finalizer(JSRuntime* rt, JSValue val);
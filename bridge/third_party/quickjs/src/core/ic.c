@@ -45,6 +45,8 @@ InlineCache *init_ic(JSContext *ctx) {
   ic->cache = NULL;
   ic->updated = FALSE;
   ic->updated_offset = 0;
+  ic->hit_count = 0;
+  ic->miss_count = 0;
   return ic;
 fail:
   return NULL;
@@ -136,6 +138,17 @@ int free_ic(InlineCache *ic) {
   return 0;
 }
 
+/* tag the shapes of the prototype chain of 'object' up to 'prototype': a
+   change in one of them makes the cached prototype entries stale */
+static void ic_watch_proto_chain(JSObject *object, JSObject *prototype) {
+  JSObject *p;
+  for (p = object->shape->proto; p != NULL; p = p->shape->proto) {
+    p->shape->is_ic_proto = TRUE;
+    if (p == prototype)
+      break;
+  }
+}
+
 #if _MSC_VER
 uint32_t add_ic_slot(InlineCache *ic, JSAtom atom, JSObject *object,
                      uint32_t prop_offset, JSObject* prototype)
@@ -197,6 +210,10 @@ force_inline uint32_t add_ic_slot(InlineCache *ic, JSAtom atom, JSObject *object
                           ic_watchpoint_free_handler);
   }
 end:
+  if (prototype) {
+    ic_watch_proto_chain(object, prototype);
+    ci->proto_epoch = rt->ic_proto_epoch;
+  }
   return ch->index;
 }
 
@@ -226,6 +243,14 @@ end:
   return 0;
 }
 
+int32_t get_ic_slot(InlineCache *ic, JSAtom atom) {
+  InlineCacheHashSlot *ch;
+  for (ch = ic->hash[get_index_hash(atom, ic->hash_bits)]; ch != NULL; ch = ch->next)
+    if (ch->atom == atom)
+      return ch->index;
+  return -1;
+}
+
 int ic_watchpoint_delete_handler(JSRuntime* rt, intptr_t ref, JSAtom atom, void* target) {
   InlineCacheRingItem *ci;
   ci = (InlineCacheRingItem *)ref;
@@ -276,7 +301,7 @@ int ic_delete_shape_proto_watchpoints(JSRuntime *rt, JSShape *shape, JSAtom atom
           o->delete_callback = NULL;
           o->free_callback = NULL;
           ic_watchpoint_free_handler(rt, o->ref, o->atom);
-          js_free_shape_null(rt, shape);
+          js_free_shape_null(rt, sh);
           list_del(el);
           js_free_rt(rt, o);
         }
@@ -302,11 +327,29 @@ int ic_free_shape_proto_watchpoints(JSRuntime *rt, JSShape *shape) {
         o->delete_callback = NULL;
         o->free_callback = NULL;
         ic_watchpoint_free_handler(rt, o->ref, o->atom);
-        js_free_shape_null(rt, shape);
+        js_free_shape_null(rt, sh);
         list_del(el);
         js_free_rt(rt, o);
       }
     p = p->shape->proto;
   }
   return 0;
-}
\ No newline at end of file
+}
+
+JS_BOOL JS_GetFunctionICStats(JSContext *ctx, JSValueConst func,
+                              JSInlineCacheStats *s) {
+  JSObject *p;
+  InlineCache *ic;
+  if (JS_VALUE_GET_TAG(func) != JS_TAG_OBJECT)
+    return FALSE;
+  p = JS_VALUE_GET_OBJ(func);
+  if (p->class_id != JS_CLASS_BYTECODE_FUNCTION)
+    return FALSE;
+  ic = p->u.func.function_bytecode->ic;
+  if (!ic)
+    return FALSE;
+  s->hits = ic->hit_count;
+  s->misses = ic->miss_count;
+  s->slot_count = ic->count;
+  return TRUE;
+}
@@ -37,6 +37,7 @@ int free_ic(InlineCache *ic);
 uint32_t add_ic_slot(InlineCache *ic, JSAtom atom, JSObject *object,
                      uint32_t prop_offset, JSObject* prototype);
 uint32_t add_ic_slot1(InlineCache *ic, JSAtom atom);
+int32_t get_ic_slot(InlineCache *ic, JSAtom atom);
 force_inline int32_t get_ic_prop_offset(InlineCache *ic, uint32_t cache_offset,
                                         JSShape *shape, JSObject **prototype) {
   uint32_t i;
@@ -48,6 +49,10 @@ force_inline int32_t get_ic_prop_offset(InlineCache *ic, uint32_t cache_offset,
   for (;;) {
     buffer = cr->buffer + i;
     if (likely(buffer->shape == shape)) {
+      /* a prototype chain object was modified since the entry was added */
+      if (buffer->proto &&
+          unlikely(buffer->proto_epoch != ic->ctx->rt->ic_proto_epoch))
+        break;
       cr->index = i;
       *prototype = buffer->proto;
       return buffer->prop_offset;
@@ -68,6 +73,27 @@ force_inline JSAtom get_ic_atom(InlineCache *ic, uint32_t cache_offset) {
   return ic->cache[cache_offset].atom;
 }
 
+/* The prototype holding a cached property may have an unhashed shape which
+   is modified in place, so check that the property at 'prop_offset' is still
+   the same data property. */
+static force_inline BOOL check_ic_proto_prop(JSObject *proto, JSAtom atom,
+                                             uint32_t prop_offset) {
+  JSShape *sh;
+  JSShapeProperty *prs;
+  sh = proto->shape;
+  if (unlikely(prop_offset >= (uint32_t)sh->prop_count))
+    return FALSE;
+  prs = get_shape_prop(sh) + prop_offset;
+  return prs->atom == atom && !(prs->flags & JS_PROP_TMASK);
+}
+
+/* must be called before adding a property to an object with the shape 'sh'
+   or changing its prototype */
+static force_inline void ic_shape_will_change(JSRuntime *rt, JSShape *sh) {
+  if (unlikely(sh->is_ic_proto))
+    rt->ic_proto_epoch++;
+}
+
 int ic_watchpoint_delete_handler(JSRuntime* rt, intptr_t ref, JSAtom atom, void* target);
 int ic_watchpoint_free_handler(JSRuntime* rt, intptr_t ref, JSAtom atom);
 int ic_delete_shape_proto_watchpoints(JSRuntime *rt, JSShape *shape, JSAtom atom);
@@ -38,11 +38,19 @@ void js_trigger_gc(JSRuntime* rt, size_t size) {
 #ifdef DUMP_GC
     printf("GC: size=%" PRIu64 "\n", (uint64_t)rt->malloc_state.malloc_size);
 #endif
-    JS_RunGC(rt);
-    rt->malloc_gc_threshold = rt->malloc_state.malloc_size + (rt->malloc_state.malloc_size >> 1);
+    if (rt->gc_generational && ++rt->gc_minor_count < rt->gc_minor_per_full) {
+      JS_RunMinorGC(rt);
+    } else {
+      JS_RunGC(rt);
+    }
+    js_update_gc_threshold(rt);
   }
 }
 
+void js_update_gc_threshold(JSRuntime* rt) {
+  rt->malloc_gc_threshold = (size_t)(rt->malloc_state.malloc_size * rt->gc_growth_factor);
+}
+
 
 /* default memory allocation functions with memory limitation */
 static inline size_t js_def_malloc_usable_size(void* ptr) {
@@ -260,4 +268,21 @@ void* js_def_realloc(JSMallocState* s, void* ptr, size_t size) {
 void JS_SetGCThreshold(JSRuntime *rt, size_t gc_threshold)
 {
   rt->malloc_gc_threshold = gc_threshold;
+}
+
+size_t JS_GetGCThreshold(JSRuntime *rt)
+{
+  return rt->malloc_gc_threshold;
+}
+
+/* the next automatic GC threshold is 'factor' times the heap size left
+   by the last collection */
+void JS_SetGCGrowthFactor(JSRuntime *rt, double factor)
+{
+  rt->gc_growth_factor = factor > 1.0 ? factor : 1.0;
+}
+
+size_t JS_GetMallocSize(JSRuntime *rt)
+{
+  return rt->malloc_state.malloc_size;
 }
\ No newline at end of file
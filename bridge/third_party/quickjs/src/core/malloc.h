@@ -34,6 +34,7 @@
 #endif
 
 void js_trigger_gc(JSRuntime* rt, size_t size);
+void js_update_gc_threshold(JSRuntime* rt);
 no_inline int js_realloc_array(JSContext* ctx, void** parray, int elem_size, int* psize, int req_size);
 
 /* resize the array and update its size if req_size > *psize */
@@ -25,6 +25,7 @@
 
 #include "memory.h"
 #include "function.h"
+#include "gc.h"
 #include "runtime.h"
 #include "shape.h"
 #include "string.h"
@@ -123,6 +124,7 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
   JSMemoryUsage_helper mem = { 0 }, *hp = &mem;
 
   memset(s, 0, sizeof(*s));
+  gc_promote_young_objects(rt);
   s->malloc_count = rt->malloc_state.malloc_count;
   s->malloc_size = rt->malloc_state.malloc_size;
   s->malloc_limit = rt->malloc_state.malloc_limit;
@@ -451,6 +453,7 @@ void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt)
       int obj_classes[JS_CLASS_INIT_COUNT + 1] = { 0 };
       int class_id;
       struct list_head *el;
+      gc_promote_young_objects(rt);
       list_for_each(el, &rt->gc_obj_list) {
         JSGCObjectHeader *gp = list_entry(el, JSGCObjectHeader, link);
         JSObject *p;
@@ -163,6 +163,7 @@ JSValue JS_GetPropertyStr(JSContext* ctx, JSValueConst this_obj, const char* pro
 JSProperty* add_property(JSContext* ctx, JSObject* p, JSAtom prop, int prop_flags) {
   JSShape *sh, *new_sh;
   sh = p->shape;
+  ic_shape_will_change(ctx->rt, sh);
   if (sh->is_hashed) {
     /* try to find an existing shape */
     new_sh = find_hashed_shape_prop(ctx->rt, sh, prop, prop_flags);
@@ -392,8 +393,10 @@ JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
   JSProperty *pr;
   JSShapeProperty *prs;
   uint32_t tag, offset, proto_depth;
+  BOOL ic_cacheable;
 
   offset = proto_depth = 0;
+  ic_cacheable = TRUE;
   tag = JS_VALUE_GET_TAG(obj);
   if (unlikely(tag != JS_TAG_OBJECT)) {
     switch(tag) {
@@ -459,8 +462,10 @@ JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
           continue;
         }
       } else {
-        // basic poly ic is only used for fast path
-        if (ic && p1->shape->is_hashed && p->shape->is_hashed) {
+        // basic poly ic is only used for fast path. The shape of a prototype
+        // is not retained by the cache so it does not need to be hashed.
+        if (ic && ic_cacheable && p1->shape->is_hashed &&
+            (p->shape->is_hashed || proto_depth > 0)) {
           ic->updated = TRUE;
           ic->updated_offset = add_ic_slot(ic, prop, p1, offset, proto_depth > 0 ? p : NULL);
         }
@@ -468,7 +473,11 @@ JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
       }
     }
     if (unlikely(p->is_exotic)) {
-      /* exotic behaviors */
+      /* exotic behaviors: the property may appear without a shape change */
+      if (!p->fast_array || __JS_AtomIsTaggedInt(prop) ||
+          (p->class_id >= JS_CLASS_UINT8C_ARRAY &&
+           p->class_id <= JS_CLASS_FLOAT64_ARRAY))
+        ic_cacheable = FALSE;
       if (p->fast_array) {
         if (__JS_AtomIsTaggedInt(prop)) {
           uint32_t idx = __JS_AtomToUInt32(prop);
@@ -558,11 +567,16 @@ force_inline JSValue JS_GetPropertyInternalWithIC(JSContext *ctx, JSValueConst o
   p = JS_VALUE_GET_OBJ(obj);
   offset = get_ic_prop_offset(ic, offset, p->shape, &proto);
   if (likely(offset >= 0)) {
-    if (proto)
+    if (proto) {
+      if (unlikely(!check_ic_proto_prop(proto, prop, offset)))
+        goto slow_path;
       p = proto;
+    }
+    ic->hit_count++;
     return JS_DupValue(ctx, p->prop[offset].u.value);
   }
 slow_path:
+  ic->miss_count++;
   return JS_GetPropertyInternal(ctx, obj, prop, this_obj, ic, throw_ref_error);
 }
 
@@ -2006,10 +2020,12 @@ force_inline int JS_SetPropertyInternalWithIC(JSContext* ctx, JSValueConst this_
   if (likely(offset >= 0)) {
     if (proto)
       goto slow_path;
+    ic->hit_count++;
     set_value(ctx, &p->prop[offset].u.value, val);
     return TRUE;
   }
 slow_path:
+  ic->miss_count++;
   return JS_SetPropertyInternal(ctx, this_obj, prop, val, flags, ic);
 }
 
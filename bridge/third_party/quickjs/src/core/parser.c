@@ -8176,6 +8176,7 @@ static int optimize_scope_make_global_ref(JSContext *ctx, JSFunctionDef *s,
   } else {
     /* XXX: need 2 extra OP_true if destructuring an array */
   }
+  add_ic_slot1(s->ic, var_name);
   if (bc_buf[pos_next] == OP_get_ref_value) {
     dbuf_putc(bc, OP_get_var);
     dbuf_put_u32(bc, JS_DupAtom(ctx, var_name));
@@ -8706,6 +8707,7 @@ static int resolve_scope_var(JSContext *ctx, JSFunctionDef *s,
     case OP_scope_put_var:
       dbuf_putc(bc, OP_get_var_undef + (op - OP_scope_get_var_undef));
       dbuf_put_u32(bc, JS_DupAtom(ctx, var_name));
+      add_ic_slot1(s->ic, var_name);
       break;
     case OP_scope_put_var_init:
       dbuf_putc(bc, OP_put_var_init);
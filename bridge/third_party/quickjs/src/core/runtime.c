@@ -48,6 +48,7 @@
 #include "builtins/js-number.h"
 #include "builtins/js-operator.h"
 #include "builtins/js-reflect.h"
+#include "builtins/js-regexp.h"
 #include "builtins/js-symbol.h"
 #include "convertion.h"
 #include "gc.h"
@@ -349,6 +350,7 @@ int JS_SetPrototypeInternal(JSContext* ctx, JSValueConst obj, JSValueConst proto
     JS_DupValue(ctx, proto_val);
   }
 
+  ic_shape_will_change(ctx->rt, p->shape);
   if (js_shape_prepare_update(ctx, p, NULL))
     return -1;
   sh = p->shape;
@@ -529,6 +531,111 @@ int JS_SetGlobalVar(JSContext* ctx, JSAtom prop, JSValue val, int flag) {
   return JS_SetPropertyInternal(ctx, ctx->global_obj, prop, val, flags, NULL);
 }
 
+/* The global object is too large to have a hashed shape, so instead of a
+   shape the inline cache records the property offset and checks that it
+   still holds the variable. Properties of the global lexical object are
+   never deleted, and a global object property stays valid until a lexical
+   variable is added. */
+static force_inline JSProperty* find_global_var_ic(JSContext* ctx, InlineCacheRingSlot* cr, JSShapeProperty** pprs) {
+  JSObject* p;
+  JSShape* sh;
+  JSShapeProperty* prs;
+  uint32_t idx;
+
+  p = JS_VALUE_GET_OBJ(ctx->global_var_obj);
+  idx = cr->global_index;
+  if (idx & IC_GLOBAL_LEXICAL) {
+    idx &= ~IC_GLOBAL_LEXICAL;
+  } else {
+    if (unlikely(p->shape->prop_count != cr->global_lexical_count))
+      return NULL;
+    p = JS_VALUE_GET_OBJ(ctx->global_obj);
+  }
+  /* wraps around if nothing is cached */
+  idx--;
+  sh = p->shape;
+  if (unlikely(idx >= (uint32_t)sh->prop_count))
+    return NULL;
+  prs = get_shape_prop(sh) + idx;
+  if (unlikely(prs->atom != cr->atom || (prs->flags & JS_PROP_TMASK)))
+    return NULL;
+  *pprs = prs;
+  return &p->prop[idx];
+}
+
+static void update_global_var_ic(JSContext* ctx, InlineCacheRingSlot* cr) {
+  JSObject* p;
+  JSShapeProperty* prs;
+  JSProperty* pr;
+
+  cr->global_index = 0;
+  p = JS_VALUE_GET_OBJ(ctx->global_var_obj);
+  prs = find_own_property(&pr, p, cr->atom);
+  if (prs) {
+    if (!(prs->flags & JS_PROP_TMASK))
+      cr->global_index = (pr - p->prop + 1) | IC_GLOBAL_LEXICAL;
+    return;
+  }
+  cr->global_lexical_count = p->shape->prop_count;
+  p = JS_VALUE_GET_OBJ(ctx->global_obj);
+  prs = find_own_property(&pr, p, cr->atom);
+  if (prs && !(prs->flags & JS_PROP_TMASK))
+    cr->global_index = pr - p->prop + 1;
+}
+
+JSValue JS_GetGlobalVarWithIC(JSContext* ctx, JSAtom prop, BOOL throw_ref_error, InlineCache* ic, int32_t offset) {
+  InlineCacheRingSlot* cr;
+  JSShapeProperty* prs;
+  JSProperty* pr;
+  JSValue val;
+
+  cr = ic->cache + offset;
+  pr = find_global_var_ic(ctx, cr, &prs);
+  if (likely(pr && !JS_IsUninitialized(pr->u.value))) {
+    ic->hit_count++;
+    return JS_DupValue(ctx, pr->u.value);
+  }
+  ic->miss_count++;
+  val = JS_GetGlobalVar(ctx, prop, throw_ref_error);
+  update_global_var_ic(ctx, cr);
+  return val;
+}
+
+int JS_CheckGlobalVarWithIC(JSContext* ctx, JSAtom prop, InlineCache* ic, int32_t offset) {
+  InlineCacheRingSlot* cr;
+  JSShapeProperty* prs;
+  int ret;
+
+  cr = ic->cache + offset;
+  if (likely(find_global_var_ic(ctx, cr, &prs))) {
+    ic->hit_count++;
+    return TRUE;
+  }
+  ic->miss_count++;
+  ret = JS_CheckGlobalVar(ctx, prop);
+  update_global_var_ic(ctx, cr);
+  return ret;
+}
+
+int JS_SetGlobalVarWithIC(JSContext* ctx, JSAtom prop, JSValue val, int flag, InlineCache* ic, int32_t offset) {
+  InlineCacheRingSlot* cr;
+  JSShapeProperty* prs;
+  JSProperty* pr;
+  int ret;
+
+  cr = ic->cache + offset;
+  pr = find_global_var_ic(ctx, cr, &prs);
+  if (likely(pr && (prs->flags & JS_PROP_WRITABLE) && !JS_IsUninitialized(pr->u.value))) {
+    ic->hit_count++;
+    set_value(ctx, &pr->u.value, val);
+    return 0;
+  }
+  ic->miss_count++;
+  ret = JS_SetGlobalVar(ctx, prop, val, flag);
+  update_global_var_ic(ctx, cr);
+  return ret;
+}
+
 /* return -1, FALSE or TRUE. return FALSE if not configurable or
    invalid object. return -1 in case of exception.
    flags can be 0, JS_PROP_THROW or JS_PROP_THROW_STRICT */
@@ -2594,6 +2701,8 @@ void JS_FreeRuntime(JSRuntime* rt) {
   }
   init_list_head(&rt->job_list);
 
+  js_regexp_cache_free(rt);
+
   JS_RunGC(rt);
 
 #ifdef DUMP_LEAKS
@@ -2859,6 +2968,7 @@ void JS_FreeContext(JSContext* ctx) {
     JSGCObjectHeader* p;
     printf("JSObjects: {\n");
     JS_DumpObjectHeader(ctx->rt);
+    gc_promote_young_objects(rt);
     list_for_each(el, &rt->gc_obj_list) {
       p = list_entry(el, JSGCObjectHeader, link);
       JS_DumpGCObject(rt, p);
@@ -3007,7 +3117,10 @@ JSRuntime* JS_NewRuntime2(const JSMallocFunctions* mf, void* opaque) {
   }
   rt->malloc_state = ms;
   rt->malloc_gc_threshold = 2 * 1024 * 1024; // 2 MB as a start
+  rt->gc_growth_factor = 1.5;
   rt->gc_off = FALSE;
+  rt->gc_generational = FALSE;
+  rt->gc_minor_per_full = 8;
 
 #ifdef CONFIG_BIGNUM
   bf_context_init(&rt->bf_ctx, js_bf_realloc, rt);
@@ -3018,6 +3131,7 @@ JSRuntime* JS_NewRuntime2(const JSMallocFunctions* mf, void* opaque) {
 
   init_list_head(&rt->context_list);
   init_list_head(&rt->gc_obj_list);
+  init_list_head(&rt->gc_young_obj_list);
   init_list_head(&rt->gc_zero_ref_count_list);
   rt->gc_phase = JS_GC_PHASE_NONE;
 
@@ -177,6 +177,11 @@ int JS_CheckGlobalVar(JSContext* ctx, JSAtom prop);
    flag = 2: normal variable write, strict check was done before
 */
 int JS_SetGlobalVar(JSContext* ctx, JSAtom prop, JSValue val, int flag);
+/* same as JS_GetGlobalVar(), JS_CheckGlobalVar() and JS_SetGlobalVar() using
+   the inline cache slot 'offset' of the variable */
+JSValue JS_GetGlobalVarWithIC(JSContext* ctx, JSAtom prop, BOOL throw_ref_error, InlineCache* ic, int32_t offset);
+int JS_CheckGlobalVarWithIC(JSContext* ctx, JSAtom prop, InlineCache* ic, int32_t offset);
+int JS_SetGlobalVarWithIC(JSContext* ctx, JSAtom prop, JSValue val, int flag, InlineCache* ic, int32_t offset);
 
 void JS_SetIsHTMLDDA(JSContext* ctx, JSValueConst obj);
 static inline BOOL JS_IsHTMLDDA(JSContext* ctx, JSValueConst obj) {
@@ -28,6 +28,7 @@
 #include "malloc.h"
 #include "object.h"
 #include "string.h"
+#include "builtins/js-json.h"
 
 /* Shape support */
 
@@ -134,7 +135,9 @@ no_inline JSShape* js_new_shape2(JSContext* ctx, JSObject* proto, int hash_size,
   sh->hash = shape_initial_hash(proto);
   sh->is_hashed = TRUE;
   sh->has_small_array_index = FALSE;
+  sh->is_ic_proto = FALSE;
   sh->watchpoint = NULL;
+  sh->json_keys = NULL;
   js_shape_hash_link(ctx->rt, sh);
   return sh;
 }
@@ -164,6 +167,7 @@ JSShape* js_clone_shape(JSContext* ctx, JSShape* sh1) {
   add_gc_object(ctx->rt, &sh->header, JS_GC_OBJ_TYPE_SHAPE);
   sh->is_hashed = FALSE;
   sh->watchpoint = NULL;
+  sh->json_keys = NULL;
   if (sh->proto) {
     JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
   }
@@ -188,6 +192,7 @@ void js_free_shape0(JSRuntime* rt, JSShape* sh) {
   if (sh->proto != NULL)
     JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
   js_shape_free_watchpoints(rt, sh);
+  js_json_free_shape_keys(rt, sh);
   pr = get_shape_prop(sh);
   for (i = 0; i < sh->prop_count; i++) {
     JS_FreeAtomRT(rt, pr->atom);
@@ -208,6 +213,13 @@ void js_free_shape_null(JSRuntime* rt, JSShape* sh) {
     js_free_shape(rt, sh);
 }
 
+/* 'sh' was memcpy'd from a header about to be freed: take its place in the
+   young or old generation list */
+static void gc_move_header(JSGCObjectHeader* sh) {
+  sh->link.prev->next = &sh->link;
+  sh->link.next->prev = &sh->link;
+}
+
 /* make space to hold at least 'count' properties */
 no_inline int resize_properties(JSContext* ctx, JSShape** psh, JSObject* p, uint32_t count) {
   JSShape* sh;
@@ -238,10 +250,9 @@ no_inline int resize_properties(JSContext* ctx, JSShape** psh, JSObject* p, uint
     if (!sh_alloc)
       return -1;
     sh = get_shape_from_alloc(sh_alloc, new_hash_size);
-    list_del(&old_sh->header.link);
     /* copy all the fields and the properties */
     memcpy(sh, old_sh, sizeof(JSShape) + sizeof(sh->prop[0]) * old_sh->prop_count);
-    list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+    gc_move_header(&sh->header);
     new_hash_mask = new_hash_size - 1;
     sh->prop_hash_mask = new_hash_mask;
     memset(prop_hash_end(sh) - new_hash_size, 0, sizeof(prop_hash_end(sh)[0]) * new_hash_size);
@@ -254,16 +265,19 @@ no_inline int resize_properties(JSContext* ctx, JSShape** psh, JSObject* p, uint
     }
     js_free(ctx, get_alloc_from_shape(old_sh));
   } else {
+    struct list_head* link_prev;
     /* only resize the properties */
+    link_prev = sh->header.link.prev;
     list_del(&sh->header.link);
     sh_alloc = js_realloc(ctx, get_alloc_from_shape(sh), get_shape_size(new_hash_size, new_size));
     if (unlikely(!sh_alloc)) {
       /* insert again in the GC list */
-      list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+      list_add(&sh->header.link, link_prev);
       return -1;
     }
     sh = get_shape_from_alloc(sh_alloc, new_hash_size);
-    list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+    /* keep the place in the young or old generation list */
+    list_add(&sh->header.link, link_prev);
   }
   *psh = sh;
   sh->prop_size = new_size;
@@ -296,9 +310,8 @@ int compact_properties(JSContext* ctx, JSObject* p) {
   if (!sh_alloc)
     return -1;
   sh = get_shape_from_alloc(sh_alloc, new_hash_size);
-  list_del(&old_sh->header.link);
   memcpy(sh, old_sh, sizeof(JSShape));
-  list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+  gc_move_header(&sh->header);
 
   memset(prop_hash_end(sh) - new_hash_size, 0, sizeof(prop_hash_end(sh)[0]) * new_hash_size);
 
@@ -449,6 +462,7 @@ __maybe_unused void JS_DumpShapes(JSRuntime* rt) {
     }
   }
   /* dump non-hashed shapes */
+  gc_promote_young_objects(rt);
   list_for_each(el, &rt->gc_obj_list) {
     gp = list_entry(el, JSGCObjectHeader, link);
     if (gp->gc_obj_type == JS_GC_OBJ_TYPE_JS_OBJECT) {
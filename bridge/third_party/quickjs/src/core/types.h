@@ -168,6 +168,14 @@ typedef enum {
     JS_RUNTIME_STATE_SHUTDOWN,
 } JSRuntimeState;
 
+#define JS_REGEXP_CACHE_SIZE 64 /* must be a power of two */
+
+typedef struct JSRegExpCacheEntry {
+    JSString *pattern; /* NULL if the entry is free */
+    JSString *bytecode;
+    int flags;
+} JSRegExpCacheEntry;
+
 struct JSRuntime {
     JSMallocFunctions mf;
     JSMallocState malloc_state;
@@ -191,9 +199,19 @@ struct JSRuntime {
     /* list of JSGCObjectHeader.link. Used during JS_FreeValueRT() */
     struct list_head gc_zero_ref_count_list;
     struct list_head tmp_obj_list; /* used during GC */
+    /* list of JSGCObjectHeader.link. GC objects allocated since the last
+       collection. They are the only ones scanned by JS_RunMinorGC() and
+       are moved to gc_obj_list once they survive a collection. */
+    struct list_head gc_young_obj_list;
     JSGCPhaseEnum gc_phase : 8;
     BOOL gc_off: 8;
+    BOOL gc_generational : 8;
+    /* number of minor collections run by js_trigger_gc() before a full one */
+    uint32_t gc_minor_per_full;
+    uint32_t gc_minor_count;
+    JSGCStats gc_stats;
     size_t malloc_gc_threshold;
+    double gc_growth_factor;
 #ifdef DUMP_LEAKS
     struct list_head string_list; /* list of JSString.link */
 #endif
@@ -229,6 +247,12 @@ struct JSRuntime {
     int shape_hash_size;
     int shape_hash_count; /* number of hashed shapes */
     JSShape **shape_hash;
+    /* compiled RegExp bytecode keyed by (source, flags), see
+       js_compile_regexp() */
+    JSRegExpCacheEntry regexp_cache[JS_REGEXP_CACHE_SIZE];
+    /* incremented when an object on a prototype chain cached by an inline
+       cache gets a new property or a new prototype, see add_ic_slot() */
+    uint32_t ic_proto_epoch;
 #ifdef CONFIG_BIGNUM
     bf_context_t bf_ctx;
     JSNumericOperations bigint_ops;
@@ -540,13 +564,23 @@ typedef struct InlineCacheRingItem {
     JSObject* proto;
     JSShape *shape;
     uint32_t prop_offset;
+    uint32_t proto_epoch; /* JSRuntime.ic_proto_epoch when proto was cached */
     ICWatchpoint *watchpoint_ref;
 } InlineCacheRingItem;
 
+/* set in InlineCacheRingSlot.global_index for global lexical variables */
+#define IC_GLOBAL_LEXICAL (1U << 31)
+
 typedef struct InlineCacheRingSlot {
     JSAtom atom;
     InlineCacheRingItem buffer[IC_CACHE_ITEM_CAPACITY];
     uint8_t index;
+    /* global variable access: property offset + 1 in the global object, or
+       in the global lexical object if IC_GLOBAL_LEXICAL is set. 0 if unset */
+    uint32_t global_index;
+    /* property count of the global lexical object when a global object
+       property was cached: a new lexical variable may shadow it */
+    uint32_t global_lexical_count;
 } InlineCacheRingSlot;
 
 typedef struct InlineCacheHashSlot {
@@ -564,6 +598,10 @@ typedef struct InlineCache {
     InlineCacheRingSlot *cache;
     uint32_t updated_offset;
     BOOL updated;
+    /* lookups of the *_ic opcodes served by the cache or falling back to
+       the generic lookup, see JS_GetFunctionICStats() */
+    uint64_t hit_count;
+    uint64_t miss_count;
 } InlineCache;
 
 typedef struct JSFunctionBytecode {
@@ -841,6 +879,10 @@ struct JSShape {
        <= n <= 2^31-1. If false, the shape is guaranteed not to have
        small array index properties */
     uint8_t has_small_array_index;
+    /* true if an object with this shape is on a prototype chain cached by an
+       inline cache: adding a property or changing the prototype must
+       increment JSRuntime.ic_proto_epoch */
+    uint8_t is_ic_proto;
     uint32_t hash; /* current hash value */
     uint32_t prop_hash_mask;
     int prop_size; /* allocated properties */
@@ -849,6 +891,8 @@ struct JSShape {
     JSShape *shape_hash_next; /* in JSRuntime.shape_hash[h] list */
     JSObject *proto;
     struct list_head *watchpoint;
+    /* the quoted keys written by JSON.stringify, see js-json.c */
+    struct JSONShapeKeys *json_keys;
     JSShapeProperty prop[0]; /* prop_size elements */
 };
 
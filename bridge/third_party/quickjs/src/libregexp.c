@@ -2493,6 +2493,162 @@ static intptr_t lre_exec_backtrack(REExecContext *s, uint8_t **capture,
     }
 }
 
+/* A non sticky regexp starts with a '.*?' loop, so that
+   lre_exec_backtrack() tries the body at every position of the subject.
+   When the body can only start with a literal string or with a character
+   of a class, the candidate positions are searched with memchr() or a
+   table lookup instead and the body is only run from them. */
+
+/* split_goto_first, any and goto of the '.*?' loop */
+#define RE_SEARCH_LOOP_LEN 11
+#define RE_SEARCH_LITERAL_MAX 16
+/* the analysis does not pay off for shorter subjects */
+#define RE_SEARCH_MIN_LEN 16
+
+typedef struct {
+    int literal_len;
+    uint16_t literal[RE_SEARCH_LITERAL_MAX];
+    const uint8_t *range; /* REOP_range operands, used if literal_len = 0 */
+    uint32_t range_bitmap[8]; /* characters < 256 of 'range' */
+} RESearchInfo;
+
+static BOOL re_range_contains(const uint8_t *range, uint32_t c)
+{
+    uint32_t low, high;
+    int idx_min, idx_max, idx;
+
+    idx_min = 0;
+    idx_max = get_u16(range) - 1;
+    range += 2;
+    /* 0xffff in for last value means +infinity */
+    if (c >= 0xffff && get_u16(range + idx_max * 4 + 2) == 0xffff)
+        return TRUE;
+    while (idx_min <= idx_max) {
+        idx = (idx_min + idx_max) / 2;
+        low = get_u16(range + idx * 4);
+        high = get_u16(range + idx * 4 + 2);
+        if (c < low)
+            idx_max = idx - 1;
+        else if (c > high)
+            idx_min = idx + 1;
+        else
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* Return the start of the regexp body if its candidate positions can be
+   searched, otherwise NULL. */
+static const uint8_t *re_get_search_info(RESearchInfo *si,
+                                         const uint8_t *bc_buf, int cbuf_type)
+{
+    const uint8_t *pc, *body;
+    uint32_t val, low, high, i, n;
+
+    if (bc_buf[RE_HEADER_FLAGS] & (LRE_FLAG_STICKY | LRE_FLAG_IGNORECASE))
+        return NULL;
+    pc = bc_buf + RE_HEADER_LEN;
+    if (pc[0] != REOP_split_goto_first)
+        return NULL;
+    body = pc + RE_SEARCH_LOOP_LEN;
+    si->literal_len = 0;
+    si->range = NULL;
+    /* the leading opcodes are run without branching, so a match must
+       start with the characters they consume */
+    for(pc = body;;) {
+        switch(pc[0]) {
+        case REOP_save_start:
+        case REOP_save_end:
+        case REOP_save_reset:
+            pc += reopcode_info[pc[0]].size;
+            continue;
+        case REOP_char:
+            val = get_u16(pc + 1);
+            /* surrogates may be matched as pairs in unicode mode */
+            if (si->literal_len == RE_SEARCH_LITERAL_MAX ||
+                (val >= 0xd800 && val < 0xe000) ||
+                (cbuf_type == 0 && val > 0xff))
+                break;
+            si->literal[si->literal_len++] = val;
+            pc += 3;
+            continue;
+        case REOP_range:
+            /* in unicode mode the class may match a surrogate pair */
+            if (si->literal_len == 0 && cbuf_type != 2) {
+                si->range = pc + 1;
+                memset(si->range_bitmap, 0, sizeof(si->range_bitmap));
+                n = get_u16(si->range);
+                for(i = 0; i < n; i++) {
+                    low = get_u16(si->range + 2 + i * 4);
+                    high = get_u16(si->range + 2 + i * 4 + 2);
+                    for(val = low; val <= high && val < 256; val++)
+                        si->range_bitmap[val >> 5] |= 1U << (val & 31);
+                }
+            }
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+    if (si->literal_len == 0 && !si->range)
+        return NULL;
+    return body;
+}
+
+/* Return the first position >= cindex where the regexp body can match or
+   -1 if there is none. */
+static int re_search_next(const RESearchInfo *si, const uint8_t *cbuf,
+                          int cindex, int clen, int cbuf_type)
+{
+    const uint16_t *cbuf16 = (const uint16_t *)cbuf;
+    int i, n, last;
+    uint32_t c;
+
+    if (si->literal_len > 0) {
+        n = si->literal_len;
+        last = clen - n;
+        if (cbuf_type == 0) {
+            const uint8_t *p, *end;
+            p = cbuf + cindex;
+            end = cbuf + last + 1;
+            while (p < end) {
+                p = memchr(p, si->literal[0], end - p);
+                if (!p)
+                    break;
+                for(i = 1; i < n && p[i] == si->literal[i]; i++)
+                    continue;
+                if (i == n)
+                    return p - cbuf;
+                p++;
+            }
+        } else {
+            for(; cindex <= last; cindex++) {
+                if (cbuf16[cindex] != si->literal[0])
+                    continue;
+                for(i = 1; i < n && cbuf16[cindex + i] == si->literal[i]; i++)
+                    continue;
+                if (i == n)
+                    return cindex;
+            }
+        }
+    } else if (cbuf_type == 0) {
+        for(; cindex < clen; cindex++) {
+            c = cbuf[cindex];
+            if ((si->range_bitmap[c >> 5] >> (c & 31)) & 1)
+                return cindex;
+        }
+    } else {
+        for(; cindex < clen; cindex++) {
+            c = cbuf16[cindex];
+            if (c < 256 ? (si->range_bitmap[c >> 5] >> (c & 31)) & 1 :
+                re_range_contains(si->range, c))
+                return cindex;
+        }
+    }
+    return -1;
+}
+
 /* Return 1 if match, 0 if not match or -1 if error. cindex is the
    starting position of the match and must be such as 0 <= cindex <=
    clen. */
@@ -2503,6 +2659,8 @@ int lre_exec(uint8_t **capture,
     REExecContext s_s, *s = &s_s;
     int re_flags, i, alloca_size, ret;
     StackInt *stack_buf;
+    RESearchInfo si;
+    const uint8_t *body;
     
     re_flags = bc_buf[RE_HEADER_FLAGS];
     s->multi_line = (re_flags & LRE_FLAG_MULTILINE) != 0;
@@ -2528,8 +2686,30 @@ int lre_exec(uint8_t **capture,
         capture[i] = NULL;
     alloca_size = s->stack_size_max * sizeof(stack_buf[0]);
     stack_buf = alloca(alloca_size);
-    ret = lre_exec_backtrack(s, capture, stack_buf, 0, bc_buf + RE_HEADER_LEN,
-                             cbuf + (cindex << cbuf_type), FALSE);
+    body = NULL;
+    if (clen - cindex >= RE_SEARCH_MIN_LEN)
+        body = re_get_search_info(&si, bc_buf, s->cbuf_type);
+    if (body) {
+        /* same as running the '.*?' loop: the body is tried at each
+           candidate position with the captures reset */
+        for(;;) {
+            cindex = re_search_next(&si, cbuf, cindex, clen, cbuf_type);
+            if (cindex < 0) {
+                ret = 0;
+                break;
+            }
+            ret = lre_exec_backtrack(s, capture, stack_buf, 0, body,
+                                     cbuf + (cindex << cbuf_type), FALSE);
+            if (ret != 0)
+                break;
+            for(i = 0; i < s->capture_count * 2; i++)
+                capture[i] = NULL;
+            cindex++;
+        }
+    } else {
+        ret = lre_exec_backtrack(s, capture, stack_buf, 0, bc_buf + RE_HEADER_LEN,
+                                 cbuf + (cindex << cbuf_type), FALSE);
+    }
     lre_realloc(s->opaque, s->state_stack, 0);
     return ret;
 }
@@ -8,6 +8,7 @@
 #include "core/html/parser/html_parser.h"
 #include "core/page.h"
 #include "foundation/native_type.h"
+#include "foundation/trace_event.h"
 #include "include/dart_api.h"
 #include "multiple_threading/dispatcher.h"
 #include "multiple_threading/task.h"
@@ -82,6 +83,7 @@ void* allocateNewPageSync(double thread_identity, void* ptr) {
 void allocateNewPage(double thread_identity,
                      int32_t sync_buffer_size,
                      void* ptr,
+                     NativeHeapPolicy* heap_policy,
                      Dart_Handle dart_handle,
                      AllocateNewPageCallback result_callback) {
 #if ENABLE_LOG
@@ -90,9 +92,11 @@ void allocateNewPage(double thread_identity,
   auto* dart_isolate_context = (webf::DartIsolateContext*)ptr;
   assert(dart_isolate_context != nullptr);
   Dart_PersistentHandle persistent_handle = Dart_NewPersistentHandle_DL(dart_handle);
+  // The policy is owned by dart side, copy it before switching to the JS thread.
+  NativeHeapPolicy policy = heap_policy != nullptr ? *heap_policy : NativeHeapPolicy{};
 
   static_cast<webf::DartIsolateContext*>(dart_isolate_context)
-      ->AddNewPage(thread_identity, sync_buffer_size, persistent_handle, result_callback);
+      ->AddNewPage(thread_identity, sync_buffer_size, policy, persistent_handle, result_callback);
 #if ENABLE_LOG
   WEBF_LOG(INFO) << "[Dispatcher]: allocateNewPage Call END";
 #endif
@@ -263,6 +267,65 @@ void clearNativeProfileData(void* ptr) {
   dart_isolate_context->profiler()->clear();
 }
 
+void setNativeTracingEnabled(int8_t enabled) {
+  webf::TraceRecorder::SetEnabled(enabled == 1);
+}
+
+void collectNativeTraceData(const char** data, uint32_t* len) {
+  std::string result = webf::TraceRecorder::ToChromeTraceJSON();
+
+  *data = static_cast<const char*>(webf::dart_malloc(sizeof(char) * result.size() + 1));
+  memcpy((void*)*data, result.c_str(), sizeof(char) * result.size() + 1);
+  *len = result.size();
+}
+
+void clearNativeTraceData() {
+  webf::TraceRecorder::Clear();
+}
+
+void collectNativeMetrics(void* dart_isolate_context, void* page_, const char** data, uint32_t* len) {
+  auto* isolate_context = static_cast<webf::DartIsolateContext*>(dart_isolate_context);
+  std::string result = R"({"dispatcher":)" + isolate_context->dispatcher()->MetricsToJSON();
+  if (page_ != nullptr) {
+    auto page = reinterpret_cast<webf::WebFPage*>(page_);
+    result += R"(,"page":)" + page->executingContext()->metrics()->ToJSON();
+  }
+  result += "}";
+
+  *data = static_cast<const char*>(webf::dart_malloc(sizeof(char) * result.size() + 1));
+  memcpy((void*)*data, result.c_str(), sizeof(char) * result.size() + 1);
+  *len = result.size();
+}
+
+void resetNativeMetrics(void* dart_isolate_context, void* page_) {
+  auto* isolate_context = static_cast<webf::DartIsolateContext*>(dart_isolate_context);
+  isolate_context->dispatcher()->ResetMetrics();
+  if (page_ != nullptr) {
+    auto page = reinterpret_cast<webf::WebFPage*>(page_);
+    page->executingContext()->metrics()->Reset();
+  }
+}
+
+void startReplayRecording(void* page_,
+                          const char* path,
+                          Dart_Handle dart_handle,
+                          StartReplayRecordingCallback result_callback) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  Dart_PersistentHandle persistent_handle = Dart_NewPersistentHandle_DL(dart_handle);
+  // The recorder is used by the JS thread, swap it there. Waiting for it could deadlock while the JS thread waits for
+  // dart, so the path is copied for the task and the result is reported by the callback.
+  page->dartIsolateContext()->dispatcher()->PostToJs(page->isDedicated(), page->contextId(),
+                                                     webf::startReplayRecordingInternal, page_, strdup(path),
+                                                     persistent_handle, result_callback);
+}
+
+void stopReplayRecording(void* page_) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page) { page->executingContext()->StopReplayRecording(); }, page);
+}
+
 void dispatchUITask(void* page_, void* context, void* callback) {
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   reinterpret_cast<void (*)(void*)>(callback)(context);
@@ -286,6 +349,25 @@ int64_t getUICommandItemSize(void* page_) {
 void clearUICommandItems(void* page_) {
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   page->executingContext()->uiCommandBuffer()->clear();
+  // Dart side had consumed the commands of this frame, the JS thread is idle until the next event arrives. Without a
+  // dedicated thread the task would run inline in the frame, dart side calls scheduleIdleGC from an idle task instead.
+  if (page->isDedicated()) {
+    page->executingContext()->idleGCScheduler()->ScheduleIdleGC();
+  }
+}
+
+void scheduleIdleGC(void* page_) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->executingContext()->idleGCScheduler()->ScheduleIdleGC();
+}
+
+void markLayoutDirty(void* page_) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->executingContext()->layoutQueryCache()->MarkLayoutDirty();
+}
+
+void markWidgetElementDefined(void* dart_isolate_context) {
+  static_cast<webf::DartIsolateContext*>(dart_isolate_context)->EnsureData()->DidDefineWidgetElement();
 }
 
 // Callbacks when dart context object was finalized by Dart GC.
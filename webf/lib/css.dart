@@ -26,6 +26,7 @@ export 'src/css/css_rule.dart';
 export 'src/css/style_declaration.dart';
 export 'src/css/style_property.dart';
 export 'src/css/style_sheet.dart';
+export 'src/css/native_style_sheet.dart';
 export 'src/css/rule_set.dart';
 export 'src/css/parser/parser.dart';
 export 'src/css/text.dart';
@@ -56,6 +57,7 @@ export 'src/css/values/angle.dart';
 export 'src/css/values/color.dart';
 export 'src/css/values/function.dart';
 export 'src/css/values/length.dart';
+export 'src/css/values/native_value.dart';
 export 'src/css/values/number.dart';
 export 'src/css/values/integer.dart';
 export 'src/css/values/position.dart';
@@ -22,6 +22,7 @@ enum BindingMethodCallOperations {
   GetAllPropertyNames,
   AnonymousFunctionCall,
   AsyncAnonymousFunction,
+  GetLayoutProperties,
 }
 
 typedef NativeAsyncAnonymousFunctionCallback = Void Function(
@@ -36,7 +37,8 @@ List<BindingCallFunc> bindingCallMethodDispatchTable = [
   setterBindingCall,
   getPropertyNamesBindingCall,
   invokeBindingMethodSync,
-  invokeBindingMethodAsync
+  invokeBindingMethodAsync,
+  getLayoutPropertiesBindingCall
 ];
 
 // Dispatch the event to the binding side.
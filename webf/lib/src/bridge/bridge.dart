@@ -34,7 +34,8 @@ FutureOr<double> initBridge(WebFViewController view, WebFThread runningThread) a
   BindingBridge.setup();
 
   double newContextId = runningThread.identity();
-  await allocateNewPage(runningThread is FlutterUIThread, newContextId, runningThread.syncBufferSize());
+  await allocateNewPage(runningThread is FlutterUIThread, newContextId, runningThread.syncBufferSize(),
+      heapPolicy: runningThread.heapPolicy());
 
   return newContextId;
 }
@@ -17,6 +17,37 @@ abstract class WebFThread {
   /// However, this concurrency sometimes leads to inconsistent UI rendering results,
   /// so it's advisable to adjust this value based on specific use cases.
   int syncBufferSize();
+
+  /// The JS heap policy of the page, null keeps the default GC thresholds of the JS runtime.
+  JSHeapPolicy? heapPolicy() => null;
+}
+
+/// Tunes the garbage collector of the JS runtime that a page runs in.
+/// Pages running in the same thread share one JS runtime, so the last allocated page of a thread wins.
+/// Zero values keep the defaults of the JS runtime.
+class JSHeapPolicy {
+  /// Heap size in bytes which triggers the first automatic GC.
+  final int initialGCThreshold;
+
+  /// The next automatic GC triggers once the heap grows to (size after last GC) * [gcGrowthFactor].
+  final double gcGrowthFactor;
+
+  /// Hard limit of the JS heap in bytes, allocations beyond it throw an out of memory exception.
+  final int memoryLimit;
+
+  /// Time budget in microseconds for a collection running in the idle gap after a frame.
+  final int idleGCBudgetUs;
+
+  /// Called when the heap stays above 80% of [memoryLimit] after an idle collection.
+  final void Function(int mallocSize, int memoryLimit)? onMemoryPressure;
+
+  const JSHeapPolicy({
+    this.initialGCThreshold = 0,
+    this.gcGrowthFactor = 0,
+    this.memoryLimit = 0,
+    this.idleGCBudgetUs = 0,
+    this.onMemoryPressure,
+  });
 }
 
 /// Executes your JavaScript code within the Flutter UI thread.
@@ -38,15 +69,23 @@ class FlutterUIThread extends WebFThread {
 class DedicatedThread extends WebFThread {
   double? _identity;
   final int _syncBufferSize;
+  final JSHeapPolicy? _heapPolicy;
 
-  DedicatedThread({ int syncBufferSize = 4 }): _syncBufferSize = syncBufferSize;
-  DedicatedThread._(this._identity, { int syncBufferSize = 4 }): _syncBufferSize = syncBufferSize;
+  DedicatedThread({ int syncBufferSize = 4, JSHeapPolicy? heapPolicy })
+      : _syncBufferSize = syncBufferSize, _heapPolicy = heapPolicy;
+  DedicatedThread._(this._identity, { int syncBufferSize = 4, JSHeapPolicy? heapPolicy })
+      : _syncBufferSize = syncBufferSize, _heapPolicy = heapPolicy;
 
   @override
   int syncBufferSize() {
     return _syncBufferSize;
   }
 
+  @override
+  JSHeapPolicy? heapPolicy() {
+    return _heapPolicy;
+  }
+
   @override
   double identity() {
     return _identity ?? (newPageId()).toDouble();
@@ -60,8 +99,8 @@ class DedicatedThreadGroup {
 
   DedicatedThreadGroup();
 
-  DedicatedThread slave({ int syncBufferSize = 4 }) {
+  DedicatedThread slave({ int syncBufferSize = 4, JSHeapPolicy? heapPolicy }) {
     String input = '$_identity.${_slaveCount++}';
-    return DedicatedThread._(double.parse(input), syncBufferSize: syncBufferSize);
+    return DedicatedThread._(double.parse(input), syncBufferSize: syncBufferSize, heapPolicy: heapPolicy);
   }
 }
@@ -148,3 +148,17 @@ class NativePerformanceEntryList extends Struct {
   @Int32()
   external int length;
 }
+
+typedef NativeMemoryPressureCallback = Void Function(Double contextId, Int64 mallocSize, Int64 memoryLimit);
+
+class NativeHeapPolicy extends Struct {
+  @Int64()
+  external int initial_gc_threshold;
+  @Double()
+  external double gc_growth_factor;
+  @Int64()
+  external int memory_limit;
+  @Int64()
+  external int idle_gc_budget_us;
+  external Pointer<NativeFunction<NativeMemoryPressureCallback>> memory_pressure_callback;
+}
@@ -541,6 +541,8 @@ class _DisposePageContext {
 
 FutureOr<void> disposePage(bool isSync, double contextId) async {
   Pointer<Void> page = _allocatedPages[contextId]!;
+  disposeInternedUICommandStrings(contextId);
+  _heapPolicies.remove(contextId);
 
   if (isSync) {
     _disposePageSync(contextId, dartContext!.pointer, page);
@@ -567,10 +569,10 @@ int newPageId() {
 typedef NativeAllocateNewPageSync = Pointer<Void> Function(Double, Pointer<Void>);
 typedef DartAllocateNewPageSync = Pointer<Void> Function(double, Pointer<Void>);
 typedef HandleAllocateNewPageResult = Void Function(Handle object, Pointer<Void> page);
-typedef NativeAllocateNewPage = Void Function(
-    Double, Int32, Pointer<Void>, Handle object, Pointer<NativeFunction<HandleAllocateNewPageResult>> handle_result);
-typedef DartAllocateNewPage = void Function(
-    double, int, Pointer<Void>, Object object, Pointer<NativeFunction<HandleAllocateNewPageResult>> handle_result);
+typedef NativeAllocateNewPage = Void Function(Double, Int32, Pointer<Void>, Pointer<NativeHeapPolicy> heapPolicy,
+    Handle object, Pointer<NativeFunction<HandleAllocateNewPageResult>> handle_result);
+typedef DartAllocateNewPage = void Function(double, int, Pointer<Void>, Pointer<NativeHeapPolicy> heapPolicy,
+    Object object, Pointer<NativeFunction<HandleAllocateNewPageResult>> handle_result);
 
 final DartAllocateNewPageSync _allocateNewPageSync =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeAllocateNewPageSync>>('allocateNewPageSync').asFunction();
@@ -591,14 +593,41 @@ class _AllocateNewPageContext {
   _AllocateNewPageContext(this.completer, this.contextId);
 }
 
-Future<void> allocateNewPage(bool sync, double newContextId, int syncBufferSize) async {
+final Map<double, JSHeapPolicy> _heapPolicies = {};
+
+void _handleMemoryPressure(double contextId, int mallocSize, int memoryLimit) {
+  _heapPolicies[contextId]?.onMemoryPressure?.call(mallocSize, memoryLimit);
+}
+
+Pointer<NativeHeapPolicy> _allocateNativeHeapPolicy(double contextId, JSHeapPolicy? heapPolicy) {
+  if (heapPolicy == null) return nullptr;
+
+  Pointer<NativeHeapPolicy> nativePolicy = malloc.allocate(sizeOf<NativeHeapPolicy>());
+  nativePolicy.ref.initial_gc_threshold = heapPolicy.initialGCThreshold;
+  nativePolicy.ref.gc_growth_factor = heapPolicy.gcGrowthFactor;
+  nativePolicy.ref.memory_limit = heapPolicy.memoryLimit;
+  nativePolicy.ref.idle_gc_budget_us = heapPolicy.idleGCBudgetUs;
+  if (heapPolicy.onMemoryPressure != null) {
+    _heapPolicies[contextId] = heapPolicy;
+    nativePolicy.ref.memory_pressure_callback = Pointer.fromFunction(_handleMemoryPressure);
+  } else {
+    nativePolicy.ref.memory_pressure_callback = nullptr;
+  }
+  return nativePolicy;
+}
+
+Future<void> allocateNewPage(bool sync, double newContextId, int syncBufferSize, {JSHeapPolicy? heapPolicy}) async {
   await waitingSyncTaskComplete(newContextId);
 
   if (!sync) {
     Completer<void> completer = Completer();
     _AllocateNewPageContext context = _AllocateNewPageContext(completer, newContextId);
     Pointer<NativeFunction<HandleAllocateNewPageResult>> f = Pointer.fromFunction(_handleAllocateNewPageResult);
-    _allocateNewPage(newContextId, syncBufferSize, dartContext!.pointer, context, f);
+    // A null policy keeps the default GC thresholds of the JS runtime.
+    Pointer<NativeHeapPolicy> nativePolicy = _allocateNativeHeapPolicy(newContextId, heapPolicy);
+    _allocateNewPage(newContextId, syncBufferSize, dartContext!.pointer, nativePolicy, context, f);
+    // The policy had been copied by the C++ side before switching to the JS thread.
+    if (nativePolicy != nullptr) malloc.free(nativePolicy);
     return completer.future;
   } else {
     Pointer<Void> page = _allocateNewPageSync(newContextId, dartContext!.pointer);
@@ -670,6 +699,127 @@ void clearNativeProfileData() {
   _clearNativeProfileData(dartContext!.pointer);
 }
 
+typedef NativeSetNativeTracingEnabled = Void Function(Int8 enabled);
+typedef DartSetNativeTracingEnabled = void Function(int enabled);
+
+final DartSetNativeTracingEnabled _setNativeTracingEnabled = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetNativeTracingEnabled>>('setNativeTracingEnabled')
+    .asFunction();
+
+void setNativeTracingEnabled(bool enabled) {
+  _setNativeTracingEnabled(enabled ? 1 : 0);
+}
+
+typedef NativeCollectNativeTraceData = Void Function(Pointer<Pointer<Utf8>> data, Pointer<Uint32> len);
+typedef DartCollectNativeTraceData = void Function(Pointer<Pointer<Utf8>> data, Pointer<Uint32> len);
+
+final DartCollectNativeTraceData _collectNativeTraceData = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeCollectNativeTraceData>>('collectNativeTraceData')
+    .asFunction();
+
+// Returns the native trace events in Chrome Trace Event format, which can be opened by Perfetto UI.
+String collectNativeTraceData() {
+  Pointer<Pointer<Utf8>> string = malloc.allocate(sizeOf<Pointer>());
+  Pointer<Uint32> len = malloc.allocate(sizeOf<Pointer>());
+
+  _collectNativeTraceData(string, len);
+
+  String result = string.value.toDartString(length: len.value);
+  malloc.free(string.value);
+  malloc.free(string);
+  malloc.free(len);
+  return result;
+}
+
+typedef NativeClearNativeTraceData = Void Function();
+typedef DartClearNativeTraceData = void Function();
+
+final DartClearNativeTraceData _clearNativeTraceData = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeClearNativeTraceData>>('clearNativeTraceData')
+    .asFunction();
+
+void clearNativeTraceData() {
+  _clearNativeTraceData();
+}
+
+typedef NativeCollectNativeMetrics = Void Function(
+    Pointer<Void> dartContext, Pointer<Void> page, Pointer<Pointer<Utf8>> data, Pointer<Uint32> len);
+typedef DartCollectNativeMetrics = void Function(
+    Pointer<Void> dartContext, Pointer<Void> page, Pointer<Pointer<Utf8>> data, Pointer<Uint32> len);
+
+final DartCollectNativeMetrics _collectNativeMetrics = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeCollectNativeMetrics>>('collectNativeMetrics')
+    .asFunction();
+
+// Returns the counters and latency histograms of the bridge as JSON, page metrics are included when contextId is given.
+String collectNativeMetrics([double? contextId]) {
+  Pointer<Pointer<Utf8>> string = malloc.allocate(sizeOf<Pointer>());
+  Pointer<Uint32> len = malloc.allocate(sizeOf<Pointer>());
+  Pointer<Void> page = contextId != null ? (getAllocatedPage(contextId) ?? nullptr) : nullptr;
+
+  _collectNativeMetrics(dartContext!.pointer, page, string, len);
+
+  String result = string.value.toDartString(length: len.value);
+  malloc.free(string.value);
+  malloc.free(string);
+  malloc.free(len);
+  return result;
+}
+
+typedef NativeResetNativeMetrics = Void Function(Pointer<Void> dartContext, Pointer<Void> page);
+typedef DartResetNativeMetrics = void Function(Pointer<Void> dartContext, Pointer<Void> page);
+
+final DartResetNativeMetrics _resetNativeMetrics = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeResetNativeMetrics>>('resetNativeMetrics')
+    .asFunction();
+
+void resetNativeMetrics([double? contextId]) {
+  Pointer<Void> page = contextId != null ? (getAllocatedPage(contextId) ?? nullptr) : nullptr;
+  _resetNativeMetrics(dartContext!.pointer, page);
+}
+
+typedef NativeStartReplayRecordingCallback = Void Function(Handle context, Int8 result);
+typedef NativeStartReplayRecording = Void Function(Pointer<Void> page, Pointer<Utf8> path, Handle context,
+    Pointer<NativeFunction<NativeStartReplayRecordingCallback>> resultCallback);
+typedef DartStartReplayRecording = void Function(Pointer<Void> page, Pointer<Utf8> path, Object context,
+    Pointer<NativeFunction<NativeStartReplayRecordingCallback>> resultCallback);
+
+final DartStartReplayRecording _startReplayRecording = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeStartReplayRecording>>('startReplayRecording')
+    .asFunction();
+
+void _handleStartReplayRecordingResult(Completer<bool> completer, int result) {
+  completer.complete(result == 1);
+}
+
+// Records the scripts, events, timers, animation frames and module results the page receives into a trace file, the
+// trace could be replayed with `webf_replay` without flutter. Call it right after the page is allocated.
+Future<bool> startReplayRecording(double contextId, String path) {
+  Pointer<Void>? page = getAllocatedPage(contextId);
+  if (page == null) return Future.value(false);
+  Completer<bool> completer = Completer();
+  Pointer<NativeFunction<NativeStartReplayRecordingCallback>> resultCallback =
+      Pointer.fromFunction(_handleStartReplayRecordingResult);
+  // Native side copies the path before the recorder is swapped at the JS thread.
+  Pointer<Utf8> nativePath = path.toNativeUtf8();
+  _startReplayRecording(page, nativePath, completer, resultCallback);
+  malloc.free(nativePath);
+  return completer.future;
+}
+
+typedef NativeStopReplayRecording = Void Function(Pointer<Void> page);
+typedef DartStopReplayRecording = void Function(Pointer<Void> page);
+
+final DartStopReplayRecording _stopReplayRecording = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeStopReplayRecording>>('stopReplayRecording')
+    .asFunction();
+
+void stopReplayRecording(double contextId) {
+  Pointer<Void>? page = getAllocatedPage(contextId);
+  if (page == null) return;
+  _stopReplayRecording(page);
+}
+
 enum UICommandType {
   startRecordingCommand,
   createElement,
@@ -691,6 +841,9 @@ enum UICommandType {
   // perf optimize
   createSVGElement,
   createElementNS,
+  setProperty,
+  styleDirtyRoots,
+  setStyleSheet,
   finishRecordingCommand,
 }
 
@@ -733,6 +886,32 @@ typedef DartClearUICommandItems = void Function(Pointer<Void>);
 final DartClearUICommandItems _clearUICommandItems =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeClearUICommandItems>>('clearUICommandItems').asFunction();
 
+typedef NativeMarkLayoutDirty = Void Function(Pointer<Void>);
+typedef DartMarkLayoutDirty = void Function(Pointer<Void>);
+
+final DartMarkLayoutDirty _markLayoutDirty =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeMarkLayoutDirty>>('markLayoutDirty').asFunction();
+
+// Drop the layout results cached at native side, should be called after each layout pass.
+void markLayoutDirty(double contextId) {
+  Pointer<Void>? page = _allocatedPages[contextId];
+  if (page == null) return;
+  _markLayoutDirty(page);
+}
+
+typedef NativeMarkWidgetElementDefined = Void Function(Pointer<Void>);
+typedef DartMarkWidgetElementDefined = void Function(Pointer<Void>);
+
+final DartMarkWidgetElementDefined _markWidgetElementDefined = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeMarkWidgetElementDefined>>('markWidgetElementDefined')
+    .asFunction();
+
+// Let native side ask the shape of the widget element tags which had none again.
+void markWidgetElementDefined() {
+  if (dartContext == null) return;
+  _markWidgetElementDefined(dartContext!.pointer);
+}
+
 typedef NativeIsJSThreadBlocked = Int8 Function(Pointer<Void>, Double);
 typedef DartIsJSThreadBlocked = int Function(Pointer<Void>, double);
 
@@ -743,10 +922,31 @@ bool isJSThreadBlocked(double contextId) {
   return _isJSThreadBlocked(dartContext!.pointer, contextId) == 1;
 }
 
+typedef NativeScheduleIdleGC = Void Function(Pointer<Void>);
+typedef DartScheduleIdleGC = void Function(Pointer<Void>);
+
+final DartScheduleIdleGC _scheduleIdleGC =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeScheduleIdleGC>>('scheduleIdleGC').asFunction();
+
+final Set<double> _idleGCScheduledPages = {};
+
+// A page running JS in the flutter UI thread schedules its idle GC itself, it would otherwise run inline in the middle
+// of the frame which cleared the UI commands.
+void _scheduleIdleGCAfterFrame(double contextId) {
+  if (isJSRunningInDedicatedThread(contextId) || !_idleGCScheduledPages.add(contextId)) return;
+  SchedulerBinding.instance.scheduleTask(() {
+    _idleGCScheduledPages.remove(contextId);
+    Pointer<Void>? page = _allocatedPages[contextId];
+    if (page == null) return;
+    _scheduleIdleGC(page);
+  }, Priority.idle);
+}
+
 void clearUICommand(double contextId) {
   assert(_allocatedPages.containsKey(contextId));
 
   _clearUICommandItems(_allocatedPages[contextId]!);
+  _scheduleIdleGCAfterFrame(contextId);
 }
 
 void flushUICommandWithContextId(double contextId, Pointer<NativeBindingObject> selfPointer) {
@@ -763,25 +963,41 @@ class _NativeCommandData {
 
   int length;
   int kindFlag;
-  List<int> rawMemory;
+  List<UICommand> commands;
 
-  _NativeCommandData(this.kindFlag, this.length, this.rawMemory);
+  _NativeCommandData(this.kindFlag, this.length, this.commands);
 }
 
+// Layout of the header of UICommandChunk in bridge/foundation/ui_command_buffer.h, in Int64 words.
+// The next pointer is padded to one Int64 word but is only pointer sized, it must be read as IntPtr.
+const int _uiCommandChunkNextOffset = 0;
+const int _uiCommandChunkSizeOffset = 1;
+const int _uiCommandChunkHeaderSize = 3;
+
 _NativeCommandData readNativeUICommandMemory(double contextId) {
-  Pointer<Uint64> nativeCommandItemPointer = _getUICommandItems(_allocatedPages[contextId]!);
+  Pointer<Uint64> nativeCommandChunkPointer = _getUICommandItems(_allocatedPages[contextId]!);
   int flag = _getUICommandKindFlags(_allocatedPages[contextId]!);
   int commandLength = _getUICommandItemSize(_allocatedPages[contextId]!);
 
-  if (commandLength == 0 || nativeCommandItemPointer == nullptr) {
+  if (commandLength == 0 || nativeCommandChunkPointer == nullptr) {
     return _NativeCommandData.empty();
   }
 
-  List<int> rawMemory =
-      nativeCommandItemPointer.cast<Int64>().asTypedList((commandLength) * nativeCommandSize).toList(growable: false);
+  // Decode the commands in place chunk by chunk, the chunks are recycled by native side after clear.
+  List<UICommand> commands = [];
+  Pointer<Int64> chunk = nativeCommandChunkPointer.cast<Int64>();
+  int readLength = 0;
+  while (readLength < commandLength) {
+    int chunkLength = chunk[_uiCommandChunkSizeOffset];
+    List<int> rawMemory = chunk.elementAt(_uiCommandChunkHeaderSize).asTypedList(chunkLength * nativeCommandSize);
+    commands.addAll(nativeUICommandToDart(rawMemory, chunkLength, contextId));
+    readLength += chunkLength;
+    chunk = Pointer.fromAddress(chunk.elementAt(_uiCommandChunkNextOffset).cast<IntPtr>().value);
+  }
   _clearUICommandItems(_allocatedPages[contextId]!);
+  _scheduleIdleGCAfterFrame(contextId);
 
-  return _NativeCommandData(flag, commandLength, rawMemory);
+  return _NativeCommandData(flag, commandLength, commands);
 }
 
 void flushUICommand(WebFViewController view, Pointer<NativeBindingObject> selfPointer) {
@@ -799,16 +1015,10 @@ void flushUICommand(WebFViewController view, Pointer<NativeBindingObject> selfPo
     WebFProfiler.instance.finishTrackUICommandStep();
   }
 
-  List<UICommand>? commands;
-  if (rawCommands.rawMemory.isNotEmpty) {
-    if (enableWebFProfileTracking) {
-      WebFProfiler.instance.startTrackUICommandStep('nativeUICommandToDart');
-    }
-
-    commands = nativeUICommandToDart(rawCommands.rawMemory, rawCommands.length, view.contextId);
+  if (rawCommands.commands.isNotEmpty) {
+    List<UICommand> commands = rawCommands.commands;
 
     if (enableWebFProfileTracking) {
-      WebFProfiler.instance.finishTrackUICommandStep();
       WebFProfiler.instance.startTrackUICommandStep('execUICommands');
     }
 
@@ -16,6 +16,8 @@ class UICommand {
   late final String args;
   late final Pointer nativePtr;
   late final Pointer nativePtr2;
+  // The typed operand of the command, see UICommandItem::immediate in bridge/foundation/ui_command_buffer.h.
+  int immediate = 0;
 
   UICommand();
   UICommand.from(this.type, this.args, this.nativePtr, this.nativePtr2);
@@ -32,12 +34,25 @@ class UICommand {
 //   const uint16_t *string_01;// offset: 1
 //   void* nativePtr;          // offset: 2
 //   void* nativePtr2;         // offset: 3
+//   int64_t immediate;        // offset: 4
 // };
-const int nativeCommandSize = 4;
+const int nativeCommandSize = 5;
 const int typeAndArgs01LenMemOffset = 0;
 const int args01StringMemOffset = 1;
 const int nativePtrMemOffset = 2;
 const int native2PtrMemOffset = 3;
+const int immediateMemOffset = 4;
+
+// Indexed by InsertAdjacentPosition in bridge/foundation/ui_command_buffer.h.
+const List<String> _insertAdjacentPositions = ['beforebegin', 'afterbegin', 'beforeend', 'afterend'];
+
+// The strings interned by SharedUICommand::InternString for each page. The string of an id is only sent with the
+// first command using the id.
+final Map<double, Map<int, String>> _internedUICommandStrings = {};
+
+void disposeInternedUICommandStrings(double contextId) {
+  _internedUICommandStrings.remove(contextId);
+}
 
 const int commandBufferPrefix = 1;
 
@@ -63,14 +78,33 @@ List<UICommand> nativeUICommandToDart(List<int> rawMemory, int commandLength, do
     command.type = UICommandType.values[type];
 
     int args01StringMemory = rawMemory[i + args01StringMemOffset];
+    String args = '';
     if (args01StringMemory != 0) {
       Pointer<Uint16> args_01 = Pointer.fromAddress(args01StringMemory);
-      command.args = uint16ToString(args_01, args01Length);
+      args = uint16ToString(args_01, args01Length);
       malloc.free(args_01);
-    } else {
-      command.args = '';
     }
 
+    int immediate = rawMemory[i + immediateMemOffset];
+    switch (command.type) {
+      case UICommandType.insertAdjacentNode:
+        args = _insertAdjacentPositions[immediate];
+        break;
+      case UICommandType.addEvent:
+      case UICommandType.removeEvent:
+        Map<int, String> strings = _internedUICommandStrings.putIfAbsent(contextId, () => {});
+        if (args01StringMemory != 0) {
+          strings[immediate] = args;
+        } else {
+          args = strings[immediate]!;
+        }
+        break;
+      default:
+        break;
+    }
+    command.args = args;
+    command.immediate = immediate;
+
     int nativePtrValue = rawMemory[i + nativePtrMemOffset];
     command.nativePtr = nativePtrValue != 0 ? Pointer.fromAddress(rawMemory[i + nativePtrMemOffset]) : nullptr;
 
@@ -243,7 +277,7 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
           } else {
             value = '';
           }
-          view.setInlineStyle(nativePtr, command.args, value);
+          view.setInlineStyle(nativePtr, command.args, value, nativeValue: command.immediate);
           pendingStylePropertiesTargets[nativePtr.address] = true;
           if (enableWebFProfileTracking) {
             WebFProfiler.instance.finishTrackUICommandStep();
@@ -312,6 +346,47 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
             WebFProfiler.instance.finishTrackUICommandStep();
           }
           break;
+        case UICommandType.setProperty:
+          if (enableWebFProfileTracking) {
+            WebFProfiler.instance.startTrackUICommandStep('FlushUICommand.setProperty');
+          }
+          Pointer<NativeValue> nativeValue = command.nativePtr2.cast<NativeValue>();
+          dynamic value = fromNativeValue(view, nativeValue);
+          malloc.free(nativeValue);
+          view.setBindingProperty(nativePtr.cast<NativeBindingObject>(), command.args, value);
+          if (enableWebFProfileTracking) {
+            WebFProfiler.instance.finishTrackUICommandStep();
+          }
+          break;
+        case UICommandType.styleDirtyRoots:
+          if (enableWebFProfileTracking) {
+            WebFProfiler.instance.startTrackUICommandStep('FlushUICommand.styleDirtyRoots');
+          }
+          // The count followed by the pointers of the topmost elements whose style changed in this batch.
+          // Elements created later in this batch are resolved when the roots are recalculated.
+          Pointer<Int64> roots = command.nativePtr2.cast<Int64>();
+          int length = roots[0];
+          for (int i = 1; i <= length; i++) {
+            view.document.markStyleDirtyRoot(roots[i]);
+          }
+          malloc.free(roots);
+          if (enableWebFProfileTracking) {
+            WebFProfiler.instance.finishTrackUICommandStep();
+          }
+          break;
+        case UICommandType.setStyleSheet:
+          if (enableWebFProfileTracking) {
+            WebFProfiler.instance.startTrackUICommandStep('FlushUICommand.setStyleSheet');
+          }
+          Pointer<Uint32> ruleSet = command.nativePtr2.cast<Uint32>();
+          view.setStyleSheet(nativePtr.cast<NativeBindingObject>(), ruleSet);
+          if (ruleSet != nullptr) {
+            malloc.free(ruleSet);
+          }
+          if (enableWebFProfileTracking) {
+            WebFProfiler.instance.finishTrackUICommandStep();
+          }
+          break;
         default:
           break;
       }
@@ -341,6 +416,8 @@ void execUICommands(WebFViewController view, List<UICommand> commands) {
     WebFProfiler.instance.startTrackUICommandStep('FlushUICommand.recalculateStyle');
   }
 
+  view.document.recalculateStyleDirtyRoots();
+
   if (enableWebFProfileTracking) {
     WebFProfiler.instance.finishTrackUICommandStep();
   }
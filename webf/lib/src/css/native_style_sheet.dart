@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'package:webf/css.dart';
+
+// Builds the rules from the rule set parsed by CSSParser in bridge/core/css/parser/css_parser.h, the layout and the
+// values below should be kept in sync with the enums there.
+const int _styleRule = 1;
+const int _keyframesRule = 2;
+const int _fontFaceRule = 3;
+
+const int _headerSize = 3;
+
+// Indexed by CSSCombinator.
+const List<int> _combinators = [
+  TokenKind.COMBINATOR_NONE,
+  TokenKind.COMBINATOR_DESCENDANT,
+  TokenKind.COMBINATOR_PLUS,
+  TokenKind.COMBINATOR_GREATER,
+  TokenKind.COMBINATOR_TILDE,
+];
+
+// Indexed by CSSAttributeMatch.
+const List<int> _attributeMatches = [
+  TokenKind.NO_MATCH,
+  TokenKind.EQUALS,
+  TokenKind.INCLUDES,
+  TokenKind.DASH_MATCH,
+  TokenKind.PREFIX_MATCH,
+  TokenKind.SUFFIX_MATCH,
+  TokenKind.SUBSTRING_MATCH,
+];
+
+// Indexed by CSSKeyframesPrefix.
+const List<int> _keyframesDirectives = [
+  TokenKind.DIRECTIVE_KEYFRAMES,
+  TokenKind.DIRECTIVE_WEB_KIT_KEYFRAMES,
+  TokenKind.DIRECTIVE_MOZ_KEYFRAMES,
+  TokenKind.DIRECTIVE_O_KEYFRAMES,
+  TokenKind.DIRECTIVE_MS_KEYFRAMES,
+];
+
+// CSSSimpleSelectorKind.
+enum _SimpleSelectorKind {
+  element,
+  universal,
+  id,
+  className,
+  attribute,
+  pseudoClass,
+  pseudoElement,
+  pseudoClassFunction,
+  pseudoElementFunction,
+  negation,
+}
+
+// CSSAttributeValueKind.
+const int _attributeValueIdentifier = 1;
+const int _attributeValueString = 2;
+
+/// Reads the rules of the rule set, the memory is owned by the caller and not referred after the call.
+List<CSSRule> decodeNativeCSSRules(Pointer<Uint32> ruleSet) {
+  Uint32List words = ruleSet.asTypedList(ruleSet[0]);
+  return _NativeRuleSetReader(words).readRules();
+}
+
+class _NativeRuleSetReader {
+  final Uint32List _words;
+  final List<String> _strings;
+  int _index = _headerSize;
+
+  _NativeRuleSetReader(this._words) : _strings = _readStrings(_words);
+
+  static List<String> _readStrings(Uint32List words) {
+    int table = words[1];
+    int count = words[table];
+    int charactersOffset = table + 1 + count * 2;
+    Uint16List characters = words.buffer
+        .asUint16List(words.offsetInBytes + charactersOffset * 4, (words.length - charactersOffset) * 2);
+    return List.generate(count, (int i) {
+      int start = words[table + 1 + i * 2];
+      int length = words[table + 2 + i * 2];
+      return String.fromCharCodes(characters, start, start + length);
+    }, growable: false);
+  }
+
+  int _read() => _words[_index++];
+
+  String _readString() => _strings[_read()];
+
+  List<CSSRule> readRules() {
+    int count = _words[2];
+    List<CSSRule> rules = [];
+    for (int i = 0; i < count; i++) {
+      switch (_read()) {
+        case _styleRule:
+          SelectorGroup selectorGroup = _readSelectorGroup();
+          rules.add(CSSStyleRule(selectorGroup, _readDeclarations()));
+          break;
+        case _keyframesRule:
+          rules.add(_readKeyframes());
+          break;
+        case _fontFaceRule:
+          rules.add(CSSFontFaceRule(_readDeclarations()));
+          break;
+      }
+    }
+    return rules;
+  }
+
+  SelectorGroup _readSelectorGroup() {
+    int count = _read();
+    List<Selector> selectors = [];
+    for (int i = 0; i < count; i++) {
+      int sequenceCount = _read();
+      List<SimpleSelectorSequence> sequences = [];
+      for (int j = 0; j < sequenceCount; j++) {
+        int combinator = _combinators[_read()];
+        sequences.add(SimpleSelectorSequence(_readSimpleSelector(), combinator));
+      }
+      selectors.add(Selector(sequences));
+    }
+    return SelectorGroup(selectors);
+  }
+
+  SimpleSelector _readSimpleSelector() {
+    switch (_SimpleSelectorKind.values[_read()]) {
+      case _SimpleSelectorKind.element:
+        return ElementSelector(Identifier(_readString()));
+      case _SimpleSelectorKind.universal:
+        return ElementSelector(Wildcard());
+      case _SimpleSelectorKind.id:
+        return IdSelector(Identifier(_readString()));
+      case _SimpleSelectorKind.className:
+        return ClassSelector(Identifier(_readString()));
+      case _SimpleSelectorKind.attribute:
+        Identifier attributeName = Identifier(_readString());
+        int match = _attributeMatches[_read()];
+        int valueKind = _read();
+        int value = _read();
+        dynamic attributeValue;
+        if (valueKind == _attributeValueIdentifier) {
+          attributeValue = Identifier(_strings[value]);
+        } else if (valueKind == _attributeValueString) {
+          attributeValue = _strings[value];
+        }
+        return AttributeSelector(attributeName, match, attributeValue);
+      case _SimpleSelectorKind.pseudoClass:
+        return PseudoClassSelector(Identifier(_readString()));
+      case _SimpleSelectorKind.pseudoElement:
+        Identifier pseudoName = Identifier(_readString());
+        return PseudoElementSelector(pseudoName, isLegacy: _read() == 1);
+      case _SimpleSelectorKind.pseudoClassFunction:
+        Identifier functionName = Identifier(_readString());
+        return PseudoClassFunctionSelector(functionName, _readStringList());
+      case _SimpleSelectorKind.pseudoElementFunction:
+        Identifier elementFunctionName = Identifier(_readString());
+        return PseudoElementFunctionSelector(elementFunctionName, _readStringList());
+      case _SimpleSelectorKind.negation:
+      default:
+        return NegationSelector(_readSimpleSelector());
+    }
+  }
+
+  List<String> _readStringList() {
+    int count = _read();
+    return List.generate(count, (_) => _readString());
+  }
+
+  CSSStyleDeclaration _readDeclarations() {
+    CSSStyleDeclaration declaration = CSSStyleDeclaration();
+    int count = _read();
+    for (int i = 0; i < count; i++) {
+      String property = _readString();
+      String value = _readString();
+      bool isImportant = _read() == 1;
+      declaration.setProperty(property, value, isImportant: isImportant);
+    }
+    return declaration;
+  }
+
+  CSSKeyframesRule _readKeyframes() {
+    int directive = _keyframesDirectives[_read()];
+    CSSKeyframesRule keyframes = CSSKeyframesRule(directive, _readString());
+    int blockCount = _read();
+    for (int i = 0; i < blockCount; i++) {
+      List<String> selectors = _readStringList();
+      CSSStyleDeclaration declarations = _readDeclarations();
+      if (selectors.isNotEmpty) {
+        keyframes.add(KeyFrameBlock(selectors, declarations));
+      }
+    }
+    return keyframes;
+  }
+}
@@ -263,6 +263,17 @@ class CSSRenderStyle extends RenderStyle
   @override
   CSSRenderStyle? parent;
 
+  // The values of the inline style parsed by the bridge, keyed by the property name.
+  Map<String, CSSNativeValue>? _nativeValues;
+
+  void setNativeValue(String propertyName, CSSNativeValue? nativeValue) {
+    if (nativeValue != null) {
+      (_nativeValues ??= {})[propertyName] = nativeValue;
+    } else {
+      _nativeValues?.remove(propertyName);
+    }
+  }
+
   @override
   getProperty(String name) {
     switch (name) {
@@ -844,8 +855,14 @@ class CSSRenderStyle extends RenderStyle
       propertyValue = CSSInitialValues[propertyName] ?? propertyValue;
     }
 
+    // Use the value parsed by the bridge if the inline style is still the value.
+    CSSNativeValue? nativeValue = _nativeValues?[propertyName];
+    dynamic value = nativeValue != null && nativeValue.text == propertyValue
+        ? nativeValue.resolve(renderStyle, propertyName)
+        : null;
+
     // Process CSSVariable.
-    dynamic value = CSSVariable.tryParse(renderStyle, propertyValue);
+    value ??= CSSVariable.tryParse(renderStyle, propertyValue);
     if (value != null) {
       if (enableWebFProfileTracking) {
         WebFProfiler.instance.finishTrackUICommandStep();
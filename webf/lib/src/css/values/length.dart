@@ -695,6 +695,70 @@ class CSSLength {
       value = double.tryParse(text);
     }
 
+    return _createLength(value, unit, renderStyle, propertyName, axisType);
+  }
+
+  // The same as [parseLength] for the length parsed by the bridge, see [CSSNativeValue].
+  static CSSLengthValue parseNativeLength(
+      double value, CSSNativeLengthUnit unit, RenderStyle renderStyle, String propertyName) {
+    CSSLengthType type = CSSLengthType.PX;
+    switch (unit) {
+      case CSSNativeLengthUnit.px:
+        break;
+      case CSSNativeLengthUnit.em:
+        type = CSSLengthType.EM;
+        break;
+      case CSSNativeLengthUnit.rem:
+        type = CSSLengthType.REM;
+        break;
+      case CSSNativeLengthUnit.rpx:
+        FlutterView? window = renderStyle.currentFlutterView;
+        if (window != null) value = value / 750.0 * window.physicalSize.width / window.devicePixelRatio;
+        break;
+      case CSSNativeLengthUnit.vw:
+        value = value / 100;
+        type = CSSLengthType.VW;
+        break;
+      case CSSNativeLengthUnit.vh:
+        value = value / 100;
+        type = CSSLengthType.VH;
+        break;
+      case CSSNativeLengthUnit.vmin:
+        value = value / 100;
+        type = CSSLengthType.VMIN;
+        break;
+      case CSSNativeLengthUnit.vmax:
+        value = value / 100;
+        type = CSSLengthType.VMAX;
+        break;
+      case CSSNativeLengthUnit.cm:
+        value = value * _1cm;
+        break;
+      case CSSNativeLengthUnit.mm:
+        value = value * _1mm;
+        break;
+      case CSSNativeLengthUnit.inch:
+        value = value * _1in;
+        break;
+      case CSSNativeLengthUnit.pt:
+        value = value * _1pt;
+        break;
+      case CSSNativeLengthUnit.pc:
+        value = value * _1pc;
+        break;
+      case CSSNativeLengthUnit.q:
+        value = value * _1Q;
+        break;
+    }
+    return _createLength(value, type, renderStyle, propertyName);
+  }
+
+  static CSSLengthValue parseNativePercentage(double value, RenderStyle renderStyle, String propertyName) {
+    return _createLength(value / 100, CSSLengthType.PERCENTAGE, renderStyle, propertyName);
+  }
+
+  static CSSLengthValue _createLength(double? value, CSSLengthType unit, RenderStyle? renderStyle,
+      [String? propertyName, Axis? axisType]) {
     if (value == 0 && unit != CSSLengthType.PERCENTAGE) {
       return CSSLengthValue.zero;
     } else if (value == null) {
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+import 'dart:ui';
+
+import 'package:webf/css.dart';
+
+// CSSValueKind in bridge/core/css/parser/css_value_parser.h.
+const int _number = 1;
+const int _percentage = 2;
+const int _length = 3;
+const int _color = 4;
+const int _keyword = 5;
+
+// CSSValueKeyword.
+const int _auto = 0;
+const int _none = 1;
+
+// The powers of ten are exact doubles, dividing the mantissa by them gives the same double as parsing the text.
+const List<double> _powersOfTen = [
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+];
+
+// CSSLengthUnit.
+enum CSSNativeLengthUnit { px, em, rem, rpx, vw, vh, vmin, vmax, cm, mm, inch, pt, pc, q }
+
+/// A value of the inline style parsed by the bridge when it was set, which saves parsing common values like lengths
+/// and colors on the UI thread. The value is only used when it is resolved for the same [text].
+///
+/// See CSSValueParser in bridge/core/css/parser/css_value_parser.h for the encoding.
+class CSSNativeValue {
+  final String text;
+  final int _value;
+
+  CSSNativeValue(this.text, this._value);
+
+  int get _kind => _value & 0xf;
+
+  double get _number => (_value >> 14) / _powersOfTen[(_value >> 9) & 0x1f];
+
+  /// Returns the value of the property, or null when the property should be resolved from the text.
+  dynamic resolve(RenderStyle renderStyle, String propertyName) {
+    switch (propertyName) {
+      case TOP:
+      case LEFT:
+      case BOTTOM:
+      case RIGHT:
+      case FLEX_BASIS:
+      case WIDTH:
+      case MIN_WIDTH:
+      case MAX_WIDTH:
+      case HEIGHT:
+      case MIN_HEIGHT:
+      case MAX_HEIGHT:
+      case PADDING_TOP:
+      case PADDING_RIGHT:
+      case PADDING_BOTTOM:
+      case PADDING_LEFT:
+      case MARGIN_TOP:
+      case MARGIN_RIGHT:
+      case MARGIN_BOTTOM:
+      case MARGIN_LEFT:
+        return _resolveLength(renderStyle, propertyName);
+      case COLOR:
+      case CARETCOLOR:
+      case BACKGROUND_COLOR:
+      case TEXT_DECORATION_COLOR:
+      case BORDER_LEFT_COLOR:
+      case BORDER_TOP_COLOR:
+      case BORDER_RIGHT_COLOR:
+      case BORDER_BOTTOM_COLOR:
+        return _kind == _color ? CSSColor(Color((_value >> 32) & 0xffffffff)) : null;
+      case OPACITY:
+        return _kind == _number ? _number : null;
+    }
+    return null;
+  }
+
+  CSSLengthValue? _resolveLength(RenderStyle renderStyle, String propertyName) {
+    switch (_kind) {
+      case _number:
+        return CSSLength.parseNativeLength(_number, CSSNativeLengthUnit.px, renderStyle, propertyName);
+      case _length:
+        return CSSLength.parseNativeLength(
+            _number, CSSNativeLengthUnit.values[(_value >> 4) & 0x1f], renderStyle, propertyName);
+      case _percentage:
+        return CSSLength.parseNativePercentage(_number, renderStyle, propertyName);
+      case _keyword:
+        int keyword = (_value >> 4) & 0xf;
+        if (keyword == _auto) return CSSLengthValue.auto;
+        if (keyword == _none) return CSSLengthValue.none;
+        break;
+    }
+    return null;
+  }
+}
@@ -104,6 +104,31 @@ class Document extends ContainerNode {
   }
   void clearElementStyleDirty(Element element) {
     _styleDirtyElements.remove(element.pointer!.address);
+    _styleDirtyRoots.remove(element.pointer!.address);
+  }
+
+  // The topmost elements whose style changed at native side, reported in front of each batch of UI commands. The
+  // attribute commands of the batch leave their style recalc to these roots, each recalculated once at the end.
+  final Set<int> _styleDirtyRoots = {};
+  bool _styleRecalcDeferredToRoots = false;
+
+  bool get styleRecalcDeferredToRoots => _styleRecalcDeferredToRoots;
+
+  void markStyleDirtyRoot(int address) {
+    _styleDirtyRoots.add(address);
+    _styleRecalcDeferredToRoots = true;
+  }
+
+  void recalculateStyleDirtyRoots() {
+    _styleRecalcDeferredToRoots = false;
+    if (_styleDirtyRoots.isEmpty) return;
+    for (int address in _styleDirtyRoots) {
+      BindingObject? root = ownerView.getBindingObject<BindingObject>(Pointer.fromAddress(address));
+      if (root is Element) {
+        root.recalculateStyle(rebuildNested: true);
+      }
+    }
+    _styleDirtyRoots.clear();
   }
 
   final NthIndexCache _nthIndexCache = NthIndexCache();
@@ -584,6 +609,7 @@ class Document extends ContainerNode {
     adoptedStyleSheets.clear();
     cookie.clearCookie();
     _styleDirtyElements.clear();
+    _styleDirtyRoots.clear();
     fixedChildren.clear();
     pendingPreloadingScriptCallbacks.clear();
     super.dispose();
@@ -117,7 +117,7 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
     final isNeedRecalculate = _checkRecalculateStyle([id, _id]);
     _updateIDMap(id, oldID: _id);
     _id = id;
-    recalculateStyle(rebuildNested: isNeedRecalculate);
+    _recalculateStyleOfAttribute(isNeedRecalculate);
   }
 
   // Is element an replaced element.
@@ -168,7 +168,7 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
     if (classList.isNotEmpty) {
       _classList.addAll(classList);
     }
-    recalculateStyle(rebuildNested: isNeedRecalculate);
+    _recalculateStyleOfAttribute(isNeedRecalculate);
   }
 
   String get className => _classList.join(_ONE_SPACE);
@@ -1373,7 +1373,7 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
       return;
     }
     final isNeedRecalculate = _checkRecalculateStyle([qualifiedName]);
-    recalculateStyle(rebuildNested: isNeedRecalculate);
+    _recalculateStyleOfAttribute(isNeedRecalculate);
   }
 
   @mustCallSuper
@@ -1387,7 +1387,7 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
     if (hasAttribute(qualifiedName)) {
       attributes.remove(qualifiedName);
       final isNeedRecalculate = _checkRecalculateStyle([qualifiedName]);
-      recalculateStyle(rebuildNested: isNeedRecalculate);
+      _recalculateStyleOfAttribute(isNeedRecalculate);
     }
   }
 
@@ -1651,10 +1651,11 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
     }
   }
 
-  // Set inline style property.
-  void setInlineStyle(String property, String value) {
+  // Set inline style property, [nativeValue] is the value parsed by the bridge, see [CSSNativeValue].
+  void setInlineStyle(String property, String value, {int nativeValue = 0}) {
     // Current only for mark property is setting by inline style.
     inlineStyle[property] = value;
+    renderStyle.setNativeValue(property, nativeValue == 0 ? null : CSSNativeValue(value, nativeValue));
     // recalculate matching styles for element when inline styles are removed.
     if (value.isEmpty) {
       style.removeProperty(property, true);
@@ -1667,6 +1668,7 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
   void clearInlineStyle() {
     for (var key in inlineStyle.keys) {
       style.removeProperty(key, true);
+      renderStyle.setNativeValue(key, null);
     }
     inlineStyle.clear();
   }
@@ -1936,6 +1938,14 @@ abstract class Element extends ContainerNode with ElementBase, ElementEventMixin
     return scrollingContentLayoutBox;
   }
 
+  // The attribute changes from a batch of UI commands are recalculated with the style dirty roots sent by native side.
+  void _recalculateStyleOfAttribute(bool rebuildNested) {
+    if (ownerDocument.styleRecalcDeferredToRoots) {
+      return;
+    }
+    recalculateStyle(rebuildNested: rebuildNested);
+  }
+
   bool _checkRecalculateStyle(List<String?> keys) {
     if (keys.isEmpty) {
       return false;
@@ -242,8 +242,17 @@ dynamic setterBindingCall(BindingObject bindingObject, List<dynamic> args, { Bin
     WebFProfiler.instance.startTrackBindingSteps(profileOp!, 'setterBindingCall');
   }
 
-  String key = args[0];
-  dynamic value = args[1];
+  applyBindingProperty(bindingObject, args[0], args[1]);
+
+  if (enableWebFProfileTracking) {
+    WebFProfiler.instance.finishTrackBindingSteps(profileOp!);
+  }
+
+  return true;
+}
+
+// Shared by the sync setter call and the write-behind setProperty UI command.
+void applyBindingProperty(BindingObject bindingObject, String key, dynamic value) {
   BindingObjectProperty? property = (bindingObject as DynamicBindingObject)._properties[key];
   if (property != null && property.setter != null) {
     property.setter!(value);
@@ -256,12 +265,29 @@ dynamic setterBindingCall(BindingObject bindingObject, List<dynamic> args, { Bin
       bindingObject.propertyDidUpdate(key, value);
     }
   }
+}
+
+// Read a group of layout properties by one call, native side keeps the results until the next layout pass.
+dynamic getLayoutPropertiesBindingCall(BindingObject bindingObject, List<dynamic> args, { BindingOpItem? profileOp }) {
+  if (enableWebFProfileTracking) {
+    WebFProfiler.instance.startTrackBindingSteps(profileOp!, 'getLayoutPropertiesBindingCall');
+  }
+
+  Map<String, BindingObjectProperty> properties = (bindingObject as DynamicBindingObject)._properties;
+  List<dynamic> result = List.generate(args.length, (int i) {
+    BindingObjectProperty? property = properties[args[i]];
+    return property?.getter();
+  });
+
+  if (enableWebFCommandLog) {
+    print('$bindingObject getLayoutPropertiesBindingCall keys: $args result: $result');
+  }
 
   if (enableWebFProfileTracking) {
     WebFProfiler.instance.finishTrackBindingSteps(profileOp!);
   }
 
-  return true;
+  return result;
 }
 
 dynamic getPropertyNamesBindingCall(BindingObject bindingObject, List<dynamic> args, { BindingOpItem? profileOp }) {
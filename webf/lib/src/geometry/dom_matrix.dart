@@ -6,7 +6,5 @@ import 'package:webf/foundation.dart';
 import 'dom_matrix_readonly.dart';
 
 class DOMMatrix extends DOMMatrixReadonly {
-  DOMMatrix(BindingContext context, List<dynamic> domMatrixInit): super(context, domMatrixInit) {
-    print('domMatrix init: $domMatrixInit');
-  }
+  DOMMatrix(BindingContext context, List<dynamic> domMatrixInit): super(context, domMatrixInit);
 }
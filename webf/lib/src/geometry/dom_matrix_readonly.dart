@@ -2,13 +2,31 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+import 'package:vector_math/vector_math_64.dart';
 import 'package:webf/foundation.dart';
 
+// The matrix math runs at native side, the values are only copied to dart when the matrix is passed to dart.
 class DOMMatrixReadonly extends DynamicBindingObject {
-  DOMMatrixReadonly(BindingContext context, List<dynamic> domMatrixInit): super(context);
+  DOMMatrixReadonly(BindingContext context, List<dynamic> domMatrixInit)
+      : matrix = _createMatrix(domMatrixInit),
+        super(context);
+
+  // Column-major, the same layout as the native side.
+  final Matrix4 matrix;
+
+  static Matrix4 _createMatrix(List<dynamic> domMatrixInit) {
+    if (domMatrixInit.isEmpty || domMatrixInit[0] is! List) return Matrix4.identity();
+    List<dynamic> values = domMatrixInit[0];
+    if (values.length != 16) return Matrix4.identity();
+    return Matrix4.fromList(values.map((value) => (value as num).toDouble()).toList());
+  }
 
   @override
   void initializeMethods(Map<String, BindingObjectMethod> methods) {
+    // Native side refreshes the values in place once the matrix changed after it was passed to dart.
+    methods['updateMatrix'] = BindingObjectMethodSync(call: (List args) {
+      matrix.setFrom(_createMatrix(args));
+    });
   }
 
   @override
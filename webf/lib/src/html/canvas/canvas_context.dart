@@ -9,6 +9,7 @@ import 'dart:ui';
 import 'dart:ffi' as ffi;
 
 import 'package:flutter/painting.dart';
+import 'package:vector_math/vector_math_64.dart' show Matrix4;
 import 'package:meta/meta.dart';
 import 'package:webf/webf.dart';
 import 'package:webf/css.dart';
@@ -187,9 +188,13 @@ class CanvasPattern extends DynamicBindingObject {
   @override
   get pointer => _pointer;
 
-  // opaque object
+  Matrix4? _transform;
+
+  Matrix4? get transform => _transform;
+
   void setTransform(DOMMatrix domMatrix) {
-    print('setTransform: $domMatrix');
+    // Copy the values, later changes to the DOMMatrix should not affect the pattern.
+    _transform = domMatrix.matrix.clone();
   }
 
   @override
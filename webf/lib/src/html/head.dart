@@ -277,6 +277,10 @@ mixin StyleElementMixin on Element {
         setter: (value) => type = attributeToProperty<String>(value));
   }
 
+  // Whether the bridge parses the text and sends the rules with UICommandType.setStyleSheet, instead of parsing the
+  // text here when the children change.
+  bool get hasNativeStyleSheetParser => false;
+
   void _recalculateStyle() {
     if (enableWebFProfileTracking) {
       WebFProfiler.instance.startTrackUICommandStep('$this.parseInlineStyle');
@@ -288,11 +292,7 @@ mixin StyleElementMixin on Element {
       } else {
         _styleSheet = CSSParser(text).parse();
       }
-      if (_styleSheet != null) {
-        ownerDocument.markElementStyleDirty(ownerDocument.documentElement!);
-        ownerDocument.styleNodeManager.appendPendingStyleSheet(_styleSheet!);
-        ownerDocument.updateStyleIfNeeded();
-      }
+      _didUpdateStyleSheet();
     }
 
     if (enableWebFProfileTracking) {
@@ -300,24 +300,47 @@ mixin StyleElementMixin on Element {
     }
   }
 
+  /// Applies the rules parsed by the bridge, the text is parsed here when the rules are null.
+  void setStyleSheetRules(List<CSSRule>? rules) {
+    if (rules == null) {
+      _recalculateStyle();
+      return;
+    }
+
+    // A new sheet object lets the style node manager diff the rules against the previous sheet.
+    if (_styleSheet != null) {
+      ownerDocument.styleNodeManager.removePendingStyleSheet(_styleSheet!);
+    }
+    _styleSheet = CSSStyleSheet(rules);
+    _didUpdateStyleSheet();
+  }
+
+  void _didUpdateStyleSheet() {
+    if (_styleSheet != null) {
+      ownerDocument.markElementStyleDirty(ownerDocument.documentElement!);
+      ownerDocument.styleNodeManager.appendPendingStyleSheet(_styleSheet!);
+      ownerDocument.updateStyleIfNeeded();
+    }
+  }
+
   @override
   Node appendChild(Node child) {
     Node ret = super.appendChild(child);
-    _recalculateStyle();
+    if (!hasNativeStyleSheetParser) _recalculateStyle();
     return ret;
   }
 
   @override
   Node insertBefore(Node child, Node referenceNode) {
     Node ret = super.insertBefore(child, referenceNode);
-    _recalculateStyle();
+    if (!hasNativeStyleSheetParser) _recalculateStyle();
     return ret;
   }
 
   @override
   Node removeChild(Node child) {
     Node ret = super.removeChild(child);
-    _recalculateStyle();
+    if (!hasNativeStyleSheetParser) _recalculateStyle();
     return ret;
   }
 
@@ -325,7 +348,7 @@ mixin StyleElementMixin on Element {
   void connectedCallback() {
     super.connectedCallback();
     if (_type == _CSS_MIME) {
-      if (_styleSheet == null) {
+      if (_styleSheet == null && !hasNativeStyleSheetParser) {
         _recalculateStyle();
       }
       ownerDocument.styleNodeManager.addStyleSheetCandidateNode(this);
@@ -345,4 +368,8 @@ mixin StyleElementMixin on Element {
 // https://www.w3.org/TR/2011/WD-html5-author-20110809/the-style-element.html
 class StyleElement extends Element with StyleElementMixin {
   StyleElement([BindingContext? context]) : super(context);
+
+  // Parsed by HTMLStyleElement in the bridge.
+  @override
+  bool get hasNativeStyleSheetParser => true;
 }
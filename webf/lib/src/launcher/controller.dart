@@ -221,6 +221,7 @@ class WebFViewController implements WidgetsBindingObserver {
   void flushPendingCommandsPerFrame() {
     if (disposed && _isFrameBindingAttached) return;
     _isFrameBindingAttached = true;
+    markLayoutDirty(contextId);
     flushUICommand(this, window.pointer!);
     SchedulerBinding.instance.addPostFrameCallback((_) => flushPendingCommandsPerFrame());
   }
@@ -589,6 +590,23 @@ class WebFViewController implements WidgetsBindingObserver {
     }
   }
 
+  void setBindingProperty(Pointer<NativeBindingObject> selfPtr, String key, dynamic value) {
+    assert(hasBindingObject(selfPtr), 'selfPtr: $selfPtr key: $key value: $value');
+    BindingObject? target = getBindingObject<BindingObject>(selfPtr);
+    if (target == null) return;
+
+    applyBindingProperty(target, key, value);
+  }
+
+  // The rule set is nullptr when the bridge leaves the sheet to the Dart parser.
+  void setStyleSheet(Pointer<NativeBindingObject> selfPtr, Pointer<Uint32> ruleSet) {
+    assert(hasBindingObject(selfPtr), 'selfPtr: $selfPtr');
+    BindingObject? target = getBindingObject<BindingObject>(selfPtr);
+    if (target is! StyleElementMixin) return;
+
+    target.setStyleSheetRules(ruleSet == nullptr ? null : decodeNativeCSSRules(ruleSet));
+  }
+
   String? getAttribute(Pointer selfPtr, String key) {
     assert(hasBindingObject(selfPtr), 'targetId: $selfPtr key: $key');
     Node? target = getBindingObject<Node>(selfPtr);
@@ -620,13 +638,13 @@ class WebFViewController implements WidgetsBindingObserver {
     }
   }
 
-  void setInlineStyle(Pointer selfPtr, String key, String value) {
+  void setInlineStyle(Pointer selfPtr, String key, String value, {int nativeValue = 0}) {
     assert(hasBindingObject(selfPtr), 'id: $selfPtr key: $key value: $value');
     Node? target = getBindingObject<Node>(selfPtr);
     if (target == null) return;
 
     if (target is Element) {
-      target.setInlineStyle(key, value);
+      target.setInlineStyle(key, value, nativeValue: nativeValue);
     } else {
       debugPrint('Only element has style, try setting style.$key from Node(#$selfPtr).');
     }
@@ -135,6 +135,7 @@ class WebF extends StatefulWidget {
       throw ArgumentError('The element name "$tagName" is not valid.');
     }
     defineElement(tagName.toUpperCase(), creator);
+    markWidgetElementDefined();
   }
 
   Future<void> load(WebFBundle bundle) async {
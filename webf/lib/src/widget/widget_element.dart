@@ -123,8 +123,8 @@ abstract class WidgetElement extends dom.Element {
   }
 
   @override
-  void setInlineStyle(String property, String value) {
-    super.setInlineStyle(property, value);
+  void setInlineStyle(String property, String value, {int nativeValue = 0}) {
+    super.setInlineStyle(property, value, nativeValue: nativeValue);
     bool shouldRebuild = shouldElementRebuild(property, style.getPropertyValue(property), value);
     if (_state != null && shouldRebuild) {
       _state!.requestUpdateState();